@@ -1,4 +1,5 @@
 
+#include <stddef.h>
 #include <stdint.h>
 
 /*!
@@ -111,6 +112,39 @@ void    aes_256_dec_key_schedule (
     uint8_t  * const ck
 );
 
+/*!
+@brief Derive the AES 128 decrypt key schedule from the encrypt one,
+    without expanding the cipher key again.
+@param [out] drk - The decrypt key schedule. May be the same as erk.
+@param [in]  erk - The encrypt key schedule
+*/
+void    aes_128_dec_key_schedule_from_enc (
+    uint32_t * const drk,
+    uint32_t * const erk
+);
+
+/*!
+@brief Derive the AES 192 decrypt key schedule from the encrypt one,
+    without expanding the cipher key again.
+@param [out] drk - The decrypt key schedule. May be the same as erk.
+@param [in]  erk - The encrypt key schedule
+*/
+void    aes_192_dec_key_schedule_from_enc (
+    uint32_t * const drk,
+    uint32_t * const erk
+);
+
+/*!
+@brief Derive the AES 256 decrypt key schedule from the encrypt one,
+    without expanding the cipher key again.
+@param [out] drk - The decrypt key schedule. May be the same as erk.
+@param [in]  erk - The encrypt key schedule
+*/
+void    aes_256_dec_key_schedule_from_enc (
+    uint32_t * const drk,
+    uint32_t * const erk
+);
+
 
 /*!
 @brief single-block AES 128 encrypt function
@@ -191,6 +225,261 @@ void    aes_256_ecb_decrypt (
     uint32_t  * rk
 );
 
+/*!
+@brief Multi-block AES 128 ECB encrypt function.
+@details Independent blocks are interleaved within each round, so that
+    every round key is loaded once per group of blocks and the latency
+    of one block is hidden behind the others.
+@param [out] ct      - Output cipher text, nblocks*AES_BLOCK_BYTES long.
+@param [in]  pt      - Input plaintext, nblocks*AES_BLOCK_BYTES long.
+@param [in]  rk      - The expanded key schedule
+@param [in]  nblocks - Number of blocks to encrypt.
+*/
+void    aes_128_ecb_encrypt_blocks (
+    uint8_t   * ct,
+    uint8_t   * pt,
+    uint32_t  * rk,
+    size_t      nblocks
+);
+
+/*!
+@brief Multi-block AES 192 ECB encrypt function.
+@param [out] ct      - Output cipher text, nblocks*AES_BLOCK_BYTES long.
+@param [in]  pt      - Input plaintext, nblocks*AES_BLOCK_BYTES long.
+@param [in]  rk      - The expanded key schedule
+@param [in]  nblocks - Number of blocks to encrypt.
+*/
+void    aes_192_ecb_encrypt_blocks (
+    uint8_t   * ct,
+    uint8_t   * pt,
+    uint32_t  * rk,
+    size_t      nblocks
+);
+
+/*!
+@brief Multi-block AES 256 ECB encrypt function.
+@param [out] ct      - Output cipher text, nblocks*AES_BLOCK_BYTES long.
+@param [in]  pt      - Input plaintext, nblocks*AES_BLOCK_BYTES long.
+@param [in]  rk      - The expanded key schedule
+@param [in]  nblocks - Number of blocks to encrypt.
+*/
+void    aes_256_ecb_encrypt_blocks (
+    uint8_t   * ct,
+    uint8_t   * pt,
+    uint32_t  * rk,
+    size_t      nblocks
+);
+
+/*!
+@brief Multi-block AES 128 ECB decrypt function.
+@details Uses the decryption key schedule, and interleaves blocks in the
+    same way as aes_128_ecb_encrypt_blocks.
+@param [out] pt      - Output plaintext, nblocks*AES_BLOCK_BYTES long.
+@param [in]  ct      - Input cipher text, nblocks*AES_BLOCK_BYTES long.
+@param [in]  rk      - The expanded key schedule
+@param [in]  nblocks - Number of blocks to decrypt.
+*/
+void    aes_128_ecb_decrypt_blocks (
+    uint8_t   * pt,
+    uint8_t   * ct,
+    uint32_t  * rk,
+    size_t      nblocks
+);
+
+/*!
+@brief Multi-block AES 192 ECB decrypt function.
+@param [out] pt      - Output plaintext, nblocks*AES_BLOCK_BYTES long.
+@param [in]  ct      - Input cipher text, nblocks*AES_BLOCK_BYTES long.
+@param [in]  rk      - The expanded key schedule
+@param [in]  nblocks - Number of blocks to decrypt.
+*/
+void    aes_192_ecb_decrypt_blocks (
+    uint8_t   * pt,
+    uint8_t   * ct,
+    uint32_t  * rk,
+    size_t      nblocks
+);
+
+/*!
+@brief Multi-block AES 256 ECB decrypt function.
+@param [out] pt      - Output plaintext, nblocks*AES_BLOCK_BYTES long.
+@param [in]  ct      - Input cipher text, nblocks*AES_BLOCK_BYTES long.
+@param [in]  rk      - The expanded key schedule
+@param [in]  nblocks - Number of blocks to decrypt.
+*/
+void    aes_256_ecb_decrypt_blocks (
+    uint8_t   * pt,
+    uint8_t   * ct,
+    uint32_t  * rk,
+    size_t      nblocks
+);
+
+/*!
+@brief AES 128 counter mode encrypt / decrypt.
+@details The keystream for block i is the encryption of ctr+i, where ctr
+    is a 128-bit big-endian counter. A trailing partial block uses the
+    leading bytes of one more keystream block. On return, ctr holds the
+    next unused counter value, so a long message may be processed in
+    several calls, as long as every call but the last is a whole number
+    of blocks.
+@param [out]   out - Output text, len bytes long.
+@param [in]    in  - Input text, len bytes long.
+@param [in]    rk  - The expanded encryption key schedule
+@param [in]    len - Length of in and out in bytes.
+@param [inout] ctr - Initial counter block. Updated in place.
+*/
+void    aes_128_ctr_xcrypt (
+    uint8_t   * out,
+    uint8_t   * in,
+    uint32_t  * rk,
+    size_t      len,
+    uint8_t     ctr [AES_BLOCK_BYTES]
+);
+
+/*!
+@brief AES 192 counter mode encrypt / decrypt.
+@param [out]   out - Output text, len bytes long.
+@param [in]    in  - Input text, len bytes long.
+@param [in]    rk  - The expanded encryption key schedule
+@param [in]    len - Length of in and out in bytes.
+@param [inout] ctr - Initial counter block. Updated in place.
+*/
+void    aes_192_ctr_xcrypt (
+    uint8_t   * out,
+    uint8_t   * in,
+    uint32_t  * rk,
+    size_t      len,
+    uint8_t     ctr [AES_BLOCK_BYTES]
+);
+
+/*!
+@brief AES 256 counter mode encrypt / decrypt.
+@param [out]   out - Output text, len bytes long.
+@param [in]    in  - Input text, len bytes long.
+@param [in]    rk  - The expanded encryption key schedule
+@param [in]    len - Length of in and out in bytes.
+@param [inout] ctr - Initial counter block. Updated in place.
+*/
+void    aes_256_ctr_xcrypt (
+    uint8_t   * out,
+    uint8_t   * in,
+    uint32_t  * rk,
+    size_t      len,
+    uint8_t     ctr [AES_BLOCK_BYTES]
+);
+
+/*!
+@brief AES 128 encrypt with on-the-fly key expansion.
+@details Round keys are computed from the cipher key as the block is
+    encrypted, so no key schedule is stored. Only provided by the
+    zscrypto_rv32 and zscrypto_rv64 implementations.
+@param [out] ct - Output cipher text
+@param [in]  pt - Input plaintext
+@param [in]  ck - The cipher key, AES_128_KEY_BYTES long.
+*/
+void    aes_128_ecb_encrypt_otf (
+    uint8_t     ct [AES_BLOCK_BYTES],
+    uint8_t     pt [AES_BLOCK_BYTES],
+    uint8_t   * ck
+);
+
+/*!
+@brief AES 192 encrypt with on-the-fly key expansion.
+@param [out] ct - Output cipher text
+@param [in]  pt - Input plaintext
+@param [in]  ck - The cipher key, AES_192_KEY_BYTES long.
+*/
+void    aes_192_ecb_encrypt_otf (
+    uint8_t     ct [AES_BLOCK_BYTES],
+    uint8_t     pt [AES_BLOCK_BYTES],
+    uint8_t   * ck
+);
+
+/*!
+@brief AES 256 encrypt with on-the-fly key expansion.
+@param [out] ct - Output cipher text
+@param [in]  pt - Input plaintext
+@param [in]  ck - The cipher key, AES_256_KEY_BYTES long.
+*/
+void    aes_256_ecb_encrypt_otf (
+    uint8_t     ct [AES_BLOCK_BYTES],
+    uint8_t     pt [AES_BLOCK_BYTES],
+    uint8_t   * ck
+);
+
+/*!
+@brief Compute the AES 128 on-the-fly decryption key.
+@details This is the last Nk words of the expanded key, i.e. the last
+    round key, from which aes_128_ecb_decrypt_otf runs the key schedule
+    backwards. It is the same size as the cipher key.
+@param [out] dk - Output decryption key, AES_128_KEY_BYTES long.
+@param [in]  ck - The cipher key, AES_128_KEY_BYTES long.
+*/
+void    aes_128_otf_dec_key (
+    uint8_t   * dk,
+    uint8_t   * ck
+);
+
+/*!
+@brief Compute the AES 192 on-the-fly decryption key.
+@details Words 48..53 of the expanded key: the last round key and the
+    two words after it, which the backwards schedule needs.
+@param [out] dk - Output decryption key, AES_192_KEY_BYTES long.
+@param [in]  ck - The cipher key, AES_192_KEY_BYTES long.
+*/
+void    aes_192_otf_dec_key (
+    uint8_t   * dk,
+    uint8_t   * ck
+);
+
+/*!
+@brief Compute the AES 256 on-the-fly decryption key.
+@details Words 56..63 of the expanded key: the last round key and the
+    four words after it, which the backwards schedule needs.
+@param [out] dk - Output decryption key, AES_256_KEY_BYTES long.
+@param [in]  ck - The cipher key, AES_256_KEY_BYTES long.
+*/
+void    aes_256_otf_dec_key (
+    uint8_t   * dk,
+    uint8_t   * ck
+);
+
+/*!
+@brief AES 128 decrypt with on-the-fly key expansion.
+@param [out] pt - Output plaintext
+@param [in]  ct - Input cipher text
+@param [in]  dk - Decryption key from aes_128_otf_dec_key
+*/
+void    aes_128_ecb_decrypt_otf (
+    uint8_t     pt [AES_BLOCK_BYTES],
+    uint8_t     ct [AES_BLOCK_BYTES],
+    uint8_t   * dk
+);
+
+/*!
+@brief AES 192 decrypt with on-the-fly key expansion.
+@param [out] pt - Output plaintext
+@param [in]  ct - Input cipher text
+@param [in]  dk - Decryption key from aes_192_otf_dec_key
+*/
+void    aes_192_ecb_decrypt_otf (
+    uint8_t     pt [AES_BLOCK_BYTES],
+    uint8_t     ct [AES_BLOCK_BYTES],
+    uint8_t   * dk
+);
+
+/*!
+@brief AES 256 decrypt with on-the-fly key expansion.
+@param [out] pt - Output plaintext
+@param [in]  ct - Input cipher text
+@param [in]  dk - Decryption key from aes_256_otf_dec_key
+*/
+void    aes_256_ecb_decrypt_otf (
+    uint8_t     pt [AES_BLOCK_BYTES],
+    uint8_t     ct [AES_BLOCK_BYTES],
+    uint8_t   * dk
+);
+
 #endif
 
 //! @}
@@ -0,0 +1,330 @@
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "riscvcrypto/aes/api_aes.h"
+
+/*!
+@defgroup crypto_block_aes_gcm Crypto Block AES GCM
+@ingroup crypto_block_aes
+@brief AES in Galois/Counter Mode, as per NIST SP 800-38D.
+@details Messages are processed with an init / aad / update / final
+    sequence. GHASH is computed with carry-less multiply, using
+    precomputed powers of H so that several blocks are folded into the
+    accumulator with a single reduction.
+@{
+*/
+
+#ifndef __API_AES_GCM_H__
+#define __API_AES_GCM_H__
+
+//! Number of bytes in a full GCM authentication tag.
+#define AES_GCM_TAG_BYTES   16
+
+//! Shortest tag aes_gcm_final_verify accepts (NIST SP 800-38D, 5.2.1.2).
+#define AES_GCM_TAG_MIN_BYTES 12
+
+//! Number of powers of H kept per key, and blocks folded per reduction.
+#define AES_GCM_H_POWERS    4
+
+//! 64-bit words of precomputed GHASH key material per power of H.
+#define AES_GCM_HTAB_STRIDE 6
+
+//! Single block AES encrypt function, as used by GCM.
+typedef void (*aes_gcm_ecb_t) (
+    uint8_t     ct [AES_BLOCK_BYTES],
+    uint8_t     pt [AES_BLOCK_BYTES],
+    uint32_t  * rk
+);
+
+//! AES counter mode function, as used by GCM.
+typedef void (*aes_gcm_ctr_t) (
+    uint8_t   * out,
+    uint8_t   * in,
+    uint32_t  * rk,
+    size_t      len,
+    uint8_t     ctr [AES_BLOCK_BYTES]
+);
+
+typedef struct aes_gcm_ctx aes_gcm_ctx_t;
+
+//! State for a single AES-GCM message.
+struct aes_gcm_ctx {
+    uint32_t      rk  [AES_256_RK_WORDS];  //!< Expanded encryption key
+    uint64_t      htab[AES_GCM_HTAB_STRIDE * AES_GCM_H_POWERS];
+                                           //!< H^1..H^n. Layout is private
+                                           //   to the GHASH implementation.
+    uint64_t      x   [2];                 //!< GHASH accumulator (bytes)
+    uint8_t       j0  [AES_BLOCK_BYTES];   //!< Pre-counter block
+    uint8_t       ctr [AES_BLOCK_BYTES];   //!< Next counter block
+    uint8_t       ks  [AES_BLOCK_BYTES];   //!< Keystream of a partial block
+    uint8_t       buf [AES_BLOCK_BYTES];   //!< Partial block of GHASH input
+    size_t        buf_len;                 //!< Bytes used in buf
+    int           aad_done;                //!< Set once text is processed
+    uint64_t      aad_len;                 //!< Total AAD bytes
+    uint64_t      txt_len;                 //!< Total text bytes
+    aes_gcm_ecb_t ecb;                     //!< Block cipher for this key
+    aes_gcm_ctr_t ctr_fn;                  //!< Counter mode for this key
+    uint32_t      nr;                      //!< Number of AES rounds
+};
+
+/*!
+@brief Whole-block function: counter mode over nblocks of in, and GHASH
+    of the cipher text, updating ctx->ctr and ctx->x.
+@param encrypt - Non-zero if out is the cipher text, zero if in is.
+*/
+typedef void (*aes_gcm_blocks_t) (
+    aes_gcm_ctx_t * ctx,
+    uint8_t       * out,
+    uint8_t       * in,
+    size_t          nblocks,
+    int             encrypt
+);
+
+
+/*!
+@brief Precompute the GHASH key table from the hash subkey H.
+@param [out] htab - AES_GCM_HTAB_STRIDE * AES_GCM_H_POWERS words.
+@param [in]  h    - The hash subkey, E(K, 0^128).
+*/
+void    ghash_init (
+    uint64_t  * htab,
+    uint8_t     h [AES_BLOCK_BYTES]
+);
+
+/*!
+@brief Fold whole blocks into a GHASH accumulator.
+@details Groups of AES_GCM_H_POWERS blocks are multiplied by descending
+    powers of H and summed before a single reduction.
+@param [in]    htab    - Table from ghash_init.
+@param [inout] x       - Accumulator, as 16 bytes in GCM order.
+@param [in]    in      - Input blocks, nblocks*AES_BLOCK_BYTES long.
+@param [in]    nblocks - Number of blocks to hash.
+*/
+void    ghash_blocks (
+    uint64_t  * htab,
+    uint64_t    x [2],
+    uint8_t   * in,
+    size_t      nblocks
+);
+
+/*!
+@brief Start an AES 128 GCM message.
+@param [out] ctx    - Message state to initialise.
+@param [in]  ck     - The AES_128_KEY_BYTES cipher key.
+@param [in]  iv     - Initialisation vector. 12 bytes is recommended.
+@param [in]  iv_len - Length of iv in bytes.
+*/
+void    aes_128_gcm_init (
+    aes_gcm_ctx_t * ctx,
+    uint8_t       * ck,
+    uint8_t       * iv,
+    size_t          iv_len
+);
+
+/*!
+@brief Start an AES 192 GCM message.
+@param [out] ctx    - Message state to initialise.
+@param [in]  ck     - The AES_192_KEY_BYTES cipher key.
+@param [in]  iv     - Initialisation vector.
+@param [in]  iv_len - Length of iv in bytes.
+*/
+void    aes_192_gcm_init (
+    aes_gcm_ctx_t * ctx,
+    uint8_t       * ck,
+    uint8_t       * iv,
+    size_t          iv_len
+);
+
+/*!
+@brief Start an AES 256 GCM message.
+@param [out] ctx    - Message state to initialise.
+@param [in]  ck     - The AES_256_KEY_BYTES cipher key.
+@param [in]  iv     - Initialisation vector.
+@param [in]  iv_len - Length of iv in bytes.
+*/
+void    aes_256_gcm_init (
+    aes_gcm_ctx_t * ctx,
+    uint8_t       * ck,
+    uint8_t       * iv,
+    size_t          iv_len
+);
+
+/*!
+@brief Add additional authenticated data.
+@details May be called any number of times, with any lengths, but only
+    before the first call to aes_gcm_encrypt_update or
+    aes_gcm_decrypt_update.
+@param [inout] ctx - Message state.
+@param [in]    aad - Additional data.
+@param [in]    len - Length of aad in bytes.
+*/
+void    aes_gcm_aad (
+    aes_gcm_ctx_t * ctx,
+    uint8_t       * aad,
+    size_t          len
+);
+
+/*!
+@brief Encrypt the next part of the message.
+@details May be called any number of times, with any lengths.
+@param [inout] ctx - Message state.
+@param [out]   ct  - Cipher text, len bytes long.
+@param [in]    pt  - Plain text, len bytes long. May equal ct.
+@param [in]    len - Length of pt and ct in bytes.
+*/
+void    aes_gcm_encrypt_update (
+    aes_gcm_ctx_t * ctx,
+    uint8_t       * ct,
+    uint8_t       * pt,
+    size_t          len
+);
+
+/*!
+@brief Decrypt the next part of the message.
+@details May be called any number of times, with any lengths.
+@param [inout] ctx - Message state.
+@param [out]   pt  - Plain text, len bytes long.
+@param [in]    ct  - Cipher text, len bytes long. May equal pt.
+@param [in]    len - Length of pt and ct in bytes.
+*/
+void    aes_gcm_decrypt_update (
+    aes_gcm_ctx_t * ctx,
+    uint8_t       * pt,
+    uint8_t       * ct,
+    size_t          len
+);
+
+/*!
+@brief Finish the message and compute the authentication tag.
+@param [inout] ctx - Message state. Must be re-initialised before reuse.
+@param [out]   tag - The AES_GCM_TAG_BYTES authentication tag.
+*/
+void    aes_gcm_final (
+    aes_gcm_ctx_t * ctx,
+    uint8_t         tag [AES_GCM_TAG_BYTES]
+);
+
+/*!
+@brief Check the authentication tag of a decrypted message.
+@details Computes the tag as aes_gcm_final does, and compares the first
+    tag_len bytes of it with tag in constant time. Truncated tags shorter
+    than AES_GCM_TAG_MIN_BYTES are always rejected: the 4 and 8 byte
+    tags SP 800-38D allows for some applications are not supported.
+@param [inout] ctx     - Message state. Must be re-initialised before reuse.
+@param [in]    tag     - The received tag.
+@param [in]    tag_len - Length of tag in bytes, from AES_GCM_TAG_MIN_BYTES
+    to AES_GCM_TAG_BYTES.
+@returns 0 if the tag matches, non-zero if it does not or tag_len is out
+    of range.
+*/
+int     aes_gcm_final_verify (
+    aes_gcm_ctx_t * ctx,
+    uint8_t       * tag,
+    size_t          tag_len
+);
+
+/*!
+@brief Counter mode over whole blocks, with the GCM inc32 function.
+@details Used by aes_gcm_blocks, and by kernels for any blocks they do
+    not handle themselves.
+*/
+void    aes_gcm_ctr (
+    aes_gcm_ctx_t * ctx,
+    uint8_t       * out,
+    uint8_t       * in,
+    size_t          nblocks
+);
+
+/*!
+@brief The default aes_gcm_blocks_t: a counter mode pass followed, or
+    preceded when decrypting, by a GHASH pass.
+*/
+void    aes_gcm_blocks (
+    aes_gcm_ctx_t * ctx,
+    uint8_t       * out,
+    uint8_t       * in,
+    size_t          nblocks,
+    int             encrypt
+);
+
+/*!
+@brief Shared body of the update functions.
+@details Handles partial blocks, and hands whole blocks to blocks.
+    aes_gcm_encrypt_update and aes_gcm_decrypt_update use aes_gcm_blocks.
+*/
+void    aes_gcm_update_with (
+    aes_gcm_ctx_t    * ctx,
+    uint8_t          * out,
+    uint8_t          * in,
+    size_t             len,
+    int                encrypt,
+    aes_gcm_blocks_t   blocks
+);
+
+/*!
+@brief As aes_gcm_encrypt_update, but whole blocks go through a single
+    pass which interleaves the AES rounds with the GHASH multiplies.
+@details Only available for RV64 with the scalar crypto extensions.
+*/
+void    aes_gcm_encrypt_update_stitched (
+    aes_gcm_ctx_t * ctx,
+    uint8_t       * ct,
+    uint8_t       * pt,
+    size_t          len
+);
+
+/*!
+@brief As aes_gcm_decrypt_update, but whole blocks are hashed and
+    decrypted in a single stitched pass. Follow with aes_gcm_final_verify.
+@details Only available for RV64 with the scalar crypto extensions.
+*/
+void    aes_gcm_decrypt_update_stitched (
+    aes_gcm_ctx_t * ctx,
+    uint8_t       * pt,
+    uint8_t       * ct,
+    size_t          len
+);
+
+/*!
+@brief Stitched RV64 kernel: encrypt nblocks of counter mode and fold
+    the cipher text into the GHASH accumulator.
+@param [out]   ct      - Cipher text.
+@param [in]    pt      - Plain text.
+@param [in]    nblocks - Number of blocks. Must be even and non-zero.
+@param [in]    rk      - Expanded encryption key.
+@param [in]    ke      - rk + 4*nr, the last round key.
+@param [in]    htab    - Table from ghash_init.
+@param [inout] x       - GHASH accumulator.
+@param [inout] ctr     - Counter block. The low 32 bits must not wrap.
+*/
+void    aes_gcm_enc_kernel_zscrypto_rv64 (
+    uint8_t   * ct,
+    uint8_t   * pt,
+    size_t      nblocks,
+    uint32_t  * rk,
+    uint32_t  * ke,
+    uint64_t  * htab,
+    uint64_t    x   [2],
+    uint8_t     ctr [AES_BLOCK_BYTES]
+);
+
+/*!
+@brief Stitched RV64 kernel: fold the cipher text into the GHASH
+    accumulator and decrypt it. Arguments are as for
+    aes_gcm_enc_kernel_zscrypto_rv64, with pt and ct swapped.
+*/
+void    aes_gcm_dec_kernel_zscrypto_rv64 (
+    uint8_t   * pt,
+    uint8_t   * ct,
+    size_t      nblocks,
+    uint32_t  * rk,
+    uint32_t  * ke,
+    uint64_t  * htab,
+    uint64_t    x   [2],
+    uint8_t     ctr [AES_BLOCK_BYTES]
+);
+
+#endif
+
+//! @}
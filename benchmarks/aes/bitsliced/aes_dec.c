@@ -0,0 +1,230 @@
+
+/*!
+@addtogroup crypto_block_aes_bitsliced AES Bitsliced
+@ingroup crypto_block_aes
+@{
+*/
+
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/aes/api_aes.h"
+#include "riscvcrypto/aes/bitsliced/common.h"
+
+extern void    aes_key_schedule (
+    uint32_t * const rk , //!< Output Nk*(Nr+1) word cipher key.
+    uint8_t  * const ck , //!< Input Nk byte cipher key
+    const int  Nk , //!< Number of words in the key.
+    const int  Nr   //!< Number of rounds.
+);
+
+/*!
+@brief Decryption uses the straightforward inverse cipher, so the
+    decryption key schedule is the encryption one.
+*/
+void    aes_128_dec_key_schedule (
+    uint32_t * const rk,
+    uint8_t  * const ck
+){
+    aes_key_schedule(rk, ck, AES_128_NK, AES_128_NR);
+}
+
+void    aes_192_dec_key_schedule (
+    uint32_t * const rk,
+    uint8_t  * const ck
+){
+    aes_key_schedule(rk, ck, AES_192_NK, AES_192_NR);
+}
+
+void    aes_256_dec_key_schedule (
+    uint32_t * const rk,
+    uint8_t  * const ck
+){
+    aes_key_schedule(rk, ck, AES_256_NK, AES_256_NR);
+}
+
+/*!
+@brief The decrypt key schedule is the encrypt one, so deriving it is a copy.
+*/
+static void aes_dec_key_schedule_copy (
+    uint32_t * const drk,
+    uint32_t * const erk,
+    int              nr
+){
+    if(drk != erk) {
+        for(int i = 0; i < 4 * (nr + 1); i ++) {
+            drk[i] = erk[i];
+        }
+    }
+}
+
+void    aes_128_dec_key_schedule_from_enc (
+    uint32_t * const drk,
+    uint32_t * const erk
+){
+    aes_dec_key_schedule_copy(drk, erk, AES_128_NR);
+}
+
+void    aes_192_dec_key_schedule_from_enc (
+    uint32_t * const drk,
+    uint32_t * const erk
+){
+    aes_dec_key_schedule_copy(drk, erk, AES_192_NR);
+}
+
+void    aes_256_dec_key_schedule_from_enc (
+    uint32_t * const drk,
+    uint32_t * const erk
+){
+    aes_dec_key_schedule_copy(drk, erk, AES_256_NR);
+}
+
+/*!
+@brief The affine map L(y) = A^-1.y ^ 0x05, where A is the affine matrix
+    of the S-box.
+@details The S-box is S(x) = A.inv(x) ^ 0x63, so inv(x) = L(S(x)), and
+    the inverse S-box is inv(L(y)) = L(S(L(y))). This reuses the forward
+    circuit rather than a second one for the inverse.
+*/
+static void aes_bs_inv_affine(aes_bs_state_t q) {
+    aes_bs_state_t y;
+    for(int i = 0; i < 8; i ++) {
+        y[i] = q[i];
+    }
+    for(int i = 0; i < 8; i ++) {
+        q[i] = y[(i + 2) & 7] ^ y[(i + 5) & 7] ^ y[(i + 7) & 7];
+    }
+    q[0] = ~q[0];
+    q[2] = ~q[2];
+}
+
+//! The AES inverse S-box on every byte.
+static void aes_bs_inv_sbox(aes_bs_state_t q) {
+    aes_bs_inv_affine(q);
+    aes_bs_sbox(q);
+    aes_bs_inv_affine(q);
+}
+
+//! InvShiftRows: rotate the 16-bit lane of row r left by 4*r bits.
+static void aes_bs_inv_shift_rows(aes_bs_state_t q) {
+    for(int j = 0; j < 8; j ++) {
+        uint64_t x = q[j];
+        q[j] =  (x        & 0x000000000000FFFFULL) |
+               ((x <<  4) & 0x00000000FFF00000ULL) |
+               ((x >> 12) & 0x00000000000F0000ULL) |
+               ((x >>  8) & 0x000000FF00000000ULL) |
+               ((x <<  8) & 0x0000FF0000000000ULL) |
+               ((x >>  4) & 0x0FFF000000000000ULL) |
+               ((x << 12) & 0xF000000000000000ULL) ;
+    }
+}
+
+/*
+InvMixColumns is MixColumns applied after the matrix with rows
+{05 00 04 00} rotated, which is s ^ 4.(s ^ s2).
+*/
+static void aes_bs_inv_mix_columns(aes_bs_state_t q) {
+    aes_bs_state_t t, t2;
+    for(int j = 0; j < 8; j ++) {
+        t[j] = q[j] ^ ROTR64(q[j], 32);
+    }
+    aes_bs_xtime(t2, t);
+    aes_bs_xtime(t , t2);
+    for(int j = 0; j < 8; j ++) {
+        q[j] ^= t[j];
+    }
+    aes_bs_mix_columns(q);
+}
+
+/*!
+@brief Decrypt nblocks consecutive blocks, AES_BS_BLOCKS at a time.
+*/
+void    aes_ecb_decrypt_blocks (
+    uint8_t   * pt,
+    uint8_t   * ct,
+    uint32_t  * rk,
+    size_t      nblocks,
+    int         nr
+){
+    aes_bs_state_t sk [AES_256_NR + 1];
+    aes_bs_state_t q;
+
+    aes_bs_slice_keys(sk, rk, nr);
+
+    while(nblocks > 0) {
+
+        size_t nb = nblocks < AES_BS_BLOCKS ? nblocks : AES_BS_BLOCKS;
+
+        aes_bs_pack(q, ct, nb);
+        aes_bs_add_round_key(q, sk[nr]);
+
+        for(int round = nr - 1; round >= 1; round --) {
+            aes_bs_inv_shift_rows(q);
+            aes_bs_inv_sbox(q);
+            aes_bs_add_round_key(q, sk[round]);
+            aes_bs_inv_mix_columns(q);
+        }
+
+        aes_bs_inv_shift_rows(q);
+        aes_bs_inv_sbox(q);
+        aes_bs_add_round_key(q, sk[0]);
+
+        aes_bs_unpack(pt, q, nb);
+
+        pt      += AES_BLOCK_BYTES * nb;
+        ct      += AES_BLOCK_BYTES * nb;
+        nblocks -= nb;
+    }
+}
+
+void    aes_128_ecb_decrypt (
+    uint8_t     pt [AES_BLOCK_BYTES],
+    uint8_t     ct [AES_BLOCK_BYTES],
+    uint32_t  * rk
+){
+    aes_ecb_decrypt_blocks(pt,ct,rk,1,AES_128_NR);
+}
+
+void    aes_192_ecb_decrypt (
+    uint8_t     pt [AES_BLOCK_BYTES],
+    uint8_t     ct [AES_BLOCK_BYTES],
+    uint32_t  * rk
+){
+    aes_ecb_decrypt_blocks(pt,ct,rk,1,AES_192_NR);
+}
+
+void    aes_256_ecb_decrypt (
+    uint8_t     pt [AES_BLOCK_BYTES],
+    uint8_t     ct [AES_BLOCK_BYTES],
+    uint32_t  * rk
+){
+    aes_ecb_decrypt_blocks(pt,ct,rk,1,AES_256_NR);
+}
+
+void    aes_128_ecb_decrypt_blocks (
+    uint8_t   * pt,
+    uint8_t   * ct,
+    uint32_t  * rk,
+    size_t      nblocks
+){
+    aes_ecb_decrypt_blocks(pt,ct,rk,nblocks,AES_128_NR);
+}
+
+void    aes_192_ecb_decrypt_blocks (
+    uint8_t   * pt,
+    uint8_t   * ct,
+    uint32_t  * rk,
+    size_t      nblocks
+){
+    aes_ecb_decrypt_blocks(pt,ct,rk,nblocks,AES_192_NR);
+}
+
+void    aes_256_ecb_decrypt_blocks (
+    uint8_t   * pt,
+    uint8_t   * ct,
+    uint32_t  * rk,
+    size_t      nblocks
+){
+    aes_ecb_decrypt_blocks(pt,ct,rk,nblocks,AES_256_NR);
+}
+
+//!@}
@@ -0,0 +1,464 @@
+
+/*!
+@addtogroup crypto_block_aes_bitsliced AES Bitsliced
+@brief Constant time bitsliced implementation of AES w.out acceleration.
+@details AES_BS_BLOCKS blocks are held as eight 64-bit words, one per bit
+    of each byte, so SubBytes becomes the Boyar-Peralta S-box circuit of
+    XOR, AND and XNOR gates applied to whole words. There are no table
+    lookups and no data dependent branches.
+
+    The key schedule is the standard one, so rk has the same layout as for
+    the other backends. Round keys are bitsliced at the start of every
+    call; the multi-block functions spread that cost over all the blocks
+    of the call.
+@ingroup crypto_block_aes
+@{
+*/
+
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/aes/api_aes.h"
+#include "riscvcrypto/aes/bitsliced/common.h"
+
+//! AES Round constants
+static const uint8_t round_const[11] = {
+  0x8d, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36
+};
+
+//! Swap the bits of a selected by mask << n with the bits of b in mask.
+#define SWAPMOVE(a, b, mask, n) {                   \
+    uint64_t t_ = (((a) >> (n)) ^ (b)) & (mask);    \
+    (b) ^= t_;                                      \
+    (a) ^= t_ << (n);                               \
+}
+
+/*!
+@brief Transpose the 8x8 bit matrix found at each byte position of the
+    eight words in q. Used both to enter and to leave bitsliced form.
+*/
+static void aes_bs_transpose(aes_bs_state_t q) {
+    SWAPMOVE(q[0], q[1], 0x5555555555555555ULL, 1);
+    SWAPMOVE(q[2], q[3], 0x5555555555555555ULL, 1);
+    SWAPMOVE(q[4], q[5], 0x5555555555555555ULL, 1);
+    SWAPMOVE(q[6], q[7], 0x5555555555555555ULL, 1);
+    SWAPMOVE(q[0], q[2], 0x3333333333333333ULL, 2);
+    SWAPMOVE(q[1], q[3], 0x3333333333333333ULL, 2);
+    SWAPMOVE(q[4], q[6], 0x3333333333333333ULL, 2);
+    SWAPMOVE(q[5], q[7], 0x3333333333333333ULL, 2);
+    SWAPMOVE(q[0], q[4], 0x0F0F0F0F0F0F0F0FULL, 4);
+    SWAPMOVE(q[1], q[5], 0x0F0F0F0F0F0F0F0FULL, 4);
+    SWAPMOVE(q[2], q[6], 0x0F0F0F0F0F0F0F0FULL, 4);
+    SWAPMOVE(q[3], q[7], 0x0F0F0F0F0F0F0F0FULL, 4);
+}
+
+/*
+Before the transpose, word 4*h+b holds the bytes of block b which are in
+the columns c with c%2 == h. Byte k of the word is row k/2 of column
+2*(k%2)+h. After the transpose, bit 8*k + 4*h + b of each word is then
+the byte at row k/2, column 2*(k%2)+h of block b, as described for
+aes_bs_state_t.
+*/
+
+void aes_bs_pack(aes_bs_state_t q, uint8_t * in, size_t nblocks) {
+    for(int i = 0; i < 8; i ++) {
+        int      h = i >> 2;
+        size_t   b = i &  3;
+        uint64_t w = 0;
+        if(b < nblocks) {
+            for(int k = 7; k >= 0; k --) {
+                int c = 2 * (k & 1) + h;
+                w = (w << 8) | in[AES_BLOCK_BYTES * b + 4 * c + (k >> 1)];
+            }
+        }
+        q[i] = w;
+    }
+    aes_bs_transpose(q);
+}
+
+void aes_bs_unpack(uint8_t * out, aes_bs_state_t q, size_t nblocks) {
+    aes_bs_transpose(q);
+    for(int i = 0; i < 8; i ++) {
+        int      h = i >> 2;
+        size_t   b = i &  3;
+        uint64_t w = q[i];
+        if(b < nblocks) {
+            for(int k = 0; k < 8; k ++) {
+                int c = 2 * (k & 1) + h;
+                out[AES_BLOCK_BYTES * b + 4 * c + (k >> 1)] = w & 0xFF;
+                w >>= 8;
+            }
+        }
+    }
+}
+
+void aes_bs_slice_keys(aes_bs_state_t * sk, uint32_t * rk, int nr) {
+    uint8_t * rkb = (uint8_t*)rk;
+    for(int r = 0; r <= nr; r ++) {
+        aes_bs_pack(sk[r], rkb + AES_BLOCK_BYTES * r, 1);
+        for(int j = 0; j < 8; j ++) {       // Copy block 0 into 1..3
+            sk[r][j] |= sk[r][j] << 1;
+            sk[r][j] |= sk[r][j] << 2;
+        }
+    }
+}
+
+void aes_bs_add_round_key(aes_bs_state_t q, aes_bs_state_t k) {
+    for(int j = 0; j < 8; j ++) {
+        q[j] ^= k[j];
+    }
+}
+
+void aes_bs_sbox(aes_bs_state_t q) {
+    // Boyar-Peralta depth 16 circuit. U0 / S0 are the most significant
+    // bit of each byte.
+    uint64_t U0 = q[7], U1 = q[6], U2 = q[5], U3 = q[4];
+    uint64_t U4 = q[3], U5 = q[2], U6 = q[1], U7 = q[0];
+
+    // Top linear transform
+    uint64_t T1  = U0  ^ U3 ;
+    uint64_t T2  = U0  ^ U5 ;
+    uint64_t T3  = U0  ^ U6 ;
+    uint64_t T4  = U3  ^ U5 ;
+    uint64_t T5  = U4  ^ U6 ;
+    uint64_t T6  = T1  ^ T5 ;
+    uint64_t T7  = U1  ^ U2 ;
+    uint64_t T8  = U7  ^ T6 ;
+    uint64_t T9  = U7  ^ T7 ;
+    uint64_t T10 = T6  ^ T7 ;
+    uint64_t T11 = U1  ^ U5 ;
+    uint64_t T12 = U2  ^ U5 ;
+    uint64_t T13 = T3  ^ T4 ;
+    uint64_t T14 = T6  ^ T11;
+    uint64_t T15 = T5  ^ T11;
+    uint64_t T16 = T5  ^ T12;
+    uint64_t T17 = T9  ^ T16;
+    uint64_t T18 = U3  ^ U7 ;
+    uint64_t T19 = T7  ^ T18;
+    uint64_t T20 = T1  ^ T19;
+    uint64_t T21 = U6  ^ U7 ;
+    uint64_t T22 = T7  ^ T21;
+    uint64_t T23 = T2  ^ T22;
+    uint64_t T24 = T2  ^ T10;
+    uint64_t T25 = T20 ^ T17;
+    uint64_t T26 = T3  ^ T16;
+    uint64_t T27 = T1  ^ T12;
+
+    // Shared non-linear middle: inversion in GF(2^4)^2
+    uint64_t M1  = T13 & T6 ;
+    uint64_t M2  = T23 & T8 ;
+    uint64_t M3  = T14 ^ M1 ;
+    uint64_t M4  = T19 & U7 ;
+    uint64_t M5  = M4  ^ M1 ;
+    uint64_t M6  = T3  & T16;
+    uint64_t M7  = T22 & T9 ;
+    uint64_t M8  = T26 ^ M6 ;
+    uint64_t M9  = T20 & T17;
+    uint64_t M10 = M9  ^ M6 ;
+    uint64_t M11 = T1  & T15;
+    uint64_t M12 = T4  & T27;
+    uint64_t M13 = M12 ^ M11;
+    uint64_t M14 = T2  & T10;
+    uint64_t M15 = M14 ^ M11;
+    uint64_t M16 = M3  ^ M2 ;
+    uint64_t M17 = M5  ^ T24;
+    uint64_t M18 = M8  ^ M7 ;
+    uint64_t M19 = M10 ^ M15;
+    uint64_t M20 = M16 ^ M13;
+    uint64_t M21 = M17 ^ M15;
+    uint64_t M22 = M18 ^ M13;
+    uint64_t M23 = M19 ^ T25;
+    uint64_t M24 = M22 ^ M23;
+    uint64_t M25 = M22 & M20;
+    uint64_t M26 = M21 ^ M25;
+    uint64_t M27 = M20 ^ M21;
+    uint64_t M28 = M23 ^ M25;
+    uint64_t M29 = M28 & M27;
+    uint64_t M30 = M26 & M24;
+    uint64_t M31 = M20 & M23;
+    uint64_t M32 = M27 & M31;
+    uint64_t M33 = M27 ^ M25;
+    uint64_t M34 = M21 & M22;
+    uint64_t M35 = M24 & M34;
+    uint64_t M36 = M24 ^ M25;
+    uint64_t M37 = M21 ^ M29;
+    uint64_t M38 = M32 ^ M33;
+    uint64_t M39 = M23 ^ M30;
+    uint64_t M40 = M35 ^ M36;
+    uint64_t M41 = M38 ^ M40;
+    uint64_t M42 = M37 ^ M39;
+    uint64_t M43 = M37 ^ M38;
+    uint64_t M44 = M39 ^ M40;
+    uint64_t M45 = M42 ^ M41;
+    uint64_t M46 = M44 & T6 ;
+    uint64_t M47 = M40 & T8 ;
+    uint64_t M48 = M39 & U7 ;
+    uint64_t M49 = M43 & T16;
+    uint64_t M50 = M38 & T9 ;
+    uint64_t M51 = M37 & T17;
+    uint64_t M52 = M42 & T15;
+    uint64_t M53 = M45 & T27;
+    uint64_t M54 = M41 & T10;
+    uint64_t M55 = M44 & T13;
+    uint64_t M56 = M40 & T23;
+    uint64_t M57 = M39 & T19;
+    uint64_t M58 = M43 & T3 ;
+    uint64_t M59 = M38 & T22;
+    uint64_t M60 = M37 & T20;
+    uint64_t M61 = M42 & T1 ;
+    uint64_t M62 = M45 & T4 ;
+    uint64_t M63 = M41 & T2 ;
+
+    // Bottom linear transform
+    uint64_t L0  = M61 ^ M62;
+    uint64_t L1  = M50 ^ M56;
+    uint64_t L2  = M46 ^ M48;
+    uint64_t L3  = M47 ^ M55;
+    uint64_t L4  = M54 ^ M58;
+    uint64_t L5  = M49 ^ M61;
+    uint64_t L6  = M62 ^ L5 ;
+    uint64_t L7  = M46 ^ L3 ;
+    uint64_t L8  = M51 ^ M59;
+    uint64_t L9  = M52 ^ M53;
+    uint64_t L10 = M53 ^ L4 ;
+    uint64_t L11 = M60 ^ L2 ;
+    uint64_t L12 = M48 ^ M51;
+    uint64_t L13 = M50 ^ L0 ;
+    uint64_t L14 = M52 ^ M61;
+    uint64_t L15 = M55 ^ L1 ;
+    uint64_t L16 = M56 ^ L0 ;
+    uint64_t L17 = M57 ^ L1 ;
+    uint64_t L18 = M58 ^ L8 ;
+    uint64_t L19 = M63 ^ L4 ;
+    uint64_t L20 = L0  ^ L1 ;
+    uint64_t L21 = L1  ^ L7 ;
+    uint64_t L22 = L3  ^ L12;
+    uint64_t L23 = L18 ^ L2 ;
+    uint64_t L24 = L15 ^ L9 ;
+    uint64_t L25 = L6  ^ L10;
+    uint64_t L26 = L7  ^ L9 ;
+    uint64_t L27 = L8  ^ L10;
+    uint64_t L28 = L11 ^ L14;
+    uint64_t L29 = L11 ^ L17;
+
+    q[7] =  L6  ^ L24 ;
+    q[6] = ~(L16 ^ L26);
+    q[5] = ~(L19 ^ L28);
+    q[4] =  L6  ^ L21 ;
+    q[3] =  L20 ^ L22 ;
+    q[2] =  L25 ^ L29 ;
+    q[1] = ~(L13 ^ L27);
+    q[0] = ~(L6  ^ L23);
+}
+
+//! ShiftRows: rotate the 16-bit lane of row r right by 4*r bits.
+static void aes_bs_shift_rows(aes_bs_state_t q) {
+    for(int j = 0; j < 8; j ++) {
+        uint64_t x = q[j];
+        q[j] =  (x        & 0x000000000000FFFFULL) |
+               ((x >>  4) & 0x000000000FFF0000ULL) |
+               ((x << 12) & 0x00000000F0000000ULL) |
+               ((x >>  8) & 0x000000FF00000000ULL) |
+               ((x <<  8) & 0x0000FF0000000000ULL) |
+               ((x >> 12) & 0x000F000000000000ULL) |
+               ((x <<  4) & 0xFFF0000000000000ULL) ;
+    }
+}
+
+void aes_bs_xtime(aes_bs_state_t out, aes_bs_state_t in) {
+    uint64_t hi = in[7];
+    out[7] = in[6];
+    out[6] = in[5];
+    out[5] = in[4];
+    out[4] = in[3] ^ hi;
+    out[3] = in[2] ^ hi;
+    out[2] = in[1];
+    out[1] = in[0] ^ hi;
+    out[0] = hi;
+}
+
+/*
+With s the column, and s1, s2 the column rotated up by one and two rows,
+MixColumns is 2.(s ^ s1) ^ s1 ^ s2 ^ s3 = 2.t ^ s1 ^ rot2(t), where
+t = s ^ s1. Rotating the rows is a rotation of each word by 16 bits.
+*/
+void aes_bs_mix_columns(aes_bs_state_t q) {
+    aes_bs_state_t t, t2;
+    for(int j = 0; j < 8; j ++) {
+        t[j] = q[j] ^ ROTR64(q[j], 16);
+    }
+    aes_bs_xtime(t2, t);
+    for(int j = 0; j < 8; j ++) {
+        q[j] = t2[j] ^ ROTR64(q[j], 16) ^ ROTR64(t[j], 32);
+    }
+}
+
+/*!
+@brief Apply the AES forward SBox to each byte in a 32-bit word.
+@details Goes through the bitsliced S-box, so that the key schedule is
+    also free of table lookups.
+*/
+static uint32_t aes_sub_word(uint32_t in) {
+    aes_bs_state_t q;
+    uint8_t        b [AES_BLOCK_BYTES] = {0};
+
+    U32_TO_U8LE(b, in, 0);
+    aes_bs_pack(q, b, 1);
+    aes_bs_sbox(q);
+    aes_bs_unpack(b, q, 1);
+
+    return U8_TO_U32LE(b);
+}
+
+
+/*!
+@brief A generic AES key schedule
+*/
+void    aes_key_schedule (
+    uint32_t * const rk , //!< Output Nk*(Nr+1) word cipher key.
+    uint8_t  * const ck , //!< Input Nk byte cipher key
+    const int  Nk , //!< Number of words in the key.
+    const int  Nr   //!< Number of rounds.
+){
+    for(int i = 0; i < Nk; i ++) {
+
+        rk[i] = U8_TO_U32LE((ck +  4*i));
+
+    }
+
+    for(int i = Nk; i < 4*(Nr+1); i += 1) {
+
+        uint32_t temp = rk[i-1];
+
+        if( i % Nk == 0 ) {
+
+            temp  = ROTR32(temp, 8);
+            temp  = aes_sub_word(temp);
+            temp ^= round_const[i/Nk];
+
+        } else if ( (Nk > 6) && (i % Nk == 4)) {
+
+            temp  = aes_sub_word(temp);
+
+        }
+
+        rk[i] = rk[i-Nk] ^ temp;
+    }
+}
+
+
+void    aes_128_enc_key_schedule (
+    uint32_t * const rk,
+    uint8_t  * const ck
+){
+    aes_key_schedule(rk, ck, AES_128_NK, AES_128_NR);
+}
+
+void    aes_192_enc_key_schedule (
+    uint32_t * const rk,
+    uint8_t  * const ck
+){
+    aes_key_schedule(rk, ck, AES_192_NK, AES_192_NR);
+}
+
+void    aes_256_enc_key_schedule (
+    uint32_t * const rk,
+    uint8_t  * const ck
+){
+    aes_key_schedule(rk, ck, AES_256_NK, AES_256_NR);
+}
+
+
+/*!
+@brief Encrypt nblocks consecutive blocks, AES_BS_BLOCKS at a time.
+@details A trailing group of fewer blocks costs as much as a full one.
+*/
+void    aes_ecb_encrypt_blocks (
+    uint8_t   * ct,
+    uint8_t   * pt,
+    uint32_t  * rk,
+    size_t      nblocks,
+    int         nr
+){
+    aes_bs_state_t sk [AES_256_NR + 1];
+    aes_bs_state_t q;
+
+    aes_bs_slice_keys(sk, rk, nr);
+
+    while(nblocks > 0) {
+
+        size_t nb = nblocks < AES_BS_BLOCKS ? nblocks : AES_BS_BLOCKS;
+
+        aes_bs_pack(q, pt, nb);
+        aes_bs_add_round_key(q, sk[0]);
+
+        for(int round = 1; round < nr; round ++) {
+            aes_bs_sbox(q);
+            aes_bs_shift_rows(q);
+            aes_bs_mix_columns(q);
+            aes_bs_add_round_key(q, sk[round]);
+        }
+
+        aes_bs_sbox(q);
+        aes_bs_shift_rows(q);
+        aes_bs_add_round_key(q, sk[nr]);
+
+        aes_bs_unpack(ct, q, nb);
+
+        ct      += AES_BLOCK_BYTES * nb;
+        pt      += AES_BLOCK_BYTES * nb;
+        nblocks -= nb;
+    }
+}
+
+void    aes_128_ecb_encrypt (
+    uint8_t     ct [AES_BLOCK_BYTES],
+    uint8_t     pt [AES_BLOCK_BYTES],
+    uint32_t  * rk
+){
+    aes_ecb_encrypt_blocks(ct,pt,rk,1,AES_128_NR);
+}
+
+void    aes_192_ecb_encrypt (
+    uint8_t     ct [AES_BLOCK_BYTES],
+    uint8_t     pt [AES_BLOCK_BYTES],
+    uint32_t  * rk
+){
+    aes_ecb_encrypt_blocks(ct,pt,rk,1,AES_192_NR);
+}
+
+void    aes_256_ecb_encrypt (
+    uint8_t     ct [AES_BLOCK_BYTES],
+    uint8_t     pt [AES_BLOCK_BYTES],
+    uint32_t  * rk
+){
+    aes_ecb_encrypt_blocks(ct,pt,rk,1,AES_256_NR);
+}
+
+void    aes_128_ecb_encrypt_blocks (
+    uint8_t   * ct,
+    uint8_t   * pt,
+    uint32_t  * rk,
+    size_t      nblocks
+){
+    aes_ecb_encrypt_blocks(ct,pt,rk,nblocks,AES_128_NR);
+}
+
+void    aes_192_ecb_encrypt_blocks (
+    uint8_t   * ct,
+    uint8_t   * pt,
+    uint32_t  * rk,
+    size_t      nblocks
+){
+    aes_ecb_encrypt_blocks(ct,pt,rk,nblocks,AES_192_NR);
+}
+
+void    aes_256_ecb_encrypt_blocks (
+    uint8_t   * ct,
+    uint8_t   * pt,
+    uint32_t  * rk,
+    size_t      nblocks
+){
+    aes_ecb_encrypt_blocks(ct,pt,rk,nblocks,AES_256_NR);
+}
+
+//!@}
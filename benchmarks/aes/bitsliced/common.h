@@ -0,0 +1,38 @@
+#ifndef __AES_BITSLICED_COMMON__
+#define __AES_BITSLICED_COMMON__
+
+#include <stddef.h>
+#include <stdint.h>
+
+//! Number of blocks held in one bitsliced state.
+#define AES_BS_BLOCKS   4
+
+/*!
+@brief Bitsliced state of AES_BS_BLOCKS blocks.
+@details Word j holds bit j of every byte. Byte r of column c of block b
+    is at bit 16*r + 4*c + b, so each row is one 16-bit lane.
+*/
+typedef uint64_t aes_bs_state_t [8];
+
+//! Convert nblocks (at most AES_BS_BLOCKS) blocks into bitsliced form.
+void aes_bs_pack(aes_bs_state_t q, uint8_t * in, size_t nblocks);
+
+//! Convert the first nblocks blocks back out of bitsliced form.
+void aes_bs_unpack(uint8_t * out, aes_bs_state_t q, size_t nblocks);
+
+//! Bitslice each round key of rk, copied into every block position.
+void aes_bs_slice_keys(aes_bs_state_t * sk, uint32_t * rk, int nr);
+
+//! XOR a bitsliced round key into the state.
+void aes_bs_add_round_key(aes_bs_state_t q, aes_bs_state_t k);
+
+//! The AES S-box on every byte, using the Boyar-Peralta circuit.
+void aes_bs_sbox(aes_bs_state_t q);
+
+//! Multiply every byte by x (0x02) in GF(2^8).
+void aes_bs_xtime(aes_bs_state_t out, aes_bs_state_t in);
+
+//! Forward MixColumns on every column.
+void aes_bs_mix_columns(aes_bs_state_t q);
+
+#endif
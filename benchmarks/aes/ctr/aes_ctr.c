@@ -0,0 +1,127 @@
+/*!
+@addtogroup crypto_block_aes_ctr AES CTR
+@brief Counter mode on top of the multi-block ECB API.
+@details Used by the backends which do not provide their own counter
+    mode. The counter lives in two 64-bit variables and is only written
+    out as big-endian counter blocks, AES_CTR_BLOCKS at a time, which are
+    then passed to aes_*_ecb_encrypt_blocks.
+@ingroup crypto_block_aes
+@{
+*/
+
+#include <string.h>
+
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/aes/api_aes.h"
+
+//! Number of counter blocks encrypted per call to the ECB function.
+#define AES_CTR_BLOCKS 4
+
+//! Signature shared by aes_{128,192,256}_ecb_encrypt_blocks.
+typedef void (*aes_ecb_blocks_t) (
+    uint8_t * ct, uint8_t * pt, uint32_t * rk, size_t nblocks
+);
+
+//! Load a 64-bit big-endian value.
+static inline uint64_t aes_ctr_load64_be(uint8_t * p) {
+    uint64_t r = 0;
+    for(int i = 0; i < 8; i ++) {
+        r = (r << 8) | p[i];
+    }
+    return r;
+}
+
+//! Store a 64-bit big-endian value.
+static inline void aes_ctr_store64_be(uint8_t * p, uint64_t x) {
+    for(int i = 7; i >= 0; i --) {
+        p[i] = x & 0xFF;
+        x  >>= 8;
+    }
+}
+
+/*!
+@brief Generic counter mode, parameterised over the ECB function.
+*/
+static void aes_ctr_xcrypt (
+    uint8_t          * out,
+    uint8_t          * in ,
+    uint32_t         * rk ,
+    size_t             len,
+    uint8_t            ctr [AES_BLOCK_BYTES],
+    aes_ecb_blocks_t   ecb
+){
+    uint64_t ks [2*AES_CTR_BLOCKS]; //!< Counter blocks, then keystream.
+    uint64_t ctr_hi = aes_ctr_load64_be(ctr + 0);
+    uint64_t ctr_lo = aes_ctr_load64_be(ctr + 8);
+
+    int aligned = (((uintptr_t)in | (uintptr_t)out) & 0x3) == 0;
+
+    while(len > 0) {
+
+        size_t nb = (len + AES_BLOCK_BYTES - 1) / AES_BLOCK_BYTES;
+        nb        = nb < AES_CTR_BLOCKS ? nb : AES_CTR_BLOCKS;
+
+        for(size_t b = 0; b < nb; b ++) {
+            aes_ctr_store64_be((uint8_t*)(ks + 2*b + 0), ctr_hi);
+            aes_ctr_store64_be((uint8_t*)(ks + 2*b + 1), ctr_lo);
+            ctr_lo += 1;
+            ctr_hi += ctr_lo == 0;
+        }
+
+        ecb((uint8_t*)ks, (uint8_t*)ks, rk, nb);
+
+        size_t nbytes = nb * AES_BLOCK_BYTES;
+        nbytes        = nbytes < len ? nbytes : len;
+        size_t nwords = aligned ? nbytes / 4 : 0;
+
+        uint32_t * ksw = (uint32_t*)ks;
+
+        for(size_t i = 0; i < nwords; i ++) {
+            ((uint32_t*)out)[i] = ((uint32_t*)in)[i] ^ ksw[i];
+        }
+
+        for(size_t i = 4*nwords; i < nbytes; i ++) {
+            out[i] = in[i] ^ ((uint8_t*)ks)[i];
+        }
+
+        out += nbytes;
+        in  += nbytes;
+        len -= nbytes;
+    }
+
+    aes_ctr_store64_be(ctr + 0, ctr_hi);
+    aes_ctr_store64_be(ctr + 8, ctr_lo);
+}
+
+void    aes_128_ctr_xcrypt (
+    uint8_t   * out,
+    uint8_t   * in,
+    uint32_t  * rk,
+    size_t      len,
+    uint8_t     ctr [AES_BLOCK_BYTES]
+){
+    aes_ctr_xcrypt(out, in, rk, len, ctr, aes_128_ecb_encrypt_blocks);
+}
+
+void    aes_192_ctr_xcrypt (
+    uint8_t   * out,
+    uint8_t   * in,
+    uint32_t  * rk,
+    size_t      len,
+    uint8_t     ctr [AES_BLOCK_BYTES]
+){
+    aes_ctr_xcrypt(out, in, rk, len, ctr, aes_192_ecb_encrypt_blocks);
+}
+
+void    aes_256_ctr_xcrypt (
+    uint8_t   * out,
+    uint8_t   * in,
+    uint32_t  * rk,
+    size_t      len,
+    uint8_t     ctr [AES_BLOCK_BYTES]
+){
+    aes_ctr_xcrypt(out, in, rk, len, ctr, aes_256_ecb_encrypt_blocks);
+}
+
+//!@}
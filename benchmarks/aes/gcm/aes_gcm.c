@@ -0,0 +1,338 @@
+/*!
+@addtogroup crypto_block_aes_gcm
+@{
+*/
+
+#include <string.h>
+
+#include "riscvcrypto/aes/api_aes.h"
+#include "riscvcrypto/aes/api_aes_gcm.h"
+
+/*!
+@brief Bulk text is processed in chunks of this many bytes, so that the
+    ciphertext is still in the cache when it is hashed.
+*/
+#define AES_GCM_CHUNK_BYTES (16 * AES_BLOCK_BYTES)
+
+//! Store a 64-bit value big-endian.
+static inline void aes_gcm_store64_be(uint8_t * p, uint64_t x) {
+    for(int i = 7; i >= 0; i --) {
+        p[i] = x & 0xFF;
+        x  >>= 8;
+    }
+}
+
+/*
+The backend counter mode function increments all 128 bits of the counter,
+so calls are split where the low word wraps, and the upper 96 bits are put
+back afterwards.
+*/
+void    aes_gcm_ctr (
+    aes_gcm_ctx_t * ctx,
+    uint8_t       * out,
+    uint8_t       * in ,
+    size_t          nblocks
+){
+    uint8_t  hi [12];
+
+    memcpy(hi, ctx->ctr, 12);
+
+    while(nblocks > 0) {
+        uint32_t lo   = ((uint32_t)ctx->ctr[12] << 24) |
+                        ((uint32_t)ctx->ctr[13] << 16) |
+                        ((uint32_t)ctx->ctr[14] <<  8) |
+                        ((uint32_t)ctx->ctr[15] <<  0) ;
+        uint64_t room = ((uint64_t)1 << 32) - lo;
+        size_t   n    = nblocks < room ? nblocks : (size_t)room;
+
+        ctx->ctr_fn(out, in, ctx->rk, n * AES_BLOCK_BYTES, ctx->ctr);
+        memcpy(ctx->ctr, hi, 12);
+
+        out     += n * AES_BLOCK_BYTES;
+        in      += n * AES_BLOCK_BYTES;
+        nblocks -= n;
+    }
+}
+
+//! Pad and hash any buffered partial block.
+static void aes_gcm_flush (
+    aes_gcm_ctx_t * ctx
+){
+    if(ctx->buf_len > 0) {
+        memset(ctx->buf + ctx->buf_len, 0, AES_BLOCK_BYTES - ctx->buf_len);
+        ghash_blocks(ctx->htab, ctx->x, ctx->buf, 1);
+        ctx->buf_len = 0;
+    }
+}
+
+//! Finish the AAD, the first time text is seen.
+static void aes_gcm_start_text (
+    aes_gcm_ctx_t * ctx
+){
+    if(!ctx->aad_done) {
+        aes_gcm_flush(ctx);
+        ctx->aad_done = 1;
+    }
+}
+
+//! Common part of the aes_*_gcm_init functions.
+static void aes_gcm_init (
+    aes_gcm_ctx_t * ctx,
+    uint8_t       * iv ,
+    size_t          iv_len
+){
+    uint8_t  h  [AES_BLOCK_BYTES];
+
+    memset(ctx->x, 0, sizeof(ctx->x));
+    memset(h     , 0, AES_BLOCK_BYTES);
+
+    ctx->ecb(h, h, ctx->rk);                // H = E(K, 0^128)
+    ghash_init(ctx->htab, h);
+
+    if(iv_len == 12) {
+
+        memcpy(ctx->j0, iv, 12);            // J0 = IV || 0^31 || 1
+        ctx->j0[12] = 0;
+        ctx->j0[13] = 0;
+        ctx->j0[14] = 0;
+        ctx->j0[15] = 1;
+
+    } else {
+
+        size_t  nb = iv_len / AES_BLOCK_BYTES;
+        size_t  nr = iv_len % AES_BLOCK_BYTES;
+
+        ghash_blocks(ctx->htab, ctx->x, iv, nb);
+
+        if(nr) {
+            memset(ctx->buf, 0, AES_BLOCK_BYTES);
+            memcpy(ctx->buf, iv + nb * AES_BLOCK_BYTES, nr);
+            ghash_blocks(ctx->htab, ctx->x, ctx->buf, 1);
+        }
+
+        memset(ctx->buf, 0, AES_BLOCK_BYTES);
+        aes_gcm_store64_be(ctx->buf + 8, (uint64_t)iv_len * 8);
+        ghash_blocks(ctx->htab, ctx->x, ctx->buf, 1);
+
+        memcpy(ctx->j0, ctx->x, AES_BLOCK_BYTES);
+        memset(ctx->x , 0, sizeof(ctx->x));
+
+    }
+
+    memcpy(ctx->ctr, ctx->j0, AES_BLOCK_BYTES);
+
+    for(int i = 15; i >= 12; i --) {        // ctr = inc32(J0)
+        if(++ctx->ctr[i] != 0) {
+            break;
+        }
+    }
+
+    ctx->buf_len  = 0;
+    ctx->aad_done = 0;
+    ctx->aad_len  = 0;
+    ctx->txt_len  = 0;
+}
+
+void    aes_128_gcm_init (
+    aes_gcm_ctx_t * ctx,
+    uint8_t       * ck,
+    uint8_t       * iv,
+    size_t          iv_len
+){
+    aes_128_enc_key_schedule(ctx->rk, ck);
+    ctx->ecb    = aes_128_ecb_encrypt;
+    ctx->ctr_fn = aes_128_ctr_xcrypt;
+    ctx->nr     = AES_128_NR;
+    aes_gcm_init(ctx, iv, iv_len);
+}
+
+void    aes_192_gcm_init (
+    aes_gcm_ctx_t * ctx,
+    uint8_t       * ck,
+    uint8_t       * iv,
+    size_t          iv_len
+){
+    aes_192_enc_key_schedule(ctx->rk, ck);
+    ctx->ecb    = aes_192_ecb_encrypt;
+    ctx->ctr_fn = aes_192_ctr_xcrypt;
+    ctx->nr     = AES_192_NR;
+    aes_gcm_init(ctx, iv, iv_len);
+}
+
+void    aes_256_gcm_init (
+    aes_gcm_ctx_t * ctx,
+    uint8_t       * ck,
+    uint8_t       * iv,
+    size_t          iv_len
+){
+    aes_256_enc_key_schedule(ctx->rk, ck);
+    ctx->ecb    = aes_256_ecb_encrypt;
+    ctx->ctr_fn = aes_256_ctr_xcrypt;
+    ctx->nr     = AES_256_NR;
+    aes_gcm_init(ctx, iv, iv_len);
+}
+
+void    aes_gcm_aad (
+    aes_gcm_ctx_t * ctx,
+    uint8_t       * aad,
+    size_t          len
+){
+    ctx->aad_len += len;
+
+    while(ctx->buf_len > 0 && len > 0) {    // Finish a partial block
+        ctx->buf[ctx->buf_len ++] = *aad ++;
+        len --;
+        if(ctx->buf_len == AES_BLOCK_BYTES) {
+            ghash_blocks(ctx->htab, ctx->x, ctx->buf, 1);
+            ctx->buf_len = 0;
+        }
+    }
+
+    size_t nb = len / AES_BLOCK_BYTES;
+
+    ghash_blocks(ctx->htab, ctx->x, aad, nb);
+
+    aad += nb * AES_BLOCK_BYTES;
+    len -= nb * AES_BLOCK_BYTES;
+
+    memcpy(ctx->buf + ctx->buf_len, aad, len);
+    ctx->buf_len += len;
+}
+
+/*
+GHASH runs over the cipher text: after the counter mode pass when
+encrypting, and before it when decrypting, so that out may alias in. Work
+is split into chunks so that the second pass hits in the cache.
+*/
+void    aes_gcm_blocks (
+    aes_gcm_ctx_t * ctx,
+    uint8_t       * out,
+    uint8_t       * in ,
+    size_t          nblocks,
+    int             encrypt
+){
+    while(nblocks > 0) {
+        size_t nb = nblocks < AES_GCM_CHUNK_BYTES / AES_BLOCK_BYTES ?
+                    nblocks : AES_GCM_CHUNK_BYTES / AES_BLOCK_BYTES ;
+
+        if(encrypt) {
+            aes_gcm_ctr (ctx, out, in, nb);
+            ghash_blocks(ctx->htab, ctx->x, out, nb);
+        } else {
+            ghash_blocks(ctx->htab, ctx->x, in, nb);
+            aes_gcm_ctr (ctx, out, in, nb);
+        }
+
+        out     += nb * AES_BLOCK_BYTES;
+        in      += nb * AES_BLOCK_BYTES;
+        nblocks -= nb;
+    }
+}
+
+void    aes_gcm_update_with (
+    aes_gcm_ctx_t    * ctx,
+    uint8_t          * out,
+    uint8_t          * in ,
+    size_t             len,
+    int                encrypt,
+    aes_gcm_blocks_t   blocks
+){
+    aes_gcm_start_text(ctx);
+
+    ctx->txt_len += len;
+
+    while(ctx->buf_len > 0 && len > 0) {    // Finish a partial block
+        uint8_t c = *in ^ ctx->ks[ctx->buf_len];
+        ctx->buf[ctx->buf_len ++] = encrypt ? c : *in;
+        *out ++ = c;
+        in   ++;
+        len  --;
+        if(ctx->buf_len == AES_BLOCK_BYTES) {
+            ghash_blocks(ctx->htab, ctx->x, ctx->buf, 1);
+            ctx->buf_len = 0;
+        }
+    }
+
+    size_t nb = len / AES_BLOCK_BYTES;      // Whole blocks
+
+    if(nb > 0) {
+        blocks(ctx, out, in, nb, encrypt);
+        out += nb * AES_BLOCK_BYTES;
+        in  += nb * AES_BLOCK_BYTES;
+        len -= nb * AES_BLOCK_BYTES;
+    }
+
+    if(len > 0) {                           // Start a partial block
+        memset(ctx->ks, 0, AES_BLOCK_BYTES);
+        aes_gcm_ctr(ctx, ctx->ks, ctx->ks, 1);
+        for(size_t i = 0; i < len; i ++) {
+            uint8_t c = in[i] ^ ctx->ks[i];
+            ctx->buf[i] = encrypt ? c : in[i];
+            out[i]      = c;
+        }
+        ctx->buf_len = len;
+    }
+}
+
+void    aes_gcm_encrypt_update (
+    aes_gcm_ctx_t * ctx,
+    uint8_t       * ct,
+    uint8_t       * pt,
+    size_t          len
+){
+    aes_gcm_update_with(ctx, ct, pt, len, 1, aes_gcm_blocks);
+}
+
+void    aes_gcm_decrypt_update (
+    aes_gcm_ctx_t * ctx,
+    uint8_t       * pt,
+    uint8_t       * ct,
+    size_t          len
+){
+    aes_gcm_update_with(ctx, pt, ct, len, 0, aes_gcm_blocks);
+}
+
+void    aes_gcm_final (
+    aes_gcm_ctx_t * ctx,
+    uint8_t         tag [AES_GCM_TAG_BYTES]
+){
+    uint8_t  ek [AES_BLOCK_BYTES];
+
+    aes_gcm_start_text(ctx);
+    aes_gcm_flush(ctx);
+
+    aes_gcm_store64_be(ctx->buf + 0, ctx->aad_len * 8);
+    aes_gcm_store64_be(ctx->buf + 8, ctx->txt_len * 8);
+    ghash_blocks(ctx->htab, ctx->x, ctx->buf, 1);
+
+    ctx->ecb(ek, ctx->j0, ctx->rk);         // T = E(K, J0) ^ S
+
+    uint8_t * x = (uint8_t*)ctx->x;
+
+    for(int i = 0; i < AES_GCM_TAG_BYTES; i ++) {
+        tag[i] = ek[i] ^ x[i];
+    }
+}
+
+int     aes_gcm_final_verify (
+    aes_gcm_ctx_t * ctx,
+    uint8_t       * tag,
+    size_t          tag_len
+){
+    uint8_t  ref [AES_GCM_TAG_BYTES];
+    uint8_t  diff = 0;
+
+    aes_gcm_final(ctx, ref);
+
+    if(tag_len < AES_GCM_TAG_MIN_BYTES || tag_len > AES_GCM_TAG_BYTES) {
+        return 1;
+    }
+
+    for(size_t i = 0; i < tag_len; i ++) {  // Constant time compare
+        diff |= ref[i] ^ tag[i];
+    }
+
+    return diff != 0;
+}
+
+//! @}
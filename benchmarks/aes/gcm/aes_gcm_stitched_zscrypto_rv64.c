@@ -0,0 +1,106 @@
+/*!
+@addtogroup crypto_block_aes_gcm
+@{
+@details Update functions which use the stitched RV64 kernels in
+    aes_gcm_zscrypto_rv64.S for whole blocks.
+
+The kernels work on pairs of blocks and increment only the low 64 bits of
+the counter. Calls are therefore split where the low 32 bits would wrap,
+and the upper 96 bits are put back afterwards. A single left over block,
+or one which lands on the wrap, is handled by aes_gcm_blocks.
+*/
+
+#include <string.h>
+
+#include "riscvcrypto/aes/api_aes.h"
+#include "riscvcrypto/aes/api_aes_gcm.h"
+
+//! Signature shared by the two stitched kernels.
+typedef void (*aes_gcm_kernel_t) (
+    uint8_t   * out,
+    uint8_t   * in,
+    size_t      nblocks,
+    uint32_t  * rk,
+    uint32_t  * ke,
+    uint64_t  * htab,
+    uint64_t    x   [2],
+    uint8_t     ctr [AES_BLOCK_BYTES]
+);
+
+//! aes_gcm_blocks_t built on top of a stitched kernel.
+static void aes_gcm_stitched_blocks (
+    aes_gcm_ctx_t    * ctx,
+    uint8_t          * out,
+    uint8_t          * in ,
+    size_t             nblocks,
+    int                encrypt,
+    aes_gcm_kernel_t   kernel
+){
+    uint32_t * ke = ctx->rk + 4 * ctx->nr;
+    uint8_t    hi [12];
+
+    memcpy(hi, ctx->ctr, 12);
+
+    while(nblocks > 0) {
+        uint32_t lo   = ((uint32_t)ctx->ctr[12] << 24) |
+                        ((uint32_t)ctx->ctr[13] << 16) |
+                        ((uint32_t)ctx->ctr[14] <<  8) |
+                        ((uint32_t)ctx->ctr[15] <<  0) ;
+        uint64_t room = ((uint64_t)1 << 32) - lo;
+        size_t   n    = (nblocks < room ? nblocks : (size_t)room) & ~1;
+
+        if(n == 0) {
+            n = 1;
+            aes_gcm_blocks(ctx, out, in, n, encrypt);
+        } else {
+            kernel(out, in, n, ctx->rk, ke, ctx->htab, ctx->x, ctx->ctr);
+            memcpy(ctx->ctr, hi, 12);
+        }
+
+        out     += n * AES_BLOCK_BYTES;
+        in      += n * AES_BLOCK_BYTES;
+        nblocks -= n;
+    }
+}
+
+static void aes_gcm_enc_blocks_stitched (
+    aes_gcm_ctx_t * ctx,
+    uint8_t       * out,
+    uint8_t       * in ,
+    size_t          nblocks,
+    int             encrypt
+){
+    aes_gcm_stitched_blocks(ctx, out, in, nblocks, encrypt,
+                            aes_gcm_enc_kernel_zscrypto_rv64);
+}
+
+static void aes_gcm_dec_blocks_stitched (
+    aes_gcm_ctx_t * ctx,
+    uint8_t       * out,
+    uint8_t       * in ,
+    size_t          nblocks,
+    int             encrypt
+){
+    aes_gcm_stitched_blocks(ctx, out, in, nblocks, encrypt,
+                            aes_gcm_dec_kernel_zscrypto_rv64);
+}
+
+void    aes_gcm_encrypt_update_stitched (
+    aes_gcm_ctx_t * ctx,
+    uint8_t       * ct,
+    uint8_t       * pt,
+    size_t          len
+){
+    aes_gcm_update_with(ctx, ct, pt, len, 1, aes_gcm_enc_blocks_stitched);
+}
+
+void    aes_gcm_decrypt_update_stitched (
+    aes_gcm_ctx_t * ctx,
+    uint8_t       * pt,
+    uint8_t       * ct,
+    size_t          len
+){
+    aes_gcm_update_with(ctx, pt, ct, len, 0, aes_gcm_dec_blocks_stitched);
+}
+
+//! @}
@@ -0,0 +1,181 @@
+/*!
+@addtogroup crypto_block_aes_gcm
+@{
+@details RV32 GHASH using the Zbkc clmul / clmulh instructions.
+
+The representation is the same as the RV64 version: each byte is
+bit-reversed with brev8, and the block is read as four little-endian
+32-bit words. A 128x128-bit product uses two levels of Karatsuba, for
+nine clmul / clmulh pairs. The outer level is deferred: the low, high
+and middle 128-bit products of AES_GCM_H_POWERS blocks are summed, then
+combined and reduced once.
+
+Per power of H, the table holds the four words h0..h3, followed by the
+Karatsuba operands h0^h1, h2^h3, h0^h2, h1^h3 and h0^h1^h2^h3.
+*/
+
+#include <string.h>
+
+#include "riscvcrypto/aes/api_aes_gcm.h"
+#include "riscvcrypto/share/riscv-crypto-intrinsics.h"
+
+//! x^128 mod the GHASH polynomial, in the bit-reflected domain.
+#define GHASH_R 0x87
+
+//! Load a 32-bit little-endian word and bit-reverse each byte.
+static inline uint32_t ghash_load(uint8_t * p) {
+    uint32_t r;
+    memcpy(&r, p, sizeof(r));
+    return _brev8(r);
+}
+
+/*!
+@brief 64x64-bit Karatsuba product of a1:a0 and b1:b0, where bm is
+    b0^b1. The 128-bit result is XORed into r[0..3].
+*/
+static inline void ghash_mul64_acc (
+    uint32_t r[4],
+    uint32_t a0, uint32_t a1,
+    uint32_t b0, uint32_t b1, uint32_t bm
+){
+    uint32_t am  = a0 ^ a1;
+    uint32_t l0  = _clmul (a0, b0);
+    uint32_t l1  = _clmulh(a0, b0);
+    uint32_t h0  = _clmul (a1, b1);
+    uint32_t h1  = _clmulh(a1, b1);
+    uint32_t m0  = _clmul (am, bm) ^ l0 ^ h0;
+    uint32_t m1  = _clmulh(am, bm) ^ l1 ^ h1;
+    r[0] ^= l0;
+    r[1] ^= l1 ^ m0;
+    r[2] ^= h0 ^ m1;
+    r[3] ^= h1;
+}
+
+/*!
+@brief Accumulate the three outer Karatsuba products of a and a table
+    entry h into lo, hi and md.
+*/
+static inline void ghash_mul_acc (
+    uint32_t lo[4], uint32_t hi[4], uint32_t md[4],
+    uint32_t a[4] , uint32_t * h
+){
+    ghash_mul64_acc(lo, a[0]       , a[1]       , h[0], h[1], h[4]);
+    ghash_mul64_acc(hi, a[2]       , a[3]       , h[2], h[3], h[5]);
+    ghash_mul64_acc(md, a[0] ^ a[2], a[1] ^ a[3], h[6], h[7], h[8]);
+}
+
+//! Combine the outer Karatsuba terms and reduce into x[0..3].
+static inline void ghash_combine_reduce (
+    uint32_t x[4],
+    uint32_t lo[4], uint32_t hi[4], uint32_t md[4]
+){
+    uint32_t r[8];
+
+    for(int i = 0; i < 4; i ++) {
+        md[i] ^= lo[i] ^ hi[i];
+    }
+
+    r[0] = lo[0];
+    r[1] = lo[1];
+    r[2] = lo[2] ^ md[0];
+    r[3] = lo[3] ^ md[1];
+    r[4] = hi[0] ^ md[2];
+    r[5] = hi[1] ^ md[3];
+    r[6] = hi[2];
+    r[7] = hi[3];
+
+    uint32_t t = _clmulh(r[7], GHASH_R);    // At most 7 bits.
+
+    x[0] = r[0] ^ _clmul (r[4], GHASH_R) ^ _clmul(t, GHASH_R);
+    x[1] = r[1] ^ _clmulh(r[4], GHASH_R) ^ _clmul(r[5], GHASH_R);
+    x[2] = r[2] ^ _clmulh(r[5], GHASH_R) ^ _clmul(r[6], GHASH_R);
+    x[3] = r[3] ^ _clmulh(r[6], GHASH_R) ^ _clmul(r[7], GHASH_R);
+}
+
+//! Fill in the Karatsuba operands of a table entry from h[0..3].
+static void ghash_htab_entry(uint32_t * h) {
+    h[4] = h[0] ^ h[1];
+    h[5] = h[2] ^ h[3];
+    h[6] = h[0] ^ h[2];
+    h[7] = h[1] ^ h[3];
+    h[8] = h[6] ^ h[7];
+}
+
+void    ghash_init (
+    uint64_t  * htab,
+    uint8_t     h [AES_BLOCK_BYTES]
+){
+    uint32_t * ht = (uint32_t*)htab;
+
+    for(int i = 0; i < 4; i ++) {
+        ht[i] = ghash_load(h + 4*i);
+    }
+    ghash_htab_entry(ht);
+
+    for(int i = 1; i < AES_GCM_H_POWERS; i ++) {
+        uint32_t * prev = ht + 2 * AES_GCM_HTAB_STRIDE * (i - 1);
+        uint32_t * next = ht + 2 * AES_GCM_HTAB_STRIDE * (i    );
+        uint32_t lo[4] = {0}, hi[4] = {0}, md[4] = {0};
+        ghash_mul_acc(lo, hi, md, prev, ht);
+        ghash_combine_reduce(next, lo, hi, md);
+        ghash_htab_entry(next);
+    }
+}
+
+void    ghash_blocks (
+    uint64_t  * htab,
+    uint64_t    x [2],
+    uint8_t   * in,
+    size_t      nblocks
+){
+    uint32_t * ht = (uint32_t*)htab;
+    uint32_t * xw = (uint32_t*)x;
+    uint32_t   s [4];
+    uint32_t   a [4];
+
+    for(int i = 0; i < 4; i ++) {
+        s[i] = _brev8(xw[i]);
+    }
+
+    while(nblocks >= AES_GCM_H_POWERS) {
+        // X = (X + C0).H^n + C1.H^(n-1) + ... + C(n-1).H
+        uint32_t lo[4] = {0}, hi[4] = {0}, md[4] = {0};
+
+        for(int b = 0; b < AES_GCM_H_POWERS; b ++) {
+            uint32_t * h = ht + 2 * AES_GCM_HTAB_STRIDE *
+                                (AES_GCM_H_POWERS - 1 - b);
+            for(int i = 0; i < 4; i ++) {
+                a[i] = ghash_load(in + 4*i);
+            }
+            if(b == 0) {
+                for(int i = 0; i < 4; i ++) {
+                    a[i] ^= s[i];
+                }
+            }
+            ghash_mul_acc(lo, hi, md, a, h);
+            in += AES_BLOCK_BYTES;
+        }
+
+        ghash_combine_reduce(s, lo, hi, md);
+        nblocks -= AES_GCM_H_POWERS;
+    }
+
+    while(nblocks > 0) {
+        uint32_t lo[4] = {0}, hi[4] = {0}, md[4] = {0};
+
+        for(int i = 0; i < 4; i ++) {
+            a[i] = ghash_load(in + 4*i) ^ s[i];
+        }
+        ghash_mul_acc(lo, hi, md, a, ht);
+        ghash_combine_reduce(s, lo, hi, md);
+
+        in      += AES_BLOCK_BYTES;
+        nblocks -= 1;
+    }
+
+    for(int i = 0; i < 4; i ++) {
+        xw[i] = _brev8(s[i]);
+    }
+}
+
+//! @}
@@ -133,6 +133,42 @@ void    aes_256_dec_key_schedule (
     aes_key_schedule(rk, ck, AES_256_NK, AES_256_NR);
 }
 
+/*!
+@brief The decrypt key schedule is the encrypt one, so deriving it is a copy.
+*/
+static void aes_dec_key_schedule_copy (
+    uint32_t * const drk,
+    uint32_t * const erk,
+    int              nr
+){
+    if(drk != erk) {
+        for(int i = 0; i < 4 * (nr + 1); i ++) {
+            drk[i] = erk[i];
+        }
+    }
+}
+
+void    aes_128_dec_key_schedule_from_enc (
+    uint32_t * const drk,
+    uint32_t * const erk
+){
+    aes_dec_key_schedule_copy(drk, erk, AES_128_NR);
+}
+
+void    aes_192_dec_key_schedule_from_enc (
+    uint32_t * const drk,
+    uint32_t * const erk
+){
+    aes_dec_key_schedule_copy(drk, erk, AES_192_NR);
+}
+
+void    aes_256_dec_key_schedule_from_enc (
+    uint32_t * const drk,
+    uint32_t * const erk
+){
+    aes_dec_key_schedule_copy(drk, erk, AES_256_NR);
+}
+
 
 void    aes_ecb_decrypt (
     uint8_t     pt [AES_BLOCK_BYTES],
@@ -187,4 +223,86 @@ void    aes_256_ecb_decrypt (
     aes_ecb_decrypt(pt,ct,rk,AES_256_NR);
 }
 
+//! Number of blocks processed side by side by aes_ecb_decrypt_blocks.
+#define AES_ECB_BLOCKS_INTERLEAVE 4
+
+/*!
+@brief Decrypt nblocks consecutive blocks, working on up to
+    AES_ECB_BLOCKS_INTERLEAVE of them in each round.
+*/
+void    aes_ecb_decrypt_blocks (
+    uint8_t   * pt,
+    uint8_t   * ct,
+    uint32_t  * rk,
+    size_t      nblocks,
+    int         nr
+){
+    uint8_t * rkb = (uint8_t*)rk;
+
+    while(nblocks > 0) {
+
+        size_t nb = nblocks < AES_ECB_BLOCKS_INTERLEAVE ?
+                    nblocks : AES_ECB_BLOCKS_INTERLEAVE;
+
+        for(size_t b = 0; b < nb; b ++) {
+            for(int i = 0; i < AES_BLOCK_BYTES; i ++) {
+                pt[16*b+i] = ct[16*b+i] ^ rkb[(16*nr) + i];
+            }
+        }
+
+        for(int round = nr -1; round >= 1; round --) {
+
+            for(size_t b = 0; b < nb; b ++) {
+                aes_subbytes_shiftrows_dec(pt + 16*b);
+
+                for(int i = 0; i < AES_BLOCK_BYTES; i ++) {
+                    pt[16*b+i] ^= rkb[(16*round) + i];
+                }
+
+                aes_mix_columns_dec(pt + 16*b);
+            }
+
+        }
+
+        for(size_t b = 0; b < nb; b ++) {
+            aes_subbytes_shiftrows_dec(pt + 16*b);
+
+            for(int i = 0; i < AES_BLOCK_BYTES; i ++) {
+                pt[16*b+i] ^= rkb[i];
+            }
+        }
+
+        pt      += AES_BLOCK_BYTES * nb;
+        ct      += AES_BLOCK_BYTES * nb;
+        nblocks -= nb;
+    }
+}
+
+void    aes_128_ecb_decrypt_blocks (
+    uint8_t   * pt,
+    uint8_t   * ct,
+    uint32_t  * rk,
+    size_t      nblocks
+){
+    aes_ecb_decrypt_blocks(pt,ct,rk,nblocks,AES_128_NR);
+}
+
+void    aes_192_ecb_decrypt_blocks (
+    uint8_t   * pt,
+    uint8_t   * ct,
+    uint32_t  * rk,
+    size_t      nblocks
+){
+    aes_ecb_decrypt_blocks(pt,ct,rk,nblocks,AES_192_NR);
+}
+
+void    aes_256_ecb_decrypt_blocks (
+    uint8_t   * pt,
+    uint8_t   * ct,
+    uint32_t  * rk,
+    size_t      nblocks
+){
+    aes_ecb_decrypt_blocks(pt,ct,rk,nblocks,AES_256_NR);
+}
+
 //!@}
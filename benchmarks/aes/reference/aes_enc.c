@@ -241,4 +241,88 @@ void    aes_256_ecb_encrypt (
     aes_ecb_encrypt(ct,pt,rk,AES_256_NR);
 }
 
+//! Number of blocks processed side by side by aes_ecb_encrypt_blocks.
+#define AES_ECB_BLOCKS_INTERLEAVE 4
+
+/*!
+@brief Encrypt nblocks consecutive blocks, working on up to
+    AES_ECB_BLOCKS_INTERLEAVE of them in each round.
+*/
+void    aes_ecb_encrypt_blocks (
+    uint8_t   * ct,
+    uint8_t   * pt,
+    uint32_t  * rk,
+    size_t      nblocks,
+    int         nr
+){
+    uint8_t * rkb = (uint8_t*)rk;
+
+    while(nblocks > 0) {
+
+        size_t nb = nblocks < AES_ECB_BLOCKS_INTERLEAVE ?
+                    nblocks : AES_ECB_BLOCKS_INTERLEAVE;
+
+        int round = 0;
+
+        // AddRoundKey
+        for(size_t b = 0; b < nb; b ++) {
+            for(int i = 0; i < AES_BLOCK_BYTES; i ++) {
+                ct[16*b+i] = pt[16*b+i] ^ rkb[i];
+            }
+        }
+
+        for(round = 1; round < nr; round ++) {
+
+            for(size_t b = 0; b < nb; b ++) {
+                aes_subbytes_shiftrows(ct + 16*b);
+                aes_mix_columns_enc(ct + 16*b);
+
+                for(int i = 0; i < AES_BLOCK_BYTES; i ++) {
+                    ct[16*b+i] ^= rkb[(16*round)+i];
+                }
+            }
+
+        }
+
+        for(size_t b = 0; b < nb; b ++) {
+            aes_subbytes_shiftrows(ct + 16*b);
+
+            for(int i = 0; i < AES_BLOCK_BYTES; i ++) {
+                ct[16*b+i] ^= rkb[(16*round)+i];
+            }
+        }
+
+        ct      += AES_BLOCK_BYTES * nb;
+        pt      += AES_BLOCK_BYTES * nb;
+        nblocks -= nb;
+    }
+}
+
+void    aes_128_ecb_encrypt_blocks (
+    uint8_t   * ct,
+    uint8_t   * pt,
+    uint32_t  * rk,
+    size_t      nblocks
+){
+    aes_ecb_encrypt_blocks(ct,pt,rk,nblocks,AES_128_NR);
+}
+
+void    aes_192_ecb_encrypt_blocks (
+    uint8_t   * ct,
+    uint8_t   * pt,
+    uint32_t  * rk,
+    size_t      nblocks
+){
+    aes_ecb_encrypt_blocks(ct,pt,rk,nblocks,AES_192_NR);
+}
+
+void    aes_256_ecb_encrypt_blocks (
+    uint8_t   * ct,
+    uint8_t   * pt,
+    uint32_t  * rk,
+    size_t      nblocks
+){
+    aes_ecb_encrypt_blocks(ct,pt,rk,nblocks,AES_256_NR);
+}
+
 //!@}
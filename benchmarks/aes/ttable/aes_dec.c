@@ -78,9 +78,25 @@
   TUPLE(55,84,7B,CB,61), TUPLE(21,B6,D5,32,70), TUPLE(0C,5C,48,6C,74), TUPLE(7D,57,D0,B8,42)  \
 }
 
+//! AES Inverse SBox, used by the final round.
+#define TUPLE(a1,a9,aB,aD,aE) 0x##a1
+const uint8_t  AES_DEC_SBOX[]  = AES_DEC_TBOX_X;
+#undef TUPLE
+
 #define TUPLE(a1,a9,aB,aD,aE) 0x##aE##a9##aD##aB
 uint32_t AES_DEC_TBOX_0[] = AES_DEC_TBOX_X;
 #undef TUPLE
+
+#if AES_TTABLE_LAYOUT == AES_TTABLE_LAYOUT_COMPACT
+
+// Each of TBOX_1..3 is TBOX_0 rotated left by another byte.
+#define AES_DEC_T0(x) (        AES_DEC_TBOX_0[x]      )
+#define AES_DEC_T1(x) ( ROTL32(AES_DEC_TBOX_0[x],  8) )
+#define AES_DEC_T2(x) ( ROTL32(AES_DEC_TBOX_0[x], 16) )
+#define AES_DEC_T3(x) ( ROTL32(AES_DEC_TBOX_0[x], 24) )
+
+#else
+
 #define TUPLE(a1,a9,aB,aD,aE) 0x##a9##aD##aB##aE
 uint32_t AES_DEC_TBOX_1[] = AES_DEC_TBOX_X;
 #undef TUPLE
@@ -90,10 +106,42 @@ uint32_t AES_DEC_TBOX_2[] = AES_DEC_TBOX_X;
 #define TUPLE(a1,a9,aB,aD,aE) 0x##aB##aE##a9##aD
 uint32_t AES_DEC_TBOX_3[] = AES_DEC_TBOX_X;
 #undef TUPLE
+
+#define AES_DEC_T0(x) ( AES_DEC_TBOX_0[x] )
+#define AES_DEC_T1(x) ( AES_DEC_TBOX_1[x] )
+#define AES_DEC_T2(x) ( AES_DEC_TBOX_2[x] )
+#define AES_DEC_T3(x) ( AES_DEC_TBOX_3[x] )
+
+#endif
+
+#if AES_TTABLE_LAYOUT == AES_TTABLE_LAYOUT_FULL
+
 #define TUPLE(a1,a9,aB,aD,aE) 0x##a1##a1##a1##a1
 uint32_t AES_DEC_TBOX_4[] = AES_DEC_TBOX_X;
 #undef TUPLE
 
+//! Inverse SBox of byte sh/8 of x, left in byte sh/8 of the result.
+#define AES_DEC_SB(x,sh) \
+  ( AES_DEC_TBOX_4[ ( (x) >> (sh) ) & 0xFF ] & ( 0xFFu << (sh) ) )
+
+//! Bytes of table read by each block.
+#define AES_DEC_TABLE_BYTES ( 5 * sizeof(AES_DEC_TBOX_0) )
+
+#else
+
+#define AES_DEC_SB(x,sh) \
+  ( ( uint32_t ) AES_DEC_SBOX[ ( (x) >> (sh) ) & 0xFF ] << (sh) )
+
+#if AES_TTABLE_LAYOUT == AES_TTABLE_LAYOUT_COMPACT
+#define AES_DEC_TABLE_BYTES ( sizeof(AES_DEC_TBOX_0) + sizeof(AES_DEC_SBOX) )
+#else
+#define AES_DEC_TABLE_BYTES ( 4*sizeof(AES_DEC_TBOX_0) + sizeof(AES_DEC_SBOX) )
+#endif
+
+#endif
+
+const size_t aes_ttable_dec_table_bytes = AES_DEC_TABLE_BYTES;
+
 #define AES_DEC_RND_INIT() {    \
   t_0 = rkp[ 0 ] ^ t_0;         \
   t_1 = rkp[ 1 ] ^ t_1;         \
@@ -104,84 +152,156 @@ uint32_t AES_DEC_TBOX_4[] = AES_DEC_TBOX_X;
 }
 
 #define AES_DEC_RND_ITER() {                                                 \
-  t_4 = rkp[ 0 ] ^ ( AES_DEC_TBOX_0[ ( t_0 >>  0 ) & 0xFF ]              ) ^ \
-                   ( AES_DEC_TBOX_1[ ( t_3 >>  8 ) & 0xFF ]              ) ^ \
-                   ( AES_DEC_TBOX_2[ ( t_2 >> 16 ) & 0xFF ]              ) ^ \
-                   ( AES_DEC_TBOX_3[ ( t_1 >> 24 ) & 0xFF ]              ) ; \
-  t_5 = rkp[ 1 ] ^ ( AES_DEC_TBOX_0[ ( t_1 >>  0 ) & 0xFF ]              ) ^ \
-                   ( AES_DEC_TBOX_1[ ( t_0 >>  8 ) & 0xFF ]              ) ^ \
-                   ( AES_DEC_TBOX_2[ ( t_3 >> 16 ) & 0xFF ]              ) ^ \
-                   ( AES_DEC_TBOX_3[ ( t_2 >> 24 ) & 0xFF ]              ) ; \
-  t_6 = rkp[ 2 ] ^ ( AES_DEC_TBOX_0[ ( t_2 >>  0 ) & 0xFF ]              ) ^ \
-                   ( AES_DEC_TBOX_1[ ( t_1 >>  8 ) & 0xFF ]              ) ^ \
-                   ( AES_DEC_TBOX_2[ ( t_0 >> 16 ) & 0xFF ]              ) ^ \
-                   ( AES_DEC_TBOX_3[ ( t_3 >> 24 ) & 0xFF ]              ) ; \
-  t_7 = rkp[ 3 ] ^ ( AES_DEC_TBOX_0[ ( t_3 >>  0 ) & 0xFF ]              ) ^ \
-                   ( AES_DEC_TBOX_1[ ( t_2 >>  8 ) & 0xFF ]              ) ^ \
-                   ( AES_DEC_TBOX_2[ ( t_1 >> 16 ) & 0xFF ]              ) ^ \
-                   ( AES_DEC_TBOX_3[ ( t_0 >> 24 ) & 0xFF ]              ) ; \
+  t_4 = rkp[ 0 ] ^ ( AES_DEC_T0( ( t_0 >>  0 ) & 0xFF ) ) ^                  \
+                   ( AES_DEC_T1( ( t_3 >>  8 ) & 0xFF ) ) ^                  \
+                   ( AES_DEC_T2( ( t_2 >> 16 ) & 0xFF ) ) ^                  \
+                   ( AES_DEC_T3( ( t_1 >> 24 ) & 0xFF ) ) ;                  \
+  t_5 = rkp[ 1 ] ^ ( AES_DEC_T0( ( t_1 >>  0 ) & 0xFF ) ) ^                  \
+                   ( AES_DEC_T1( ( t_0 >>  8 ) & 0xFF ) ) ^                  \
+                   ( AES_DEC_T2( ( t_3 >> 16 ) & 0xFF ) ) ^                  \
+                   ( AES_DEC_T3( ( t_2 >> 24 ) & 0xFF ) ) ;                  \
+  t_6 = rkp[ 2 ] ^ ( AES_DEC_T0( ( t_2 >>  0 ) & 0xFF ) ) ^                  \
+                   ( AES_DEC_T1( ( t_1 >>  8 ) & 0xFF ) ) ^                  \
+                   ( AES_DEC_T2( ( t_0 >> 16 ) & 0xFF ) ) ^                  \
+                   ( AES_DEC_T3( ( t_3 >> 24 ) & 0xFF ) ) ;                  \
+  t_7 = rkp[ 3 ] ^ ( AES_DEC_T0( ( t_3 >>  0 ) & 0xFF ) ) ^                  \
+                   ( AES_DEC_T1( ( t_2 >>  8 ) & 0xFF ) ) ^                  \
+                   ( AES_DEC_T2( ( t_1 >> 16 ) & 0xFF ) ) ^                  \
+                   ( AES_DEC_T3( ( t_0 >> 24 ) & 0xFF ) ) ;                  \
                                                                              \
   rkp -= AES_128_NB; t_0 = t_4; t_1 = t_5; t_2 = t_6; t_3 = t_7;             \
 }
 
 #define AES_DEC_RND_FINI() {                                                 \
-  t_4 = rkp[ 0 ] ^ ( AES_DEC_TBOX_4[ ( t_0 >>  0 ) & 0xFF ] & 0x000000FF ) ^ \
-                   ( AES_DEC_TBOX_4[ ( t_3 >>  8 ) & 0xFF ] & 0x0000FF00 ) ^ \
-                   ( AES_DEC_TBOX_4[ ( t_2 >> 16 ) & 0xFF ] & 0x00FF0000 ) ^ \
-                   ( AES_DEC_TBOX_4[ ( t_1 >> 24 ) & 0xFF ] & 0xFF000000 ) ; \
-  t_5 = rkp[ 1 ] ^ ( AES_DEC_TBOX_4[ ( t_1 >>  0 ) & 0xFF ] & 0x000000FF ) ^ \
-                   ( AES_DEC_TBOX_4[ ( t_0 >>  8 ) & 0xFF ] & 0x0000FF00 ) ^ \
-                   ( AES_DEC_TBOX_4[ ( t_3 >> 16 ) & 0xFF ] & 0x00FF0000 ) ^ \
-                   ( AES_DEC_TBOX_4[ ( t_2 >> 24 ) & 0xFF ] & 0xFF000000 ) ; \
-  t_6 = rkp[ 2 ] ^ ( AES_DEC_TBOX_4[ ( t_2 >>  0 ) & 0xFF ] & 0x000000FF ) ^ \
-                   ( AES_DEC_TBOX_4[ ( t_1 >>  8 ) & 0xFF ] & 0x0000FF00 ) ^ \
-                   ( AES_DEC_TBOX_4[ ( t_0 >> 16 ) & 0xFF ] & 0x00FF0000 ) ^ \
-                   ( AES_DEC_TBOX_4[ ( t_3 >> 24 ) & 0xFF ] & 0xFF000000 ) ; \
-  t_7 = rkp[ 3 ] ^ ( AES_DEC_TBOX_4[ ( t_3 >>  0 ) & 0xFF ] & 0x000000FF ) ^ \
-                   ( AES_DEC_TBOX_4[ ( t_2 >>  8 ) & 0xFF ] & 0x0000FF00 ) ^ \
-                   ( AES_DEC_TBOX_4[ ( t_1 >> 16 ) & 0xFF ] & 0x00FF0000 ) ^ \
-                   ( AES_DEC_TBOX_4[ ( t_0 >> 24 ) & 0xFF ] & 0xFF000000 ) ; \
+  t_4 = rkp[ 0 ] ^ ( AES_DEC_SB( t_0,  0 ) ) ^                               \
+                   ( AES_DEC_SB( t_3,  8 ) ) ^                               \
+                   ( AES_DEC_SB( t_2, 16 ) ) ^                               \
+                   ( AES_DEC_SB( t_1, 24 ) ) ;                               \
+  t_5 = rkp[ 1 ] ^ ( AES_DEC_SB( t_1,  0 ) ) ^                               \
+                   ( AES_DEC_SB( t_0,  8 ) ) ^                               \
+                   ( AES_DEC_SB( t_3, 16 ) ) ^                               \
+                   ( AES_DEC_SB( t_2, 24 ) ) ;                               \
+  t_6 = rkp[ 2 ] ^ ( AES_DEC_SB( t_2,  0 ) ) ^                               \
+                   ( AES_DEC_SB( t_1,  8 ) ) ^                               \
+                   ( AES_DEC_SB( t_0, 16 ) ) ^                               \
+                   ( AES_DEC_SB( t_3, 24 ) ) ;                               \
+  t_7 = rkp[ 3 ] ^ ( AES_DEC_SB( t_3,  0 ) ) ^                               \
+                   ( AES_DEC_SB( t_2,  8 ) ) ^                               \
+                   ( AES_DEC_SB( t_1, 16 ) ) ^                               \
+                   ( AES_DEC_SB( t_0, 24 ) ) ;                               \
                                                                              \
   rkp -= AES_128_NB; t_0 = t_4; t_1 = t_5; t_2 = t_6; t_3 = t_7;             \
 }
 
+//! One inverse table-lookup column: four T-box lookups and a key word.
+#define AES_DEC_COL(k,x0,x1,x2,x3) (                                         \
+  (k) ^ ( AES_DEC_T0( ( (x0) >>  0 ) & 0xFF ) ) ^                            \
+        ( AES_DEC_T1( ( (x1) >>  8 ) & 0xFF ) ) ^                            \
+        ( AES_DEC_T2( ( (x2) >> 16 ) & 0xFF ) ) ^                            \
+        ( AES_DEC_T3( ( (x3) >> 24 ) & 0xFF ) ) )
+
+//! One inverse final round column, using only the SBox bytes.
+#define AES_DEC_COL_FINI(k,x0,x1,x2,x3) (                                    \
+  (k) ^ ( AES_DEC_SB( (x0),  0 ) ) ^                                         \
+        ( AES_DEC_SB( (x1),  8 ) ) ^                                         \
+        ( AES_DEC_SB( (x2), 16 ) ) ^                                         \
+        ( AES_DEC_SB( (x3), 24 ) ) )
+
+//! Initial key addition for two interleaved blocks.
+#define AES_DEC_RND_INIT_X2() {                                              \
+  k_0 = rkp[ 0 ]; k_1 = rkp[ 1 ]; k_2 = rkp[ 2 ]; k_3 = rkp[ 3 ];            \
+  a_0 = k_0 ^ a_0;                                                           \
+  a_1 = k_1 ^ a_1;                                                           \
+  a_2 = k_2 ^ a_2;                                                           \
+  a_3 = k_3 ^ a_3;                                                           \
+  b_0 = k_0 ^ b_0;                                                           \
+  b_1 = k_1 ^ b_1;                                                           \
+  b_2 = k_2 ^ b_2;                                                           \
+  b_3 = k_3 ^ b_3;                                                           \
+                                                                             \
+  rkp -= AES_128_NB;                                                         \
+}
+
+//! One full round for two interleaved blocks sharing a round key load.
+#define AES_DEC_RND_ITER_X2() {                                              \
+  k_0 = rkp[ 0 ]; k_1 = rkp[ 1 ]; k_2 = rkp[ 2 ]; k_3 = rkp[ 3 ];            \
+  n_0 = AES_DEC_COL(k_0, a_0, a_3, a_2, a_1);                                \
+  n_1 = AES_DEC_COL(k_1, a_1, a_0, a_3, a_2);                                \
+  n_2 = AES_DEC_COL(k_2, a_2, a_1, a_0, a_3);                                \
+  n_3 = AES_DEC_COL(k_3, a_3, a_2, a_1, a_0);                                \
+  m_0 = AES_DEC_COL(k_0, b_0, b_3, b_2, b_1);                                \
+  m_1 = AES_DEC_COL(k_1, b_1, b_0, b_3, b_2);                                \
+  m_2 = AES_DEC_COL(k_2, b_2, b_1, b_0, b_3);                                \
+  m_3 = AES_DEC_COL(k_3, b_3, b_2, b_1, b_0);                                \
+                                                                             \
+  rkp -= AES_128_NB;                                                         \
+  a_0 = n_0; a_1 = n_1; a_2 = n_2; a_3 = n_3;                                \
+  b_0 = m_0; b_1 = m_1; b_2 = m_2; b_3 = m_3;                                \
+}
+
+//! Final round for two interleaved blocks.
+#define AES_DEC_RND_FINI_X2() {                                              \
+  k_0 = rkp[ 0 ]; k_1 = rkp[ 1 ]; k_2 = rkp[ 2 ]; k_3 = rkp[ 3 ];            \
+  n_0 = AES_DEC_COL_FINI(k_0, a_0, a_3, a_2, a_1);                           \
+  n_1 = AES_DEC_COL_FINI(k_1, a_1, a_0, a_3, a_2);                           \
+  n_2 = AES_DEC_COL_FINI(k_2, a_2, a_1, a_0, a_3);                           \
+  n_3 = AES_DEC_COL_FINI(k_3, a_3, a_2, a_1, a_0);                           \
+  m_0 = AES_DEC_COL_FINI(k_0, b_0, b_3, b_2, b_1);                           \
+  m_1 = AES_DEC_COL_FINI(k_1, b_1, b_0, b_3, b_2);                           \
+  m_2 = AES_DEC_COL_FINI(k_2, b_2, b_1, b_0, b_3);                           \
+  m_3 = AES_DEC_COL_FINI(k_3, b_3, b_2, b_1, b_0);                           \
+                                                                             \
+  rkp -= AES_128_NB;                                                         \
+  a_0 = n_0; a_1 = n_1; a_2 = n_2; a_3 = n_3;                                \
+  b_0 = m_0; b_1 = m_1; b_2 = m_2; b_3 = m_3;                                \
+}
+
+
 
 
 /*!
+@brief Derive the decrypt key schedule from the encrypt one.
+@details Round keys 0 and nr are copied. The others have InvMixColumns
+    applied, via the decrypt tables with the SBox undone first, so the
+    rounds can use the equivalent inverse cipher. drk may equal erk.
 */
-void    aes_dec_key_schedule_inv_mc (
-    uint32_t * const rk,
-    uint8_t  * const ck,
+static void aes_dec_key_schedule_inv_mc (
+    uint32_t * const drk,
+    uint32_t * const erk,
     int              nr
 ){
-    // First, call the encryption key-schedule
+    for( int i = 0; i < 4; i++ ) {
+      drk[ i          ] = erk[ i          ];
+      drk[ i + 4 * nr ] = erk[ i + 4 * nr ];
+    }
+
     for( int i = 1; i < nr; i++ ) {
-      uint32_t t_0 = rk[ ( i * 4 ) + 0 ];
-      uint32_t t_1 = rk[ ( i * 4 ) + 1 ];
-      uint32_t t_2 = rk[ ( i * 4 ) + 2 ];
-      uint32_t t_3 = rk[ ( i * 4 ) + 3 ];
-
-      t_0 = AES_DEC_TBOX_0[ AES_ENC_TBOX_4[ ( t_0 >>  0 ) & 0xFF ] & 0xFF ] ^
-            AES_DEC_TBOX_1[ AES_ENC_TBOX_4[ ( t_0 >>  8 ) & 0xFF ] & 0xFF ] ^
-            AES_DEC_TBOX_2[ AES_ENC_TBOX_4[ ( t_0 >> 16 ) & 0xFF ] & 0xFF ] ^
-            AES_DEC_TBOX_3[ AES_ENC_TBOX_4[ ( t_0 >> 24 ) & 0xFF ] & 0xFF ] ;
-      t_1 = AES_DEC_TBOX_0[ AES_ENC_TBOX_4[ ( t_1 >>  0 ) & 0xFF ] & 0xFF ] ^
-            AES_DEC_TBOX_1[ AES_ENC_TBOX_4[ ( t_1 >>  8 ) & 0xFF ] & 0xFF ] ^
-            AES_DEC_TBOX_2[ AES_ENC_TBOX_4[ ( t_1 >> 16 ) & 0xFF ] & 0xFF ] ^
-            AES_DEC_TBOX_3[ AES_ENC_TBOX_4[ ( t_1 >> 24 ) & 0xFF ] & 0xFF ] ;
-      t_2 = AES_DEC_TBOX_0[ AES_ENC_TBOX_4[ ( t_2 >>  0 ) & 0xFF ] & 0xFF ] ^
-            AES_DEC_TBOX_1[ AES_ENC_TBOX_4[ ( t_2 >>  8 ) & 0xFF ] & 0xFF ] ^
-            AES_DEC_TBOX_2[ AES_ENC_TBOX_4[ ( t_2 >> 16 ) & 0xFF ] & 0xFF ] ^
-            AES_DEC_TBOX_3[ AES_ENC_TBOX_4[ ( t_2 >> 24 ) & 0xFF ] & 0xFF ] ;
-      t_3 = AES_DEC_TBOX_0[ AES_ENC_TBOX_4[ ( t_3 >>  0 ) & 0xFF ] & 0xFF ] ^
-            AES_DEC_TBOX_1[ AES_ENC_TBOX_4[ ( t_3 >>  8 ) & 0xFF ] & 0xFF ] ^
-            AES_DEC_TBOX_2[ AES_ENC_TBOX_4[ ( t_3 >> 16 ) & 0xFF ] & 0xFF ] ^
-            AES_DEC_TBOX_3[ AES_ENC_TBOX_4[ ( t_3 >> 24 ) & 0xFF ] & 0xFF ] ;
-
-      rk[ ( i * 4 ) + 0 ] = t_0;
-      rk[ ( i * 4 ) + 1 ] = t_1;
-      rk[ ( i * 4 ) + 2 ] = t_2;
-      rk[ ( i * 4 ) + 3 ] = t_3;
+      uint32_t t_0 = erk[ ( i * 4 ) + 0 ];
+      uint32_t t_1 = erk[ ( i * 4 ) + 1 ];
+      uint32_t t_2 = erk[ ( i * 4 ) + 2 ];
+      uint32_t t_3 = erk[ ( i * 4 ) + 3 ];
+
+      t_0 = AES_DEC_T0( AES_ENC_SBOX[ ( t_0 >>  0 ) & 0xFF ] ) ^
+            AES_DEC_T1( AES_ENC_SBOX[ ( t_0 >>  8 ) & 0xFF ] ) ^
+            AES_DEC_T2( AES_ENC_SBOX[ ( t_0 >> 16 ) & 0xFF ] ) ^
+            AES_DEC_T3( AES_ENC_SBOX[ ( t_0 >> 24 ) & 0xFF ] ) ;
+      t_1 = AES_DEC_T0( AES_ENC_SBOX[ ( t_1 >>  0 ) & 0xFF ] ) ^
+            AES_DEC_T1( AES_ENC_SBOX[ ( t_1 >>  8 ) & 0xFF ] ) ^
+            AES_DEC_T2( AES_ENC_SBOX[ ( t_1 >> 16 ) & 0xFF ] ) ^
+            AES_DEC_T3( AES_ENC_SBOX[ ( t_1 >> 24 ) & 0xFF ] ) ;
+      t_2 = AES_DEC_T0( AES_ENC_SBOX[ ( t_2 >>  0 ) & 0xFF ] ) ^
+            AES_DEC_T1( AES_ENC_SBOX[ ( t_2 >>  8 ) & 0xFF ] ) ^
+            AES_DEC_T2( AES_ENC_SBOX[ ( t_2 >> 16 ) & 0xFF ] ) ^
+            AES_DEC_T3( AES_ENC_SBOX[ ( t_2 >> 24 ) & 0xFF ] ) ;
+      t_3 = AES_DEC_T0( AES_ENC_SBOX[ ( t_3 >>  0 ) & 0xFF ] ) ^
+            AES_DEC_T1( AES_ENC_SBOX[ ( t_3 >>  8 ) & 0xFF ] ) ^
+            AES_DEC_T2( AES_ENC_SBOX[ ( t_3 >> 16 ) & 0xFF ] ) ^
+            AES_DEC_T3( AES_ENC_SBOX[ ( t_3 >> 24 ) & 0xFF ] ) ;
+
+      drk[ ( i * 4 ) + 0 ] = t_0;
+      drk[ ( i * 4 ) + 1 ] = t_1;
+      drk[ ( i * 4 ) + 2 ] = t_2;
+      drk[ ( i * 4 ) + 3 ] = t_3;
     }
 }
 
@@ -198,7 +318,7 @@ void    aes_128_dec_key_schedule (
     uint8_t  * const ck
 ){
     aes_128_enc_key_schedule(rk, ck);
-    aes_dec_key_schedule_inv_mc(rk,ck,AES_128_NR);
+    aes_dec_key_schedule_inv_mc(rk,rk,AES_128_NR);
 }
 
 void    aes_192_dec_key_schedule (
@@ -206,7 +326,7 @@ void    aes_192_dec_key_schedule (
     uint8_t  * const ck
 ){
     aes_192_enc_key_schedule(rk, ck);
-    aes_dec_key_schedule_inv_mc(rk,ck,AES_192_NR);
+    aes_dec_key_schedule_inv_mc(rk,rk,AES_192_NR);
 }
 
 
@@ -215,7 +335,28 @@ void    aes_256_dec_key_schedule (
     uint8_t  * const ck
 ){
     aes_256_enc_key_schedule(rk, ck);
-    aes_dec_key_schedule_inv_mc(rk,ck,AES_256_NR);
+    aes_dec_key_schedule_inv_mc(rk,rk,AES_256_NR);
+}
+
+void    aes_128_dec_key_schedule_from_enc (
+    uint32_t * const drk,
+    uint32_t * const erk
+){
+    aes_dec_key_schedule_inv_mc(drk,erk,AES_128_NR);
+}
+
+void    aes_192_dec_key_schedule_from_enc (
+    uint32_t * const drk,
+    uint32_t * const erk
+){
+    aes_dec_key_schedule_inv_mc(drk,erk,AES_192_NR);
+}
+
+void    aes_256_dec_key_schedule_from_enc (
+    uint32_t * const drk,
+    uint32_t * const erk
+){
+    aes_dec_key_schedule_inv_mc(drk,erk,AES_256_NR);
 }
 
 void    aes_ecb_decrypt (
@@ -271,5 +412,87 @@ void    aes_256_ecb_decrypt (
     aes_ecb_decrypt(pt,ct,rk,AES_256_NR);
 }
 
+/*!
+@brief Decrypt nblocks consecutive blocks, two at a time.
+@details Both blocks share each round key load, and their table lookups
+    are independent, so one block's loads overlap the other's. An odd
+    trailing block goes through aes_ecb_decrypt.
+*/
+void    aes_ecb_decrypt_blocks (
+    uint8_t   * pt,
+    uint8_t   * ct,
+    uint32_t  * rk,
+    size_t      nblocks,
+    int         nr
+){
+    for(; nblocks >= 2; nblocks -= 2) {
+
+        uint32_t *rkp = ( AES_128_NB * nr) + ( uint32_t* )( rk );
+        uint32_t  k_0, k_1, k_2, k_3;
+        uint32_t  a_0, a_1, a_2, a_3, n_0, n_1, n_2, n_3;
+        uint32_t  b_0, b_1, b_2, b_3, m_0, m_1, m_2, m_3;
+
+        a_0 = U8_TO_U32LE((ct +  0));
+        a_1 = U8_TO_U32LE((ct +  4));
+        a_2 = U8_TO_U32LE((ct +  8));
+        a_3 = U8_TO_U32LE((ct + 12));
+        b_0 = U8_TO_U32LE((ct + 16));
+        b_1 = U8_TO_U32LE((ct + 20));
+        b_2 = U8_TO_U32LE((ct + 24));
+        b_3 = U8_TO_U32LE((ct + 28));
+
+        AES_DEC_RND_INIT_X2();
+
+        for( int i = 1; i < nr; i++ ) {
+            AES_DEC_RND_ITER_X2();
+        }
+
+        AES_DEC_RND_FINI_X2();
+
+        U32_TO_U8LE(pt, a_0,  0 );
+        U32_TO_U8LE(pt, a_1,  4 );
+        U32_TO_U8LE(pt, a_2,  8 );
+        U32_TO_U8LE(pt, a_3, 12 );
+        U32_TO_U8LE(pt, b_0, 16 );
+        U32_TO_U8LE(pt, b_1, 20 );
+        U32_TO_U8LE(pt, b_2, 24 );
+        U32_TO_U8LE(pt, b_3, 28 );
+
+        pt += 2*AES_BLOCK_BYTES;
+        ct += 2*AES_BLOCK_BYTES;
+    }
+
+    if(nblocks) {
+        aes_ecb_decrypt(pt,ct,rk,nr);
+    }
+}
+
+void    aes_128_ecb_decrypt_blocks (
+    uint8_t   * pt,
+    uint8_t   * ct,
+    uint32_t  * rk,
+    size_t      nblocks
+){
+    aes_ecb_decrypt_blocks(pt,ct,rk,nblocks,AES_128_NR);
+}
+
+void    aes_192_ecb_decrypt_blocks (
+    uint8_t   * pt,
+    uint8_t   * ct,
+    uint32_t  * rk,
+    size_t      nblocks
+){
+    aes_ecb_decrypt_blocks(pt,ct,rk,nblocks,AES_192_NR);
+}
+
+void    aes_256_ecb_decrypt_blocks (
+    uint8_t   * pt,
+    uint8_t   * ct,
+    uint32_t  * rk,
+    size_t      nblocks
+){
+    aes_ecb_decrypt_blocks(pt,ct,rk,nblocks,AES_256_NR);
+}
+
 //!@}
 
@@ -0,0 +1,7 @@
+/*
+Builds aes_dec.c with the compact table layout. See aes/ttable/common.h
+*/
+
+#define AES_TTABLE_LAYOUT AES_TTABLE_LAYOUT_COMPACT
+
+#include "aes_dec.c"
@@ -9,6 +9,7 @@
 #include "riscvcrypto/share/util.h"
 
 #include "riscvcrypto/aes/api_aes.h"
+#include "riscvcrypto/aes/ttable/common.h"
 
 //! AES Round constants
 static const uint8_t round_const[11] = {
@@ -82,9 +83,25 @@ static const uint8_t round_const[11] = {
   TUPLE(B0,7B,CB), TUPLE(54,A8,FC), TUPLE(BB,6D,D6), TUPLE(16,2C,3A)  \
 }
 
+//! AES Forward SBox, used by the key schedule and the final round.
+#define TUPLE(a1,a2,a3)       0x##a1
+const uint8_t  AES_ENC_SBOX[]  = AES_ENC_TBOX_X;
+#undef TUPLE
+
 #define TUPLE(a1,a2,a3)       0x##a3##a1##a1##a2
 uint32_t AES_ENC_TBOX_0[] = AES_ENC_TBOX_X;
 #undef TUPLE
+
+#if AES_TTABLE_LAYOUT == AES_TTABLE_LAYOUT_COMPACT
+
+// Each of TBOX_1..3 is TBOX_0 rotated left by another byte.
+#define AES_ENC_T0(x) (        AES_ENC_TBOX_0[x]      )
+#define AES_ENC_T1(x) ( ROTL32(AES_ENC_TBOX_0[x],  8) )
+#define AES_ENC_T2(x) ( ROTL32(AES_ENC_TBOX_0[x], 16) )
+#define AES_ENC_T3(x) ( ROTL32(AES_ENC_TBOX_0[x], 24) )
+
+#else
+
 #define TUPLE(a1,a2,a3)       0x##a1##a1##a2##a3
 uint32_t AES_ENC_TBOX_1[] = AES_ENC_TBOX_X;
 #undef TUPLE
@@ -94,10 +111,43 @@ uint32_t AES_ENC_TBOX_2[] = AES_ENC_TBOX_X;
 #define TUPLE(a1,a2,a3)       0x##a2##a3##a1##a1
 uint32_t AES_ENC_TBOX_3[] = AES_ENC_TBOX_X;
 #undef TUPLE
+
+#define AES_ENC_T0(x) ( AES_ENC_TBOX_0[x] )
+#define AES_ENC_T1(x) ( AES_ENC_TBOX_1[x] )
+#define AES_ENC_T2(x) ( AES_ENC_TBOX_2[x] )
+#define AES_ENC_T3(x) ( AES_ENC_TBOX_3[x] )
+
+#endif
+
+#if AES_TTABLE_LAYOUT == AES_TTABLE_LAYOUT_FULL
+
 #define TUPLE(a1,a2,a3)       0x##a1##a1##a1##a1
 uint32_t AES_ENC_TBOX_4[] = AES_ENC_TBOX_X;
 #undef TUPLE
 
+//! SBox of byte sh/8 of x, left in byte sh/8 of the result.
+#define AES_ENC_SB(x,sh) \
+  ( AES_ENC_TBOX_4[ ( (x) >> (sh) ) & 0xFF ] & ( 0xFFu << (sh) ) )
+
+//! Bytes of table read by each block.
+#define AES_ENC_TABLE_BYTES ( 5 * sizeof(AES_ENC_TBOX_0) )
+
+#else
+
+#define AES_ENC_SB(x,sh) \
+  ( ( uint32_t ) AES_ENC_SBOX[ ( (x) >> (sh) ) & 0xFF ] << (sh) )
+
+#if AES_TTABLE_LAYOUT == AES_TTABLE_LAYOUT_COMPACT
+#define AES_ENC_TABLE_BYTES ( sizeof(AES_ENC_TBOX_0) + sizeof(AES_ENC_SBOX) )
+#else
+#define AES_ENC_TABLE_BYTES ( 4*sizeof(AES_ENC_TBOX_0) + sizeof(AES_ENC_SBOX) )
+#endif
+
+#endif
+
+const char * aes_ttable_layout          = AES_TTABLE_LAYOUT_NAME;
+const size_t aes_ttable_enc_table_bytes = AES_ENC_TABLE_BYTES;
+
 #define AES_ENC_RND_INIT() {  \
   t_0 = rkp[ 0 ] ^ t_0;       \
   t_1 = rkp[ 1 ] ^ t_1;       \
@@ -108,72 +158,109 @@ uint32_t AES_ENC_TBOX_4[] = AES_ENC_TBOX_X;
 }
 
 #define AES_ENC_RND_ITER() {                                                 \
-  t_4 = rkp[ 0 ] ^ ( AES_ENC_TBOX_0[ ( t_0 >>  0 ) & 0xFF ]              ) ^ \
-                   ( AES_ENC_TBOX_1[ ( t_1 >>  8 ) & 0xFF ]              ) ^ \
-                   ( AES_ENC_TBOX_2[ ( t_2 >> 16 ) & 0xFF ]              ) ^ \
-                   ( AES_ENC_TBOX_3[ ( t_3 >> 24 ) & 0xFF ]              ) ; \
-  t_5 = rkp[ 1 ] ^ ( AES_ENC_TBOX_0[ ( t_1 >>  0 ) & 0xFF ]              ) ^ \
-                   ( AES_ENC_TBOX_1[ ( t_2 >>  8 ) & 0xFF ]              ) ^ \
-                   ( AES_ENC_TBOX_2[ ( t_3 >> 16 ) & 0xFF ]              ) ^ \
-                   ( AES_ENC_TBOX_3[ ( t_0 >> 24 ) & 0xFF ]              ) ; \
-  t_6 = rkp[ 2 ] ^ ( AES_ENC_TBOX_0[ ( t_2 >>  0 ) & 0xFF ]              ) ^ \
-                   ( AES_ENC_TBOX_1[ ( t_3 >>  8 ) & 0xFF ]              ) ^ \
-                   ( AES_ENC_TBOX_2[ ( t_0 >> 16 ) & 0xFF ]              ) ^ \
-                   ( AES_ENC_TBOX_3[ ( t_1 >> 24 ) & 0xFF ]              ) ; \
-  t_7 = rkp[ 3 ] ^ ( AES_ENC_TBOX_0[ ( t_3 >>  0 ) & 0xFF ]              ) ^ \
-                   ( AES_ENC_TBOX_1[ ( t_0 >>  8 ) & 0xFF ]              ) ^ \
-                   ( AES_ENC_TBOX_2[ ( t_1 >> 16 ) & 0xFF ]              ) ^ \
-                   ( AES_ENC_TBOX_3[ ( t_2 >> 24 ) & 0xFF ]              ) ; \
+  t_4 = rkp[ 0 ] ^ ( AES_ENC_T0( ( t_0 >>  0 ) & 0xFF ) ) ^                  \
+                   ( AES_ENC_T1( ( t_1 >>  8 ) & 0xFF ) ) ^                  \
+                   ( AES_ENC_T2( ( t_2 >> 16 ) & 0xFF ) ) ^                  \
+                   ( AES_ENC_T3( ( t_3 >> 24 ) & 0xFF ) ) ;                  \
+  t_5 = rkp[ 1 ] ^ ( AES_ENC_T0( ( t_1 >>  0 ) & 0xFF ) ) ^                  \
+                   ( AES_ENC_T1( ( t_2 >>  8 ) & 0xFF ) ) ^                  \
+                   ( AES_ENC_T2( ( t_3 >> 16 ) & 0xFF ) ) ^                  \
+                   ( AES_ENC_T3( ( t_0 >> 24 ) & 0xFF ) ) ;                  \
+  t_6 = rkp[ 2 ] ^ ( AES_ENC_T0( ( t_2 >>  0 ) & 0xFF ) ) ^                  \
+                   ( AES_ENC_T1( ( t_3 >>  8 ) & 0xFF ) ) ^                  \
+                   ( AES_ENC_T2( ( t_0 >> 16 ) & 0xFF ) ) ^                  \
+                   ( AES_ENC_T3( ( t_1 >> 24 ) & 0xFF ) ) ;                  \
+  t_7 = rkp[ 3 ] ^ ( AES_ENC_T0( ( t_3 >>  0 ) & 0xFF ) ) ^                  \
+                   ( AES_ENC_T1( ( t_0 >>  8 ) & 0xFF ) ) ^                  \
+                   ( AES_ENC_T2( ( t_1 >> 16 ) & 0xFF ) ) ^                  \
+                   ( AES_ENC_T3( ( t_2 >> 24 ) & 0xFF ) ) ;                  \
                                                                              \
   rkp += AES_128_NB; t_0 = t_4; t_1 = t_5; t_2 = t_6; t_3 = t_7;             \
 }
 
 #define AES_ENC_RND_FINI() {                                                 \
-  t_4 = rkp[ 0 ] ^ ( AES_ENC_TBOX_4[ ( t_0 >>  0 ) & 0xFF ] & 0x000000FF ) ^ \
-                   ( AES_ENC_TBOX_4[ ( t_1 >>  8 ) & 0xFF ] & 0x0000FF00 ) ^ \
-                   ( AES_ENC_TBOX_4[ ( t_2 >> 16 ) & 0xFF ] & 0x00FF0000 ) ^ \
-                   ( AES_ENC_TBOX_4[ ( t_3 >> 24 ) & 0xFF ] & 0xFF000000 ) ; \
-  t_5 = rkp[ 1 ] ^ ( AES_ENC_TBOX_4[ ( t_1 >>  0 ) & 0xFF ] & 0x000000FF ) ^ \
-                   ( AES_ENC_TBOX_4[ ( t_2 >>  8 ) & 0xFF ] & 0x0000FF00 ) ^ \
-                   ( AES_ENC_TBOX_4[ ( t_3 >> 16 ) & 0xFF ] & 0x00FF0000 ) ^ \
-                   ( AES_ENC_TBOX_4[ ( t_0 >> 24 ) & 0xFF ] & 0xFF000000 ) ; \
-  t_6 = rkp[ 2 ] ^ ( AES_ENC_TBOX_4[ ( t_2 >>  0 ) & 0xFF ] & 0x000000FF ) ^ \
-                   ( AES_ENC_TBOX_4[ ( t_3 >>  8 ) & 0xFF ] & 0x0000FF00 ) ^ \
-                   ( AES_ENC_TBOX_4[ ( t_0 >> 16 ) & 0xFF ] & 0x00FF0000 ) ^ \
-                   ( AES_ENC_TBOX_4[ ( t_1 >> 24 ) & 0xFF ] & 0xFF000000 ) ; \
-  t_7 = rkp[ 3 ] ^ ( AES_ENC_TBOX_4[ ( t_3 >>  0 ) & 0xFF ] & 0x000000FF ) ^ \
-                   ( AES_ENC_TBOX_4[ ( t_0 >>  8 ) & 0xFF ] & 0x0000FF00 ) ^ \
-                   ( AES_ENC_TBOX_4[ ( t_1 >> 16 ) & 0xFF ] & 0x00FF0000 ) ^ \
-                   ( AES_ENC_TBOX_4[ ( t_2 >> 24 ) & 0xFF ] & 0xFF000000 ) ; \
+  t_4 = rkp[ 0 ] ^ ( AES_ENC_SB( t_0,  0 ) ) ^                               \
+                   ( AES_ENC_SB( t_1,  8 ) ) ^                               \
+                   ( AES_ENC_SB( t_2, 16 ) ) ^                               \
+                   ( AES_ENC_SB( t_3, 24 ) ) ;                               \
+  t_5 = rkp[ 1 ] ^ ( AES_ENC_SB( t_1,  0 ) ) ^                               \
+                   ( AES_ENC_SB( t_2,  8 ) ) ^                               \
+                   ( AES_ENC_SB( t_3, 16 ) ) ^                               \
+                   ( AES_ENC_SB( t_0, 24 ) ) ;                               \
+  t_6 = rkp[ 2 ] ^ ( AES_ENC_SB( t_2,  0 ) ) ^                               \
+                   ( AES_ENC_SB( t_3,  8 ) ) ^                               \
+                   ( AES_ENC_SB( t_0, 16 ) ) ^                               \
+                   ( AES_ENC_SB( t_1, 24 ) ) ;                               \
+  t_7 = rkp[ 3 ] ^ ( AES_ENC_SB( t_3,  0 ) ) ^                               \
+                   ( AES_ENC_SB( t_0,  8 ) ) ^                               \
+                   ( AES_ENC_SB( t_1, 16 ) ) ^                               \
+                   ( AES_ENC_SB( t_2, 24 ) ) ;                               \
                                                                              \
   rkp += AES_128_NB; t_0 = t_4; t_1 = t_5; t_2 = t_6; t_3 = t_7;             \
 }
 
-//! AES Forward SBox
-static const uint8_t e_sbox[256] = {
-  0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b,
-  0xfe, 0xd7, 0xab, 0x76, 0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0,
-  0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0, 0xb7, 0xfd, 0x93, 0x26,
-  0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
-  0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2,
-  0xeb, 0x27, 0xb2, 0x75, 0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0,
-  0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84, 0x53, 0xd1, 0x00, 0xed,
-  0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
-  0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f,
-  0x50, 0x3c, 0x9f, 0xa8, 0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5,
-  0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2, 0xcd, 0x0c, 0x13, 0xec,
-  0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
-  0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14,
-  0xde, 0x5e, 0x0b, 0xdb, 0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c,
-  0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79, 0xe7, 0xc8, 0x37, 0x6d,
-  0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
-  0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f,
-  0x4b, 0xbd, 0x8b, 0x8a, 0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e,
-  0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e, 0xe1, 0xf8, 0x98, 0x11,
-  0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
-  0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f,
-  0xb0, 0x54, 0xbb, 0x16
-};
+//! One forward table-lookup column: four T-box lookups and a key word.
+#define AES_ENC_COL(k,x0,x1,x2,x3) (                                         \
+  (k) ^ ( AES_ENC_T0( ( (x0) >>  0 ) & 0xFF ) ) ^                            \
+        ( AES_ENC_T1( ( (x1) >>  8 ) & 0xFF ) ) ^                            \
+        ( AES_ENC_T2( ( (x2) >> 16 ) & 0xFF ) ) ^                            \
+        ( AES_ENC_T3( ( (x3) >> 24 ) & 0xFF ) ) )
+
+//! One forward final round column, using only the SBox bytes.
+#define AES_ENC_COL_FINI(k,x0,x1,x2,x3) (                                    \
+  (k) ^ ( AES_ENC_SB( (x0),  0 ) ) ^                                         \
+        ( AES_ENC_SB( (x1),  8 ) ) ^                                         \
+        ( AES_ENC_SB( (x2), 16 ) ) ^                                         \
+        ( AES_ENC_SB( (x3), 24 ) ) )
+
+//! Initial key addition for two interleaved blocks.
+#define AES_ENC_RND_INIT_X2() {                                              \
+  k_0 = rkp[ 0 ]; k_1 = rkp[ 1 ]; k_2 = rkp[ 2 ]; k_3 = rkp[ 3 ];            \
+  a_0 = k_0 ^ a_0;                                                           \
+  a_1 = k_1 ^ a_1;                                                           \
+  a_2 = k_2 ^ a_2;                                                           \
+  a_3 = k_3 ^ a_3;                                                           \
+  b_0 = k_0 ^ b_0;                                                           \
+  b_1 = k_1 ^ b_1;                                                           \
+  b_2 = k_2 ^ b_2;                                                           \
+  b_3 = k_3 ^ b_3;                                                           \
+                                                                             \
+  rkp += AES_128_NB;                                                         \
+}
+
+//! One full round for two interleaved blocks sharing a round key load.
+#define AES_ENC_RND_ITER_X2() {                                              \
+  k_0 = rkp[ 0 ]; k_1 = rkp[ 1 ]; k_2 = rkp[ 2 ]; k_3 = rkp[ 3 ];            \
+  n_0 = AES_ENC_COL(k_0, a_0, a_1, a_2, a_3);                                \
+  n_1 = AES_ENC_COL(k_1, a_1, a_2, a_3, a_0);                                \
+  n_2 = AES_ENC_COL(k_2, a_2, a_3, a_0, a_1);                                \
+  n_3 = AES_ENC_COL(k_3, a_3, a_0, a_1, a_2);                                \
+  m_0 = AES_ENC_COL(k_0, b_0, b_1, b_2, b_3);                                \
+  m_1 = AES_ENC_COL(k_1, b_1, b_2, b_3, b_0);                                \
+  m_2 = AES_ENC_COL(k_2, b_2, b_3, b_0, b_1);                                \
+  m_3 = AES_ENC_COL(k_3, b_3, b_0, b_1, b_2);                                \
+                                                                             \
+  rkp += AES_128_NB;                                                         \
+  a_0 = n_0; a_1 = n_1; a_2 = n_2; a_3 = n_3;                                \
+  b_0 = m_0; b_1 = m_1; b_2 = m_2; b_3 = m_3;                                \
+}
+
+//! Final round for two interleaved blocks.
+#define AES_ENC_RND_FINI_X2() {                                              \
+  k_0 = rkp[ 0 ]; k_1 = rkp[ 1 ]; k_2 = rkp[ 2 ]; k_3 = rkp[ 3 ];            \
+  n_0 = AES_ENC_COL_FINI(k_0, a_0, a_1, a_2, a_3);                           \
+  n_1 = AES_ENC_COL_FINI(k_1, a_1, a_2, a_3, a_0);                           \
+  n_2 = AES_ENC_COL_FINI(k_2, a_2, a_3, a_0, a_1);                           \
+  n_3 = AES_ENC_COL_FINI(k_3, a_3, a_0, a_1, a_2);                           \
+  m_0 = AES_ENC_COL_FINI(k_0, b_0, b_1, b_2, b_3);                           \
+  m_1 = AES_ENC_COL_FINI(k_1, b_1, b_2, b_3, b_0);                           \
+  m_2 = AES_ENC_COL_FINI(k_2, b_2, b_3, b_0, b_1);                           \
+  m_3 = AES_ENC_COL_FINI(k_3, b_3, b_0, b_1, b_2);                           \
+                                                                             \
+  rkp += AES_128_NB;                                                         \
+  a_0 = n_0; a_1 = n_1; a_2 = n_2; a_3 = n_3;                                \
+  b_0 = m_0; b_1 = m_1; b_2 = m_2; b_3 = m_3;                                \
+}
 
 
 /*!
@@ -181,10 +268,10 @@ static const uint8_t e_sbox[256] = {
 */
 static uint32_t aes_sub_word(uint32_t in) {
 
-    uint32_t t0 = e_sbox[(in >>  0) & 0xFF] <<  0;
-    uint32_t t1 = e_sbox[(in >>  8) & 0xFF] <<  8;
-    uint32_t t2 = e_sbox[(in >> 16) & 0xFF] << 16;
-    uint32_t t3 = e_sbox[(in >> 24) & 0xFF] << 24;
+    uint32_t t0 = AES_ENC_SBOX[(in >>  0) & 0xFF] <<  0;
+    uint32_t t1 = AES_ENC_SBOX[(in >>  8) & 0xFF] <<  8;
+    uint32_t t2 = AES_ENC_SBOX[(in >> 16) & 0xFF] << 16;
+    uint32_t t3 = AES_ENC_SBOX[(in >> 24) & 0xFF] << 24;
     
     return t3 | t2 | t1 | t0;
 }
@@ -307,4 +394,86 @@ void    aes_256_ecb_encrypt (
     aes_ecb_encrypt(ct,pt,rk,AES_256_NR);
 }
 
+/*!
+@brief Encrypt nblocks consecutive blocks, two at a time.
+@details Both blocks share each round key load, and their table lookups
+    are independent, so one block's loads overlap the other's. An odd
+    trailing block goes through aes_ecb_encrypt.
+*/
+void    aes_ecb_encrypt_blocks (
+    uint8_t   * ct,
+    uint8_t   * pt,
+    uint32_t  * rk,
+    size_t      nblocks,
+    int         nr
+){
+    for(; nblocks >= 2; nblocks -= 2) {
+
+        uint32_t *rkp = ( uint32_t* )( rk );
+        uint32_t  k_0, k_1, k_2, k_3;
+        uint32_t  a_0, a_1, a_2, a_3, n_0, n_1, n_2, n_3;
+        uint32_t  b_0, b_1, b_2, b_3, m_0, m_1, m_2, m_3;
+
+        a_0 = U8_TO_U32LE((pt +  0));
+        a_1 = U8_TO_U32LE((pt +  4));
+        a_2 = U8_TO_U32LE((pt +  8));
+        a_3 = U8_TO_U32LE((pt + 12));
+        b_0 = U8_TO_U32LE((pt + 16));
+        b_1 = U8_TO_U32LE((pt + 20));
+        b_2 = U8_TO_U32LE((pt + 24));
+        b_3 = U8_TO_U32LE((pt + 28));
+
+        AES_ENC_RND_INIT_X2();
+
+        for( int i = 1; i < nr; i++ ) {
+            AES_ENC_RND_ITER_X2();
+        }
+
+        AES_ENC_RND_FINI_X2();
+
+        U32_TO_U8LE(ct, a_0,  0 );
+        U32_TO_U8LE(ct, a_1,  4 );
+        U32_TO_U8LE(ct, a_2,  8 );
+        U32_TO_U8LE(ct, a_3, 12 );
+        U32_TO_U8LE(ct, b_0, 16 );
+        U32_TO_U8LE(ct, b_1, 20 );
+        U32_TO_U8LE(ct, b_2, 24 );
+        U32_TO_U8LE(ct, b_3, 28 );
+
+        ct += 2*AES_BLOCK_BYTES;
+        pt += 2*AES_BLOCK_BYTES;
+    }
+
+    if(nblocks) {
+        aes_ecb_encrypt(ct,pt,rk,nr);
+    }
+}
+
+void    aes_128_ecb_encrypt_blocks (
+    uint8_t   * ct,
+    uint8_t   * pt,
+    uint32_t  * rk,
+    size_t      nblocks
+){
+    aes_ecb_encrypt_blocks(ct,pt,rk,nblocks,AES_128_NR);
+}
+
+void    aes_192_ecb_encrypt_blocks (
+    uint8_t   * ct,
+    uint8_t   * pt,
+    uint32_t  * rk,
+    size_t      nblocks
+){
+    aes_ecb_encrypt_blocks(ct,pt,rk,nblocks,AES_192_NR);
+}
+
+void    aes_256_ecb_encrypt_blocks (
+    uint8_t   * ct,
+    uint8_t   * pt,
+    uint32_t  * rk,
+    size_t      nblocks
+){
+    aes_ecb_encrypt_blocks(ct,pt,rk,nblocks,AES_256_NR);
+}
+
 //!@}
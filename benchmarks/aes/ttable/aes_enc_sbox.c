@@ -0,0 +1,7 @@
+/*
+Builds aes_enc.c with the sbox table layout. See aes/ttable/common.h
+*/
+
+#define AES_TTABLE_LAYOUT AES_TTABLE_LAYOUT_SBOX
+
+#include "aes_enc.c"
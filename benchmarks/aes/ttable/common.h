@@ -1,12 +1,55 @@
-
 #ifndef __AES_TTABLE_COMMON__
 #define __AES_TTABLE_COMMON__
 
+#include <stddef.h>
+#include <stdint.h>
+
+/*!
+@brief Table layouts for the TTable AES, selected at build time by
+    defining AES_TTABLE_LAYOUT.
+@details
+- FULL    : Four 1KB round tables and a 1KB final round table per
+            direction. 5KB of tables for each of encrypt and decrypt.
+- SBOX    : The four round tables, with the 256 byte SBox for the final
+            round. 4.25KB per direction.
+- COMPACT : One 1KB round table, rotated to give the other three, and the
+            256 byte SBox for the final round. 1.25KB per direction, at
+            the cost of three rotations per column.
+*/
+#define AES_TTABLE_LAYOUT_FULL    0
+#define AES_TTABLE_LAYOUT_SBOX    1
+#define AES_TTABLE_LAYOUT_COMPACT 2
+
+#ifndef AES_TTABLE_LAYOUT
+#define AES_TTABLE_LAYOUT AES_TTABLE_LAYOUT_FULL
+#endif
+
+#if   AES_TTABLE_LAYOUT == AES_TTABLE_LAYOUT_FULL
+#define AES_TTABLE_LAYOUT_NAME "full"
+#elif AES_TTABLE_LAYOUT == AES_TTABLE_LAYOUT_SBOX
+#define AES_TTABLE_LAYOUT_NAME "sbox"
+#elif AES_TTABLE_LAYOUT == AES_TTABLE_LAYOUT_COMPACT
+#define AES_TTABLE_LAYOUT_NAME "compact"
+#else
+#error "Unknown AES_TTABLE_LAYOUT"
+#endif
+
 extern uint32_t AES_ENC_TBOX_0[];
 extern uint32_t AES_ENC_TBOX_1[];
 extern uint32_t AES_ENC_TBOX_2[];
 extern uint32_t AES_ENC_TBOX_3[];
 extern uint32_t AES_ENC_TBOX_4[];
 
-#endif
+extern const uint8_t AES_ENC_SBOX[];
+extern const uint8_t AES_DEC_SBOX[];
+
+//! Name of the table layout the library was built with.
+extern const char * aes_ttable_layout;
 
+//! Bytes of lookup table touched by encrypting blocks.
+extern const size_t aes_ttable_enc_table_bytes;
+
+//! Bytes of lookup table touched by decrypting blocks.
+extern const size_t aes_ttable_dec_table_bytes;
+
+#endif
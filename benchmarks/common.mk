@@ -116,6 +116,36 @@ BUILDTARGETS += build-lib-${1}
 endef
 
 
+#
+# Copy a library, keeping only the symbols listed in a file global and
+# renaming each of them to <library>_<symbol>. This lets several backends
+# which implement the same API be linked into one program.
+#
+# 1. New library name
+# 2. Library to copy
+# 3. File listing the symbols to keep, one per line.
+define add_prefixed_lib_target
+
+$(call map_lib,${1}) : $(call map_lib,${2}) ${3}
+	@mkdir -p $(dir $(call map_lib,${1})) $(BUILD_DIR)/obj/${1}
+	$(CC) $(CFLAGS) -nostdlib -r -o $(BUILD_DIR)/obj/${1}/${1}.o \
+        -Wl,--whole-archive $(call map_lib,${2}) -Wl,--no-whole-archive
+	$(OBJCOPY) --keep-global-symbols=${3} $(BUILD_DIR)/obj/${1}/${1}.o
+	sed "s/.*/& ${2}_&/" ${3} > $(BUILD_DIR)/obj/${1}/${1}.map
+	$(OBJCOPY) --redefine-syms=$(BUILD_DIR)/obj/${1}/${1}.map \
+        $(BUILD_DIR)/obj/${1}/${1}.o
+	rm -f $${@}
+	$(AR) rcs $${@} $(BUILD_DIR)/obj/${1}/${1}.o
+
+TARGETS      += $(call map_lib,${1})
+
+build-lib-${1} : $(call map_lib,${1})
+
+BUILDTARGETS += build-lib-${1}
+
+endef
+
+
 #
 # 1. Source Files
 # 2. Libraries and extra source files.
@@ -0,0 +1,390 @@
+/*!
+@defgroup crypto_dispatch Crypto Dispatch
+@brief Run time selection of the fastest backend for each algorithm.
+@details Several backends are linked into one binary, each with its
+    API symbols prefixed by its library name (see add_prefixed_lib_target
+    in common.mk). On first use, the ISA extensions of the hart are probed
+    and every entry of rvcrypto_dispatch is pointed at the best backend
+    which the hart can run. After that, a call is a single indirect call:
+    @code
+        rvcrypto_dispatch.aes_128_ecb_encrypt(ct, pt, rk);
+    @endcode
+@{
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "riscvcrypto/sha256/api_sha256.h"
+#include "riscvcrypto/sha512/api_sha512.h"
+#include "riscvcrypto/sha3/fips202.h"
+#include "riscvcrypto/sha3/k12.h"
+#include "riscvcrypto/sha3/sp800_185.h"
+#include "riscvcrypto/sm3/api_sm3.h"
+
+#ifndef __API_DISPATCH_H__
+#define __API_DISPATCH_H__
+
+//! @name ISA extension bits returned by rvcrypto_isa_probe
+//! @{
+#define RVCRYPTO_ISA_ZBKB   (1 << 0)
+#define RVCRYPTO_ISA_ZBKC   (1 << 1)
+#define RVCRYPTO_ISA_ZBKX   (1 << 2)
+#define RVCRYPTO_ISA_ZKND   (1 << 3)
+#define RVCRYPTO_ISA_ZKNE   (1 << 4)
+#define RVCRYPTO_ISA_ZKNH   (1 << 5)
+#define RVCRYPTO_ISA_ZKSED  (1 << 6)
+#define RVCRYPTO_ISA_ZKSH   (1 << 7)
+//! @}
+
+/*!
+@brief Every dispatched function, as X(ret, name, params, args) if it
+    returns void, or R(ret, name, params, args) if it returns a value.
+@details Adding a function here adds it to rvcrypto_dispatch_t, to the
+    first-use stubs, and to each backend binding of its family. The
+    function must also be listed in the family's dispatch/<family>.syms file.
+    Only the first-use stubs treat X and R differently: an R stub passes
+    the result back.
+*/
+#define RVCRYPTO_DISPATCH_AES(X, R)                                     \
+    X(void, aes_128_enc_key_schedule,                                   \
+        (uint32_t * const rk, uint8_t * const ck), (rk, ck))            \
+    X(void, aes_192_enc_key_schedule,                                   \
+        (uint32_t * const rk, uint8_t * const ck), (rk, ck))            \
+    X(void, aes_256_enc_key_schedule,                                   \
+        (uint32_t * const rk, uint8_t * const ck), (rk, ck))            \
+    X(void, aes_128_dec_key_schedule,                                   \
+        (uint32_t * const rk, uint8_t * const ck), (rk, ck))            \
+    X(void, aes_192_dec_key_schedule,                                   \
+        (uint32_t * const rk, uint8_t * const ck), (rk, ck))            \
+    X(void, aes_256_dec_key_schedule,                                   \
+        (uint32_t * const rk, uint8_t * const ck), (rk, ck))            \
+    X(void, aes_128_dec_key_schedule_from_enc,                          \
+        (uint32_t * const drk, uint32_t * const erk), (drk, erk))       \
+    X(void, aes_192_dec_key_schedule_from_enc,                          \
+        (uint32_t * const drk, uint32_t * const erk), (drk, erk))       \
+    X(void, aes_256_dec_key_schedule_from_enc,                          \
+        (uint32_t * const drk, uint32_t * const erk), (drk, erk))       \
+    X(void, aes_128_ecb_encrypt,                                        \
+        (uint8_t * ct, uint8_t * pt, uint32_t * rk), (ct, pt, rk))      \
+    X(void, aes_192_ecb_encrypt,                                        \
+        (uint8_t * ct, uint8_t * pt, uint32_t * rk), (ct, pt, rk))      \
+    X(void, aes_256_ecb_encrypt,                                        \
+        (uint8_t * ct, uint8_t * pt, uint32_t * rk), (ct, pt, rk))      \
+    X(void, aes_128_ecb_decrypt,                                        \
+        (uint8_t * pt, uint8_t * ct, uint32_t * rk), (pt, ct, rk))      \
+    X(void, aes_192_ecb_decrypt,                                        \
+        (uint8_t * pt, uint8_t * ct, uint32_t * rk), (pt, ct, rk))      \
+    X(void, aes_256_ecb_decrypt,                                        \
+        (uint8_t * pt, uint8_t * ct, uint32_t * rk), (pt, ct, rk))      \
+    X(void, aes_128_ecb_encrypt_blocks,                                 \
+        (uint8_t * ct, uint8_t * pt, uint32_t * rk, size_t n),          \
+        (ct, pt, rk, n))                                                \
+    X(void, aes_192_ecb_encrypt_blocks,                                 \
+        (uint8_t * ct, uint8_t * pt, uint32_t * rk, size_t n),          \
+        (ct, pt, rk, n))                                                \
+    X(void, aes_256_ecb_encrypt_blocks,                                 \
+        (uint8_t * ct, uint8_t * pt, uint32_t * rk, size_t n),          \
+        (ct, pt, rk, n))                                                \
+    X(void, aes_128_ecb_decrypt_blocks,                                 \
+        (uint8_t * pt, uint8_t * ct, uint32_t * rk, size_t n),          \
+        (pt, ct, rk, n))                                                \
+    X(void, aes_192_ecb_decrypt_blocks,                                 \
+        (uint8_t * pt, uint8_t * ct, uint32_t * rk, size_t n),          \
+        (pt, ct, rk, n))                                                \
+    X(void, aes_256_ecb_decrypt_blocks,                                 \
+        (uint8_t * pt, uint8_t * ct, uint32_t * rk, size_t n),          \
+        (pt, ct, rk, n))
+
+#define RVCRYPTO_DISPATCH_SHA256(X, R)                                  \
+    X(void, sha256_hash,                                                \
+        (uint32_t H[8], uint8_t * M, size_t len), (H, M, len))          \
+    X(void, sha224_hash,                                                \
+        (uint8_t digest[SHA224_DIGEST_BYTES], uint8_t * M, size_t len), \
+        (digest, M, len))                                               \
+    X(void, sha256_hash_block,                                          \
+        (uint32_t H[8], uint32_t M[16]), (H, M))                        \
+    X(void, sha256_hash_block_words,                                    \
+        (uint32_t H[8], const uint32_t W[16]), (H, W))                  \
+    X(void, sha256_hash_blocks,                                         \
+        (uint32_t H[8], uint8_t * M, size_t n), (H, M, n))              \
+    X(void, sha256_init,                                                \
+        (sha256_ctx_t * ctx), (ctx))                                    \
+    X(void, sha224_init,                                                \
+        (sha256_ctx_t * ctx), (ctx))                                    \
+    X(void, sha256_update,                                              \
+        (sha256_ctx_t * ctx, uint8_t * M, size_t len), (ctx, M, len))   \
+    X(void, sha256_final,                                               \
+        (sha256_ctx_t * ctx, uint8_t * digest), (ctx, digest))
+
+#define RVCRYPTO_DISPATCH_SHA512(X, R)                                  \
+    X(void, sha512_hash,                                                \
+        (uint64_t H[8], uint8_t * M, size_t len), (H, M, len))          \
+    X(void, sha512_hash_block,                                          \
+        (uint64_t H[8], uint64_t M[16]), (H, M))                        \
+    X(void, sha512_hash_block_words,                                    \
+        (uint64_t H[8], const uint64_t W[16]), (H, W))                  \
+    X(void, sha512_hash_blocks,                                         \
+        (uint64_t H[8], uint8_t * M, size_t n), (H, M, n))              \
+    X(void, sha384_hash,                                                \
+        (uint8_t digest[SHA384_DIGEST_BYTES], uint8_t * M, size_t len), \
+        (digest, M, len))                                               \
+    X(void, sha512_256_hash,                                            \
+        (uint8_t * digest, uint8_t * M, size_t len), (digest, M, len))  \
+    X(void, sha512_224_hash,                                            \
+        (uint8_t * digest, uint8_t * M, size_t len), (digest, M, len))  \
+    X(void, sha512_init,                                                \
+        (sha512_ctx_t * ctx), (ctx))                                    \
+    X(void, sha384_init,                                                \
+        (sha512_ctx_t * ctx), (ctx))                                    \
+    X(void, sha512_256_init,                                            \
+        (sha512_ctx_t * ctx), (ctx))                                    \
+    X(void, sha512_224_init,                                            \
+        (sha512_ctx_t * ctx), (ctx))                                    \
+    X(void, sha512_update,                                              \
+        (sha512_ctx_t * ctx, uint8_t * M, size_t len), (ctx, M, len))   \
+    X(void, sha512_final,                                               \
+        (sha512_ctx_t * ctx, uint8_t * digest), (ctx, digest))
+
+#define RVCRYPTO_DISPATCH_SHA3(X, R)                                    \
+    X(void, FIPS202_SHAKE128,                                           \
+        (const unsigned char * in, unsigned long long inlen,            \
+         unsigned char * out, unsigned long long outlen),               \
+        (in, inlen, out, outlen))                                       \
+    X(void, FIPS202_SHAKE256,                                           \
+        (const unsigned char * in, unsigned long long inlen,            \
+         unsigned char * out, unsigned long long outlen),               \
+        (in, inlen, out, outlen))                                       \
+    X(void, FIPS202_SHA3_224,                                           \
+        (const unsigned char * in, unsigned long long inlen,            \
+         unsigned char * out), (in, inlen, out))                        \
+    X(void, FIPS202_SHA3_256,                                           \
+        (const unsigned char * in, unsigned long long inlen,            \
+         unsigned char * out), (in, inlen, out))                        \
+    X(void, FIPS202_SHA3_384,                                           \
+        (const unsigned char * in, unsigned long long inlen,            \
+         unsigned char * out), (in, inlen, out))                        \
+    X(void, FIPS202_SHA3_512,                                           \
+        (const unsigned char * in, unsigned long long inlen,            \
+         unsigned char * out), (in, inlen, out))                        \
+    X(void, keccak_init,                                                \
+        (keccak_ctx_t * ctx, unsigned int rate, uint8_t suffix),        \
+        (ctx, rate, suffix))                                            \
+    X(void, keccak_absorb,                                              \
+        (keccak_ctx_t * ctx, const uint8_t * in, uint64_t len),         \
+        (ctx, in, len))                                                 \
+    X(void, keccak_finalize,                                            \
+        (keccak_ctx_t * ctx), (ctx))                                    \
+    X(void, keccak_squeeze,                                             \
+        (keccak_ctx_t * ctx, uint8_t * out, uint64_t len),              \
+        (ctx, out, len))                                                \
+    X(void, shake128_x4_init,                                           \
+        (shake128_x4_ctx_t * ctx), (ctx))                               \
+    X(void, shake128_x4_absorb,                                         \
+        (shake128_x4_ctx_t * ctx, const uint8_t * in[4], uint64_t len), \
+        (ctx, in, len))                                                 \
+    X(void, shake128_x4_finalize,                                       \
+        (shake128_x4_ctx_t * ctx), (ctx))                               \
+    X(void, shake128_x4_squeeze,                                        \
+        (shake128_x4_ctx_t * ctx, uint8_t * out[4], uint64_t len),      \
+        (ctx, out, len))                                                \
+    X(void, keccak_init_rounds,                                         \
+        (keccak_ctx_t * ctx, unsigned int rate, uint8_t suffix,         \
+         unsigned int rounds), (ctx, rate, suffix, rounds))             \
+    X(void, TurboSHAKE128,                                              \
+        (const uint8_t * in, uint64_t inlen, uint8_t D,                 \
+         uint8_t * out, uint64_t outlen), (in, inlen, D, out, outlen))  \
+    X(void, TurboSHAKE256,                                              \
+        (const uint8_t * in, uint64_t inlen, uint8_t D,                 \
+         uint8_t * out, uint64_t outlen), (in, inlen, D, out, outlen))  \
+    X(void, k12_init,                                                   \
+        (k12_ctx_t * ctx), (ctx))                                       \
+    X(void, k12_absorb,                                                 \
+        (k12_ctx_t * ctx, const uint8_t * in, uint64_t len),            \
+        (ctx, in, len))                                                 \
+    R(int , k12_absorb_cvs,                                             \
+        (k12_ctx_t * ctx, const uint8_t * cvs, uint64_t n),             \
+        (ctx, cvs, n))                                                  \
+    X(void, k12_finalize,                                               \
+        (k12_ctx_t * ctx, const uint8_t * custom, uint64_t clen),       \
+        (ctx, custom, clen))                                            \
+    X(void, k12_squeeze,                                                \
+        (k12_ctx_t * ctx, uint8_t * out, uint64_t len),                 \
+        (ctx, out, len))                                                \
+    X(void, k12_leaf_cvs,                                               \
+        (const uint8_t * in, uint64_t n, uint8_t * cvs), (in, n, cvs))  \
+    X(void, KangarooTwelve,                                             \
+        (const uint8_t * in, uint64_t inlen,                            \
+         const uint8_t * custom, uint64_t clen,                         \
+         uint8_t * out, uint64_t outlen),                               \
+        (in, inlen, custom, clen, out, outlen))                         \
+    X(void, cshake_init,                                                \
+        (keccak_ctx_t * ctx, unsigned int rate, const uint8_t * N,      \
+         uint64_t nlen, const uint8_t * S, uint64_t slen),              \
+        (ctx, rate, N, nlen, S, slen))                                  \
+    X(void, kmac_init,                                                  \
+        (keccak_ctx_t * ctx, unsigned int rate, const uint8_t * K,      \
+         uint64_t klen, const uint8_t * S, uint64_t slen),              \
+        (ctx, rate, K, klen, S, slen))                                  \
+    X(void, kmac_finalize,                                              \
+        (keccak_ctx_t * ctx, uint64_t outlen), (ctx, outlen))           \
+    R(int , parallelhash_init,                                          \
+        (parallelhash_ctx_t * ctx, unsigned int rate, uint64_t B,       \
+         const uint8_t * S, uint64_t slen), (ctx, rate, B, S, slen))    \
+    X(void, parallelhash_absorb,                                        \
+        (parallelhash_ctx_t * ctx, const uint8_t * in, uint64_t len),   \
+        (ctx, in, len))                                                 \
+    X(void, parallelhash_block_cvs,                                     \
+        (unsigned int rate, const uint8_t * in, uint64_t B,             \
+         uint64_t n, uint8_t * cvs), (rate, in, B, n, cvs))             \
+    R(int , parallelhash_absorb_cvs,                                    \
+        (parallelhash_ctx_t * ctx, const uint8_t * cvs, uint64_t n),    \
+        (ctx, cvs, n))                                                  \
+    X(void, parallelhash_finalize,                                      \
+        (parallelhash_ctx_t * ctx, uint64_t outlen), (ctx, outlen))     \
+    X(void, parallelhash_squeeze,                                       \
+        (parallelhash_ctx_t * ctx, uint8_t * out, uint64_t len),        \
+        (ctx, out, len))                                                \
+    X(void, cSHAKE128,                                                  \
+        (const uint8_t * in, uint64_t inlen, const uint8_t * N,         \
+         uint64_t nlen, const uint8_t * S, uint64_t slen,               \
+         uint8_t * out, uint64_t outlen),                               \
+        (in, inlen, N, nlen, S, slen, out, outlen))                     \
+    X(void, cSHAKE256,                                                  \
+        (const uint8_t * in, uint64_t inlen, const uint8_t * N,         \
+         uint64_t nlen, const uint8_t * S, uint64_t slen,               \
+         uint8_t * out, uint64_t outlen),                               \
+        (in, inlen, N, nlen, S, slen, out, outlen))                     \
+    X(void, KMAC128,                                                    \
+        (const uint8_t * K, uint64_t klen, const uint8_t * in,          \
+         uint64_t inlen, const uint8_t * S, uint64_t slen,              \
+         uint8_t * out, uint64_t outlen),                               \
+        (K, klen, in, inlen, S, slen, out, outlen))                     \
+    X(void, KMAC256,                                                    \
+        (const uint8_t * K, uint64_t klen, const uint8_t * in,          \
+         uint64_t inlen, const uint8_t * S, uint64_t slen,              \
+         uint8_t * out, uint64_t outlen),                               \
+        (K, klen, in, inlen, S, slen, out, outlen))                     \
+    X(void, KMACXOF128,                                                 \
+        (const uint8_t * K, uint64_t klen, const uint8_t * in,          \
+         uint64_t inlen, const uint8_t * S, uint64_t slen,              \
+         uint8_t * out, uint64_t outlen),                               \
+        (K, klen, in, inlen, S, slen, out, outlen))                     \
+    X(void, KMACXOF256,                                                 \
+        (const uint8_t * K, uint64_t klen, const uint8_t * in,          \
+         uint64_t inlen, const uint8_t * S, uint64_t slen,              \
+         uint8_t * out, uint64_t outlen),                               \
+        (K, klen, in, inlen, S, slen, out, outlen))                     \
+    R(int , ParallelHash128,                                            \
+        (const uint8_t * in, uint64_t inlen, uint64_t B,                \
+         const uint8_t * S, uint64_t slen,                              \
+         uint8_t * out, uint64_t outlen),                               \
+        (in, inlen, B, S, slen, out, outlen))                           \
+    R(int , ParallelHash256,                                            \
+        (const uint8_t * in, uint64_t inlen, uint64_t B,                \
+         const uint8_t * S, uint64_t slen,                              \
+         uint8_t * out, uint64_t outlen),                               \
+        (in, inlen, B, S, slen, out, outlen))                           \
+    R(int , ParallelHashXOF128,                                         \
+        (const uint8_t * in, uint64_t inlen, uint64_t B,                \
+         const uint8_t * S, uint64_t slen,                              \
+         uint8_t * out, uint64_t outlen),                               \
+        (in, inlen, B, S, slen, out, outlen))                           \
+    R(int , ParallelHashXOF256,                                         \
+        (const uint8_t * in, uint64_t inlen, uint64_t B,                \
+         const uint8_t * S, uint64_t slen,                              \
+         uint8_t * out, uint64_t outlen),                               \
+        (in, inlen, B, S, slen, out, outlen))
+
+#define RVCRYPTO_DISPATCH_SM3(X, R)                                     \
+    X(void, sm3_hash,                                                   \
+        (uint8_t hash[32], const uint8_t * M, size_t len),              \
+        (hash, M, len))                                                 \
+    X(void, sm3_hash_blocks,                                            \
+        (uint32_t H[8], const uint8_t * M, size_t n), (H, M, n))        \
+    X(void, sm3_init,                                                   \
+        (sm3_ctx_t * ctx), (ctx))                                       \
+    X(void, sm3_update,                                                 \
+        (sm3_ctx_t * ctx, const uint8_t * M, size_t len),               \
+        (ctx, M, len))                                                  \
+    X(void, sm3_final,                                                  \
+        (sm3_ctx_t * ctx, uint8_t * digest), (ctx, digest))
+
+#define RVCRYPTO_DISPATCH_SM4(X, R)                                     \
+    X(void, sm4_key_schedule_enc,                                       \
+        (uint32_t rk[32], uint8_t mk[16]), (rk, mk))                    \
+    X(void, sm4_key_schedule_dec,                                       \
+        (uint32_t rk[32], uint8_t mk[16]), (rk, mk))                    \
+    X(void, sm4_block_enc_dec,                                          \
+        (uint8_t out[16], uint8_t in[16], uint32_t rk[32]),             \
+        (out, in, rk))                                                  \
+    X(void, sm4_ecb_blocks,                                             \
+        (uint8_t * out, uint8_t * in, uint32_t rk[32], size_t nblocks), \
+        (out, in, rk, nblocks))
+
+#define RVCRYPTO_DISPATCH_ALL(X, R)                                     \
+    RVCRYPTO_DISPATCH_AES(X, R)                                         \
+    RVCRYPTO_DISPATCH_SHA256(X, R)                                      \
+    RVCRYPTO_DISPATCH_SHA512(X, R)                                      \
+    RVCRYPTO_DISPATCH_SHA3(X, R)                                        \
+    RVCRYPTO_DISPATCH_SM3(X, R)                                         \
+    RVCRYPTO_DISPATCH_SM4(X, R)
+
+#define RVCRYPTO_DISPATCH_MEMBER(RET, NAME, PARAMS, ARGS) RET (*NAME) PARAMS;
+
+//! Table of resolved functions, and the backend chosen for each family.
+typedef struct {
+    RVCRYPTO_DISPATCH_ALL(RVCRYPTO_DISPATCH_MEMBER, RVCRYPTO_DISPATCH_MEMBER)
+    const char * aes_backend;
+    const char * sha256_backend;
+    const char * sha512_backend;
+    const char * sha3_backend;
+    const char * sm3_backend;
+    const char * sm4_backend;
+} rvcrypto_dispatch_t;
+
+#undef RVCRYPTO_DISPATCH_MEMBER
+
+/*!
+@brief The dispatch table.
+@details Before rvcrypto_dispatch_init, each function entry is a stub
+    which initialises the table with rvcrypto_isa() and then makes the
+    call, so the table may be used without any explicit set up.
+*/
+extern rvcrypto_dispatch_t rvcrypto_dispatch;
+
+/*!
+@brief Probe the ISA extensions of the current hart.
+@details On Linux this asks the kernel through riscv_hwprobe. Only if
+    the kernel cannot answer, because it lacks the call or predates the
+    scalar crypto bits, is one instruction from each extension executed
+    under a SIGILL handler. Elsewhere (e.g. under pk) there is no
+    way to ask, and the extensions the library was configured with
+    (-D__ZSCRYPTO) are assumed present.
+@returns A mask of RVCRYPTO_ISA_* bits.
+*/
+uint32_t rvcrypto_isa_probe(void);
+
+/*!
+@brief rvcrypto_isa_probe, run once and cached.
+@details Safe to call from several threads. The first caller probes and
+    any others wait for its result.
+*/
+uint32_t rvcrypto_isa(void);
+
+/*!
+@brief Bind every entry of rvcrypto_dispatch for the extensions in isa.
+@details Called automatically on first use with rvcrypto_isa(). The probe
+    and that first bind run exactly once, even when several threads make
+    their first dispatched call at the same time. The table is bound in
+    a local copy and each entry is then published with an atomic store,
+    so a concurrent caller sees either the stub or the bound function.
+    May be called again, e.g. with a subset of the probed extensions to
+    force a slower backend, but not while other threads are calling
+    through the table: they could mix two backends of one family.
+*/
+void rvcrypto_dispatch_init(uint32_t isa);
+
+#endif // __API_DISPATCH_H__
+
+//! @}
@@ -0,0 +1,458 @@
+
+/*!
+@addtogroup crypto_dispatch
+@{
+*/
+
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/dispatch/api_dispatch.h"
+
+#if defined(__riscv) && defined(__linux__)
+#include <setjmp.h>
+#include <signal.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <sys/utsname.h>
+#endif
+
+#if defined(__ZSCRYPTO) && (__riscv_xlen == 64)
+#define RVCRYPTO_AES_ZSCRYPTO    aes_zscrypto_rv64
+#define RVCRYPTO_SHA512_ZSCRYPTO sha512_zscrypto_rv64
+#define RVCRYPTO_SHA3_ZSCRYPTO   sha3_zscrypto_rv64
+#define RVCRYPTO_SM3_ZSCRYPTO    sm3_zscrypto_rv64
+#elif defined(__ZSCRYPTO) && (__riscv_xlen == 32)
+#define RVCRYPTO_AES_ZSCRYPTO    aes_zscrypto_rv32
+#define RVCRYPTO_SHA512_ZSCRYPTO sha512_zscrypto_rv32
+#define RVCRYPTO_SHA3_ZSCRYPTO   sha3_zscrypto_rv32
+#define RVCRYPTO_SM3_ZSCRYPTO    sm3_zscrypto_rv32
+#endif
+
+#if defined(__ZSCRYPTO)
+#define RVCRYPTO_SHA256_ZSCRYPTO sha256_zscrypto
+#define RVCRYPTO_SM4_ZSCRYPTO    sm4_zscrypto
+#endif
+
+//! Extensions each zscrypto backend executes.
+#define RVCRYPTO_AES_ZSCRYPTO_ISA    (RVCRYPTO_ISA_ZKNE | RVCRYPTO_ISA_ZKND)
+#define RVCRYPTO_SHA256_ZSCRYPTO_ISA (RVCRYPTO_ISA_ZKNH)
+#define RVCRYPTO_SHA512_ZSCRYPTO_ISA (RVCRYPTO_ISA_ZKNH)
+#define RVCRYPTO_SHA3_ZSCRYPTO_ISA   (RVCRYPTO_ISA_ZBKB)
+#define RVCRYPTO_SM3_ZSCRYPTO_ISA    (RVCRYPTO_ISA_ZKSH)
+#define RVCRYPTO_SM4_ZSCRYPTO_ISA    (RVCRYPTO_ISA_ZKSED)
+
+//! Every extension which the library knows how to use.
+#define RVCRYPTO_ISA_ALL (RVCRYPTO_ISA_ZBKB  | RVCRYPTO_ISA_ZBKC  | \
+                          RVCRYPTO_ISA_ZBKX  | RVCRYPTO_ISA_ZKND  | \
+                          RVCRYPTO_ISA_ZKNE  | RVCRYPTO_ISA_ZKNH  | \
+                          RVCRYPTO_ISA_ZKSED | RVCRYPTO_ISA_ZKSH  )
+
+#define RVCRYPTO_PASTE_(A, B) A ## _ ## B
+#define RVCRYPTO_PASTE(A, B)  RVCRYPTO_PASTE_(A, B)
+
+//
+// Backend symbols are <library>_<function>. BACKEND names the library.
+#define RVCRYPTO_DECLARE(RET, NAME, PARAMS, ARGS) \
+    extern RET RVCRYPTO_PASTE(BACKEND, NAME) PARAMS;
+
+#define RVCRYPTO_BIND(RET, NAME, PARAMS, ARGS) \
+    t->NAME = RVCRYPTO_PASTE(BACKEND, NAME);
+
+#define BACKEND aes_ttable
+RVCRYPTO_DISPATCH_AES(RVCRYPTO_DECLARE, RVCRYPTO_DECLARE)
+#undef  BACKEND
+#define BACKEND sha256_reference
+RVCRYPTO_DISPATCH_SHA256(RVCRYPTO_DECLARE, RVCRYPTO_DECLARE)
+#undef  BACKEND
+#define BACKEND sha512_reference
+RVCRYPTO_DISPATCH_SHA512(RVCRYPTO_DECLARE, RVCRYPTO_DECLARE)
+#undef  BACKEND
+#define BACKEND sha3_unrolled
+RVCRYPTO_DISPATCH_SHA3(RVCRYPTO_DECLARE, RVCRYPTO_DECLARE)
+#undef  BACKEND
+#define BACKEND sm3_reference
+RVCRYPTO_DISPATCH_SM3(RVCRYPTO_DECLARE, RVCRYPTO_DECLARE)
+#undef  BACKEND
+#define BACKEND sm4_reference
+RVCRYPTO_DISPATCH_SM4(RVCRYPTO_DECLARE, RVCRYPTO_DECLARE)
+#undef  BACKEND
+
+#ifdef RVCRYPTO_AES_ZSCRYPTO
+#define BACKEND RVCRYPTO_AES_ZSCRYPTO
+RVCRYPTO_DISPATCH_AES(RVCRYPTO_DECLARE, RVCRYPTO_DECLARE)
+#undef  BACKEND
+#endif
+#ifdef RVCRYPTO_SHA256_ZSCRYPTO
+#define BACKEND RVCRYPTO_SHA256_ZSCRYPTO
+RVCRYPTO_DISPATCH_SHA256(RVCRYPTO_DECLARE, RVCRYPTO_DECLARE)
+#undef  BACKEND
+#endif
+#ifdef RVCRYPTO_SHA512_ZSCRYPTO
+#define BACKEND RVCRYPTO_SHA512_ZSCRYPTO
+RVCRYPTO_DISPATCH_SHA512(RVCRYPTO_DECLARE, RVCRYPTO_DECLARE)
+#undef  BACKEND
+#endif
+#ifdef RVCRYPTO_SHA3_ZSCRYPTO
+#define BACKEND RVCRYPTO_SHA3_ZSCRYPTO
+RVCRYPTO_DISPATCH_SHA3(RVCRYPTO_DECLARE, RVCRYPTO_DECLARE)
+#undef  BACKEND
+#endif
+#ifdef RVCRYPTO_SM3_ZSCRYPTO
+#define BACKEND RVCRYPTO_SM3_ZSCRYPTO
+RVCRYPTO_DISPATCH_SM3(RVCRYPTO_DECLARE, RVCRYPTO_DECLARE)
+#undef  BACKEND
+#endif
+#ifdef RVCRYPTO_SM4_ZSCRYPTO
+#define BACKEND RVCRYPTO_SM4_ZSCRYPTO
+RVCRYPTO_DISPATCH_SM4(RVCRYPTO_DECLARE, RVCRYPTO_DECLARE)
+#undef  BACKEND
+#endif
+
+/*!
+@brief Pick the backend for each family. The zscrypto backends are used
+    whenever every extension they execute is present.
+*/
+static void rvcrypto_dispatch_bind(rvcrypto_dispatch_t * t, uint32_t isa) {
+
+    #define BACKEND aes_ttable
+    RVCRYPTO_DISPATCH_AES(RVCRYPTO_BIND, RVCRYPTO_BIND)
+    t->aes_backend = STR(BACKEND);
+    #undef  BACKEND
+#ifdef RVCRYPTO_AES_ZSCRYPTO
+    if((isa & RVCRYPTO_AES_ZSCRYPTO_ISA) == RVCRYPTO_AES_ZSCRYPTO_ISA) {
+        #define BACKEND RVCRYPTO_AES_ZSCRYPTO
+        RVCRYPTO_DISPATCH_AES(RVCRYPTO_BIND, RVCRYPTO_BIND)
+        t->aes_backend = STR(BACKEND);
+        #undef  BACKEND
+    }
+#endif
+
+    #define BACKEND sha256_reference
+    RVCRYPTO_DISPATCH_SHA256(RVCRYPTO_BIND, RVCRYPTO_BIND)
+    t->sha256_backend = STR(BACKEND);
+    #undef  BACKEND
+#ifdef RVCRYPTO_SHA256_ZSCRYPTO
+    if((isa & RVCRYPTO_SHA256_ZSCRYPTO_ISA) == RVCRYPTO_SHA256_ZSCRYPTO_ISA) {
+        #define BACKEND RVCRYPTO_SHA256_ZSCRYPTO
+        RVCRYPTO_DISPATCH_SHA256(RVCRYPTO_BIND, RVCRYPTO_BIND)
+        t->sha256_backend = STR(BACKEND);
+        #undef  BACKEND
+    }
+#endif
+
+    #define BACKEND sha512_reference
+    RVCRYPTO_DISPATCH_SHA512(RVCRYPTO_BIND, RVCRYPTO_BIND)
+    t->sha512_backend = STR(BACKEND);
+    #undef  BACKEND
+#ifdef RVCRYPTO_SHA512_ZSCRYPTO
+    if((isa & RVCRYPTO_SHA512_ZSCRYPTO_ISA) == RVCRYPTO_SHA512_ZSCRYPTO_ISA) {
+        #define BACKEND RVCRYPTO_SHA512_ZSCRYPTO
+        RVCRYPTO_DISPATCH_SHA512(RVCRYPTO_BIND, RVCRYPTO_BIND)
+        t->sha512_backend = STR(BACKEND);
+        #undef  BACKEND
+    }
+#endif
+
+    #define BACKEND sha3_unrolled
+    RVCRYPTO_DISPATCH_SHA3(RVCRYPTO_BIND, RVCRYPTO_BIND)
+    t->sha3_backend = STR(BACKEND);
+    #undef  BACKEND
+#ifdef RVCRYPTO_SHA3_ZSCRYPTO
+    if((isa & RVCRYPTO_SHA3_ZSCRYPTO_ISA) == RVCRYPTO_SHA3_ZSCRYPTO_ISA) {
+        #define BACKEND RVCRYPTO_SHA3_ZSCRYPTO
+        RVCRYPTO_DISPATCH_SHA3(RVCRYPTO_BIND, RVCRYPTO_BIND)
+        t->sha3_backend = STR(BACKEND);
+        #undef  BACKEND
+    }
+#endif
+
+    #define BACKEND sm3_reference
+    RVCRYPTO_DISPATCH_SM3(RVCRYPTO_BIND, RVCRYPTO_BIND)
+    t->sm3_backend = STR(BACKEND);
+    #undef  BACKEND
+#ifdef RVCRYPTO_SM3_ZSCRYPTO
+    if((isa & RVCRYPTO_SM3_ZSCRYPTO_ISA) == RVCRYPTO_SM3_ZSCRYPTO_ISA) {
+        #define BACKEND RVCRYPTO_SM3_ZSCRYPTO
+        RVCRYPTO_DISPATCH_SM3(RVCRYPTO_BIND, RVCRYPTO_BIND)
+        t->sm3_backend = STR(BACKEND);
+        #undef  BACKEND
+    }
+#endif
+
+    #define BACKEND sm4_reference
+    RVCRYPTO_DISPATCH_SM4(RVCRYPTO_BIND, RVCRYPTO_BIND)
+    t->sm4_backend = STR(BACKEND);
+    #undef  BACKEND
+#ifdef RVCRYPTO_SM4_ZSCRYPTO
+    if((isa & RVCRYPTO_SM4_ZSCRYPTO_ISA) == RVCRYPTO_SM4_ZSCRYPTO_ISA) {
+        #define BACKEND RVCRYPTO_SM4_ZSCRYPTO
+        RVCRYPTO_DISPATCH_SM4(RVCRYPTO_BIND, RVCRYPTO_BIND)
+        t->sm4_backend = STR(BACKEND);
+        #undef  BACKEND
+    }
+#endif
+
+}
+
+//
+// Copy one entry of a bound table into rvcrypto_dispatch.
+#define RVCRYPTO_PUBLISH(RET, NAME, PARAMS, ARGS) \
+    __atomic_store_n(&rvcrypto_dispatch.NAME, t.NAME, __ATOMIC_RELEASE);
+
+void rvcrypto_dispatch_init(uint32_t isa) {
+    rvcrypto_dispatch_t t;
+
+    rvcrypto_dispatch_bind(&t, isa);
+
+    RVCRYPTO_DISPATCH_ALL(RVCRYPTO_PUBLISH, RVCRYPTO_PUBLISH)
+
+    __atomic_store_n(&rvcrypto_dispatch.aes_backend   , t.aes_backend   ,
+                     __ATOMIC_RELEASE);
+    __atomic_store_n(&rvcrypto_dispatch.sha256_backend, t.sha256_backend,
+                     __ATOMIC_RELEASE);
+    __atomic_store_n(&rvcrypto_dispatch.sha512_backend, t.sha512_backend,
+                     __ATOMIC_RELEASE);
+    __atomic_store_n(&rvcrypto_dispatch.sha3_backend  , t.sha3_backend  ,
+                     __ATOMIC_RELEASE);
+    __atomic_store_n(&rvcrypto_dispatch.sm3_backend   , t.sm3_backend   ,
+                     __ATOMIC_RELEASE);
+    __atomic_store_n(&rvcrypto_dispatch.sm4_backend   , t.sm4_backend   ,
+                     __ATOMIC_RELEASE);
+}
+
+/*!
+@brief Run fn exactly once, however many threads call this with state.
+@details state is 0 before the first call, 1 while fn runs and 2 after.
+    Threads which lose the race spin until the winner is done, so none of
+    them returns before fn has finished.
+*/
+static void rvcrypto_once(int * state, void (*fn)(void)) {
+    int expect = 0;
+
+    if(__atomic_load_n(state, __ATOMIC_ACQUIRE) == 2) {
+        return;
+    }
+
+    if(__atomic_compare_exchange_n(state, &expect, 1, 0,
+                                   __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+        fn();
+        __atomic_store_n(state, 2, __ATOMIC_RELEASE);
+        return;
+    }
+
+    while(__atomic_load_n(state, __ATOMIC_ACQUIRE) != 2) {
+        // Wait for the thread running fn.
+    }
+}
+
+static int rvcrypto_first_bind_state = 0;
+
+//! Probe and bind the table for the detected extensions.
+static void rvcrypto_first_bind() {
+    rvcrypto_dispatch_init(rvcrypto_isa());
+}
+
+//
+// First-use stubs. RVCRYPTO_STUB_VOID for the X entries of the function
+// lists, RVCRYPTO_STUB_VALUE for the R entries, which return a result.
+#define RVCRYPTO_STUB_VOID(RET, NAME, PARAMS, ARGS)                     \
+    static RET rvcrypto_stub_ ## NAME PARAMS {                          \
+        rvcrypto_once(&rvcrypto_first_bind_state, rvcrypto_first_bind); \
+        __atomic_load_n(&rvcrypto_dispatch.NAME,                        \
+                        __ATOMIC_ACQUIRE) ARGS;                         \
+    }
+
+#define RVCRYPTO_STUB_VALUE(RET, NAME, PARAMS, ARGS)                    \
+    static RET rvcrypto_stub_ ## NAME PARAMS {                          \
+        rvcrypto_once(&rvcrypto_first_bind_state, rvcrypto_first_bind); \
+        return __atomic_load_n(&rvcrypto_dispatch.NAME,                 \
+                               __ATOMIC_ACQUIRE) ARGS;                  \
+    }
+
+RVCRYPTO_DISPATCH_ALL(RVCRYPTO_STUB_VOID, RVCRYPTO_STUB_VALUE)
+
+#define RVCRYPTO_STUB_INIT(RET, NAME, PARAMS, ARGS) \
+    .NAME = rvcrypto_stub_ ## NAME,
+
+rvcrypto_dispatch_t rvcrypto_dispatch = {
+    RVCRYPTO_DISPATCH_ALL(RVCRYPTO_STUB_INIT, RVCRYPTO_STUB_INIT)
+    .aes_backend    = "unbound",
+    .sha256_backend = "unbound",
+    .sha512_backend = "unbound",
+    .sha3_backend   = "unbound",
+    .sm3_backend    = "unbound",
+    .sm4_backend    = "unbound",
+};
+
+#if defined(__riscv) && defined(__linux__)
+
+//
+// riscv_hwprobe, from <asm/hwprobe.h>. Defined here so that older kernel
+// headers still build; older kernels return an error or leave bits clear.
+#ifndef __NR_riscv_hwprobe
+#define __NR_riscv_hwprobe              258
+#endif
+#define RISCV_HWPROBE_KEY_IMA_EXT_0     4
+#define RISCV_HWPROBE_EXT_ZBKB          (1ULL <<  8)
+#define RISCV_HWPROBE_EXT_ZBKC          (1ULL <<  9)
+#define RISCV_HWPROBE_EXT_ZBKX          (1ULL << 10)
+#define RISCV_HWPROBE_EXT_ZKND          (1ULL << 11)
+#define RISCV_HWPROBE_EXT_ZKNE          (1ULL << 12)
+#define RISCV_HWPROBE_EXT_ZKNH          (1ULL << 13)
+#define RISCV_HWPROBE_EXT_ZKSED         (1ULL << 14)
+#define RISCV_HWPROBE_EXT_ZKSH          (1ULL << 15)
+
+struct rvcrypto_hwprobe {
+    int64_t  key;
+    uint64_t value;
+};
+
+/*!
+@brief Ask the kernel for the extensions of every hart.
+@details The scalar crypto bits of RISCV_HWPROBE_KEY_IMA_EXT_0 were added
+    in Linux 6.8. Older kernels which have riscv_hwprobe report the key,
+    but leave those bits clear whatever the hardware has, so their answer
+    does not count.
+@param [out] isa - Mask of RVCRYPTO_ISA_* bits, set when this returns 0.
+@returns 0 if the kernel answered, non-zero if the call failed (e.g. with
+    ENOSYS) or the kernel does not know the crypto extension bits.
+*/
+static int rvcrypto_isa_hwprobe(uint32_t * isa) {
+    struct rvcrypto_hwprobe p = {RISCV_HWPROBE_KEY_IMA_EXT_0, 0};
+    struct utsname          u;
+    int                     major = 0, minor = 0;
+
+    if(syscall(__NR_riscv_hwprobe, &p, 1, 0, NULL, 0) != 0 || p.key < 0) {
+        return 1;
+    }
+
+    if(uname(&u) != 0 || sscanf(u.release, "%d.%d", &major, &minor) != 2 ||
+       major < 6 || (major == 6 && minor < 8)) {
+        return 1;
+    }
+
+    *isa = 0;
+    if(p.value & RISCV_HWPROBE_EXT_ZBKB ) *isa |= RVCRYPTO_ISA_ZBKB ;
+    if(p.value & RISCV_HWPROBE_EXT_ZBKC ) *isa |= RVCRYPTO_ISA_ZBKC ;
+    if(p.value & RISCV_HWPROBE_EXT_ZBKX ) *isa |= RVCRYPTO_ISA_ZBKX ;
+    if(p.value & RISCV_HWPROBE_EXT_ZKND ) *isa |= RVCRYPTO_ISA_ZKND ;
+    if(p.value & RISCV_HWPROBE_EXT_ZKNE ) *isa |= RVCRYPTO_ISA_ZKNE ;
+    if(p.value & RISCV_HWPROBE_EXT_ZKNH ) *isa |= RVCRYPTO_ISA_ZKNH ;
+    if(p.value & RISCV_HWPROBE_EXT_ZKSED) *isa |= RVCRYPTO_ISA_ZKSED;
+    if(p.value & RISCV_HWPROBE_EXT_ZKSH ) *isa |= RVCRYPTO_ISA_ZKSH ;
+
+    return 0;
+}
+
+//
+// The handler is process wide, but only the probing thread has a jump
+// buffer to go back to. A SIGILL on any other thread puts the previous
+// disposition back, and returning re-runs the faulting instruction under it.
+static _Thread_local sigjmp_buf rvcrypto_probe_env;
+static _Thread_local int        rvcrypto_probe_active = 0;
+static struct sigaction         rvcrypto_probe_old;
+
+static void rvcrypto_probe_sigill(int sig) {
+    if(rvcrypto_probe_active) {
+        siglongjmp(rvcrypto_probe_env, 1);
+    }
+    sigaction(SIGILL, &rvcrypto_probe_old, NULL);
+}
+
+//
+// Run INSN, and set BIT in isa if it does not raise SIGILL. The
+// instructions are given as .insn so the probe builds for any -march.
+#define RVCRYPTO_PROBE(BIT, INSN)                                       \
+    if(sigsetjmp(rvcrypto_probe_env, 1) == 0) {                         \
+        __asm__ volatile (INSN ::: "a0");                               \
+        isa |= BIT;                                                     \
+    }
+
+#if __riscv_xlen == 64
+#define RVCRYPTO_INSN_ZKNE ".insn r 0x33, 0, 0x19, a0, a0, a0" // aes64es
+#define RVCRYPTO_INSN_ZKND ".insn r 0x33, 0, 0x1d, a0, a0, a0" // aes64ds
+#else
+#define RVCRYPTO_INSN_ZKNE ".insn r 0x33, 0, 0x11, a0, a0, a0" // aes32esi
+#define RVCRYPTO_INSN_ZKND ".insn r 0x33, 0, 0x15, a0, a0, a0" // aes32dsi
+#endif
+
+static int      rvcrypto_sigill_state = 0;
+static uint32_t rvcrypto_sigill_isa   = 0;
+
+/*!
+@brief Try one instruction from each extension under a SIGILL handler.
+@details Run once, through rvcrypto_once, so that threads never swap the
+    SIGILL disposition under each other.
+*/
+static void rvcrypto_isa_sigill_once() {
+    volatile uint32_t isa = 0;
+    struct sigaction  sa;
+
+    sa.sa_handler = rvcrypto_probe_sigill;
+    sa.sa_flags   = 0;
+    sigemptyset(&sa.sa_mask);
+
+    if(sigaction(SIGILL, &sa, &rvcrypto_probe_old) != 0) {
+        return;
+    }
+
+    rvcrypto_probe_active = 1;
+
+    RVCRYPTO_PROBE(RVCRYPTO_ISA_ZBKB , ".insn r 0x33, 4, 0x04, a0, a0, a0")
+    RVCRYPTO_PROBE(RVCRYPTO_ISA_ZBKC , ".insn r 0x33, 1, 0x05, a0, a0, a0")
+    RVCRYPTO_PROBE(RVCRYPTO_ISA_ZBKX , ".insn r 0x33, 4, 0x14, a0, a0, a0")
+    RVCRYPTO_PROBE(RVCRYPTO_ISA_ZKNE , RVCRYPTO_INSN_ZKNE)
+    RVCRYPTO_PROBE(RVCRYPTO_ISA_ZKND , RVCRYPTO_INSN_ZKND)
+    RVCRYPTO_PROBE(RVCRYPTO_ISA_ZKNH , ".insn i 0x13, 1, a0, a0, 0x102")
+    RVCRYPTO_PROBE(RVCRYPTO_ISA_ZKSED, ".insn r 0x33, 0, 0x18, a0, a0, a0")
+    RVCRYPTO_PROBE(RVCRYPTO_ISA_ZKSH , ".insn i 0x13, 1, a0, a0, 0x108")
+
+    rvcrypto_probe_active = 0;
+
+    sigaction(SIGILL, &rvcrypto_probe_old, NULL);
+
+    rvcrypto_sigill_isa = isa;
+}
+
+//! rvcrypto_isa_sigill_once, run once and cached.
+static uint32_t rvcrypto_isa_sigill() {
+    rvcrypto_once(&rvcrypto_sigill_state, rvcrypto_isa_sigill_once);
+    return rvcrypto_sigill_isa;
+}
+
+uint32_t rvcrypto_isa_probe() {
+    uint32_t isa = 0;
+    if(rvcrypto_isa_hwprobe(&isa) != 0) {
+        // No hwprobe, or a kernel which predates the scalar crypto bits.
+        // A kernel which answers with none of them set is believed.
+        isa = rvcrypto_isa_sigill();
+    }
+    return isa;
+}
+
+#else
+
+uint32_t rvcrypto_isa_probe() {
+#if defined(__ZSCRYPTO)
+    return RVCRYPTO_ISA_ALL;
+#else
+    return 0;
+#endif
+}
+
+#endif
+
+static int      rvcrypto_isa_state = 0;
+static uint32_t rvcrypto_isa_mask  = 0;
+
+static void rvcrypto_isa_once() {
+    rvcrypto_isa_mask = rvcrypto_isa_probe();
+}
+
+uint32_t rvcrypto_isa() {
+    rvcrypto_once(&rvcrypto_isa_state, rvcrypto_isa_once);
+    return rvcrypto_isa_mask;
+}
+
+//! @}
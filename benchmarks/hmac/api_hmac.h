@@ -0,0 +1,112 @@
+#include <stddef.h>
+#include <stdint.h>
+
+#include "riscvcrypto/sha256/api_sha256.h"
+#include "riscvcrypto/sha512/api_sha512.h"
+
+/*!
+@defgroup crypto_mac_hmac Crypto MAC HMAC
+@brief HMAC-SHA256, HMAC-SHA384 and HMAC-SHA512, as per FIPS 198-1.
+@details The key is absorbed once, into a key context holding the
+    chaining values after the ipad block and after the opad block. Each
+    MAC then starts from those midstates, so it costs only the message
+    blocks plus a single outer block, rather than two extra compressions
+    for the pads.
+    Built on whichever SHA-256 and SHA-512 backends are linked in.
+@{
+*/
+
+#ifndef __API_HMAC_H__
+#define __API_HMAC_H__
+
+//! Number of bytes in an HMAC-SHA256 tag.
+#define HMAC_SHA256_BYTES   SHA256_DIGEST_BYTES
+
+//! Number of bytes in an HMAC-SHA384 tag.
+#define HMAC_SHA384_BYTES   SHA384_DIGEST_BYTES
+
+//! Number of bytes in an HMAC-SHA512 tag.
+#define HMAC_SHA512_BYTES   SHA512_DIGEST_BYTES
+
+//! Precomputed HMAC-SHA256 key.
+typedef struct {
+    uint32_t    inner [8]; //!< Chaining value after the K ^ ipad block.
+    uint32_t    outer [8]; //!< Chaining value after the K ^ opad block.
+} hmac_sha256_key_t;
+
+//! Precomputed HMAC-SHA384 or HMAC-SHA512 key.
+typedef struct {
+    uint64_t    inner [8]; //!< Chaining value after the K ^ ipad block.
+    uint64_t    outer [8]; //!< Chaining value after the K ^ opad block.
+    size_t      mac_bytes; //!< HMAC_SHA384_BYTES or HMAC_SHA512_BYTES
+} hmac_sha512_key_t;
+
+/*!
+@brief Compute the ipad and opad midstates of an HMAC-SHA256 key.
+@details Keys longer than a block are hashed first, as FIPS 198-1 says.
+*/
+void hmac_sha256_key_init (
+    hmac_sha256_key_t * key , //!< out - Key context.
+    uint8_t           * k   , //!< in - Key bytes.
+    size_t              klen  //!< Length of k in bytes.
+);
+
+//! Begin an HMAC-SHA256 computation. Absorb the message with sha256_update
+void hmac_sha256_init (
+    sha256_ctx_t      * ctx , //!< out - Hash context.
+    hmac_sha256_key_t * key   //!< in - Key context.
+);
+
+//! Finish an HMAC-SHA256 computation, with the single outer block.
+void hmac_sha256_final (
+    sha256_ctx_t      * ctx , //!< in - Hash context.
+    hmac_sha256_key_t * key , //!< in - Key context given to init.
+    uint8_t           * mac   //!< out - HMAC_SHA256_BYTES tag.
+);
+
+//! Compute the HMAC-SHA256 of a whole message.
+void hmac_sha256 (
+    uint8_t             mac [HMAC_SHA256_BYTES], //!< out - Tag.
+    hmac_sha256_key_t * key , //!< in - Key context.
+    uint8_t           * M   , //!< in - Message.
+    size_t              len   //!< Length of M in bytes.
+);
+
+//! As hmac_sha256_key_init, for HMAC-SHA384.
+void hmac_sha384_key_init (
+    hmac_sha512_key_t * key , //!< out - Key context.
+    uint8_t           * k   , //!< in - Key bytes.
+    size_t              klen  //!< Length of k in bytes.
+);
+
+//! As hmac_sha256_key_init, for HMAC-SHA512.
+void hmac_sha512_key_init (
+    hmac_sha512_key_t * key , //!< out - Key context.
+    uint8_t           * k   , //!< in - Key bytes.
+    size_t              klen  //!< Length of k in bytes.
+);
+
+//! Begin an HMAC-SHA384/512 computation. Absorb with sha512_update.
+void hmac_sha512_init (
+    sha512_ctx_t      * ctx , //!< out - Hash context.
+    hmac_sha512_key_t * key   //!< in - Key context.
+);
+
+//! Finish an HMAC-SHA384/512 computation, with the single outer block.
+void hmac_sha512_final (
+    sha512_ctx_t      * ctx , //!< in - Hash context.
+    hmac_sha512_key_t * key , //!< in - Key context given to init.
+    uint8_t           * mac   //!< out - key->mac_bytes tag.
+);
+
+//! Compute the HMAC-SHA384 or HMAC-SHA512 (per the key) of a message.
+void hmac_sha512 (
+    uint8_t           * mac , //!< out - key->mac_bytes tag.
+    hmac_sha512_key_t * key , //!< in - Key context.
+    uint8_t           * M   , //!< in - Message.
+    size_t              len   //!< Length of M in bytes.
+);
+
+#endif // __API_HMAC_H__
+
+//! @}
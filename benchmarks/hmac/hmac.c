@@ -0,0 +1,176 @@
+/*!
+@addtogroup crypto_mac_hmac
+@{
+*/
+
+#include <string.h>
+
+#include "riscvcrypto/hmac/api_hmac.h"
+
+//! Inner and outer pad bytes.
+#define HMAC_IPAD 0x36
+#define HMAC_OPAD 0x5c
+
+void hmac_sha256_key_init (
+    hmac_sha256_key_t * key ,
+    uint8_t           * k   ,
+    size_t              klen
+){
+    uint8_t      k0  [SHA256_BLOCK_BYTES] = {0};
+    uint8_t      pad [SHA256_BLOCK_BYTES];
+    sha256_ctx_t ctx;
+
+    if(klen > SHA256_BLOCK_BYTES) {     // Long keys are hashed first.
+        sha256_hash((uint32_t*)k0, k, klen);
+    } else {
+        memcpy(k0, k, klen);
+    }
+
+    for(int i = 0; i < SHA256_BLOCK_BYTES; i ++) {
+        pad[i] = k0[i] ^ HMAC_IPAD;
+    }
+    sha256_init  (&ctx);
+    sha256_update(&ctx, pad, SHA256_BLOCK_BYTES);
+    memcpy(key->inner, ctx.H, sizeof(key->inner));
+
+    for(int i = 0; i < SHA256_BLOCK_BYTES; i ++) {
+        pad[i] = k0[i] ^ HMAC_OPAD;
+    }
+    sha256_init  (&ctx);
+    sha256_update(&ctx, pad, SHA256_BLOCK_BYTES);
+    memcpy(key->outer, ctx.H, sizeof(key->outer));
+}
+
+void hmac_sha256_init (
+    sha256_ctx_t      * ctx ,
+    hmac_sha256_key_t * key
+){
+    sha256_init(ctx);                   // Resume after the ipad block.
+    memcpy(ctx->H, key->inner, sizeof(key->inner));
+    ctx->len = SHA256_BLOCK_BYTES;
+}
+
+void hmac_sha256_final (
+    sha256_ctx_t      * ctx ,
+    hmac_sha256_key_t * key ,
+    uint8_t           * mac
+){
+    uint8_t      inner [SHA256_DIGEST_BYTES];
+
+    sha256_final(ctx, inner);
+
+    sha256_init(ctx);                   // Resume after the opad block.
+    memcpy(ctx->H, key->outer, sizeof(key->outer));
+    ctx->len = SHA256_BLOCK_BYTES;
+
+    sha256_update(ctx, inner, SHA256_DIGEST_BYTES);
+    sha256_final (ctx, mac);            // Inner hash + padding: one block.
+}
+
+void hmac_sha256 (
+    uint8_t             mac [HMAC_SHA256_BYTES],
+    hmac_sha256_key_t * key ,
+    uint8_t           * M   ,
+    size_t              len
+){
+    sha256_ctx_t ctx;
+    hmac_sha256_init (&ctx, key);
+    sha256_update    (&ctx, M, len);
+    hmac_sha256_final(&ctx, key, mac);
+}
+
+typedef void (*sha512_init_t)(sha512_ctx_t * ctx);
+
+//! Shared by the SHA-384 and SHA-512 key set up, which differ by init.
+static void hmac_sha512_key_init_with (
+    hmac_sha512_key_t * key ,
+    uint8_t           * k   ,
+    size_t              klen,
+    sha512_init_t       init
+){
+    uint8_t      k0  [SHA512_BLOCK_BYTES] = {0};
+    uint8_t      pad [SHA512_BLOCK_BYTES];
+    sha512_ctx_t ctx;
+
+    init(&ctx);
+    key->mac_bytes = ctx.digest_bytes;
+
+    if(klen > SHA512_BLOCK_BYTES) {     // Long keys are hashed first.
+        sha512_update(&ctx, k, klen);
+        sha512_final (&ctx, k0);
+    } else {
+        memcpy(k0, k, klen);
+    }
+
+    for(int i = 0; i < SHA512_BLOCK_BYTES; i ++) {
+        pad[i] = k0[i] ^ HMAC_IPAD;
+    }
+    init(&ctx);
+    sha512_update(&ctx, pad, SHA512_BLOCK_BYTES);
+    memcpy(key->inner, ctx.H, sizeof(key->inner));
+
+    for(int i = 0; i < SHA512_BLOCK_BYTES; i ++) {
+        pad[i] = k0[i] ^ HMAC_OPAD;
+    }
+    init(&ctx);
+    sha512_update(&ctx, pad, SHA512_BLOCK_BYTES);
+    memcpy(key->outer, ctx.H, sizeof(key->outer));
+}
+
+void hmac_sha384_key_init (
+    hmac_sha512_key_t * key ,
+    uint8_t           * k   ,
+    size_t              klen
+){
+    hmac_sha512_key_init_with(key, k, klen, sha384_init);
+}
+
+void hmac_sha512_key_init (
+    hmac_sha512_key_t * key ,
+    uint8_t           * k   ,
+    size_t              klen
+){
+    hmac_sha512_key_init_with(key, k, klen, sha512_init);
+}
+
+void hmac_sha512_init (
+    sha512_ctx_t      * ctx ,
+    hmac_sha512_key_t * key
+){
+    sha512_init(ctx);                   // Resume after the ipad block.
+    memcpy(ctx->H, key->inner, sizeof(key->inner));
+    ctx->len_lo       = SHA512_BLOCK_BYTES;
+    ctx->digest_bytes = key->mac_bytes;
+}
+
+void hmac_sha512_final (
+    sha512_ctx_t      * ctx ,
+    hmac_sha512_key_t * key ,
+    uint8_t           * mac
+){
+    uint8_t      inner [SHA512_DIGEST_BYTES];
+
+    sha512_final(ctx, inner);
+
+    sha512_init(ctx);                   // Resume after the opad block.
+    memcpy(ctx->H, key->outer, sizeof(key->outer));
+    ctx->len_lo       = SHA512_BLOCK_BYTES;
+    ctx->digest_bytes = key->mac_bytes;
+
+    sha512_update(ctx, inner, key->mac_bytes);
+    sha512_final (ctx, mac);            // Inner hash + padding: one block.
+}
+
+void hmac_sha512 (
+    uint8_t           * mac ,
+    hmac_sha512_key_t * key ,
+    uint8_t           * M   ,
+    size_t              len
+){
+    sha512_ctx_t ctx;
+    hmac_sha512_init (&ctx, key);
+    sha512_update    (&ctx, M, len);
+    hmac_sha512_final(&ctx, key, mac);
+}
+
+//! @}
@@ -0,0 +1,98 @@
+#include <stddef.h>
+#include <stdint.h>
+
+#include "riscvcrypto/hmac/api_hmac.h"
+
+/*!
+@defgroup crypto_kdf Crypto KDF
+@brief PBKDF2 (RFC 8018) and HKDF (RFC 5869) over HMAC-SHA256 and
+    HMAC-SHA512.
+@details PBKDF2 spends nearly all of its time in the iteration
+    U_j = HMAC(P, U_{j-1}), which always hashes one digest-sized input.
+    The password's pad midstates are computed once. The padding and
+    length words of the inner and outer blocks are written once, and
+    each compression's output lands directly in the first words of the
+    next compression's input block. An iteration is then exactly two
+    compressions with no byte order conversion, no buffering and no
+    copies beyond reloading the two midstates.
+@{
+*/
+
+#ifndef __API_KDF_H__
+#define __API_KDF_H__
+
+/*!
+@brief Derive dklen bytes with PBKDF2-HMAC-SHA256.
+@returns 0 on success, non-zero if iterations is 0.
+*/
+int pbkdf2_hmac_sha256 (
+    uint8_t   * dk        , //!< out - Derived key.
+    size_t      dklen     , //!< Length of dk in bytes.
+    uint8_t   * P         , //!< in - Password.
+    size_t      plen      , //!< Length of P in bytes.
+    uint8_t   * S         , //!< in - Salt.
+    size_t      slen      , //!< Length of S in bytes.
+    uint32_t    iterations  //!< Iteration count, at least 1.
+);
+
+/*!
+@brief Derive dklen bytes with PBKDF2-HMAC-SHA512.
+@returns 0 on success, non-zero if iterations is 0.
+*/
+int pbkdf2_hmac_sha512 (
+    uint8_t   * dk        , //!< out - Derived key.
+    size_t      dklen     , //!< Length of dk in bytes.
+    uint8_t   * P         , //!< in - Password.
+    size_t      plen      , //!< Length of P in bytes.
+    uint8_t   * S         , //!< in - Salt.
+    size_t      slen      , //!< Length of S in bytes.
+    uint32_t    iterations  //!< Iteration count, at least 1.
+);
+
+//! HKDF-Extract with HMAC-SHA256. An empty salt means HashLen zeros.
+void hkdf_sha256_extract (
+    uint8_t     prk [SHA256_DIGEST_BYTES], //!< out - Pseudorandom key.
+    uint8_t   * salt    , //!< in - Optional salt.
+    size_t      saltlen , //!< Length of salt in bytes. May be 0.
+    uint8_t   * ikm     , //!< in - Input keying material.
+    size_t      ikmlen    //!< Length of ikm in bytes.
+);
+
+/*!
+@brief HKDF-Expand with HMAC-SHA256.
+@returns 0 on success, non-zero if okmlen is over 255 * HashLen.
+*/
+int hkdf_sha256_expand (
+    uint8_t   * okm     , //!< out - Output keying material.
+    size_t      okmlen  , //!< Length of okm in bytes.
+    uint8_t   * prk     , //!< in - Pseudorandom key.
+    size_t      prklen  , //!< Length of prk, at least SHA256_DIGEST_BYTES.
+    uint8_t   * info    , //!< in - Optional context information.
+    size_t      infolen   //!< Length of info in bytes. May be 0.
+);
+
+//! HKDF-Extract with HMAC-SHA512. An empty salt means HashLen zeros.
+void hkdf_sha512_extract (
+    uint8_t     prk [SHA512_DIGEST_BYTES], //!< out - Pseudorandom key.
+    uint8_t   * salt    , //!< in - Optional salt.
+    size_t      saltlen , //!< Length of salt in bytes. May be 0.
+    uint8_t   * ikm     , //!< in - Input keying material.
+    size_t      ikmlen    //!< Length of ikm in bytes.
+);
+
+/*!
+@brief HKDF-Expand with HMAC-SHA512.
+@returns 0 on success, non-zero if okmlen is over 255 * HashLen.
+*/
+int hkdf_sha512_expand (
+    uint8_t   * okm     , //!< out - Output keying material.
+    size_t      okmlen  , //!< Length of okm in bytes.
+    uint8_t   * prk     , //!< in - Pseudorandom key.
+    size_t      prklen  , //!< Length of prk, at least SHA512_DIGEST_BYTES.
+    uint8_t   * info    , //!< in - Optional context information.
+    size_t      infolen   //!< Length of info in bytes. May be 0.
+);
+
+#endif // __API_KDF_H__
+
+//! @}
@@ -0,0 +1,112 @@
+/*!
+@addtogroup crypto_kdf
+@{
+*/
+
+#include <string.h>
+
+#include "riscvcrypto/kdf/api_kdf.h"
+
+void hkdf_sha256_extract (
+    uint8_t     prk [SHA256_DIGEST_BYTES],
+    uint8_t   * salt    ,
+    size_t      saltlen ,
+    uint8_t   * ikm     ,
+    size_t      ikmlen
+){
+    hmac_sha256_key_t key;              // An empty key is zero padded, so
+    hmac_sha256_key_init(&key, salt, saltlen); // equals HashLen zeros.
+    hmac_sha256(prk, &key, ikm, ikmlen);
+}
+
+int hkdf_sha256_expand (
+    uint8_t   * okm     ,
+    size_t      okmlen  ,
+    uint8_t   * prk     ,
+    size_t      prklen  ,
+    uint8_t   * info    ,
+    size_t      infolen
+){
+    hmac_sha256_key_t key;
+    sha256_ctx_t      ctx;
+    uint8_t           t [SHA256_DIGEST_BYTES];
+    uint8_t           i = 1;
+
+    if(okmlen > 255 * SHA256_DIGEST_BYTES) {
+        return 1;
+    }
+
+    hmac_sha256_key_init(&key, prk, prklen); // Midstates shared by all T(i)
+
+    while(okmlen > 0) {                 // T(i) = HMAC(PRK, T(i-1)|info|i)
+        hmac_sha256_init(&ctx, &key);
+        if(i > 1) {
+            sha256_update(&ctx, t, SHA256_DIGEST_BYTES);
+        }
+        sha256_update    (&ctx, info, infolen);
+        sha256_update    (&ctx, &i  , 1);
+        hmac_sha256_final(&ctx, &key, t);
+
+        size_t take = okmlen < SHA256_DIGEST_BYTES ? okmlen : SHA256_DIGEST_BYTES;
+        memcpy(okm, t, take);
+
+        okm    += take;
+        okmlen -= take;
+        i      += 1;
+    }
+
+    return 0;
+}
+
+void hkdf_sha512_extract (
+    uint8_t     prk [SHA512_DIGEST_BYTES],
+    uint8_t   * salt    ,
+    size_t      saltlen ,
+    uint8_t   * ikm     ,
+    size_t      ikmlen
+){
+    hmac_sha512_key_t key;
+    hmac_sha512_key_init(&key, salt, saltlen);
+    hmac_sha512(prk, &key, ikm, ikmlen);
+}
+
+int hkdf_sha512_expand (
+    uint8_t   * okm     ,
+    size_t      okmlen  ,
+    uint8_t   * prk     ,
+    size_t      prklen  ,
+    uint8_t   * info    ,
+    size_t      infolen
+){
+    hmac_sha512_key_t key;
+    sha512_ctx_t      ctx;
+    uint8_t           t [SHA512_DIGEST_BYTES];
+    uint8_t           i = 1;
+
+    if(okmlen > 255 * SHA512_DIGEST_BYTES) {
+        return 1;
+    }
+
+    hmac_sha512_key_init(&key, prk, prklen);
+
+    while(okmlen > 0) {
+        hmac_sha512_init(&ctx, &key);
+        if(i > 1) {
+            sha512_update(&ctx, t, SHA512_DIGEST_BYTES);
+        }
+        sha512_update    (&ctx, info, infolen);
+        sha512_update    (&ctx, &i  , 1);
+        hmac_sha512_final(&ctx, &key, t);
+
+        size_t take = okmlen < SHA512_DIGEST_BYTES ? okmlen : SHA512_DIGEST_BYTES;
+        memcpy(okm, t, take);
+
+        okm    += take;
+        okmlen -= take;
+        i      += 1;
+    }
+
+    return 0;
+}
+
+//! @}
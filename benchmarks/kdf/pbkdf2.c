@@ -0,0 +1,166 @@
+/*!
+@addtogroup crypto_kdf
+@{
+*/
+
+#include <string.h>
+
+#include "riscvcrypto/kdf/api_kdf.h"
+
+//! Write a 32-bit block index big-endian, as INT(i) in RFC 8018.
+static void pbkdf2_int32_be(uint8_t out[4], uint32_t i) {
+    out[0] = i >> 24;
+    out[1] = i >> 16;
+    out[2] = i >>  8;
+    out[3] = i >>  0;
+}
+
+int pbkdf2_hmac_sha256 (
+    uint8_t   * dk        ,
+    size_t      dklen     ,
+    uint8_t   * P         ,
+    size_t      plen      ,
+    uint8_t   * S         ,
+    size_t      slen      ,
+    uint32_t    iterations
+){
+    hmac_sha256_key_t key;
+    sha256_ctx_t      ctx;
+    uint8_t           u   [SHA256_DIGEST_BYTES];
+    uint8_t           idx [4];
+    uint32_t          T   [8];
+
+    /*
+    Win is the inner block: U_{j-1} then padding for a 64 + 32 byte
+    message. Wout is the outer block, whose first 8 words double as the
+    chaining value of the inner compression, and Win's as the chaining
+    value of the outer one. So each output is already in place.
+    */
+    uint32_t          Win [16] = {0};
+    uint32_t          Wout[16] = {0};
+
+    if(iterations == 0) {
+        return 1;
+    }
+
+    Win [ 8] = 0x80000000;
+    Wout[ 8] = 0x80000000;
+    Win [15] = (SHA256_BLOCK_BYTES + SHA256_DIGEST_BYTES) * 8;
+    Wout[15] = (SHA256_BLOCK_BYTES + SHA256_DIGEST_BYTES) * 8;
+
+    hmac_sha256_key_init(&key, P, plen);
+
+    for(uint32_t block = 1; dklen > 0; block ++) {
+
+        pbkdf2_int32_be(idx, block);    // U_1 = HMAC(P, S || INT(i))
+
+        hmac_sha256_init (&ctx, &key);
+        sha256_update    (&ctx, S  , slen);
+        sha256_update    (&ctx, idx, 4);
+        hmac_sha256_final(&ctx, &key, u);
+
+        for(int i = 0; i < 8; i ++) {
+            Win[i] = ((uint32_t)u[4*i+0] << 24) | ((uint32_t)u[4*i+1] << 16) |
+                     ((uint32_t)u[4*i+2] <<  8) | ((uint32_t)u[4*i+3] <<  0) ;
+            T  [i] = Win[i];
+        }
+
+        for(uint32_t j = 1; j < iterations; j ++) {
+            memcpy(Wout, key.inner, sizeof(key.inner));
+            sha256_hash_block_words(Wout, Win );
+
+            memcpy(Win , key.outer, sizeof(key.outer));
+            sha256_hash_block_words(Win , Wout);
+
+            for(int i = 0; i < 8; i ++) {
+                T[i] ^= Win[i];
+            }
+        }
+
+        size_t take = dklen < SHA256_DIGEST_BYTES ? dklen : SHA256_DIGEST_BYTES;
+
+        for(size_t i = 0; i < take; i ++) {
+            dk[i] = T[i / 4] >> (24 - 8 * (i % 4));
+        }
+
+        dk    += take;
+        dklen -= take;
+    }
+
+    return 0;
+}
+
+int pbkdf2_hmac_sha512 (
+    uint8_t   * dk        ,
+    size_t      dklen     ,
+    uint8_t   * P         ,
+    size_t      plen      ,
+    uint8_t   * S         ,
+    size_t      slen      ,
+    uint32_t    iterations
+){
+    hmac_sha512_key_t key;
+    sha512_ctx_t      ctx;
+    uint8_t           u   [SHA512_DIGEST_BYTES];
+    uint8_t           idx [4];
+    uint64_t          T   [8];
+
+    // As for SHA-256. The 128-bit length's upper word, Win[14], is zero.
+    uint64_t          Win [16] = {0};
+    uint64_t          Wout[16] = {0};
+
+    if(iterations == 0) {
+        return 1;
+    }
+
+    Win [ 8] = 0x8000000000000000ULL;
+    Wout[ 8] = 0x8000000000000000ULL;
+    Win [15] = (SHA512_BLOCK_BYTES + SHA512_DIGEST_BYTES) * 8;
+    Wout[15] = (SHA512_BLOCK_BYTES + SHA512_DIGEST_BYTES) * 8;
+
+    hmac_sha512_key_init(&key, P, plen);
+
+    for(uint32_t block = 1; dklen > 0; block ++) {
+
+        pbkdf2_int32_be(idx, block);    // U_1 = HMAC(P, S || INT(i))
+
+        hmac_sha512_init (&ctx, &key);
+        sha512_update    (&ctx, S  , slen);
+        sha512_update    (&ctx, idx, 4);
+        hmac_sha512_final(&ctx, &key, u);
+
+        for(int i = 0; i < 8; i ++) {
+            uint64_t w = 0;
+            for(int b = 0; b < 8; b ++) {
+                w = (w << 8) | u[8*i + b];
+            }
+            Win[i] = w;
+            T  [i] = w;
+        }
+
+        for(uint32_t j = 1; j < iterations; j ++) {
+            memcpy(Wout, key.inner, sizeof(key.inner));
+            sha512_hash_block_words(Wout, Win );
+
+            memcpy(Win , key.outer, sizeof(key.outer));
+            sha512_hash_block_words(Win , Wout);
+
+            for(int i = 0; i < 8; i ++) {
+                T[i] ^= Win[i];
+            }
+        }
+
+        size_t take = dklen < SHA512_DIGEST_BYTES ? dklen : SHA512_DIGEST_BYTES;
+
+        for(size_t i = 0; i < take; i ++) {
+            dk[i] = T[i / 8] >> (56 - 8 * (i % 8));
+        }
+
+        dk    += take;
+        dklen -= take;
+    }
+
+    return 0;
+}
+
+//! @}
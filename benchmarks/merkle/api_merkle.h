@@ -0,0 +1,131 @@
+#include <stddef.h>
+#include <stdint.h>
+
+#include "riscvcrypto/sha256/api_sha256.h"
+
+/*!
+@defgroup crypto_merkle Crypto Merkle Tree
+@brief Binary SHA-256 Merkle trees over fixed-size storage chunks.
+@details A leaf is the SHA-256 digest of its chunk. An internal node is
+    the SHA-256 digest of its two children, left then right. A node with
+    no sibling, the last one of an odd-length level, is carried up to the
+    next level unchanged.
+
+    Internal nodes always hash exactly 64 bytes, so they go through
+    merkle_sha256_hash_64: one compression of the children and one of a
+    constant padding block, with none of the buffering or length
+    bookkeeping of sha256_hash.
+
+    A tree is built one level at a time. The pairs of each level are
+    handed to a merkle_kernel_t in batches of at most MERKLE_BATCH_PAIRS,
+    so a multi-buffer or vector kernel can hash several nodes at once.
+@{
+*/
+
+#ifndef __API_MERKLE_H__
+#define __API_MERKLE_H__
+
+//! Size of a tree node in bytes.
+#define MERKLE_NODE_BYTES   SHA256_DIGEST_BYTES
+
+//! Most levels a tree can have, leaves included.
+#define MERKLE_MAX_LEVELS   48
+
+//! Most pairs passed to a merkle_kernel_t in one call.
+#define MERKLE_BATCH_PAIRS  16
+
+/*!
+@brief Hash npairs adjacent pairs of nodes into their parents.
+@details in holds 2*npairs nodes, out receives npairs. npairs is never
+    more than MERKLE_BATCH_PAIRS.
+*/
+typedef void (*merkle_kernel_t)(
+    uint8_t   * out   , //!< out - npairs parent nodes.
+    uint8_t   * in    , //!< in - 2*npairs child nodes.
+    size_t      npairs  //!< Number of pairs.
+);
+
+//! A Merkle tree, stored level by level in caller supplied memory.
+typedef struct {
+    uint8_t       * nodes ; //!< All nodes, leaves first, root last.
+    size_t          levels; //!< Number of levels, leaves included.
+    size_t          start [MERKLE_MAX_LEVELS]; //!< First node of level.
+    size_t          count [MERKLE_MAX_LEVELS]; //!< Nodes in each level.
+    merkle_kernel_t kernel; //!< Hashes the pairs of each level.
+} merkle_tree_t;
+
+//! SHA-256 of exactly 64 bytes: the parent of two nodes.
+void merkle_sha256_hash_64 (
+    uint8_t     out [MERKLE_NODE_BYTES]    , //!< out - Digest.
+    uint8_t     in  [2 * MERKLE_NODE_BYTES]  //!< in - Left then right node.
+);
+
+//! The default merkle_kernel_t: merkle_sha256_hash_64 on each pair.
+void merkle_sha256_pairs (
+    uint8_t   * out   ,
+    uint8_t   * in    ,
+    size_t      npairs
+);
+
+/*!
+@brief A merkle_kernel_t hashing four pairs at a time with
+    sha256_hash_blocks_x4. Link the merkle_mb library, and a SHA-256
+    backend with multi-buffer support, to use it.
+*/
+void merkle_sha256_pairs_x4 (
+    uint8_t   * out   ,
+    uint8_t   * in    ,
+    size_t      npairs
+);
+
+//! Number of nodes, hence MERKLE_NODE_BYTES blocks, a tree needs.
+size_t merkle_tree_nodes (
+    size_t      nleaves //!< Number of leaves.
+);
+
+/*!
+@brief Lay out a tree of nleaves leaves over nodes.
+@details Leaves are set with merkle_tree_set_leaf, then hashed up with
+    merkle_tree_build.
+@returns 0 on success, non-zero if nleaves is 0 or needs too many levels.
+*/
+int merkle_tree_init (
+    merkle_tree_t * tree   , //!< out - Tree.
+    uint8_t       * nodes  , //!< in - merkle_tree_nodes(nleaves) nodes.
+    size_t          nleaves, //!< Number of leaves.
+    merkle_kernel_t kernel   //!< Pair kernel. NULL for merkle_sha256_pairs.
+);
+
+//! Set leaf i to the digest of a chunk, without touching its ancestors.
+void merkle_tree_set_leaf (
+    merkle_tree_t * tree , //!< in,out - Tree.
+    size_t          i    , //!< Leaf index.
+    uint8_t       * chunk, //!< in - Chunk contents.
+    size_t          len    //!< Length of chunk in bytes.
+);
+
+//! Hash every level above the leaves, breadth first.
+void merkle_tree_build (
+    merkle_tree_t * tree   //!< in,out - Tree with all leaves set.
+);
+
+/*!
+@brief Replace leaf i and rehash only its path to the root.
+@details Costs one merkle_sha256_hash_64 per level, rather than the
+    nleaves - 1 of a rebuild.
+*/
+void merkle_tree_update (
+    merkle_tree_t * tree , //!< in,out - Built tree.
+    size_t          i    , //!< Leaf index.
+    uint8_t       * chunk, //!< in - New chunk contents.
+    size_t          len    //!< Length of chunk in bytes.
+);
+
+//! Pointer to the root node of a built tree.
+uint8_t * merkle_tree_root (
+    merkle_tree_t * tree   //!< in - Tree.
+);
+
+#endif // __API_MERKLE_H__
+
+//! @}
@@ -0,0 +1,171 @@
+/*!
+@addtogroup crypto_merkle
+@{
+*/
+
+#include <string.h>
+
+#include "riscvcrypto/merkle/api_merkle.h"
+
+//! SHA-256 initial chaining value.
+static const uint32_t merkle_sha256_iv [8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+/*!
+@brief The second block of every 64-byte message: the 1 bit, zeros, and
+    a length of 512 bits. Held as words, so it is never converted.
+*/
+static const uint32_t merkle_sha256_pad [16] = {
+    0x80000000, 0, 0, 0, 0, 0, 0, 0,
+    0         , 0, 0, 0, 0, 0, 0, 512
+};
+
+void merkle_sha256_hash_64 (
+    uint8_t     out [MERKLE_NODE_BYTES],
+    uint8_t     in  [2 * MERKLE_NODE_BYTES]
+){
+    uint32_t H [8];
+
+    memcpy(H, merkle_sha256_iv, sizeof(H));
+
+    sha256_hash_blocks     (H, in, 1);
+    sha256_hash_block_words(H, merkle_sha256_pad);
+
+    for(int i = 0; i < 8; i ++) {
+        out[4*i+0] = H[i] >> 24;
+        out[4*i+1] = H[i] >> 16;
+        out[4*i+2] = H[i] >>  8;
+        out[4*i+3] = H[i] >>  0;
+    }
+}
+
+void merkle_sha256_pairs (
+    uint8_t   * out   ,
+    uint8_t   * in    ,
+    size_t      npairs
+){
+    for(size_t i = 0; i < npairs; i ++) {
+        merkle_sha256_hash_64(out + i * MERKLE_NODE_BYTES,
+                              in  + i * MERKLE_NODE_BYTES * 2);
+    }
+}
+
+size_t merkle_tree_nodes (
+    size_t      nleaves
+){
+    size_t total = nleaves;
+    while(nleaves > 1) {
+        nleaves = (nleaves + 1) / 2;
+        total  += nleaves;
+    }
+    return total;
+}
+
+int merkle_tree_init (
+    merkle_tree_t * tree   ,
+    uint8_t       * nodes  ,
+    size_t          nleaves,
+    merkle_kernel_t kernel
+){
+    size_t n     = nleaves;
+    size_t start = 0;
+    size_t l     = 0;
+
+    if(nleaves == 0) {
+        return 1;
+    }
+
+    for(;;) {
+        if(l >= MERKLE_MAX_LEVELS) {
+            return 1;
+        }
+        tree->start[l] = start;
+        tree->count[l] = n;
+        start += n;
+        l     += 1;
+        if(n == 1) {
+            break;
+        }
+        n = (n + 1) / 2;
+    }
+
+    tree->nodes  = nodes;
+    tree->levels = l;
+    tree->kernel = kernel ? kernel : merkle_sha256_pairs;
+
+    return 0;
+}
+
+//! Address of node i of level l.
+static inline uint8_t * merkle_node (
+    merkle_tree_t * tree,
+    size_t          l   ,
+    size_t          i
+){
+    return tree->nodes + (tree->start[l] + i) * MERKLE_NODE_BYTES;
+}
+
+void merkle_tree_set_leaf (
+    merkle_tree_t * tree ,
+    size_t          i    ,
+    uint8_t       * chunk,
+    size_t          len
+){
+    sha256_hash((uint32_t*)merkle_node(tree, 0, i), chunk, len);
+}
+
+void merkle_tree_build (
+    merkle_tree_t * tree
+){
+    for(size_t l = 0; l + 1 < tree->levels; l ++) {
+
+        size_t    npairs = tree->count[l] / 2;
+        uint8_t * in     = merkle_node(tree, l    , 0);
+        uint8_t * out    = merkle_node(tree, l + 1, 0);
+
+        for(size_t p = 0; p < npairs; p += MERKLE_BATCH_PAIRS) {
+            size_t n = npairs - p;
+            n = n < MERKLE_BATCH_PAIRS ? n : MERKLE_BATCH_PAIRS;
+            tree->kernel(out + p * MERKLE_NODE_BYTES,
+                         in  + p * MERKLE_NODE_BYTES * 2, n);
+        }
+
+        if(tree->count[l] & 1) {        // Carry the unpaired node up.
+            memcpy(out + npairs * MERKLE_NODE_BYTES,
+                   in  + npairs * MERKLE_NODE_BYTES * 2, MERKLE_NODE_BYTES);
+        }
+    }
+}
+
+void merkle_tree_update (
+    merkle_tree_t * tree ,
+    size_t          i    ,
+    uint8_t       * chunk,
+    size_t          len
+){
+    merkle_tree_set_leaf(tree, i, chunk, len);
+
+    for(size_t l = 0; l + 1 < tree->levels; l ++) {
+
+        size_t    left   = i & ~(size_t)1;
+        uint8_t * parent = merkle_node(tree, l + 1, i >> 1);
+
+        if(left + 1 < tree->count[l]) {
+            merkle_sha256_hash_64(parent, merkle_node(tree, l, left));
+        } else {
+            memcpy(parent, merkle_node(tree, l, left), MERKLE_NODE_BYTES);
+        }
+
+        i >>= 1;
+    }
+}
+
+uint8_t * merkle_tree_root (
+    merkle_tree_t * tree
+){
+    return merkle_node(tree, tree->levels - 1, 0);
+}
+
+//! @}
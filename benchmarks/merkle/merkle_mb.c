@@ -0,0 +1,67 @@
+/*!
+@addtogroup crypto_merkle
+@{
+*/
+
+#include <string.h>
+
+#include "riscvcrypto/merkle/api_merkle.h"
+
+//! SHA-256 initial chaining value.
+static const uint32_t merkle_mb_iv [8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+/*!
+@brief The padding block of a 64-byte message, as bytes, since the
+    multi-buffer kernels only take byte input.
+*/
+static const uint8_t merkle_mb_pad [SHA256_BLOCK_BYTES] = {
+    0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0   , 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0   , 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0   , 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0
+};
+
+void merkle_sha256_pairs_x4 (
+    uint8_t   * out   ,
+    uint8_t   * in    ,
+    size_t      npairs
+){
+    uint32_t   H  [4][8];
+    uint32_t * Hp [4] = {H[0], H[1], H[2], H[3]};
+    uint8_t  * Mp [4];
+    size_t     p  = 0;
+
+    for(; p + 4 <= npairs; p += 4) {
+
+        for(int l = 0; l < 4; l ++) {
+            memcpy(H[l], merkle_mb_iv, sizeof(merkle_mb_iv));
+            Mp[l] = in + (p + l) * MERKLE_NODE_BYTES * 2;
+        }
+
+        sha256_hash_blocks_x4(Hp, Mp, 1);
+
+        for(int l = 0; l < 4; l ++) {
+            Mp[l] = (uint8_t*)merkle_mb_pad;
+        }
+
+        sha256_hash_blocks_x4(Hp, Mp, 1);
+
+        for(int l = 0; l < 4; l ++) {
+            uint8_t * o = out + (p + l) * MERKLE_NODE_BYTES;
+            for(int i = 0; i < 8; i ++) {
+                o[4*i+0] = H[l][i] >> 24;
+                o[4*i+1] = H[l][i] >> 16;
+                o[4*i+2] = H[l][i] >>  8;
+                o[4*i+3] = H[l][i] >>  0;
+            }
+        }
+    }
+
+    merkle_sha256_pairs(out + p * MERKLE_NODE_BYTES,    // Up to 3 left.
+                        in  + p * MERKLE_NODE_BYTES * 2, npairs - p);
+}
+
+//! @}
@@ -1,4 +1,3 @@
-
 /*!
 @defgroup crypto_hash_sha256 Crypto Hash SHA256
 @{
@@ -12,13 +11,166 @@
 #ifndef __API_SHA256__
 #define __API_SHA256__
 
-//! Add a single message block to the current hash digest.
+//! Size of one SHA-256 message block in bytes.
+#define SHA256_BLOCK_BYTES   64
+
+//! Size of a SHA-256 digest in bytes.
+#define SHA256_DIGEST_BYTES  32
+
+//! Size of a SHA-224 digest in bytes.
+#define SHA224_DIGEST_BYTES  28
+
+/*!
+@brief State of a streaming SHA-256 or SHA-224 computation.
+@details The two differ only in their initial value and in how much of
+    the final chaining value is output, so they share a context.
+*/
+typedef struct {
+    uint32_t    H [8] ;       //!< Chaining value.
+    uint32_t    B [16];       //!< Partial block. Words, so it is aligned.
+    uint64_t    len   ;       //!< Bytes absorbed so far.
+    size_t      digest_bytes; //!< SHA256_DIGEST_BYTES or SHA224_DIGEST_BYTES
+} sha256_ctx_t;
+
+/*!
+@brief Add a single message block to the chaining value H.
+@details Implemented by each backend. M must be 4-byte aligned.
+*/
+void sha256_hash_block (
+    uint32_t    H[ 8], //!< in,out - chaining value
+    uint32_t    M[16]  //!< in - The message block to add to the hash
+);
+
+/*!
+@brief Add a single message block, given as 16 host order words, to H.
+@details For callers which build blocks from chaining values (HMAC
+    iterations, Merkle nodes), as it avoids converting to bytes and back.
+*/
+void sha256_hash_block_words (
+    uint32_t    H[ 8], //!< in,out - chaining value
+    const uint32_t W[16] //!< in - The message block, word i is bytes 4*i.. BE
+);
+
+/*!
+@brief Add nblocks consecutive message blocks to the chaining value H.
+@details Words are read big-endian straight from M, with word loads when
+    M is 4-byte aligned and byte loads when it is not, so M never needs
+    to be copied.
+*/
+void sha256_hash_blocks (
+    uint32_t    H[ 8], //!< in,out - chaining value
+    uint8_t   * M    , //!< in - The message blocks. Any alignment.
+    size_t      nblocks //!< Number of SHA256_BLOCK_BYTES blocks in M.
+);
+
+//! Begin a SHA-256 computation.
+void sha256_init (
+    sha256_ctx_t * ctx //!< out - Context to initialise.
+);
+
+//! Begin a SHA-224 computation.
+void sha224_init (
+    sha256_ctx_t * ctx //!< out - Context to initialise.
+);
+
+/*!
+@brief Absorb len bytes of message into a SHA-256 or SHA-224 context.
+@details Whole blocks are compressed straight from M, whatever its
+    alignment. Only partial blocks are copied through the context.
+*/
+void sha256_update (
+    sha256_ctx_t * ctx, //!< in,out - Context.
+    uint8_t      * M  , //!< in - Message bytes.
+    size_t         len  //!< Length of M in bytes.
+);
+
+/*!
+@brief Pad the message and write the digest.
+@details Writes ctx->digest_bytes bytes: 32 for SHA-256, 28 for SHA-224.
+*/
+void sha256_final (
+    sha256_ctx_t * ctx   , //!< in - Context. Must be re-initialised after.
+    uint8_t      * digest  //!< out - Message digest.
+);
+
+//! Hash a whole message with SHA-256. H receives the digest bytes.
 void sha256_hash (
-    uint32_t    H[ 8], //!< in,out - message block hash
+    uint32_t    H[ 8], //!< out - message digest
+    uint8_t   * M    , //!< in - The message to be hashed
+    size_t      len    //!< Length of the message in *bytes*.
+);
+
+//! Hash a whole message with SHA-224.
+void sha224_hash (
+    uint8_t     digest[SHA224_DIGEST_BYTES], //!< out - message digest
     uint8_t   * M    , //!< in - The message to be hashed
     size_t      len    //!< Length of the message in *bytes*.
 );
 
+/*!
+@name Multi-buffer SHA-256
+@brief Hash several independent messages at once, interleaving their
+    rounds so the round-to-round dependency chain of one message does not
+    leave issue slots idle. Only the zscrypto backend provides these.
+@{
+*/
+
+//! Number of messages the widest multi-buffer kernel hashes at once.
+#define SHA256_MB_LANES 4
+
+/*!
+@brief Add nblocks consecutive blocks from each of two messages to their
+    chaining values. Messages may have any alignment.
+*/
+void sha256_hash_blocks_x2 (
+    uint32_t  * H[2], //!< in,out - chaining value of each message
+    uint8_t   * M[2], //!< in - The message blocks of each message
+    size_t      nblocks //!< Number of blocks from each message.
+);
+
+//! As sha256_hash_blocks_x2, for four messages.
+void sha256_hash_blocks_x4 (
+    uint32_t  * H[4], //!< in,out - chaining value of each message
+    uint8_t   * M[4], //!< in - The message blocks of each message
+    size_t      nblocks //!< Number of blocks from each message.
+);
+
+//! Hash two messages of the same length with SHA-256.
+void sha256_hash_x2 (
+    uint8_t   * digest[2], //!< out - SHA256_DIGEST_BYTES per message
+    uint8_t   * M     [2], //!< in - The messages to be hashed
+    size_t      len        //!< Length of each message in *bytes*.
+);
+
+//! Hash four messages of the same length with SHA-256.
+void sha256_hash_x4 (
+    uint8_t   * digest[4], //!< out - SHA256_DIGEST_BYTES per message
+    uint8_t   * M     [4], //!< in - The messages to be hashed
+    size_t      len        //!< Length of each message in *bytes*.
+);
+
+//! One message to be hashed by sha256_hash_jobs.
+typedef struct {
+    uint8_t   * M     ; //!< in - The message to be hashed.
+    size_t      len   ; //!< in - Length of the message in bytes.
+    uint8_t     digest [SHA256_DIGEST_BYTES]; //!< out - Its SHA-256 digest
+} sha256_job_t;
+
+/*!
+@brief Hash any number of messages of any lengths with the multi-buffer
+    kernels.
+@details Jobs are taken in batches, sorted by length, and fed to
+    SHA256_MB_LANES lanes. A lane whose message ends is refilled with the
+    next job, so the lanes stay busy until the batch drains, when the x2
+    and single-stream kernels finish off the stragglers.
+*/
+void sha256_hash_jobs (
+    sha256_job_t * jobs , //!< in,out - Messages, and their digests.
+    size_t         njobs  //!< Number of jobs.
+);
+
+//! @}
+
 /*! @} */
 
 #endif // __API_SHA256__
@@ -18,19 +18,6 @@ static uint32_t K [64] = {
     0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
 };
 
-static inline void sha256_hash_init (
-    uint32_t    H [8]  //!< out - message block hash
-){
-    H[0] = 0x6a09e667;
-    H[1] = 0xbb67ae85;
-    H[2] = 0x3c6ef372;
-    H[3] = 0xa54ff53a;
-    H[4] = 0x510e527f;
-    H[5] = 0x9b05688c;
-    H[6] = 0x1f83d9ab;
-    H[7] = 0x5be0cd19;
-}
-
 #define SHA256_LOAD32_BE(X, A, I) {    \
     X = ((uint32_t*)A)[I];             \
     X = (((X >>  0) & 0xFF) << 24) |   \
@@ -39,15 +26,14 @@ static inline void sha256_hash_init (
         (((X >> 24) & 0xFF) <<  0) ;   \
 }
 
-#define SHA256_STORE32_BE(X, A, I) {    \
-    A[I] = \
-        (((X >>  0) & 0xFF) << 24) |   \
-        (((X >>  8) & 0xFF) << 16) |   \
-        (((X >> 16) & 0xFF) <<  8) |   \
-        (((X >> 24) & 0xFF) <<  0) ;   \
+//! Load big-endian word I of A, which need not be aligned.
+#define SHA256_LOADU32_BE(X, A, I) {           \
+    X = ((uint32_t)A[4*I + 0] << 24) |         \
+        ((uint32_t)A[4*I + 1] << 16) |         \
+        ((uint32_t)A[4*I + 2] <<  8) |         \
+        ((uint32_t)A[4*I + 3] <<  0) ;         \
 }
 
-
 #define ROR32(X,Y) ((X>>Y) | (X << (32-Y)))
 #define SHR32(X,Y) ((X>>Y)                )
 
@@ -70,9 +56,15 @@ static inline void sha256_hash_init (
     M0 = SIGMA_1(ME) + M9 + SIGMA_0(M1) + M0; \
 }
 
-static void sha256_hash_block (
-    uint32_t    H[ 8], //!< in,out - message block hash
-    uint32_t    M[16]  //!< in - The message block to add to the hash
+/*!
+@brief Add one block to H, loading its words straight from M, or taking
+    them from W when it is not NULL. Inlined, so each caller gets only
+    the path it uses.
+*/
+static inline void sha256_compress (
+    uint32_t    H[ 8], //!< in,out - chaining value
+    uint8_t   * M    , //!< in - The message block to add to the hash
+    const uint32_t * W     //!< in - Host order message words, or NULL.
 ){
     uint32_t    a,b,c,d,e,f,g,h ;   // Working variables.
 
@@ -87,22 +79,58 @@ static void sha256_hash_block (
 
     uint32_t m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, ma, mb, mc, md, me, mf;
 
-    SHA256_LOAD32_BE(m0, M,  0);
-    SHA256_LOAD32_BE(m1, M,  1);
-    SHA256_LOAD32_BE(m2, M,  2);
-    SHA256_LOAD32_BE(m3, M,  3);
-    SHA256_LOAD32_BE(m4, M,  4);
-    SHA256_LOAD32_BE(m5, M,  5);
-    SHA256_LOAD32_BE(m6, M,  6);
-    SHA256_LOAD32_BE(m7, M,  7);
-    SHA256_LOAD32_BE(m8, M,  8);
-    SHA256_LOAD32_BE(m9, M,  9);
-    SHA256_LOAD32_BE(ma, M, 10);
-    SHA256_LOAD32_BE(mb, M, 11);
-    SHA256_LOAD32_BE(mc, M, 12);
-    SHA256_LOAD32_BE(md, M, 13);
-    SHA256_LOAD32_BE(me, M, 14);
-    SHA256_LOAD32_BE(mf, M, 15);
+    if(W != NULL) {                     // Words given by the caller.
+        m0 = W[ 0];
+        m1 = W[ 1];
+        m2 = W[ 2];
+        m3 = W[ 3];
+        m4 = W[ 4];
+        m5 = W[ 5];
+        m6 = W[ 6];
+        m7 = W[ 7];
+        m8 = W[ 8];
+        m9 = W[ 9];
+        ma = W[10];
+        mb = W[11];
+        mc = W[12];
+        md = W[13];
+        me = W[14];
+        mf = W[15];
+    } else if(((uintptr_t)M & 3) == 0) { // Aligned: plain word loads.
+        SHA256_LOAD32_BE(m0, M,  0);
+        SHA256_LOAD32_BE(m1, M,  1);
+        SHA256_LOAD32_BE(m2, M,  2);
+        SHA256_LOAD32_BE(m3, M,  3);
+        SHA256_LOAD32_BE(m4, M,  4);
+        SHA256_LOAD32_BE(m5, M,  5);
+        SHA256_LOAD32_BE(m6, M,  6);
+        SHA256_LOAD32_BE(m7, M,  7);
+        SHA256_LOAD32_BE(m8, M,  8);
+        SHA256_LOAD32_BE(m9, M,  9);
+        SHA256_LOAD32_BE(ma, M, 10);
+        SHA256_LOAD32_BE(mb, M, 11);
+        SHA256_LOAD32_BE(mc, M, 12);
+        SHA256_LOAD32_BE(md, M, 13);
+        SHA256_LOAD32_BE(me, M, 14);
+        SHA256_LOAD32_BE(mf, M, 15);
+    } else {                            // Misaligned: byte loads.
+        SHA256_LOADU32_BE(m0, M,  0);
+        SHA256_LOADU32_BE(m1, M,  1);
+        SHA256_LOADU32_BE(m2, M,  2);
+        SHA256_LOADU32_BE(m3, M,  3);
+        SHA256_LOADU32_BE(m4, M,  4);
+        SHA256_LOADU32_BE(m5, M,  5);
+        SHA256_LOADU32_BE(m6, M,  6);
+        SHA256_LOADU32_BE(m7, M,  7);
+        SHA256_LOADU32_BE(m8, M,  8);
+        SHA256_LOADU32_BE(m9, M,  9);
+        SHA256_LOADU32_BE(ma, M, 10);
+        SHA256_LOADU32_BE(mb, M, 11);
+        SHA256_LOADU32_BE(mc, M, 12);
+        SHA256_LOADU32_BE(md, M, 13);
+        SHA256_LOADU32_BE(me, M, 14);
+        SHA256_LOADU32_BE(mf, M, 15);
+    }
 
     uint32_t *kp = K     ;
     uint32_t *ke = K + 48;
@@ -158,56 +186,27 @@ static void sha256_hash_block (
     H[7] += h;
 }
 
-
-void sha256_hash (
-    uint32_t    H[ 8], //!< in,out - message block hash
-    uint8_t   * M    , //!< in - The message to be hashed
-    size_t      len    //!< Length of the message in *bytes*.
+void sha256_hash_block (
+    uint32_t    H[ 8],
+    uint32_t    M[16]
 ){
-    uint32_t   p_H[ 8] ;
-    uint32_t   p_B[16] ;
-    uint8_t  * p_M     = M ;
-
-    size_t     len_bits= len << 3;
-
-    sha256_hash_init(p_H);
-
-    while(len >= 64) {
-        memcpy(p_B, p_M, 64);           // Copy 64 bytes/512 bits to process. 
-
-        sha256_hash_block (p_H, p_B);   // Digest another block
-
-        p_M += 64;                      // Adjust pointers and length.
-        len -= 64;
-    }
-
-    memcpy(p_B, p_M, len);              // Copy remaining bytes into block
-
-    uint8_t * bp = (uint8_t*)p_B;
-    bp[len++] = 0x80;                   // Append `1` to end of message
-
-    if(len > 56) {                      // Do we spill into another block?
-        memset(bp+len, 0, 64-len);      // If yes, clear rest of this block
-        sha256_hash_block(p_H, p_B);    // Length will be added in a new block
-        len = 0;                        //
-    }
-
-    size_t i = 64;
-    while(len_bits) {                   // Add length to end of this block
-        bp[--i] = len_bits  & 0xFF;
-        len_bits= len_bits >>    8;
-    }
-
-    memset(bp + len, 0, i-len);         // Clear fstart of block/EoM to len
+    sha256_hash_blocks(H, (uint8_t*)M, 1);
+}
 
-    sha256_hash_block(p_H,p_B);
+void sha256_hash_block_words (
+    uint32_t    H[ 8],
+    const uint32_t W[16]
+){
+    sha256_compress(H, NULL, W);
+}
 
-    for(size_t i = 0; i < 8; i ++) {    // Store result in big endian
-        uint32_t x = p_H[i];
-        SHA256_STORE32_BE(x,H,i);
+void sha256_hash_blocks (
+    uint32_t    H[ 8],
+    uint8_t   * M    ,
+    size_t      nblocks
+){
+    while(nblocks --) {
+        sha256_compress(H, M, NULL);
+        M += 64;
     }
 }
-
-
-
-
@@ -0,0 +1,134 @@
+
+/*!
+@addtogroup crypto_hash_sha256
+@{
+*/
+
+#include <string.h>
+
+#include "riscvcrypto/sha256/api_sha256.h"
+
+void sha256_init (
+    sha256_ctx_t * ctx
+){
+    ctx->H[0] = 0x6a09e667;
+    ctx->H[1] = 0xbb67ae85;
+    ctx->H[2] = 0x3c6ef372;
+    ctx->H[3] = 0xa54ff53a;
+    ctx->H[4] = 0x510e527f;
+    ctx->H[5] = 0x9b05688c;
+    ctx->H[6] = 0x1f83d9ab;
+    ctx->H[7] = 0x5be0cd19;
+    ctx->len  = 0;
+    ctx->digest_bytes = SHA256_DIGEST_BYTES;
+}
+
+void sha224_init (
+    sha256_ctx_t * ctx
+){
+    ctx->H[0] = 0xc1059ed8;
+    ctx->H[1] = 0x367cd507;
+    ctx->H[2] = 0x3070dd17;
+    ctx->H[3] = 0xf70e5939;
+    ctx->H[4] = 0xffc00b31;
+    ctx->H[5] = 0x68581511;
+    ctx->H[6] = 0x64f98fa7;
+    ctx->H[7] = 0xbefa4fa4;
+    ctx->len  = 0;
+    ctx->digest_bytes = SHA224_DIGEST_BYTES;
+}
+
+void sha256_update (
+    sha256_ctx_t * ctx,
+    uint8_t      * M  ,
+    size_t         len
+){
+    uint8_t * bp   = (uint8_t*)ctx->B;
+    size_t    fill = ctx->len % SHA256_BLOCK_BYTES;
+
+    ctx->len += len;
+
+    if(fill) {                          // Top up a partial block first.
+        size_t take = SHA256_BLOCK_BYTES - fill;
+        take = take < len ? take : len;
+
+        memcpy(bp + fill, M, take);
+
+        M    += take;
+        len  -= take;
+        fill += take;
+
+        if(fill < SHA256_BLOCK_BYTES) {
+            return;
+        }
+
+        sha256_hash_block(ctx->H, ctx->B);
+    }
+
+    size_t nblocks = len / SHA256_BLOCK_BYTES;
+
+    sha256_hash_blocks(ctx->H, M, nblocks); // Compress whole blocks in place
+
+    M   += SHA256_BLOCK_BYTES * nblocks;
+    len -= SHA256_BLOCK_BYTES * nblocks;
+
+    memcpy(bp, M, len);                 // Keep the tail for next time.
+}
+
+void sha256_final (
+    sha256_ctx_t * ctx   ,
+    uint8_t      * digest
+){
+    uint8_t * bp       = (uint8_t*)ctx->B;
+    size_t    fill     = ctx->len % SHA256_BLOCK_BYTES;
+    uint64_t  len_bits = ctx->len << 3;
+
+    bp[fill++] = 0x80;                  // Append `1` to end of message
+
+    if(fill > 56) {                     // Do we spill into another block?
+        memset(bp + fill, 0, SHA256_BLOCK_BYTES - fill);
+        sha256_hash_block(ctx->H, ctx->B);
+        fill = 0;
+    }
+
+    memset(bp + fill, 0, 56 - fill);
+
+    for(int i = 63; i >= 56; i --) {    // Add length to end of this block
+        bp[i]    = len_bits & 0xFF;
+        len_bits = len_bits >>    8;
+    }
+
+    sha256_hash_block(ctx->H, ctx->B);
+
+    for(size_t i = 0; i < ctx->digest_bytes / 4; i ++) {
+        uint32_t x = ctx->H[i];         // Store result in big endian
+        digest[4*i + 0] = x >> 24;
+        digest[4*i + 1] = x >> 16;
+        digest[4*i + 2] = x >>  8;
+        digest[4*i + 3] = x >>  0;
+    }
+}
+
+void sha256_hash (
+    uint32_t    H[ 8],
+    uint8_t   * M    ,
+    size_t      len
+){
+    sha256_ctx_t ctx;
+    sha256_init  (&ctx);
+    sha256_update(&ctx, M, len);
+    sha256_final (&ctx, (uint8_t*)H);
+}
+
+void sha224_hash (
+    uint8_t     digest[SHA224_DIGEST_BYTES],
+    uint8_t   * M    ,
+    size_t      len
+){
+    sha256_ctx_t ctx;
+    sha224_init  (&ctx);
+    sha256_update(&ctx, M, len);
+    sha256_final (&ctx, digest);
+}
+
+//! @}
@@ -0,0 +1,361 @@
+
+/*!
+@addtogroup crypto_hash_sha256
+@{
+*/
+
+#include <string.h>
+
+#include "riscvcrypto/sha256/api_sha256.h"
+#include "riscvcrypto/share/riscv-crypto-intrinsics.h"
+
+//! Number of jobs sorted and scheduled together by sha256_hash_jobs.
+#define SHA256_MB_BATCH 64
+
+static const uint32_t K [64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const uint32_t sha256_mb_iv [8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+#define CH(X,Y,Z)  ((X&Y)^(~X&Z))
+#define MAJ(X,Y,Z) ((X&Y)^(X&Z)^(Y&Z))
+
+#define SUM_0(X)   (_sha256sum0(X))
+#define SUM_1(X)   (_sha256sum1(X))
+
+#define SIGMA_0(X) (_sha256sig0(X))
+#define SIGMA_1(X) (_sha256sig1(X))
+
+#define ROUND(A,B,C,D,E,F,G,H,K,W) { \
+    H  = H + SUM_1(E) + CH(E,F,G) + K + W   ; \
+    D  = D + H                              ; \
+    H  = H + SUM_0(A) + MAJ(A,B,C)          ; \
+}
+
+//! Message word I of a lane, for rounds 0-15.
+#define MB_W_LOAD(W, I)  (W[(I)])
+
+//! Message word I of a lane, expanding the schedule in place for 16-63.
+#define MB_W_SCHED(W, I) (W[(I) & 15] += SIGMA_1(W[((I) -  2) & 15]) + \
+                                         W[((I) -  7) & 15]          + \
+                                         SIGMA_0(W[((I) - 15) & 15]) )
+
+//! Eight rounds of lane L, starting at round I. WF fetches message words.
+#define MB_ROUNDS8(L, I, WF)                                                \
+    ROUND(a##L,b##L,c##L,d##L,e##L,f##L,g##L,h##L,K[I+0],WF(w##L,I+0))      \
+    ROUND(h##L,a##L,b##L,c##L,d##L,e##L,f##L,g##L,K[I+1],WF(w##L,I+1))      \
+    ROUND(g##L,h##L,a##L,b##L,c##L,d##L,e##L,f##L,K[I+2],WF(w##L,I+2))      \
+    ROUND(f##L,g##L,h##L,a##L,b##L,c##L,d##L,e##L,K[I+3],WF(w##L,I+3))      \
+    ROUND(e##L,f##L,g##L,h##L,a##L,b##L,c##L,d##L,K[I+4],WF(w##L,I+4))      \
+    ROUND(d##L,e##L,f##L,g##L,h##L,a##L,b##L,c##L,K[I+5],WF(w##L,I+5))      \
+    ROUND(c##L,d##L,e##L,f##L,g##L,h##L,a##L,b##L,K[I+6],WF(w##L,I+6))      \
+    ROUND(b##L,c##L,d##L,e##L,f##L,g##L,h##L,a##L,K[I+7],WF(w##L,I+7))
+
+/*!
+@brief All 64 rounds of every lane. Each group of eight rounds is issued
+    for all lanes before the next, so the independent chains interleave.
+*/
+#define MB_ROUNDS64(LANES)                                                  \
+    LANES(MB_ROUNDS8,  0, MB_W_LOAD )                                       \
+    LANES(MB_ROUNDS8,  8, MB_W_LOAD )                                       \
+    LANES(MB_ROUNDS8, 16, MB_W_SCHED)                                       \
+    LANES(MB_ROUNDS8, 24, MB_W_SCHED)                                       \
+    LANES(MB_ROUNDS8, 32, MB_W_SCHED)                                       \
+    LANES(MB_ROUNDS8, 40, MB_W_SCHED)                                       \
+    LANES(MB_ROUNDS8, 48, MB_W_SCHED)                                       \
+    LANES(MB_ROUNDS8, 56, MB_W_SCHED)
+
+//! Lane lists. Apply F to each lane number.
+#define MB_LANES_X2(F, ...) F(0, __VA_ARGS__) F(1, __VA_ARGS__)
+#define MB_LANES_X4(F, ...) F(0, __VA_ARGS__) F(1, __VA_ARGS__) \
+                            F(2, __VA_ARGS__) F(3, __VA_ARGS__)
+
+//! Declare lane L's working variables and load its chaining value.
+#define MB_LANE_INIT(L, ...)                                                \
+    uint32_t * hp##L = H[L];                                                \
+    uint8_t  * mp##L = M[L];                                                \
+    uint32_t   w##L [16];                                                   \
+    uint32_t   a##L = hp##L[0], b##L = hp##L[1], c##L = hp##L[2],           \
+               d##L = hp##L[3], e##L = hp##L[4], f##L = hp##L[5],           \
+               g##L = hp##L[6], h##L = hp##L[7];
+
+//! Load lane L's next message block.
+#define MB_LANE_LOAD(L, ...)                                                \
+    sha256_mb_load(w##L, mp##L);                                            \
+    mp##L += SHA256_BLOCK_BYTES;
+
+//! Add lane L's working variables back into its chaining value.
+#define MB_LANE_FEED(L, ...)                                                \
+    a##L = (hp##L[0] += a##L); b##L = (hp##L[1] += b##L);                   \
+    c##L = (hp##L[2] += c##L); d##L = (hp##L[3] += d##L);                   \
+    e##L = (hp##L[4] += e##L); f##L = (hp##L[5] += f##L);                   \
+    g##L = (hp##L[6] += g##L); h##L = (hp##L[7] += h##L);
+
+//! The body of a multi-buffer kernel over the lanes in LANES.
+#define MB_KERNEL(LANES)                                                    \
+    LANES(MB_LANE_INIT)                                                     \
+    while(nblocks --) {                                                     \
+        LANES(MB_LANE_LOAD)                                                 \
+        MB_ROUNDS64(LANES)                                                  \
+        LANES(MB_LANE_FEED)                                                 \
+    }
+
+//! Load the 16 big-endian words of one block, which may be misaligned.
+static inline void sha256_mb_load (
+    uint32_t    w[16],
+    uint8_t   * M
+){
+    if(((uintptr_t)M & 3) == 0) {
+        for(int i = 0; i < 16; i ++) {
+            w[i] = __builtin_bswap32(((uint32_t*)M)[i]);
+        }
+    } else {
+        for(int i = 0; i < 16; i ++) {
+            uint32_t x;
+            memcpy(&x, M + 4*i, 4);
+            w[i] = __builtin_bswap32(x);
+        }
+    }
+}
+
+void sha256_hash_blocks_x2 (
+    uint32_t  * H[2],
+    uint8_t   * M[2],
+    size_t      nblocks
+){
+    MB_KERNEL(MB_LANES_X2)
+}
+
+void sha256_hash_blocks_x4 (
+    uint32_t  * H[4],
+    uint8_t   * M[4],
+    size_t      nblocks
+){
+    MB_KERNEL(MB_LANES_X4)
+}
+
+/*!
+@brief Pad the last len % 64 bytes of a len byte message into tail.
+@returns The number of padded blocks, 1 or 2.
+*/
+static size_t sha256_mb_tail (
+    uint32_t    tail[32],
+    uint8_t   * M       ,
+    size_t      len
+){
+    uint8_t  * tp       = (uint8_t*)tail;
+    size_t     rem      = len % SHA256_BLOCK_BYTES;
+    size_t     ntail    = rem < 56 ? 1 : 2;
+    size_t     end      = SHA256_BLOCK_BYTES * ntail;
+    uint64_t   len_bits = (uint64_t)len << 3;
+
+    memcpy(tp, M + len - rem, rem);
+    tp[rem] = 0x80;                     // Append `1` to end of message
+    memset(tp + rem + 1, 0, end - rem - 1 - 8);
+
+    for(int i = 1; i <= 8; i ++) {      // Add length to end of last block
+        tp[end - i] = len_bits & 0xFF;
+        len_bits    = len_bits >>    8;
+    }
+
+    return ntail;
+}
+
+//! Store a chaining value as a big-endian digest.
+static void sha256_mb_store (
+    uint8_t   * digest,
+    uint32_t    H[8]
+){
+    for(int i = 0; i < 8; i ++) {
+        digest[4*i + 0] = H[i] >> 24;
+        digest[4*i + 1] = H[i] >> 16;
+        digest[4*i + 2] = H[i] >>  8;
+        digest[4*i + 3] = H[i] >>  0;
+    }
+}
+
+typedef void (*sha256_mb_kernel_t)(uint32_t ** H, uint8_t ** M, size_t n);
+
+//! Hash n equal length messages with an n lane kernel.
+static void sha256_hash_xn (
+    uint8_t           ** digest,
+    uint8_t           ** M     ,
+    size_t               len   ,
+    int                  n     ,
+    sha256_mb_kernel_t   kernel
+){
+    uint32_t   H    [SHA256_MB_LANES][8];
+    uint32_t   tail [SHA256_MB_LANES][32];
+    uint32_t * hp   [SHA256_MB_LANES];
+    uint8_t  * tp   [SHA256_MB_LANES];
+    size_t     ntail = 0;
+
+    for(int l = 0; l < n; l ++) {
+        memcpy(H[l], sha256_mb_iv, sizeof(sha256_mb_iv));
+        hp[l]  = H[l];
+        tp[l]  = (uint8_t*)tail[l];
+        ntail  = sha256_mb_tail(tail[l], M[l], len);
+    }
+
+    kernel(hp, M , len / SHA256_BLOCK_BYTES);
+    kernel(hp, tp, ntail);
+
+    for(int l = 0; l < n; l ++) {
+        sha256_mb_store(digest[l], H[l]);
+    }
+}
+
+void sha256_hash_x2 (
+    uint8_t   * digest[2],
+    uint8_t   * M     [2],
+    size_t      len
+){
+    sha256_hash_xn(digest, M, len, 2, sha256_hash_blocks_x2);
+}
+
+void sha256_hash_x4 (
+    uint8_t   * digest[4],
+    uint8_t   * M     [4],
+    size_t      len
+){
+    sha256_hash_xn(digest, M, len, 4, sha256_hash_blocks_x4);
+}
+
+//! One lane of the sha256_hash_jobs scheduler.
+typedef struct {
+    sha256_job_t * job  ;      //!< Job in this lane, or NULL when idle.
+    uint8_t      * M    ;      //!< Next block: in the message, then tail.
+    size_t         full ;      //!< Whole message blocks left.
+    size_t         ntail;      //!< Padded tail blocks left.
+    uint32_t       H    [8];   //!< Chaining value.
+    uint32_t       tail [32];  //!< Padded final block(s).
+} sha256_mb_lane_t;
+
+static void sha256_mb_lane_start (
+    sha256_mb_lane_t * lane,
+    sha256_job_t     * job
+){
+    memcpy(lane->H, sha256_mb_iv, sizeof(sha256_mb_iv));
+    lane->job   = job;
+    lane->M     = job->M;
+    lane->full  = job->len / SHA256_BLOCK_BYTES;
+    lane->ntail = sha256_mb_tail(lane->tail, job->M, job->len);
+    if(lane->full == 0) {
+        lane->M = (uint8_t*)lane->tail;
+    }
+}
+
+//! Number of contiguous blocks at lane->M.
+static inline size_t sha256_mb_lane_run (
+    sha256_mb_lane_t * lane
+){
+    return lane->full ? lane->full : lane->ntail;
+}
+
+//! Step a lane past n blocks, retiring its job when it is finished.
+static void sha256_mb_lane_advance (
+    sha256_mb_lane_t * lane,
+    size_t             n
+){
+    lane->M += SHA256_BLOCK_BYTES * n;
+    if(lane->full) {
+        lane->full -= n;
+        if(lane->full == 0) {
+            lane->M = (uint8_t*)lane->tail;
+        }
+    } else {
+        lane->ntail -= n;
+        if(lane->ntail == 0) {
+            sha256_mb_store(lane->job->digest, lane->H);
+            lane->job = NULL;
+        }
+    }
+}
+
+void sha256_hash_jobs (
+    sha256_job_t * jobs ,
+    size_t         njobs
+){
+    sha256_mb_lane_t   lanes [SHA256_MB_LANES];
+    sha256_job_t     * order [SHA256_MB_BATCH];
+
+    for(size_t base = 0; base < njobs; base += SHA256_MB_BATCH) {
+
+        size_t n    = njobs - base;
+        size_t next = 0;
+        n = n < SHA256_MB_BATCH ? n : SHA256_MB_BATCH;
+
+        for(size_t i = 0; i < n; i ++) {    // Sort the batch by length.
+            sha256_job_t * j = &jobs[base + i];
+            size_t         k = i;
+            while(k > 0 && order[k-1]->len > j->len) {
+                order[k] = order[k-1];
+                k --;
+            }
+            order[k] = j;
+        }
+
+        for(int l = 0; l < SHA256_MB_LANES; l ++) {
+            lanes[l].job = NULL;
+        }
+
+        while(1) {
+
+            sha256_mb_lane_t * act [SHA256_MB_LANES];
+            uint32_t         * hp  [SHA256_MB_LANES];
+            uint8_t          * mp  [SHA256_MB_LANES];
+            int                nact = 0;
+
+            for(int l = 0; l < SHA256_MB_LANES; l ++) {
+                if(lanes[l].job == NULL && next < n) {
+                    sha256_mb_lane_start(&lanes[l], order[next ++]);
+                }
+                if(lanes[l].job != NULL) {
+                    act[nact ++] = &lanes[l];
+                }
+            }
+
+            if(nact == 0) {
+                break;
+            }
+
+            int    width = nact >= 4 ? 4 : (nact >= 2 ? 2 : 1);
+            size_t run   = (size_t)-1;
+
+            for(int i = 0; i < width; i ++) {
+                size_t r = sha256_mb_lane_run(act[i]);
+                run   = r < run ? r : run;
+                hp[i] = act[i]->H;
+                mp[i] = act[i]->M;
+            }
+
+            if(width == 4) {
+                sha256_hash_blocks_x4(hp, mp, run);
+            } else if(width == 2) {
+                sha256_hash_blocks_x2(hp, mp, run);
+            } else {
+                sha256_hash_blocks(hp[0], mp[0], run);
+            }
+
+            for(int i = 0; i < width; i ++) {
+                sha256_mb_lane_advance(act[i], run);
+            }
+        }
+    }
+}
+
+//! @}
@@ -49,4 +49,199 @@ void Keccak(
     unsigned long long int outputByteLen
 );
 
+/*!
+@brief The Keccak-f[1600] permutation, provided by each backend.
+@details Lane A[x,y] is s[x + 5*y]. How the bits of a lane are arranged
+    within s[x + 5*y] is up to the backend, so the state should only be
+    read or written with KeccakF1600_StateXORBytes and
+    KeccakF1600_StateExtractBytes.
+*/
+void KeccakF1600_StatePermute(
+    uint64_t * s
+);
+
+/*!
+@brief Keccak-f[1600] on two independent states at once.
+@details The rounds of the two are interleaved, so the dependency chain
+    of one hides the latency of the other. Provided by each backend.
+*/
+void KeccakF1600_StatePermute_x2(
+    uint64_t s[2][25]
+);
+
+//! Keccak-f[1600] on four independent states at once.
+void KeccakF1600_StatePermute_x4(
+    uint64_t s[4][25]
+);
+
+/*!
+@brief Keccak-p[1600,12]: the last 12 of the 24 rounds of Keccak-f[1600].
+@details The permutation of TurboSHAKE and KangarooTwelve. Provided by
+    each backend, on the same lane layout as KeccakF1600_StatePermute.
+*/
+void KeccakP1600_StatePermute_12rounds(
+    uint64_t * s
+);
+
+//! Keccak-p[1600,12] on two independent states at once.
+void KeccakP1600_StatePermute_12rounds_x2(
+    uint64_t s[2][25]
+);
+
+//! Keccak-p[1600,12] on four independent states at once.
+void KeccakP1600_StatePermute_12rounds_x4(
+    uint64_t s[4][25]
+);
+
+/*!
+@brief XOR length bytes of data into the state, from byte offset onward.
+@details Provided by each backend, as only the backend knows how its
+    lanes are laid out in memory. offset + length is at most
+    KECCAK_STATE_BYTES.
+*/
+void KeccakF1600_StateXORBytes(
+    uint64_t      * s     ,
+    unsigned int    offset,
+    const uint8_t * data  ,
+    unsigned int    length
+);
+
+//! Copy length bytes of the state, from byte offset onward, to data.
+void KeccakF1600_StateExtractBytes(
+    uint64_t      * s     ,
+    unsigned int    offset,
+    uint8_t       * data  ,
+    unsigned int    length
+);
+
+//! Size of the Keccak-f[1600] state in bytes.
+#define KECCAK_STATE_BYTES      200
+
+//! @name Number of rounds of the permutation used by a sponge.
+//! @{
+#define KECCAK_ROUNDS_F1600     24 //!< Keccak-f[1600], as in FIPS 202.
+#define KECCAK_ROUNDS_P1600_12  12 //!< Keccak-p[1600,12], as in TurboSHAKE.
+//! @}
+
+//! @name Rates, in bytes, of the FIPS 202 functions.
+//! @{
+#define KECCAK_RATE_SHAKE128    168
+#define KECCAK_RATE_SHAKE256    136
+#define KECCAK_RATE_SHA3_224    144
+#define KECCAK_RATE_SHA3_256    136
+#define KECCAK_RATE_SHA3_384    104
+#define KECCAK_RATE_SHA3_512     72
+//! @}
+
+//! @name Delimited suffixes of the FIPS 202 functions. See Keccak().
+//! @{
+#define KECCAK_SUFFIX_SHA3      0x06
+#define KECCAK_SUFFIX_SHAKE     0x1F
+//! @}
+
+/*!
+@brief State of an incremental Keccak sponge.
+@details Input is XORed into the state a lane at a time, straight from
+    the caller's buffer, and output is read out of the lanes the same
+    way, so nothing is buffered beside the state itself.
+*/
+typedef struct {
+    uint64_t    A [25]   ; //!< State, in the backend's lane layout.
+    uint32_t    rate     ; //!< Rate in bytes.
+    uint32_t    pos      ; //!< Bytes absorbed or squeezed in this block.
+    uint8_t     suffix   ; //!< Delimited suffix, as for Keccak().
+    uint8_t     squeezing; //!< Set by keccak_finalize. Selects the phase.
+    uint8_t     rounds   ; //!< KECCAK_ROUNDS_F1600 or KECCAK_ROUNDS_P1600_12
+} keccak_ctx_t;
+
+/*!
+@brief Begin a sponge computation.
+@details For example, keccak_init(&ctx, KECCAK_RATE_SHAKE128,
+    KECCAK_SUFFIX_SHAKE) begins SHAKE128.
+*/
+void keccak_init (
+    keccak_ctx_t  * ctx   , //!< out - Context to initialise.
+    unsigned int    rate  , //!< Rate in bytes, below KECCAK_STATE_BYTES.
+    uint8_t         suffix  //!< Delimited suffix, as for Keccak().
+);
+
+/*!
+@brief Begin a sponge computation on a reduced-round permutation.
+@details keccak_init is keccak_init_rounds with KECCAK_ROUNDS_F1600.
+    TurboSHAKE128 is rate KECCAK_RATE_SHAKE128 with KECCAK_ROUNDS_P1600_12.
+*/
+void keccak_init_rounds (
+    keccak_ctx_t  * ctx   , //!< out - Context to initialise.
+    unsigned int    rate  , //!< Rate in bytes, below KECCAK_STATE_BYTES.
+    uint8_t         suffix, //!< Delimited suffix, as for Keccak().
+    unsigned int    rounds  //!< KECCAK_ROUNDS_F1600 or KECCAK_ROUNDS_P1600_12
+);
+
+/*!
+@brief Absorb len bytes.
+@details May be called any number of times before finalizing. Once the
+    context is finalized, further input is ignored.
+*/
+void keccak_absorb (
+    keccak_ctx_t  * ctx   , //!< in,out - Context.
+    const uint8_t * in    , //!< in - Input bytes. Any alignment.
+    uint64_t        len     //!< Length of in, in bytes.
+);
+
+//! Pad the input and switch the sponge to squeezing. Does nothing if the
+//! context is already squeezing.
+void keccak_finalize (
+    keccak_ctx_t  * ctx     //!< in,out - Context.
+);
+
+/*!
+@brief Squeeze len more bytes of output.
+@details Successive calls continue the same output stream, so an XOF
+    can be read in pieces of any size. A context that is still absorbing
+    is finalized first.
+*/
+void keccak_squeeze (
+    keccak_ctx_t  * ctx   , //!< in,out - Context.
+    uint8_t       * out   , //!< out - Output bytes. Any alignment.
+    uint64_t        len     //!< Number of bytes to squeeze.
+);
+
+/*!
+@brief State of four SHAKE128 computations run side by side.
+@details All four absorb the same number of bytes, and squeeze the same
+    number, as when expanding a matrix from a seed and its indices. Each
+    permutation call is KeccakF1600_StatePermute_x4.
+*/
+typedef struct {
+    uint64_t    A [4][25]; //!< State lanes of each instance.
+    uint32_t    pos      ; //!< Bytes absorbed or squeezed in this block.
+    uint8_t     squeezing; //!< Set by shake128_x4_finalize. Selects the phase.
+} shake128_x4_ctx_t;
+
+//! Begin four SHAKE128 computations.
+void shake128_x4_init (
+    shake128_x4_ctx_t * ctx     //!< out - Context to initialise.
+);
+
+//! Absorb len bytes into each of the four instances. Ignored once finalized.
+void shake128_x4_absorb (
+    shake128_x4_ctx_t * ctx   , //!< in,out - Context.
+    const uint8_t     * in [4], //!< in - Input of each instance.
+    uint64_t            len     //!< Length of each input, in bytes.
+);
+
+//! Pad the input of all four instances and switch to squeezing. Does
+//! nothing if the context is already squeezing.
+void shake128_x4_finalize (
+    shake128_x4_ctx_t * ctx     //!< in,out - Context.
+);
+
+//! Squeeze len more bytes of output from each of the four instances.
+//! A context that is still absorbing is finalized first.
+void shake128_x4_squeeze (
+    shake128_x4_ctx_t * ctx    , //!< in,out - Context.
+    uint8_t           * out [4], //!< out - Output of each instance.
+    uint64_t            len      //!< Number of bytes to squeeze from each.
+);
+
 #endif // __KECCAK_H__
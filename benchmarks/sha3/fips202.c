@@ -17,7 +17,7 @@ http://creativecommons.org/publicdomain/zero/1.0/
 /**
   *  Function to compute SHAKE128 on the input message with any output length.
   */
-void FIPS202_SHAKE128(const unsigned char *input, unsigned int inputByteLen, unsigned char *output, int outputByteLen)
+void FIPS202_SHAKE128(const unsigned char *input, unsigned long long inputByteLen, unsigned char *output, unsigned long long outputByteLen)
 {
     Keccak(1344, 256, input, inputByteLen, 0x1F, output, outputByteLen);
 }
@@ -25,7 +25,7 @@ void FIPS202_SHAKE128(const unsigned char *input, unsigned int inputByteLen, uns
 /**
   *  Function to compute SHAKE256 on the input message with any output length.
   */
-void FIPS202_SHAKE256(const unsigned char *input, unsigned int inputByteLen, unsigned char *output, int outputByteLen)
+void FIPS202_SHAKE256(const unsigned char *input, unsigned long long inputByteLen, unsigned char *output, unsigned long long outputByteLen)
 {
     Keccak(1088, 512, input, inputByteLen, 0x1F, output, outputByteLen);
 }
@@ -33,7 +33,7 @@ void FIPS202_SHAKE256(const unsigned char *input, unsigned int inputByteLen, uns
 /**
   *  Function to compute SHA3-224 on the input message. The output length is fixed to 28 bytes.
   */
-void FIPS202_SHA3_224(const unsigned char *input, unsigned int inputByteLen, unsigned char *output)
+void FIPS202_SHA3_224(const unsigned char *input, unsigned long long inputByteLen, unsigned char *output)
 {
     Keccak(1152, 448, input, inputByteLen, 0x06, output, 28);
 }
@@ -41,7 +41,7 @@ void FIPS202_SHA3_224(const unsigned char *input, unsigned int inputByteLen, uns
 /**
   *  Function to compute SHA3-256 on the input message. The output length is fixed to 32 bytes.
   */
-void FIPS202_SHA3_256(const unsigned char *input, unsigned int inputByteLen, unsigned char *output)
+void FIPS202_SHA3_256(const unsigned char *input, unsigned long long inputByteLen, unsigned char *output)
 {
     Keccak(1088, 512, input, inputByteLen, 0x06, output, 32);
 }
@@ -49,7 +49,7 @@ void FIPS202_SHA3_256(const unsigned char *input, unsigned int inputByteLen, uns
 /**
   *  Function to compute SHA3-384 on the input message. The output length is fixed to 48 bytes.
   */
-void FIPS202_SHA3_384(const unsigned char *input, unsigned int inputByteLen, unsigned char *output)
+void FIPS202_SHA3_384(const unsigned char *input, unsigned long long inputByteLen, unsigned char *output)
 {
     Keccak(832, 768, input, inputByteLen, 0x06, output, 48);
 }
@@ -57,7 +57,7 @@ void FIPS202_SHA3_384(const unsigned char *input, unsigned int inputByteLen, uns
 /**
   *  Function to compute SHA3-512 on the input message. The output length is fixed to 64 bytes.
   */
-void FIPS202_SHA3_512(const unsigned char *input, unsigned int inputByteLen, unsigned char *output)
+void FIPS202_SHA3_512(const unsigned char *input, unsigned long long inputByteLen, unsigned char *output)
 {
     Keccak(576, 1024, input, inputByteLen, 0x06, output, 64);
 }
@@ -22,9 +22,9 @@
 */
 void FIPS202_SHAKE128(
     const unsigned char *input,
-    unsigned int inputByteLen,
+    unsigned long long inputByteLen,
     unsigned char *output,
-    int outputByteLen
+    unsigned long long outputByteLen
 );
 
 /*!
@@ -32,9 +32,9 @@ void FIPS202_SHAKE128(
 */
 void FIPS202_SHAKE256(
     const unsigned char *input,
-    unsigned int inputByteLen,
+    unsigned long long inputByteLen,
     unsigned char *output,
-    int outputByteLen
+    unsigned long long outputByteLen
 );
 
 
@@ -43,7 +43,7 @@ void FIPS202_SHAKE256(
 */
 void FIPS202_SHA3_224(
     const unsigned char *input,
-    unsigned int inputByteLen,
+    unsigned long long inputByteLen,
     unsigned char *output
 );
 
@@ -53,7 +53,7 @@ void FIPS202_SHA3_224(
 */
 void FIPS202_SHA3_256(
     const unsigned char *input,
-    unsigned int inputByteLen,
+    unsigned long long inputByteLen,
     unsigned char *output
 );
 
@@ -64,7 +64,7 @@ to 48 bytes.
 */
 void FIPS202_SHA3_384(
     const unsigned char *input,
-    unsigned int inputByteLen,
+    unsigned long long inputByteLen,
     unsigned char *output
 );
 
@@ -74,7 +74,7 @@ fixed to 64 bytes.
 */
 void FIPS202_SHA3_512(
     const unsigned char *input,
-    unsigned int inputByteLen,
+    unsigned long long inputByteLen,
     unsigned char *output
 );
 
@@ -0,0 +1,285 @@
+/*!
+@addtogroup crypto_hash_k12
+@{
+*/
+
+#include "riscvcrypto/sha3/k12.h"
+
+//! @name Domain separation bytes of KangarooTwelve's TurboSHAKE128 calls.
+//! @{
+#define K12_SUFFIX_SINGLE       0x07 //!< Whole input fits in one chunk.
+#define K12_SUFFIX_FINAL        0x06 //!< Final node of a tree.
+#define K12_SUFFIX_LEAF         0x0B //!< Leaf, giving a CV.
+//! @}
+
+//! Appended to the first chunk when leaves follow it.
+static const uint8_t k12_marker [8] = {0x03, 0, 0, 0, 0, 0, 0, 0};
+
+//! Appended to the final node after the number of CVs.
+static const uint8_t k12_terminator [2] = {0xFF, 0xFF};
+
+/*!
+@brief Write length_encode(x) to buf.
+@details x as big-endian bytes without leading zeros, followed by the
+    number of those bytes. length_encode(0) is the single byte 0x00.
+@returns The number of bytes written, at most 9.
+*/
+static unsigned int k12_length_encode(uint8_t buf[9], uint64_t x) {
+    unsigned int n = 0;
+    for(uint64_t v = x; v > 0; v >>= 8) {
+        n ++;
+    }
+    for(unsigned int i = 0; i < n; i ++) {
+        buf[i] = (uint8_t)(x >> (8 * (n - 1 - i)));
+    }
+    buf[n] = (uint8_t)n;
+    return n + 1;
+}
+
+//! Keccak-p[1600,12] on the first n of the states, n being 1, 2 or 4.
+static inline void k12_permute_n(uint64_t (*A)[25], unsigned int n) {
+    if(n == 4) {
+        KeccakP1600_StatePermute_12rounds_x4(A);
+    } else if(n == 2) {
+        KeccakP1600_StatePermute_12rounds_x2(A);
+    } else {
+        KeccakP1600_StatePermute_12rounds(A[0]);
+    }
+}
+
+/*!
+@brief The CVs of n consecutive leaves, n being 1, 2 or 4.
+@details A leaf is 48 full blocks plus 128 bytes, so the whole leaf is
+    absorbed here without going through a keccak_ctx_t.
+*/
+static void k12_leaves(const uint8_t * in, unsigned int n, uint8_t * cvs) {
+    const unsigned int rate   = KECCAK_RATE_SHAKE128;
+    const unsigned int rem    = K12_CHUNK_BYTES % KECCAK_RATE_SHAKE128;
+    const uint8_t      suffix = K12_SUFFIX_LEAF;
+    const uint8_t      pad    = 0x80;
+    uint64_t           A [K12_LEAF_LANES][25];
+    unsigned int       off;
+
+    memset(A, 0, sizeof(A[0]) * n);
+
+    for(off = 0; off + rate <= K12_CHUNK_BYTES; off += rate) {
+        for(unsigned int l = 0; l < n; l ++) {
+            KeccakF1600_StateXORBytes(A[l], 0, in + l*K12_CHUNK_BYTES + off, rate);
+        }
+        k12_permute_n(A, n);
+    }
+
+    for(unsigned int l = 0; l < n; l ++) {
+        KeccakF1600_StateXORBytes(A[l], 0, in + l*K12_CHUNK_BYTES + off, rem);
+        KeccakF1600_StateXORBytes(A[l], rem     , &suffix, 1);
+        KeccakF1600_StateXORBytes(A[l], rate - 1, &pad   , 1);
+    }
+
+    k12_permute_n(A, n);
+
+    for(unsigned int l = 0; l < n; l ++) {
+        KeccakF1600_StateExtractBytes(A[l], 0, cvs + l*K12_CV_BYTES, K12_CV_BYTES);
+    }
+}
+
+void k12_leaf_cvs (
+    const uint8_t * in    ,
+    uint64_t        n     ,
+    uint8_t       * cvs
+){
+    while(n > 0) {
+        unsigned int lanes = n >= 4 ? 4 : (n >= 2 ? 2 : 1);
+        k12_leaves(in, lanes, cvs);
+        in  += (uint64_t)lanes * K12_CHUNK_BYTES;
+        cvs += lanes * K12_CV_BYTES;
+        n   -= lanes;
+    }
+}
+
+static void turboshake(
+    unsigned int    rate   ,
+    const uint8_t * in     ,
+    uint64_t        inlen  ,
+    uint8_t         D      ,
+    uint8_t       * out    ,
+    uint64_t        outlen
+){
+    keccak_ctx_t ctx;
+    keccak_init_rounds(&ctx, rate, D, KECCAK_ROUNDS_P1600_12);
+    keccak_absorb     (&ctx, in , inlen );
+    keccak_finalize   (&ctx);
+    keccak_squeeze    (&ctx, out, outlen);
+}
+
+void TurboSHAKE128 (
+    const uint8_t * in     ,
+    uint64_t        inlen  ,
+    uint8_t         D      ,
+    uint8_t       * out    ,
+    uint64_t        outlen
+){
+    turboshake(KECCAK_RATE_SHAKE128, in, inlen, D, out, outlen);
+}
+
+void TurboSHAKE256 (
+    const uint8_t * in     ,
+    uint64_t        inlen  ,
+    uint8_t         D      ,
+    uint8_t       * out    ,
+    uint64_t        outlen
+){
+    turboshake(KECCAK_RATE_SHAKE256, in, inlen, D, out, outlen);
+}
+
+void k12_init (
+    k12_ctx_t     * ctx
+){
+    keccak_init_rounds(&ctx->final, KECCAK_RATE_SHAKE128, K12_SUFFIX_SINGLE,
+                       KECCAK_ROUNDS_P1600_12);
+    ctx->total = 0;
+    ctx->ncv   = 0;
+}
+
+//! Byte offset of the next message byte within the current leaf.
+static inline uint64_t k12_leaf_offset(k12_ctx_t * ctx) {
+    return (ctx->total - K12_CHUNK_BYTES) % K12_CHUNK_BYTES;
+}
+
+//! Called before the first leaf byte or CV: close off the first chunk.
+static inline void k12_begin_leaves(k12_ctx_t * ctx) {
+    if(ctx->total == K12_CHUNK_BYTES) {
+        keccak_absorb(&ctx->final, k12_marker, sizeof(k12_marker));
+    }
+}
+
+//! Finish the leaf in ctx->leaf and absorb its CV into the final node.
+static void k12_end_leaf(k12_ctx_t * ctx) {
+    uint8_t cv [K12_CV_BYTES];
+    keccak_finalize(&ctx->leaf);
+    keccak_squeeze (&ctx->leaf, cv, K12_CV_BYTES);
+    keccak_absorb  (&ctx->final, cv, K12_CV_BYTES);
+    ctx->ncv ++;
+}
+
+void k12_absorb (
+    k12_ctx_t     * ctx   ,
+    const uint8_t * in    ,
+    uint64_t        len
+){
+    uint8_t cvs [K12_LEAF_LANES * K12_CV_BYTES];
+
+    while(len > 0) {
+
+        uint64_t take;
+
+        if(ctx->total < K12_CHUNK_BYTES) {
+
+            take = K12_CHUNK_BYTES - ctx->total;
+            take = take < len ? take : len;
+            keccak_absorb(&ctx->final, in, take);
+
+        } else {
+
+            uint64_t off = k12_leaf_offset(ctx);
+
+            k12_begin_leaves(ctx);
+
+            if(off == 0 && len >= K12_CHUNK_BYTES) {
+                // Whole leaves in the caller's buffer: no copy, 4 at once.
+                uint64_t n = len / K12_CHUNK_BYTES;
+                n    = n < K12_LEAF_LANES ? n : K12_LEAF_LANES;
+                take = n * K12_CHUNK_BYTES;
+                k12_leaf_cvs(in, n, cvs);
+                keccak_absorb(&ctx->final, cvs, n * K12_CV_BYTES);
+                ctx->ncv += n;
+            } else {
+                if(off == 0) {
+                    keccak_init_rounds(&ctx->leaf, KECCAK_RATE_SHAKE128,
+                        K12_SUFFIX_LEAF, KECCAK_ROUNDS_P1600_12);
+                }
+                take = K12_CHUNK_BYTES - off;
+                take = take < len ? take : len;
+                keccak_absorb(&ctx->leaf, in, take);
+                if(off + take == K12_CHUNK_BYTES) {
+                    k12_end_leaf(ctx);
+                }
+            }
+        }
+
+        in         += take;
+        len        -= take;
+        ctx->total += take;
+    }
+}
+
+int  k12_absorb_cvs (
+    k12_ctx_t     * ctx   ,
+    const uint8_t * cvs   ,
+    uint64_t        n
+){
+    if(ctx->total < K12_CHUNK_BYTES || k12_leaf_offset(ctx) != 0) {
+        return 1;
+    }
+
+    if(n > 0) {
+        k12_begin_leaves(ctx);
+        keccak_absorb(&ctx->final, cvs, n * K12_CV_BYTES);
+        ctx->ncv   += n;
+        ctx->total += n * K12_CHUNK_BYTES;
+    }
+
+    return 0;
+}
+
+void k12_finalize (
+    k12_ctx_t     * ctx   ,
+    const uint8_t * custom,
+    uint64_t        clen
+){
+    uint8_t      enc [9];
+    unsigned int enc_len;
+
+    enc_len = k12_length_encode(enc, clen);
+    k12_absorb(ctx, custom, clen   );
+    k12_absorb(ctx, enc   , enc_len);
+
+    if(ctx->total > K12_CHUNK_BYTES) {
+
+        if(k12_leaf_offset(ctx) != 0) {
+            k12_end_leaf(ctx);
+        }
+
+        enc_len = k12_length_encode(enc, ctx->ncv);
+        keccak_absorb(&ctx->final, enc, enc_len);
+        keccak_absorb(&ctx->final, k12_terminator, sizeof(k12_terminator));
+
+        ctx->final.suffix = K12_SUFFIX_FINAL;
+    }
+
+    keccak_finalize(&ctx->final);
+}
+
+void k12_squeeze (
+    k12_ctx_t     * ctx   ,
+    uint8_t       * out   ,
+    uint64_t        len
+){
+    keccak_squeeze(&ctx->final, out, len);
+}
+
+void KangarooTwelve (
+    const uint8_t * in     ,
+    uint64_t        inlen  ,
+    const uint8_t * custom ,
+    uint64_t        clen   ,
+    uint8_t       * out    ,
+    uint64_t        outlen
+){
+    k12_ctx_t ctx;
+    k12_init    (&ctx);
+    k12_absorb  (&ctx, in, inlen);
+    k12_finalize(&ctx, custom, clen);
+    k12_squeeze (&ctx, out, outlen);
+}
+
+/*! @} */
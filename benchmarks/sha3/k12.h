@@ -0,0 +1,131 @@
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "riscvcrypto/sha3/Keccak.h"
+
+#ifndef __K12_H__
+#define __K12_H__
+
+/*!
+@defgroup crypto_hash_k12 Crypto Hash TurboSHAKE and KangarooTwelve
+@brief TurboSHAKE and KangarooTwelve (KT128), as in RFC 9861.
+@details Both use Keccak-p[1600,12], half the rounds of SHA-3.
+    KangarooTwelve cuts long inputs into 8 KiB leaves which are hashed
+    independently, so four leaves at a time go through
+    KeccakP1600_StatePermute_12rounds_x4.
+@ingroup crypto_hash_sha3
+@{
+*/
+
+//! Size in bytes of a KangarooTwelve chunk (the first chunk and each leaf).
+#define K12_CHUNK_BYTES         8192
+
+//! Size in bytes of a leaf's chaining value.
+#define K12_CV_BYTES            32
+
+//! Leaves hashed side by side by k12_leaf_cvs and k12_absorb.
+#define K12_LEAF_LANES          4
+
+//! Default domain separation byte of TurboSHAKE, in 0x01..0x7F.
+#define TURBOSHAKE_DEFAULT_D    0x1F
+
+//! TurboSHAKE128 of in, with domain separation byte D.
+void TurboSHAKE128 (
+    const uint8_t * in     , //!< Input bytes.
+    uint64_t        inlen  , //!< Length of in.
+    uint8_t         D      , //!< Domain separation byte, 0x01..0x7F.
+    uint8_t       * out    , //!< Output bytes.
+    uint64_t        outlen   //!< Number of bytes to output.
+);
+
+//! TurboSHAKE256 of in, with domain separation byte D.
+void TurboSHAKE256 (
+    const uint8_t * in     , //!< Input bytes.
+    uint64_t        inlen  , //!< Length of in.
+    uint8_t         D      , //!< Domain separation byte, 0x01..0x7F.
+    uint8_t       * out    , //!< Output bytes.
+    uint64_t        outlen   //!< Number of bytes to output.
+);
+
+/*!
+@brief State of an incremental KangarooTwelve computation.
+@details Input goes into the final node until the first chunk is full.
+    After that it is cut into leaves. Whole leaves found in the caller's
+    buffer are hashed four at a time; a leaf split across calls is
+    absorbed into leaf.
+*/
+typedef struct {
+    keccak_ctx_t    final    ; //!< Final node: first chunk, then CVs.
+    keccak_ctx_t    leaf     ; //!< The leaf being absorbed.
+    uint64_t        total    ; //!< Bytes of message absorbed.
+    uint64_t        ncv      ; //!< Number of CVs absorbed into final.
+} k12_ctx_t;
+
+//! Begin a KangarooTwelve computation.
+void k12_init (
+    k12_ctx_t     * ctx      //!< out - Context to initialise.
+);
+
+//! Absorb len bytes of the message.
+void k12_absorb (
+    k12_ctx_t     * ctx   , //!< in,out - Context.
+    const uint8_t * in    , //!< in - Message bytes. Any alignment.
+    uint64_t        len     //!< Length of in, in bytes.
+);
+
+/*!
+@brief Absorb n leaves which the caller has already reduced to CVs.
+@details The leaves of KangarooTwelve are independent, so a caller with
+    several harts can split a long message over them, each running
+    k12_leaf_cvs on its own range of leaves, and then pass the CVs here in
+    order. Only valid once exactly K12_CHUNK_BYTES plus a whole number of
+    leaves have been absorbed, i.e. on a leaf boundary past the first
+    chunk.
+@returns 0 on success, non-zero if ctx is not on a leaf boundary.
+*/
+int  k12_absorb_cvs (
+    k12_ctx_t     * ctx   , //!< in,out - Context.
+    const uint8_t * cvs   , //!< in - n CVs of K12_CV_BYTES each.
+    uint64_t        n       //!< Number of leaves the CVs stand for.
+);
+
+//! Absorb the customization string and switch to squeezing.
+void k12_finalize (
+    k12_ctx_t     * ctx   , //!< in,out - Context.
+    const uint8_t * custom, //!< in - Customization string.
+    uint64_t        clen    //!< Length of custom. May be zero.
+);
+
+//! Squeeze len more bytes of output.
+void k12_squeeze (
+    k12_ctx_t     * ctx   , //!< in,out - Finalized context.
+    uint8_t       * out   , //!< out - Output bytes. Any alignment.
+    uint64_t        len     //!< Number of bytes to squeeze.
+);
+
+/*!
+@brief The CVs of n consecutive whole leaves.
+@details Hashes K12_LEAF_LANES leaves per call of the multi-state
+    permutation. Leaves are independent, so disjoint ranges of a message
+    may be given to different harts.
+*/
+void k12_leaf_cvs (
+    const uint8_t * in    , //!< in - n * K12_CHUNK_BYTES bytes of leaves.
+    uint64_t        n     , //!< Number of leaves.
+    uint8_t       * cvs     //!< out - n * K12_CV_BYTES bytes of CVs.
+);
+
+//! KangarooTwelve (KT128) of in with customization string custom.
+void KangarooTwelve (
+    const uint8_t * in     , //!< Input bytes.
+    uint64_t        inlen  , //!< Length of in.
+    const uint8_t * custom , //!< Customization string.
+    uint64_t        clen   , //!< Length of custom. May be zero.
+    uint8_t       * out    , //!< Output bytes.
+    uint64_t        outlen   //!< Number of bytes to output.
+);
+
+/*! @} */
+
+#endif // __K12_H__
@@ -0,0 +1,84 @@
+
+/*!
+@addtogroup crypto_hash_sha3
+@{
+*/
+
+#include "riscvcrypto/sha3/Keccak.h"
+
+/*
+The plain lane layout, shared by the backends which keep each lane in a
+uint64_t. At most one partial lane at each end of a call is handled a
+byte at a time. Everything between is moved whole lanes at a time.
+
+Lanes are read and written with memcpy, which is a plain (possibly
+misaligned) load or store on a little-endian hart, and little-endian is
+the lane byte order Keccak uses.
+*/
+
+//! Load a whole lane from any address.
+static inline uint64_t keccak_load_lane(const uint8_t * p) {
+    uint64_t x;
+    memcpy(&x, p, 8);
+    return x;
+}
+
+//! Load n < 8 bytes as the low bytes of a lane.
+static inline uint64_t keccak_load_part(const uint8_t * p, unsigned int n) {
+    uint64_t x = 0;
+    memcpy(&x, p, n);
+    return x;
+}
+
+void KeccakF1600_StateXORBytes (
+    uint64_t      * A   ,
+    unsigned int    pos ,
+    const uint8_t * in  ,
+    unsigned int    len
+){
+    unsigned int off = pos & 7;
+    uint64_t   * a   = A + pos / 8;
+
+    if(off) {
+        unsigned int n = 8 - off < len ? 8 - off : len;
+        *a++ ^= keccak_load_part(in, n) << (8 * off);
+        in   += n;
+        len  -= n;
+    }
+
+    for(; len >= 8; len -= 8, in += 8) {
+        *a++ ^= keccak_load_lane(in);
+    }
+
+    if(len) {
+        *a   ^= keccak_load_part(in, len);
+    }
+}
+
+void KeccakF1600_StateExtractBytes (
+    uint64_t      * A   ,
+    unsigned int    pos ,
+    uint8_t       * out ,
+    unsigned int    len
+){
+    unsigned int off = pos & 7;
+    uint64_t   * a   = A + pos / 8;
+
+    if(off) {
+        unsigned int n = 8 - off < len ? 8 - off : len;
+        uint64_t     x = *a++ >> (8 * off);
+        memcpy(out, &x, n);
+        out  += n;
+        len  -= n;
+    }
+
+    for(; len >= 8; len -= 8, out += 8) {
+        memcpy(out, a++, 8);
+    }
+
+    if(len) {
+        memcpy(out, a, len);
+    }
+}
+
+/*! @} */
@@ -0,0 +1,222 @@
+
+/*!
+@addtogroup crypto_hash_sha3
+@{
+*/
+
+#include "riscvcrypto/sha3/Keccak.h"
+
+//! Apply the context's permutation to its state.
+static inline void keccak_permute(keccak_ctx_t * ctx) {
+    if(ctx->rounds == KECCAK_ROUNDS_P1600_12) {
+        KeccakP1600_StatePermute_12rounds(ctx->A);
+    } else {
+        KeccakF1600_StatePermute(ctx->A);
+    }
+}
+
+void keccak_init_rounds (
+    keccak_ctx_t  * ctx   ,
+    unsigned int    rate  ,
+    uint8_t         suffix,
+    unsigned int    rounds
+){
+    memset(ctx->A, 0, sizeof(ctx->A));
+    ctx->rate      = rate;
+    ctx->pos       = 0;
+    ctx->suffix    = suffix;
+    ctx->squeezing = 0;
+    ctx->rounds    = rounds;
+}
+
+void keccak_init (
+    keccak_ctx_t  * ctx   ,
+    unsigned int    rate  ,
+    uint8_t         suffix
+){
+    keccak_init_rounds(ctx, rate, suffix, KECCAK_ROUNDS_F1600);
+}
+
+void keccak_absorb (
+    keccak_ctx_t  * ctx   ,
+    const uint8_t * in    ,
+    uint64_t        len
+){
+    if(ctx->squeezing) {
+        return;                         // Input after finalizing is ignored.
+    }
+
+    while(len > 0) {
+
+        unsigned int take = ctx->rate - ctx->pos;
+        take = take < len ? take : (unsigned int)len;
+
+        KeccakF1600_StateXORBytes(ctx->A, ctx->pos, in, take);
+
+        in       += take;
+        len      -= take;
+        ctx->pos += take;
+
+        if(ctx->pos == ctx->rate) {
+            keccak_permute(ctx);
+            ctx->pos = 0;
+        }
+    }
+}
+
+void keccak_finalize (
+    keccak_ctx_t  * ctx
+){
+    const uint8_t pad  = 0x80;
+    unsigned int  last = ctx->rate - 1;
+
+    if(ctx->squeezing) {
+        return;                         // Already finalized.
+    }
+
+    KeccakF1600_StateXORBytes(ctx->A, ctx->pos, &ctx->suffix, 1);
+
+    // If the delimiter's final bit is the last bit of the block, the
+    // second padding bit needs a block of its own.
+    if((ctx->suffix & 0x80) && ctx->pos == last) {
+        keccak_permute(ctx);
+    }
+
+    KeccakF1600_StateXORBytes(ctx->A, last, &pad, 1);
+
+    keccak_permute(ctx);
+
+    ctx->pos       = 0;
+    ctx->squeezing = 1;
+}
+
+void keccak_squeeze (
+    keccak_ctx_t  * ctx   ,
+    uint8_t       * out   ,
+    uint64_t        len
+){
+    if(!ctx->squeezing) {
+        keccak_finalize(ctx);
+    }
+
+    while(len > 0) {
+
+        if(ctx->pos == ctx->rate) {     // Permute only when more is wanted.
+            keccak_permute(ctx);
+            ctx->pos = 0;
+        }
+
+        unsigned int take = ctx->rate - ctx->pos;
+        take = take < len ? take : (unsigned int)len;
+
+        KeccakF1600_StateExtractBytes(ctx->A, ctx->pos, out, take);
+
+        out      += take;
+        len      -= take;
+        ctx->pos += take;
+    }
+}
+
+void shake128_x4_init (
+    shake128_x4_ctx_t * ctx
+){
+    memset(ctx->A, 0, sizeof(ctx->A));
+    ctx->pos       = 0;
+    ctx->squeezing = 0;
+}
+
+void shake128_x4_absorb (
+    shake128_x4_ctx_t * ctx   ,
+    const uint8_t     * in [4],
+    uint64_t            len
+){
+    uint64_t done = 0;
+
+    if(ctx->squeezing) {
+        return;                         // Input after finalizing is ignored.
+    }
+
+    while(done < len) {
+
+        unsigned int take = KECCAK_RATE_SHAKE128 - ctx->pos;
+        take = take < len - done ? take : (unsigned int)(len - done);
+
+        for(int l = 0; l < 4; l ++) {
+            KeccakF1600_StateXORBytes(ctx->A[l], ctx->pos, in[l] + done, take);
+        }
+
+        done     += take;
+        ctx->pos += take;
+
+        if(ctx->pos == KECCAK_RATE_SHAKE128) {
+            KeccakF1600_StatePermute_x4(ctx->A);
+            ctx->pos = 0;
+        }
+    }
+}
+
+void shake128_x4_finalize (
+    shake128_x4_ctx_t * ctx
+){
+    const uint8_t suffix = KECCAK_SUFFIX_SHAKE;
+    const uint8_t pad    = 0x80;
+
+    if(ctx->squeezing) {
+        return;                         // Already finalized.
+    }
+
+    for(int l = 0; l < 4; l ++) {       // The SHAKE suffix has no top bit.
+        KeccakF1600_StateXORBytes(ctx->A[l], ctx->pos, &suffix, 1);
+        KeccakF1600_StateXORBytes(ctx->A[l], KECCAK_RATE_SHAKE128-1, &pad, 1);
+    }
+
+    KeccakF1600_StatePermute_x4(ctx->A);
+
+    ctx->pos       = 0;
+    ctx->squeezing = 1;
+}
+
+void shake128_x4_squeeze (
+    shake128_x4_ctx_t * ctx    ,
+    uint8_t           * out [4],
+    uint64_t            len
+){
+    uint64_t done = 0;
+
+    if(!ctx->squeezing) {
+        shake128_x4_finalize(ctx);
+    }
+
+    while(done < len) {
+
+        if(ctx->pos == KECCAK_RATE_SHAKE128) {
+            KeccakF1600_StatePermute_x4(ctx->A);
+            ctx->pos = 0;
+        }
+
+        unsigned int take = KECCAK_RATE_SHAKE128 - ctx->pos;
+        take = take < len - done ? take : (unsigned int)(len - done);
+
+        for(int l = 0; l < 4; l ++) {
+            KeccakF1600_StateExtractBytes(ctx->A[l], ctx->pos, out[l] + done, take);
+        }
+
+        done     += take;
+        ctx->pos += take;
+    }
+}
+
+void Keccak(unsigned int rate, unsigned int capacity, const unsigned char *input, unsigned long long int inputByteLen, unsigned char delimitedSuffix, unsigned char *output, unsigned long long int outputByteLen)
+{
+    keccak_ctx_t ctx;
+
+    if (((rate + capacity) != 1600) || ((rate % 8) != 0))
+        return;
+
+    keccak_init    (&ctx, rate / 8, delimitedSuffix);
+    keccak_absorb  (&ctx, input , inputByteLen );
+    keccak_finalize(&ctx);
+    keccak_squeeze (&ctx, output, outputByteLen);
+}
+
+/*! @} */
@@ -92,13 +92,14 @@ static const unsigned int KeccakP1600RhoOffsets[25] =
 };
 
 /**
- * Function that computes the Keccak-f[1600] permutation on the given state.
+ * Function that computes Keccak-p[1600, nr], the last nr rounds of the
+ * Keccak-f[1600] permutation, on the given state.
  */
-static void KeccakF1600_StatePermute(void *state)
+static inline void KeccakP1600_StatePermute_nr(uint64_t *state, const int nr)
 {
     int round, x, y;
 
-    for(round=0; round<24; round++) {
+    for(round=24-nr; round<24; round++) {
         uint64_t C[5];
         uint64_t tempA[25];
         uint64_t D;
@@ -144,62 +145,88 @@ static void KeccakF1600_StatePermute(void *state)
 }
 
 /*
-================================================================
-A readable and compact implementation of the Keccak sponge functions
-that use the Keccak-f[1600] permutation.
-================================================================
+The multi-state permutations take each step across every state before
+moving on to the next step. The states are independent, so this gives the
+compiler several dependency chains to schedule side by side.
 */
+static inline void KeccakP1600_StatePermute_xN(
+    uint64_t (*s)[25], const int n, const int nr)
+{
+    int round, x, y, l;
 
-#define MIN(a, b) ((a) < (b) ? (a) : (b))
+    for(round=24-nr; round<24; round++) {
+        uint64_t C[4][5];
+        uint64_t tempA[4][25];
+        uint64_t D;
 
-void Keccak(unsigned int rate, unsigned int capacity, const unsigned char *input, unsigned long long int inputByteLen, unsigned char delimitedSuffix, unsigned char *output, unsigned long long int outputByteLen)
-{
-    uint8_t state[200];
-    unsigned int rateInBytes = rate/8;
-    unsigned int blockSize = 0;
-    unsigned int i;
-
-    if (((rate + capacity) != 1600) || ((rate % 8) != 0))
-        return;
-
-    /* === Initialize the state === */
-    memset(state, 0, sizeof(state));
-
-    /* === Absorb all the input blocks === */
-    while(inputByteLen > 0) {
-        blockSize = MIN(inputByteLen, rateInBytes);
-        for(i=0; i<blockSize; i++)
-            state[i] ^= input[i];
-        input += blockSize;
-        inputByteLen -= blockSize;
-
-        if (blockSize == rateInBytes) {
-            KeccakF1600_StatePermute(state);
-            blockSize = 0;
+        // Theta / Rho / Pi
+
+        for(l=0; l<n; l++) {
+            for(x=0; x<5; x++) {
+                C[l][x] = s[l][index(x, 0)] ^ s[l][index(x, 1)] ^
+                          s[l][index(x, 2)] ^ s[l][index(x, 3)] ^
+                          s[l][index(x, 4)] ;
+            }
         }
-    }
 
-    /* === Do the padding and switch to the squeezing phase === */
-    /* Absorb the last few bits and add the first bit of padding (which coincides with the delimiter in delimitedSuffix) */
-    state[blockSize] ^= delimitedSuffix;
-    /* If the first bit of padding is at position rate-1, we need a whole new block for the second bit of padding */
-    if (((delimitedSuffix & 0x80) != 0) && (blockSize == (rateInBytes-1)))
-        KeccakF1600_StatePermute(state);
-    /* Add the second bit of padding */
-    state[rateInBytes-1] ^= 0x80;
-    /* Switch to the squeezing phase */
-    KeccakF1600_StatePermute(state);
-
-    /* === Squeeze out all the output blocks === */
-    while(outputByteLen > 0) {
-        blockSize = MIN(outputByteLen, rateInBytes);
-        memcpy(output, state, blockSize);
-        output += blockSize;
-        outputByteLen -= blockSize;
-
-        if (outputByteLen > 0)
-            KeccakF1600_StatePermute(state);
+        for(l=0; l<n; l++) {
+            for(x=0; x<5; x++) {
+                D = ROL64(C[l][(x+1)%5], 1) ^ C[l][(x+4)%5];
+                for(y=0; y<5; y++) {
+                    tempA[l][index(0*x+1*y, 2*x+3*y)] =
+                        ROL64(s[l][index(x, y)] ^ D,
+                              KeccakP1600RhoOffsets[index(x, y)]);
+                }
+            }
+        }
+
+        // Chi
+
+        for(l=0; l<n; l++) {
+            for(y=0; y<5; y++) {
+                for(x=0; x<5; x++) {
+                    s[l][index(x, y)] = tempA[l][index(x, y)] ^
+                        ((~tempA[l][index(x+1, y)]) & tempA[l][index(x+2, y)]);
+                }
+            }
+        }
+
+        // Iota
+
+        for(l=0; l<n; l++) {
+            s[l][index(0, 0)] ^= KeccakP1600RoundConstants[round];
+        }
     }
 }
 
+void KeccakF1600_StatePermute(uint64_t *state)
+{
+    KeccakP1600_StatePermute_nr(state, 24);
+}
+
+void KeccakF1600_StatePermute_x2(uint64_t s[2][25])
+{
+    KeccakP1600_StatePermute_xN(s, 2, 24);
+}
+
+void KeccakF1600_StatePermute_x4(uint64_t s[4][25])
+{
+    KeccakP1600_StatePermute_xN(s, 4, 24);
+}
+
+void KeccakP1600_StatePermute_12rounds(uint64_t *state)
+{
+    KeccakP1600_StatePermute_nr(state, 12);
+}
+
+void KeccakP1600_StatePermute_12rounds_x2(uint64_t s[2][25])
+{
+    KeccakP1600_StatePermute_xN(s, 2, 12);
+}
+
+void KeccakP1600_StatePermute_12rounds_x4(uint64_t s[4][25])
+{
+    KeccakP1600_StatePermute_xN(s, 4, 12);
+}
+
 /*! @} */
@@ -0,0 +1,401 @@
+/*!
+@addtogroup crypto_hash_sp800_185
+@{
+*/
+
+#include "riscvcrypto/sha3/sp800_185.h"
+
+//! Delimited suffix of cSHAKE with a non-empty N or S: the bits 0,0.
+#define KECCAK_SUFFIX_CSHAKE    0x04
+
+static const uint8_t sp800_185_kmac         [] = "KMAC";
+static const uint8_t sp800_185_parallelhash [] = "ParallelHash";
+
+/*!
+@brief Write left_encode(x) (left = 1) or right_encode(x) (left = 0).
+@details x as big-endian bytes without leading zeros, but at least one,
+    with the number of those bytes before (left) or after (right) them.
+@returns The number of bytes written, at most 9.
+*/
+static unsigned int sp800_185_encode(uint8_t buf[9], uint64_t x, int left) {
+    unsigned int n = 1;
+    while(n < 8 && (x >> (8 * n)) != 0) {
+        n ++;
+    }
+    uint8_t * p = left ? buf + 1 : buf;
+    for(unsigned int i = 0; i < n; i ++) {
+        p[i] = (uint8_t)(x >> (8 * (n - 1 - i)));
+    }
+    buf[left ? 0 : n] = (uint8_t)n;
+    return n + 1;
+}
+
+//! Absorb left_encode(x).
+static void sp800_185_left_encode(keccak_ctx_t * ctx, uint64_t x) {
+    uint8_t buf [9];
+    keccak_absorb(ctx, buf, sp800_185_encode(buf, x, 1));
+}
+
+//! Absorb right_encode(x).
+static void sp800_185_right_encode(keccak_ctx_t * ctx, uint64_t x) {
+    uint8_t buf [9];
+    keccak_absorb(ctx, buf, sp800_185_encode(buf, x, 0));
+}
+
+//! Absorb encode_string(s): its length in bits, then s.
+static void sp800_185_encode_string(
+    keccak_ctx_t * ctx, const uint8_t * s, uint64_t len
+){
+    sp800_185_left_encode(ctx, len * 8);
+    keccak_absorb(ctx, s, len);
+}
+
+/*!
+@brief Absorb zeros up to the end of the block.
+@details Ends bytepad(X, rate). The X of SP 800-185 always starts with
+    left_encode(rate), so a block which has just been filled is the only
+    time no zeros are needed.
+*/
+static void sp800_185_pad_block(keccak_ctx_t * ctx) {
+    static const uint8_t zeros [KECCAK_STATE_BYTES] = {0};
+    if(ctx->pos != 0) {
+        keccak_absorb(ctx, zeros, ctx->rate - ctx->pos);
+    }
+}
+
+void cshake_init (
+    keccak_ctx_t  * ctx   ,
+    unsigned int    rate  ,
+    const uint8_t * N     ,
+    uint64_t        nlen  ,
+    const uint8_t * S     ,
+    uint64_t        slen
+){
+    if(nlen == 0 && slen == 0) {
+        keccak_init(ctx, rate, KECCAK_SUFFIX_SHAKE);
+        return;
+    }
+
+    keccak_init(ctx, rate, KECCAK_SUFFIX_CSHAKE);
+
+    // bytepad(encode_string(N) || encode_string(S), rate)
+    sp800_185_left_encode  (ctx, rate);
+    sp800_185_encode_string(ctx, N, nlen);
+    sp800_185_encode_string(ctx, S, slen);
+    sp800_185_pad_block    (ctx);
+}
+
+void kmac_init (
+    keccak_ctx_t  * ctx   ,
+    unsigned int    rate  ,
+    const uint8_t * K     ,
+    uint64_t        klen  ,
+    const uint8_t * S     ,
+    uint64_t        slen
+){
+    cshake_init(ctx, rate, sp800_185_kmac, sizeof(sp800_185_kmac) - 1,
+                S, slen);
+
+    // bytepad(encode_string(K), rate)
+    sp800_185_left_encode  (ctx, rate);
+    sp800_185_encode_string(ctx, K, klen);
+    sp800_185_pad_block    (ctx);
+}
+
+void kmac_finalize (
+    keccak_ctx_t  * ctx   ,
+    uint64_t        outlen
+){
+    sp800_185_right_encode(ctx, outlen * 8);
+    keccak_finalize(ctx);
+}
+
+//! Keccak-f[1600] on the first n of the states, n being 1, 2 or 4.
+static inline void parallelhash_permute_n(uint64_t (*A)[25], unsigned int n) {
+    if(n == 4) {
+        KeccakF1600_StatePermute_x4(A);
+    } else if(n == 2) {
+        KeccakF1600_StatePermute_x2(A);
+    } else {
+        KeccakF1600_StatePermute(A[0]);
+    }
+}
+
+//! SHAKE of n blocks of B bytes side by side, n being 1, 2 or 4.
+static void parallelhash_blocks(
+    unsigned int    rate,
+    const uint8_t * in  ,
+    uint64_t        B   ,
+    unsigned int    n   ,
+    uint8_t       * cvs
+){
+    const unsigned int cv_bytes = KECCAK_STATE_BYTES - rate;
+    const uint8_t      suffix   = KECCAK_SUFFIX_SHAKE;
+    const uint8_t      pad      = 0x80;
+    uint64_t           A [PARALLELHASH_LANES][25];
+    uint64_t           off;
+
+    memset(A, 0, sizeof(A[0]) * n);
+
+    for(off = 0; off + rate <= B; off += rate) {
+        for(unsigned int l = 0; l < n; l ++) {
+            KeccakF1600_StateXORBytes(A[l], 0, in + l * B + off, rate);
+        }
+        parallelhash_permute_n(A, n);
+    }
+
+    unsigned int rem = (unsigned int)(B - off);
+
+    for(unsigned int l = 0; l < n; l ++) {  // The SHAKE suffix has no top bit.
+        KeccakF1600_StateXORBytes(A[l], 0, in + l * B + off, rem);
+        KeccakF1600_StateXORBytes(A[l], rem     , &suffix, 1);
+        KeccakF1600_StateXORBytes(A[l], rate - 1, &pad   , 1);
+    }
+
+    parallelhash_permute_n(A, n);
+
+    for(unsigned int l = 0; l < n; l ++) {
+        KeccakF1600_StateExtractBytes(A[l], 0, cvs + l * cv_bytes, cv_bytes);
+    }
+}
+
+void parallelhash_block_cvs (
+    unsigned int         rate  ,
+    const uint8_t      * in    ,
+    uint64_t             B     ,
+    uint64_t             n     ,
+    uint8_t            * cvs
+){
+    const unsigned int cv_bytes = KECCAK_STATE_BYTES - rate;
+
+    while(n > 0) {
+        unsigned int lanes = n >= 4 ? 4 : (n >= 2 ? 2 : 1);
+        parallelhash_blocks(rate, in, B, lanes, cvs);
+        in  += lanes * B;
+        cvs += lanes * cv_bytes;
+        n   -= lanes;
+    }
+}
+
+int  parallelhash_init (
+    parallelhash_ctx_t * ctx   ,
+    unsigned int         rate  ,
+    uint64_t             B     ,
+    const uint8_t      * S     ,
+    uint64_t             slen
+){
+    if(B == 0) {
+        return 1;
+    }
+
+    cshake_init(&ctx->final, rate, sp800_185_parallelhash,
+                sizeof(sp800_185_parallelhash) - 1, S, slen);
+    sp800_185_left_encode(&ctx->final, B);
+
+    ctx->B   = B;
+    ctx->pos = 0;
+    ctx->n   = 0;
+
+    return 0;
+}
+
+//! Finish the block in ctx->block and absorb its CV into the final node.
+static void parallelhash_end_block(parallelhash_ctx_t * ctx) {
+    uint8_t      cv [KECCAK_STATE_BYTES];
+    unsigned int cv_bytes = KECCAK_STATE_BYTES - ctx->final.rate;
+    keccak_finalize(&ctx->block);
+    keccak_squeeze (&ctx->block, cv, cv_bytes);
+    keccak_absorb  (&ctx->final, cv, cv_bytes);
+    ctx->n ++;
+}
+
+void parallelhash_absorb (
+    parallelhash_ctx_t * ctx   ,
+    const uint8_t      * in    ,
+    uint64_t             len
+){
+    const unsigned int rate = ctx->final.rate;
+    uint8_t            cvs [PARALLELHASH_LANES * KECCAK_STATE_BYTES];
+
+    while(len > 0) {
+
+        uint64_t take;
+
+        if(ctx->pos == 0 && len >= ctx->B) {
+            // Whole blocks in the caller's buffer: no copy, 4 at once.
+            uint64_t n = len / ctx->B;
+            n    = n < PARALLELHASH_LANES ? n : PARALLELHASH_LANES;
+            take = n * ctx->B;
+            parallelhash_block_cvs(rate, in, ctx->B, n, cvs);
+            keccak_absorb(&ctx->final, cvs, n * (KECCAK_STATE_BYTES - rate));
+            ctx->n += n;
+        } else {
+            if(ctx->pos == 0) {
+                keccak_init(&ctx->block, rate, KECCAK_SUFFIX_SHAKE);
+            }
+            take = ctx->B - ctx->pos;
+            take = take < len ? take : len;
+            keccak_absorb(&ctx->block, in, take);
+            ctx->pos += take;
+            if(ctx->pos == ctx->B) {
+                parallelhash_end_block(ctx);
+                ctx->pos = 0;
+            }
+        }
+
+        in  += take;
+        len -= take;
+    }
+}
+
+int  parallelhash_absorb_cvs (
+    parallelhash_ctx_t * ctx   ,
+    const uint8_t      * cvs   ,
+    uint64_t             n
+){
+    if(ctx->pos != 0) {
+        return 1;
+    }
+
+    keccak_absorb(&ctx->final, cvs, n * (KECCAK_STATE_BYTES - ctx->final.rate));
+    ctx->n += n;
+
+    return 0;
+}
+
+void parallelhash_finalize (
+    parallelhash_ctx_t * ctx   ,
+    uint64_t             outlen
+){
+    if(ctx->pos != 0) {
+        parallelhash_end_block(ctx);
+        ctx->pos = 0;
+    }
+
+    sp800_185_right_encode(&ctx->final, ctx->n);
+    sp800_185_right_encode(&ctx->final, outlen * 8);
+    keccak_finalize(&ctx->final);
+}
+
+void parallelhash_squeeze (
+    parallelhash_ctx_t * ctx   ,
+    uint8_t            * out   ,
+    uint64_t             len
+){
+    keccak_squeeze(&ctx->final, out, len);
+}
+
+static void cshake(
+    unsigned int rate,
+    const uint8_t * in, uint64_t inlen, const uint8_t * N, uint64_t nlen,
+    const uint8_t * S, uint64_t slen, uint8_t * out, uint64_t outlen
+){
+    keccak_ctx_t ctx;
+    cshake_init    (&ctx, rate, N, nlen, S, slen);
+    keccak_absorb  (&ctx, in, inlen);
+    keccak_finalize(&ctx);
+    keccak_squeeze (&ctx, out, outlen);
+}
+
+void cSHAKE128 (
+    const uint8_t * in, uint64_t inlen, const uint8_t * N, uint64_t nlen,
+    const uint8_t * S, uint64_t slen, uint8_t * out, uint64_t outlen
+){
+    cshake(KECCAK_RATE_SHAKE128, in, inlen, N, nlen, S, slen, out, outlen);
+}
+
+void cSHAKE256 (
+    const uint8_t * in, uint64_t inlen, const uint8_t * N, uint64_t nlen,
+    const uint8_t * S, uint64_t slen, uint8_t * out, uint64_t outlen
+){
+    cshake(KECCAK_RATE_SHAKE256, in, inlen, N, nlen, S, slen, out, outlen);
+}
+
+static void kmac(
+    unsigned int rate, int xof,
+    const uint8_t * K, uint64_t klen, const uint8_t * in, uint64_t inlen,
+    const uint8_t * S, uint64_t slen, uint8_t * out, uint64_t outlen
+){
+    keccak_ctx_t ctx;
+    kmac_init     (&ctx, rate, K, klen, S, slen);
+    keccak_absorb (&ctx, in, inlen);
+    kmac_finalize (&ctx, xof ? 0 : outlen);
+    keccak_squeeze(&ctx, out, outlen);
+}
+
+void KMAC128 (
+    const uint8_t * K, uint64_t klen, const uint8_t * in, uint64_t inlen,
+    const uint8_t * S, uint64_t slen, uint8_t * out, uint64_t outlen
+){
+    kmac(KECCAK_RATE_SHAKE128, 0, K, klen, in, inlen, S, slen, out, outlen);
+}
+
+void KMAC256 (
+    const uint8_t * K, uint64_t klen, const uint8_t * in, uint64_t inlen,
+    const uint8_t * S, uint64_t slen, uint8_t * out, uint64_t outlen
+){
+    kmac(KECCAK_RATE_SHAKE256, 0, K, klen, in, inlen, S, slen, out, outlen);
+}
+
+void KMACXOF128 (
+    const uint8_t * K, uint64_t klen, const uint8_t * in, uint64_t inlen,
+    const uint8_t * S, uint64_t slen, uint8_t * out, uint64_t outlen
+){
+    kmac(KECCAK_RATE_SHAKE128, 1, K, klen, in, inlen, S, slen, out, outlen);
+}
+
+void KMACXOF256 (
+    const uint8_t * K, uint64_t klen, const uint8_t * in, uint64_t inlen,
+    const uint8_t * S, uint64_t slen, uint8_t * out, uint64_t outlen
+){
+    kmac(KECCAK_RATE_SHAKE256, 1, K, klen, in, inlen, S, slen, out, outlen);
+}
+
+static int  parallelhash(
+    unsigned int rate, int xof,
+    const uint8_t * in, uint64_t inlen, uint64_t B,
+    const uint8_t * S, uint64_t slen, uint8_t * out, uint64_t outlen
+){
+    parallelhash_ctx_t ctx;
+    if(parallelhash_init(&ctx, rate, B, S, slen)) {
+        return 1;
+    }
+    parallelhash_absorb  (&ctx, in, inlen);
+    parallelhash_finalize(&ctx, xof ? 0 : outlen);
+    parallelhash_squeeze (&ctx, out, outlen);
+    return 0;
+}
+
+int  ParallelHash128 (
+    const uint8_t * in, uint64_t inlen, uint64_t B,
+    const uint8_t * S, uint64_t slen, uint8_t * out, uint64_t outlen
+){
+    return parallelhash(KECCAK_RATE_SHAKE128, 0, in, inlen, B, S, slen,
+                        out, outlen);
+}
+
+int  ParallelHash256 (
+    const uint8_t * in, uint64_t inlen, uint64_t B,
+    const uint8_t * S, uint64_t slen, uint8_t * out, uint64_t outlen
+){
+    return parallelhash(KECCAK_RATE_SHAKE256, 0, in, inlen, B, S, slen,
+                        out, outlen);
+}
+
+int  ParallelHashXOF128 (
+    const uint8_t * in, uint64_t inlen, uint64_t B,
+    const uint8_t * S, uint64_t slen, uint8_t * out, uint64_t outlen
+){
+    return parallelhash(KECCAK_RATE_SHAKE128, 1, in, inlen, B, S, slen,
+                        out, outlen);
+}
+
+int  ParallelHashXOF256 (
+    const uint8_t * in, uint64_t inlen, uint64_t B,
+    const uint8_t * S, uint64_t slen, uint8_t * out, uint64_t outlen
+){
+    return parallelhash(KECCAK_RATE_SHAKE256, 1, in, inlen, B, S, slen,
+                        out, outlen);
+}
+
+/*! @} */
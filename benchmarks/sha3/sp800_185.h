@@ -0,0 +1,196 @@
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "riscvcrypto/sha3/Keccak.h"
+
+#ifndef __SP800_185_H__
+#define __SP800_185_H__
+
+/*!
+@defgroup crypto_hash_sp800_185 Crypto Hash cSHAKE, KMAC and ParallelHash
+@brief The SHA-3 derived functions of NIST SP 800-185.
+@details cSHAKE and KMAC set up a keccak_ctx_t, after which the message
+    is absorbed and the output squeezed with keccak_absorb and
+    keccak_squeeze. ParallelHash has a context of its own, which hashes
+    whole blocks found in the caller's buffer four at a time with
+    KeccakF1600_StatePermute_x4.
+
+    Output lengths are given in bytes. The bit lengths encoded into the
+    hash are eight times those.
+@ingroup crypto_hash_sha3
+@{
+*/
+
+//! Blocks hashed side by side by parallelhash_block_cvs.
+#define PARALLELHASH_LANES      4
+
+/*!
+@brief Begin cSHAKE with function name N and customization string S.
+@details With N and S both empty this is SHAKE, as the standard says.
+*/
+void cshake_init (
+    keccak_ctx_t  * ctx   , //!< out - Context to initialise.
+    unsigned int    rate  , //!< KECCAK_RATE_SHAKE128 or KECCAK_RATE_SHAKE256
+    const uint8_t * N     , //!< in - Function name.
+    uint64_t        nlen  , //!< Length of N in bytes.
+    const uint8_t * S     , //!< in - Customization string.
+    uint64_t        slen    //!< Length of S in bytes.
+);
+
+//! Begin KMAC with key K and customization string S.
+void kmac_init (
+    keccak_ctx_t  * ctx   , //!< out - Context to initialise.
+    unsigned int    rate  , //!< KECCAK_RATE_SHAKE128 or KECCAK_RATE_SHAKE256
+    const uint8_t * K     , //!< in - Key.
+    uint64_t        klen  , //!< Length of K in bytes.
+    const uint8_t * S     , //!< in - Customization string.
+    uint64_t        slen    //!< Length of S in bytes.
+);
+
+/*!
+@brief Bind the output length into a KMAC and switch to squeezing.
+@details outlen is 0 for KMACXOF, which may then be squeezed to any length.
+*/
+void kmac_finalize (
+    keccak_ctx_t  * ctx   , //!< in,out - Context.
+    uint64_t        outlen  //!< Output length in bytes, or 0 for KMACXOF.
+);
+
+/*!
+@brief State of an incremental ParallelHash computation.
+@details The message is cut into blocks of B bytes. Each block is hashed
+    with SHAKE to a CV of twice the security level, and the CVs go into
+    the final cSHAKE.
+*/
+typedef struct {
+    keccak_ctx_t    final    ; //!< cSHAKE over the encoded CVs.
+    keccak_ctx_t    block    ; //!< The block being absorbed.
+    uint64_t        B        ; //!< Block size in bytes.
+    uint64_t        pos      ; //!< Bytes absorbed into the current block.
+    uint64_t        n        ; //!< Number of CVs absorbed into final.
+} parallelhash_ctx_t;
+
+/*!
+@brief Begin ParallelHash with block size B and customization string S.
+@returns 0 on success, non-zero if B is zero.
+*/
+int  parallelhash_init (
+    parallelhash_ctx_t * ctx   , //!< out - Context to initialise.
+    unsigned int         rate  , //!< KECCAK_RATE_SHAKE128 or 256.
+    uint64_t             B     , //!< Block size in bytes.
+    const uint8_t      * S     , //!< in - Customization string.
+    uint64_t             slen    //!< Length of S in bytes.
+);
+
+//! Absorb len bytes of the message.
+void parallelhash_absorb (
+    parallelhash_ctx_t * ctx   , //!< in,out - Context.
+    const uint8_t      * in    , //!< in - Message bytes. Any alignment.
+    uint64_t             len     //!< Length of in, in bytes.
+);
+
+/*!
+@brief The CVs of n consecutive whole blocks of B bytes.
+@details Hashes PARALLELHASH_LANES blocks per permutation call. Blocks
+    are independent, so a caller with several harts can give each a
+    disjoint range, and pass the CVs to parallelhash_absorb_cvs in order.
+    Each CV is KECCAK_STATE_BYTES - rate bytes.
+*/
+void parallelhash_block_cvs (
+    unsigned int         rate  , //!< KECCAK_RATE_SHAKE128 or 256.
+    const uint8_t      * in    , //!< in - n * B bytes of blocks.
+    uint64_t             B     , //!< Block size in bytes.
+    uint64_t             n     , //!< Number of blocks.
+    uint8_t            * cvs     //!< out - The CVs of the n blocks.
+);
+
+/*!
+@brief Absorb n blocks which the caller has already reduced to CVs.
+@returns 0 on success, non-zero if ctx is part way through a block.
+*/
+int  parallelhash_absorb_cvs (
+    parallelhash_ctx_t * ctx   , //!< in,out - Context.
+    const uint8_t      * cvs   , //!< in - n CVs from parallelhash_block_cvs.
+    uint64_t             n       //!< Number of blocks the CVs stand for.
+);
+
+//! Finish the last block, bind the output length and switch to squeezing.
+void parallelhash_finalize (
+    parallelhash_ctx_t * ctx   , //!< in,out - Context.
+    uint64_t             outlen  //!< Output length in bytes, or 0 for XOF.
+);
+
+//! Squeeze len more bytes of output.
+void parallelhash_squeeze (
+    parallelhash_ctx_t * ctx   , //!< in,out - Finalized context.
+    uint8_t            * out   , //!< out - Output bytes.
+    uint64_t             len     //!< Number of bytes to squeeze.
+);
+
+//! cSHAKE128 of in, with function name N and customization string S.
+void cSHAKE128 (
+    const uint8_t * in, uint64_t inlen, const uint8_t * N, uint64_t nlen,
+    const uint8_t * S, uint64_t slen, uint8_t * out, uint64_t outlen
+);
+
+//! cSHAKE256 of in, with function name N and customization string S.
+void cSHAKE256 (
+    const uint8_t * in, uint64_t inlen, const uint8_t * N, uint64_t nlen,
+    const uint8_t * S, uint64_t slen, uint8_t * out, uint64_t outlen
+);
+
+//! KMAC128 of in under key K, with customization string S.
+void KMAC128 (
+    const uint8_t * K, uint64_t klen, const uint8_t * in, uint64_t inlen,
+    const uint8_t * S, uint64_t slen, uint8_t * out, uint64_t outlen
+);
+
+//! KMAC256 of in under key K, with customization string S.
+void KMAC256 (
+    const uint8_t * K, uint64_t klen, const uint8_t * in, uint64_t inlen,
+    const uint8_t * S, uint64_t slen, uint8_t * out, uint64_t outlen
+);
+
+//! KMACXOF128: as KMAC128, but the output length is not bound in.
+void KMACXOF128 (
+    const uint8_t * K, uint64_t klen, const uint8_t * in, uint64_t inlen,
+    const uint8_t * S, uint64_t slen, uint8_t * out, uint64_t outlen
+);
+
+//! KMACXOF256: as KMAC256, but the output length is not bound in.
+void KMACXOF256 (
+    const uint8_t * K, uint64_t klen, const uint8_t * in, uint64_t inlen,
+    const uint8_t * S, uint64_t slen, uint8_t * out, uint64_t outlen
+);
+
+/*!
+@brief ParallelHash128 of in, with block size B and customization S.
+@returns 0 on success, non-zero if B is zero.
+*/
+int  ParallelHash128 (
+    const uint8_t * in, uint64_t inlen, uint64_t B,
+    const uint8_t * S, uint64_t slen, uint8_t * out, uint64_t outlen
+);
+
+//! ParallelHash256 of in, with block size B and customization S.
+int  ParallelHash256 (
+    const uint8_t * in, uint64_t inlen, uint64_t B,
+    const uint8_t * S, uint64_t slen, uint8_t * out, uint64_t outlen
+);
+
+//! ParallelHashXOF128: the output length is not bound in.
+int  ParallelHashXOF128 (
+    const uint8_t * in, uint64_t inlen, uint64_t B,
+    const uint8_t * S, uint64_t slen, uint8_t * out, uint64_t outlen
+);
+
+//! ParallelHashXOF256: the output length is not bound in.
+int  ParallelHashXOF256 (
+    const uint8_t * in, uint64_t inlen, uint64_t B,
+    const uint8_t * S, uint64_t slen, uint8_t * out, uint64_t outlen
+);
+
+/*! @} */
+
+#endif // __SP800_185_H__
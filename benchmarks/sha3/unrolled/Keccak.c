@@ -0,0 +1,274 @@
+/*!
+@addtogroup crypto_hash_sha3_unrolled SHA3 Unrolled
+@brief Keccak-f[1600] for baseline cores, without Zbkb.
+@details Every round is written out, with the 25 lanes held in local
+    variables so the compiler can keep them in registers, and the rho
+    rotations and pi moves resolved at compile time.
+
+    Chi computes a ^ (~b & c) for every lane, which is one NOT per lane
+    on a core without andn. Lane complementing removes most of these:
+    lanes 1, 2, 8, 12, 17 and 20 are held inverted during the
+    permutation, and each chi is rewritten to use AND or OR on the
+    inverted inputs, leaving one NOT per plane. The lanes are inverted
+    on entry and exit, so the state in memory is the plain layout, and
+    keccak_bytes.c does the XOR and extract.
+@ingroup crypto_hash_sha3
+@{
+*/
+
+#include "riscvcrypto/sha3/Keccak.h"
+
+#define ROL64(a, offset) ((((uint64_t)a) << offset) ^ (((uint64_t)a) >> (64-offset)))
+
+static const uint64_t KeccakP1600RoundConstants[24] =
+{
+    0x0000000000000001,
+    0x0000000000008082,
+    0x800000000000808a,
+    0x8000000080008000,
+    0x000000000000808b,
+    0x0000000080000001,
+    0x8000000080008081,
+    0x8000000000008009,
+    0x000000000000008a,
+    0x0000000000000088,
+    0x0000000080008009,
+    0x000000008000000a,
+    0x000000008000808b,
+    0x800000000000008b,
+    0x8000000000008089,
+    0x8000000000008003,
+    0x8000000000008002,
+    0x8000000000000080,
+    0x000000000000800a,
+    0x800000008000000a,
+    0x8000000080008081,
+    0x8000000000008080,
+    0x0000000080000001,
+    0x8000000080008008,
+};
+
+/*!
+@brief Round i, from lanes A## into lanes E##.
+@details Lane names are A<row><column>, rows b g k m s for y = 0..4 and
+    columns a e i o u for x = 0..4. Each group of five B is one plane of
+    the output after rho and pi. The chi of each plane matches the lanes
+    complemented in its inputs and outputs.
+*/
+#define KECCAK_ROUND(A, E, i) {                                         \
+    Ca = A##ba ^ A##ga ^ A##ka ^ A##ma ^ A##sa;                         \
+    Ce = A##be ^ A##ge ^ A##ke ^ A##me ^ A##se;                         \
+    Ci = A##bi ^ A##gi ^ A##ki ^ A##mi ^ A##si;                         \
+    Co = A##bo ^ A##go ^ A##ko ^ A##mo ^ A##so;                         \
+    Cu = A##bu ^ A##gu ^ A##ku ^ A##mu ^ A##su;                         \
+    Da = Cu ^ ROL64(Ce, 1);                                             \
+    De = Ca ^ ROL64(Ci, 1);                                             \
+    Di = Ce ^ ROL64(Co, 1);                                             \
+    Do = Ci ^ ROL64(Cu, 1);                                             \
+    Du = Co ^ ROL64(Ca, 1);                                             \
+    Ba = A##ba ^ Da;                                                    \
+    Be = ROL64(A##ge ^ De, 44);                                         \
+    Bi = ROL64(A##ki ^ Di, 43);                                         \
+    Bo = ROL64(A##mo ^ Do, 21);                                         \
+    Bu = ROL64(A##su ^ Du, 14);                                         \
+    E##ba = Ba ^(  Be |  Bi );                                          \
+    E##be = Be ^((~Bi)|  Bo );                                          \
+    E##bi = Bi ^(  Bo &  Bu );                                          \
+    E##bo = Bo ^(  Bu |  Ba );                                          \
+    E##bu = Bu ^(  Ba &  Be );                                          \
+    Ba = ROL64(A##bo ^ Do, 28);                                         \
+    Be = ROL64(A##gu ^ Du, 20);                                         \
+    Bi = ROL64(A##ka ^ Da, 3);                                          \
+    Bo = ROL64(A##me ^ De, 45);                                         \
+    Bu = ROL64(A##si ^ Di, 61);                                         \
+    E##ga = Ba ^(  Be |  Bi );                                          \
+    E##ge = Be ^(  Bi &  Bo );                                          \
+    E##gi = Bi ^(  Bo |(~Bu));                                          \
+    E##go = Bo ^(  Bu |  Ba );                                          \
+    E##gu = Bu ^(  Ba &  Be );                                          \
+    Ba = ROL64(A##be ^ De, 1);                                          \
+    Be = ROL64(A##gi ^ Di, 6);                                          \
+    Bi = ROL64(A##ko ^ Do, 25);                                         \
+    Bo = ROL64(A##mu ^ Du, 8);                                          \
+    Bu = ROL64(A##sa ^ Da, 18);                                         \
+    E##ka = Ba ^(  Be |  Bi );                                          \
+    E##ke = Be ^(  Bi &  Bo );                                          \
+    E##ki = Bi ^((~Bo)&  Bu );                                          \
+    E##ko = (~Bo)^(  Bu |  Ba );                                        \
+    E##ku = Bu ^(  Ba &  Be );                                          \
+    Ba = ROL64(A##bu ^ Du, 27);                                         \
+    Be = ROL64(A##ga ^ Da, 36);                                         \
+    Bi = ROL64(A##ke ^ De, 10);                                         \
+    Bo = ROL64(A##mi ^ Di, 15);                                         \
+    Bu = ROL64(A##so ^ Do, 56);                                         \
+    E##ma = Ba ^(  Be &  Bi );                                          \
+    E##me = Be ^(  Bi |  Bo );                                          \
+    E##mi = Bi ^((~Bo)|  Bu );                                          \
+    E##mo = (~Bo)^(  Bu &  Ba );                                        \
+    E##mu = Bu ^(  Ba |  Be );                                          \
+    Ba = ROL64(A##bi ^ Di, 62);                                         \
+    Be = ROL64(A##go ^ Do, 55);                                         \
+    Bi = ROL64(A##ku ^ Du, 39);                                         \
+    Bo = ROL64(A##ma ^ Da, 41);                                         \
+    Bu = ROL64(A##se ^ De, 2);                                          \
+    E##sa = Ba ^((~Be)&  Bi );                                          \
+    E##se = (~Be)^(  Bi |  Bo );                                        \
+    E##si = Bi ^(  Bo &  Bu );                                          \
+    E##so = Bo ^(  Bu |  Ba );                                          \
+    E##su = Bu ^(  Ba &  Be );                                          \
+    E##ba ^= KeccakP1600RoundConstants[i];                              \
+}
+
+//! Rounds 0 to 11, from lanes A back into lanes A.
+#define KECCAK_ROUNDS_0_11                                              \
+    KECCAK_ROUND(A, E,  0)                                              \
+    KECCAK_ROUND(E, A,  1)                                              \
+    KECCAK_ROUND(A, E,  2)                                              \
+    KECCAK_ROUND(E, A,  3)                                              \
+    KECCAK_ROUND(A, E,  4)                                              \
+    KECCAK_ROUND(E, A,  5)                                              \
+    KECCAK_ROUND(A, E,  6)                                              \
+    KECCAK_ROUND(E, A,  7)                                              \
+    KECCAK_ROUND(A, E,  8)                                              \
+    KECCAK_ROUND(E, A,  9)                                              \
+    KECCAK_ROUND(A, E, 10)                                              \
+    KECCAK_ROUND(E, A, 11)
+
+//! Rounds 12 to 23, from lanes A back into lanes A.
+#define KECCAK_ROUNDS_12_23                                             \
+    KECCAK_ROUND(A, E, 12)                                              \
+    KECCAK_ROUND(E, A, 13)                                              \
+    KECCAK_ROUND(A, E, 14)                                              \
+    KECCAK_ROUND(E, A, 15)                                              \
+    KECCAK_ROUND(A, E, 16)                                              \
+    KECCAK_ROUND(E, A, 17)                                              \
+    KECCAK_ROUND(A, E, 18)                                              \
+    KECCAK_ROUND(E, A, 19)                                              \
+    KECCAK_ROUND(A, E, 20)                                              \
+    KECCAK_ROUND(E, A, 21)                                              \
+    KECCAK_ROUND(A, E, 22)                                              \
+    KECCAK_ROUND(E, A, 23)
+
+/**
+ * Function that computes Keccak-p[1600, nr], the last nr rounds of the
+ * Keccak-f[1600] permutation, on the given state. nr is 12 or 24.
+ */
+static inline void KeccakP1600_StatePermute_nr(uint64_t *s, const int nr)
+{
+    uint64_t Aba, Abe, Abi, Abo, Abu;
+    uint64_t Aga, Age, Agi, Ago, Agu;
+    uint64_t Aka, Ake, Aki, Ako, Aku;
+    uint64_t Ama, Ame, Ami, Amo, Amu;
+    uint64_t Asa, Ase, Asi, Aso, Asu;
+    uint64_t Eba, Ebe, Ebi, Ebo, Ebu;
+    uint64_t Ega, Ege, Egi, Ego, Egu;
+    uint64_t Eka, Eke, Eki, Eko, Eku;
+    uint64_t Ema, Eme, Emi, Emo, Emu;
+    uint64_t Esa, Ese, Esi, Eso, Esu;
+    uint64_t Ba, Be, Bi, Bo, Bu;
+    uint64_t Ca, Ce, Ci, Co, Cu;
+    uint64_t Da, De, Di, Do, Du;
+
+    Aba =  s[ 0];
+    Abe = ~s[ 1];
+    Abi = ~s[ 2];
+    Abo =  s[ 3];
+    Abu =  s[ 4];
+    Aga =  s[ 5];
+    Age =  s[ 6];
+    Agi =  s[ 7];
+    Ago = ~s[ 8];
+    Agu =  s[ 9];
+    Aka =  s[10];
+    Ake =  s[11];
+    Aki = ~s[12];
+    Ako =  s[13];
+    Aku =  s[14];
+    Ama =  s[15];
+    Ame =  s[16];
+    Ami = ~s[17];
+    Amo =  s[18];
+    Amu =  s[19];
+    Asa = ~s[20];
+    Ase =  s[21];
+    Asi =  s[22];
+    Aso =  s[23];
+    Asu =  s[24];
+
+    if(nr == 24) {
+        KECCAK_ROUNDS_0_11
+    }
+
+    KECCAK_ROUNDS_12_23
+
+    s[ 0] =  Aba;
+    s[ 1] = ~Abe;
+    s[ 2] = ~Abi;
+    s[ 3] =  Abo;
+    s[ 4] =  Abu;
+    s[ 5] =  Aga;
+    s[ 6] =  Age;
+    s[ 7] =  Agi;
+    s[ 8] = ~Ago;
+    s[ 9] =  Agu;
+    s[10] =  Aka;
+    s[11] =  Ake;
+    s[12] = ~Aki;
+    s[13] =  Ako;
+    s[14] =  Aku;
+    s[15] =  Ama;
+    s[16] =  Ame;
+    s[17] = ~Ami;
+    s[18] =  Amo;
+    s[19] =  Amu;
+    s[20] = ~Asa;
+    s[21] =  Ase;
+    s[22] =  Asi;
+    s[23] =  Aso;
+    s[24] =  Asu;
+}
+
+void KeccakF1600_StatePermute(uint64_t *s)
+{
+    KeccakP1600_StatePermute_nr(s, 24);
+}
+
+void KeccakP1600_StatePermute_12rounds(uint64_t *s)
+{
+    KeccakP1600_StatePermute_nr(s, 12);
+}
+
+/*
+One state already fills the register file of a baseline core, so the
+multi-state permutations run the states one after another.
+*/
+
+void KeccakF1600_StatePermute_x2(uint64_t s[2][25])
+{
+    KeccakF1600_StatePermute(s[0]);
+    KeccakF1600_StatePermute(s[1]);
+}
+
+void KeccakF1600_StatePermute_x4(uint64_t s[4][25])
+{
+    KeccakF1600_StatePermute(s[0]);
+    KeccakF1600_StatePermute(s[1]);
+    KeccakF1600_StatePermute(s[2]);
+    KeccakF1600_StatePermute(s[3]);
+}
+
+void KeccakP1600_StatePermute_12rounds_x2(uint64_t s[2][25])
+{
+    KeccakP1600_StatePermute_12rounds(s[0]);
+    KeccakP1600_StatePermute_12rounds(s[1]);
+}
+
+void KeccakP1600_StatePermute_12rounds_x4(uint64_t s[4][25])
+{
+    KeccakP1600_StatePermute_12rounds(s[0]);
+    KeccakP1600_StatePermute_12rounds(s[1]);
+    KeccakP1600_StatePermute_12rounds(s[2]);
+    KeccakP1600_StatePermute_12rounds(s[3]);
+}
+
+/*! @} */
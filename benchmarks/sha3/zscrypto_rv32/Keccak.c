@@ -0,0 +1,268 @@
+#include "riscvcrypto/sha3/Keccak.h"
+
+/*!
+@addtogroup crypto_hash_sha3_zscrypto_rv32 SHA3 RV32 Zbkb
+@brief Bit-interleaved Keccak-f[1600] for RV32 with Zbkb.
+@details Each 64-bit lane is held as two 32-bit words: the even numbered
+    bits of the lane, and the odd numbered bits. A 64-bit rotate of the
+    lane is then one 32-bit rotate of each word (swapping the two words
+    when the amount is odd), rather than the four shifts and two ORs per
+    half needed on the plain representation. Chi uses andn.
+
+    The conversion to and from the interleaved form is done when bytes
+    are XORed into or extracted from the state, using unzip and zip, so
+    the permutation itself never sees the plain representation.
+    Lane i of the state is the words ((uint32_t*)s)[2*i] (even bits) and
+    ((uint32_t*)s)[2*i+1] (odd bits).
+@ingroup crypto_hash_sha3
+@{
+*/
+
+static inline uint32_t rori32(uint32_t rs1, int i) {
+    uint32_t rd;
+    asm ("rori %0, %1, %2" : "=r"(rd) :"r"(rs1),"i"(i & 31));
+    return rd;
+}
+
+static inline uint32_t andn32(uint32_t rs1, uint32_t rs2) {
+    uint32_t rd;
+    asm ("andn %0, %1, %2" : "=r"(rd) :"r"(rs1),"r"(rs2));
+    return rd;
+}
+
+static inline uint32_t zip32(uint32_t rs1) {
+    uint32_t rd;
+    asm ("zip %0, %1" : "=r"(rd) :"r"(rs1));
+    return rd;
+}
+
+static inline uint32_t unzip32(uint32_t rs1) {
+    uint32_t rd;
+    asm ("unzip %0, %1" : "=r"(rd) :"r"(rs1));
+    return rd;
+}
+
+#define ROL32(a, offset) rori32(a, 32 - (offset))
+
+/*!
+@brief B[d] = ROL64(A[s], r) on interleaved lanes.
+@details Even r rotates both halves by r/2. Odd r swaps them: the even
+    bits of the result are the odd bits of the input rotated by (r+1)/2.
+*/
+#define KECCAK_ROL_LANE(B, d, A, s, r) {                                \
+    if((r) & 1) {                                                       \
+        B[2*(d)  ] = ROL32(A[2*(s)+1], ((r) + 1) / 2);                  \
+        B[2*(d)+1] = ROL32(A[2*(s)  ], ((r)    ) / 2);                  \
+    } else {                                                            \
+        B[2*(d)  ] = ROL32(A[2*(s)  ], (r) / 2);                        \
+        B[2*(d)+1] = ROL32(A[2*(s)+1], (r) / 2);                        \
+    }                                                                   \
+}
+
+//! Round constants, interleaved: {even bits, odd bits}.
+static const uint32_t KeccakP1600RoundConstantsInterleaved[24][2] =
+{
+    {0x00000001, 0x00000000}, {0x00000000, 0x00000089},
+    {0x00000000, 0x8000008b}, {0x00000000, 0x80008080},
+    {0x00000001, 0x0000008b}, {0x00000001, 0x00008000},
+    {0x00000001, 0x80008088}, {0x00000001, 0x80000082},
+    {0x00000000, 0x0000000b}, {0x00000000, 0x0000000a},
+    {0x00000001, 0x00008082}, {0x00000000, 0x00008003},
+    {0x00000001, 0x0000808b}, {0x00000001, 0x8000000b},
+    {0x00000001, 0x8000008a}, {0x00000001, 0x80000081},
+    {0x00000000, 0x80000081}, {0x00000000, 0x80000008},
+    {0x00000000, 0x00000083}, {0x00000000, 0x80008003},
+    {0x00000001, 0x80008088}, {0x00000000, 0x80000088},
+    {0x00000001, 0x00008000}, {0x00000000, 0x80008082},
+};
+
+/**
+ * Function that computes Keccak-p[1600, nr], the last nr rounds of the
+ * Keccak-f[1600] permutation, on the given bit-interleaved state.
+ */
+static inline void KeccakP1600_StatePermute_nr(uint64_t *s, const int nr)
+{
+    uint32_t * a = (uint32_t*)s;
+    uint32_t   B [50];
+    uint32_t   Ce[5], Co[5];
+
+    for(int round=24-nr; round<24; round++) {
+
+        // Theta
+
+        for(int x=0; x<5; x++) {
+            Ce[x] = a[2*x  ] ^ a[2*x+10] ^ a[2*x+20] ^ a[2*x+30] ^ a[2*x+40];
+            Co[x] = a[2*x+1] ^ a[2*x+11] ^ a[2*x+21] ^ a[2*x+31] ^ a[2*x+41];
+        }
+
+        for(int x=0; x<5; x++) {
+            // D = C[x-1] ^ ROL64(C[x+1], 1)
+            uint32_t De = Ce[(x+4)%5] ^ ROL32(Co[(x+1)%5], 1);
+            uint32_t Do = Co[(x+4)%5] ^       Ce[(x+1)%5]    ;
+            for(int y=0; y<5; y++) {
+                a[2*(x+5*y)  ] ^= De;
+                a[2*(x+5*y)+1] ^= Do;
+            }
+        }
+
+        // Rho and Pi
+
+        KECCAK_ROL_LANE(B,  0, a,  0,  0);
+        KECCAK_ROL_LANE(B, 10, a,  1,  1);
+        KECCAK_ROL_LANE(B, 20, a,  2, 62);
+        KECCAK_ROL_LANE(B,  5, a,  3, 28);
+        KECCAK_ROL_LANE(B, 15, a,  4, 27);
+        KECCAK_ROL_LANE(B, 16, a,  5, 36);
+        KECCAK_ROL_LANE(B,  1, a,  6, 44);
+        KECCAK_ROL_LANE(B, 11, a,  7,  6);
+        KECCAK_ROL_LANE(B, 21, a,  8, 55);
+        KECCAK_ROL_LANE(B,  6, a,  9, 20);
+        KECCAK_ROL_LANE(B,  7, a, 10,  3);
+        KECCAK_ROL_LANE(B, 17, a, 11, 10);
+        KECCAK_ROL_LANE(B,  2, a, 12, 43);
+        KECCAK_ROL_LANE(B, 12, a, 13, 25);
+        KECCAK_ROL_LANE(B, 22, a, 14, 39);
+        KECCAK_ROL_LANE(B, 23, a, 15, 41);
+        KECCAK_ROL_LANE(B,  8, a, 16, 45);
+        KECCAK_ROL_LANE(B, 18, a, 17, 15);
+        KECCAK_ROL_LANE(B,  3, a, 18, 21);
+        KECCAK_ROL_LANE(B, 13, a, 19,  8);
+        KECCAK_ROL_LANE(B, 14, a, 20, 18);
+        KECCAK_ROL_LANE(B, 24, a, 21,  2);
+        KECCAK_ROL_LANE(B,  9, a, 22, 61);
+        KECCAK_ROL_LANE(B, 19, a, 23, 56);
+        KECCAK_ROL_LANE(B,  4, a, 24, 14);
+
+        // Chi
+
+        for(int y=0; y<5; y++) {
+            for(int x=0; x<5; x++) {
+                int i0 = 2*(5*y +  x       );
+                int i1 = 2*(5*y + (x+1) % 5);
+                int i2 = 2*(5*y + (x+2) % 5);
+                a[i0  ] = B[i0  ] ^ andn32(B[i2  ], B[i1  ]);
+                a[i0+1] = B[i0+1] ^ andn32(B[i2+1], B[i1+1]);
+            }
+        }
+
+        // Iota
+
+        a[0] ^= KeccakP1600RoundConstantsInterleaved[round][0];
+        a[1] ^= KeccakP1600RoundConstantsInterleaved[round][1];
+    }
+}
+
+void KeccakF1600_StatePermute(uint64_t *s)
+{
+    KeccakP1600_StatePermute_nr(s, 24);
+}
+
+void KeccakP1600_StatePermute_12rounds(uint64_t *s)
+{
+    KeccakP1600_StatePermute_nr(s, 12);
+}
+
+/*
+Two bit-interleaved states need 100 words, far beyond the register file,
+so the multi-state permutations gain nothing from interleaving rounds
+here. They are provided so the shake128_x4 API works on this backend.
+*/
+
+void KeccakF1600_StatePermute_x2(uint64_t s[2][25])
+{
+    KeccakF1600_StatePermute(s[0]);
+    KeccakF1600_StatePermute(s[1]);
+}
+
+void KeccakF1600_StatePermute_x4(uint64_t s[4][25])
+{
+    KeccakF1600_StatePermute(s[0]);
+    KeccakF1600_StatePermute(s[1]);
+    KeccakF1600_StatePermute(s[2]);
+    KeccakF1600_StatePermute(s[3]);
+}
+
+void KeccakP1600_StatePermute_12rounds_x2(uint64_t s[2][25])
+{
+    KeccakP1600_StatePermute_12rounds(s[0]);
+    KeccakP1600_StatePermute_12rounds(s[1]);
+}
+
+void KeccakP1600_StatePermute_12rounds_x4(uint64_t s[4][25])
+{
+    KeccakP1600_StatePermute_12rounds(s[0]);
+    KeccakP1600_StatePermute_12rounds(s[1]);
+    KeccakP1600_StatePermute_12rounds(s[2]);
+    KeccakP1600_StatePermute_12rounds(s[3]);
+}
+
+//! XOR the plain lane {lo, hi} into interleaved lane a[0], a[1].
+static inline void keccak_xor_lane(uint32_t * a, uint32_t lo, uint32_t hi) {
+    uint32_t l = unzip32(lo);           // Odd bits high, even bits low.
+    uint32_t h = unzip32(hi);
+    a[0] ^= (l & 0x0000FFFF) | (h << 16);
+    a[1] ^= (l >> 16) | (h & 0xFFFF0000);
+}
+
+//! Convert interleaved lane a[0], a[1] back to the plain {lo, hi}.
+static inline void keccak_get_lane(uint32_t * a, uint32_t * lo, uint32_t * hi) {
+    *lo = zip32((a[0] & 0x0000FFFF) | (a[1] << 16));
+    *hi = zip32((a[0] >> 16) | (a[1] & 0xFFFF0000));
+}
+
+void KeccakF1600_StateXORBytes(
+    uint64_t      * s     ,
+    unsigned int    offset,
+    const uint8_t * data  ,
+    unsigned int    length
+){
+    uint32_t   * a   = (uint32_t*)s + 2 * (offset / 8);
+    unsigned int off = offset & 7;
+    uint32_t     w [2];
+
+    while(length > 0) {
+
+        unsigned int n = 8 - off < length ? 8 - off : length;
+
+        if(n == 8) {
+            memcpy(w, data, 8);
+        } else {
+            uint8_t lane [8] = {0};
+            memcpy(lane + off, data, n);
+            memcpy(w, lane, 8);
+        }
+
+        keccak_xor_lane(a, w[0], w[1]);
+
+        a      += 2;
+        data   += n;
+        length -= n;
+        off     = 0;
+    }
+}
+
+void KeccakF1600_StateExtractBytes(
+    uint64_t      * s     ,
+    unsigned int    offset,
+    uint8_t       * data  ,
+    unsigned int    length
+){
+    uint32_t   * a   = (uint32_t*)s + 2 * (offset / 8);
+    unsigned int off = offset & 7;
+    uint32_t     w [2];
+
+    while(length > 0) {
+
+        unsigned int n = 8 - off < length ? 8 - off : length;
+
+        keccak_get_lane(a, &w[0], &w[1]);
+        memcpy(data, (uint8_t*)w + off, n);
+
+        a      += 2;
+        data   += n;
+        length -= n;
+        off     = 0;
+    }
+}
+
+/*! @} */
@@ -56,179 +56,198 @@ static inline uint64_t andn(uint64_t rs1, uint64_t rs2) {
 #define ROL64(a, offset) roli(a,offset)
 #define ANDN(x,y) andn(y,x)
 
+//! Theta on state S. T is four words of scratch.
+#define KECCAK_THETA(S, T) {                                            \
+    T[0] = S[0] ^ S[5] ^ S[10] ^ S[15] ^ S[20] ;                        \
+    T[1] = S[1] ^ S[6] ^ S[11] ^ S[16] ^ S[21] ;                        \
+    T[3] = S[4] ^ S[9] ^ S[14] ^ S[19] ^ S[24] ;                        \
+    T[2] = ROL64(T[1], 1) ^ T[3];                                       \
+    S[ 0] = S[ 0] ^ T[2];                                               \
+    S[ 5] = S[ 5] ^ T[2];                                               \
+    S[10] = S[10] ^ T[2];                                               \
+    S[15] = S[15] ^ T[2];                                               \
+    S[20] = S[20] ^ T[2];                                               \
+    T[2] = S[2] ^ S[7] ^ S[12] ^ S[17] ^ S[22] ;                        \
+    T[3] = ROL64(T[3], 1) ^ T[2];                                       \
+    T[2] = ROL64(T[2], 1) ^ T[0];                                       \
+    S[ 1] = S[ 1] ^ T[2];                                               \
+    S[ 6] = S[ 6] ^ T[2];                                               \
+    S[11] = S[11] ^ T[2];                                               \
+    S[16] = S[16] ^ T[2];                                               \
+    S[21] = S[21] ^ T[2];                                               \
+    T[2] = S[3] ^ S[8] ^ S[13] ^ S[18] ^ S[23] ;                        \
+    T[0] = ROL64(T[0], 1) ^ T[2];                                       \
+    T[2] = ROL64(T[2], 1) ^ T[1];                                       \
+    S[ 4] = S[ 4] ^ T[0];                                               \
+    S[ 9] = S[ 9] ^ T[0];                                               \
+    S[14] = S[14] ^ T[0];                                               \
+    S[19] = S[19] ^ T[0];                                               \
+    S[24] = S[24] ^ T[0];                                               \
+    S[ 3] = S[ 3] ^ T[3];                                               \
+    S[ 8] = S[ 8] ^ T[3];                                               \
+    S[13] = S[13] ^ T[3];                                               \
+    S[18] = S[18] ^ T[3];                                               \
+    S[23] = S[23] ^ T[3];                                               \
+    S[ 2] = S[ 2] ^ T[2];                                               \
+    S[ 7] = S[ 7] ^ T[2];                                               \
+    S[12] = S[12] ^ T[2];                                               \
+    S[17] = S[17] ^ T[2];                                               \
+    S[22] = S[22] ^ T[2];                                               \
+}
+
+//! Rho and Pi on state S, moving each lane to its new position.
+#define KECCAK_RHO_PI(S, T) {                                           \
+    T[1]    = S[5];                                                     \
+    S[ 5] = ROL64(S[ 3],28);                                            \
+    S[ 3] = ROL64(S[18],21);                                            \
+    S[18] = ROL64(S[17],15);                                            \
+    S[17] = ROL64(S[11],10);                                            \
+    S[11] = ROL64(S[ 7], 6);                                            \
+    S[ 7] = ROL64(S[10], 3);                                            \
+    S[10] = ROL64(S[ 1], 1);                                            \
+    S[ 1] = ROL64(S[ 6],44);                                            \
+    S[ 6] = ROL64(S[ 9],20);                                            \
+    S[ 9] = ROL64(S[22],61);                                            \
+    S[22] = ROL64(S[14],39);                                            \
+    S[14] = ROL64(S[20],18);                                            \
+    S[20] = ROL64(S[ 2],62);                                            \
+    S[ 2] = ROL64(S[12],43);                                            \
+    S[12] = ROL64(S[13],25);                                            \
+    S[13] = ROL64(S[19], 8);                                            \
+    S[19] = ROL64(S[23],56);                                            \
+    S[23] = ROL64(S[15],41);                                            \
+    S[15] = ROL64(S[ 4],27);                                            \
+    S[ 4] = ROL64(S[24],14);                                            \
+    S[24] = ROL64(S[21], 2);                                            \
+    S[21] = ROL64(S[ 8],55);                                            \
+    S[ 8] = ROL64(S[16],45);                                            \
+    S[16] = ROL64(T[1],36);                                             \
+}
+
+//! Chi on state S, one row of five lanes at a time.
+#define KECCAK_CHI(S, T) {                                              \
+    T[0]    = (~S[ 3]) & S[ 4];                                         \
+    S[ 4] = S[ 4] ^ ANDN(S[ 0], S[ 1]);                                 \
+    S[ 1] = S[ 1] ^ ANDN(S[ 2], S[ 3]);                                 \
+    S[ 3] = S[ 3] ^ ANDN(S[ 4], S[ 0]);                                 \
+    S[ 0] = S[ 0] ^ ANDN(S[ 1], S[ 2]);                                 \
+    S[ 2] = S[ 2] ^ (T[0]              );                               \
+    T[0]    = (~S[ 8]) & S[ 9];                                         \
+    S[ 9] = S[ 9] ^ ANDN(S[ 5], S[ 6]);                                 \
+    S[ 6] = S[ 6] ^ ANDN(S[ 7], S[ 8]);                                 \
+    S[ 8] = S[ 8] ^ ANDN(S[ 9], S[ 5]);                                 \
+    S[ 5] = S[ 5] ^ ANDN(S[ 6], S[ 7]);                                 \
+    S[ 7] = S[ 7] ^ (T[0]              );                               \
+    T[0]    = (~S[13]) & S[14];                                         \
+    S[14] = S[14] ^ ANDN(S[10], S[11]);                                 \
+    S[11] = S[11] ^ ANDN(S[12], S[13]);                                 \
+    S[13] = S[13] ^ ANDN(S[14], S[10]);                                 \
+    S[10] = S[10] ^ ANDN(S[11], S[12]);                                 \
+    S[12] = S[12] ^ (T[0]                );                             \
+    T[0]    = (~S[18]) & S[19];                                         \
+    S[19] = S[19] ^ ANDN(S[15], S[16]);                                 \
+    S[16] = S[16] ^ ANDN(S[17], S[18]);                                 \
+    S[18] = S[18] ^ ANDN(S[19], S[15]);                                 \
+    S[15] = S[15] ^ ANDN(S[16], S[17]);                                 \
+    S[17] = S[17] ^ (T[0]                );                             \
+    T[0]    = (~S[23]) & S[24];                                         \
+    S[24] = S[24] ^ ANDN(S[20], S[21]);                                 \
+    S[21] = S[21] ^ ANDN(S[22], S[23]);                                 \
+    S[23] = S[23] ^ ANDN(S[24], S[20]);                                 \
+    S[20] = S[20] ^ ANDN(S[21], S[22]);                                 \
+    S[22] = S[22] ^ (T[0]                );                             \
+}
+
+/*
+Each step is a macro so the multi-state permutations can interleave the
+same step of several states. The states share no data, so the rori/andn
+dependency chain of one fills the issue slots left idle by the others.
+*/
+
 /**
- * Function that computes the Keccak-f[1600] permutation on the given state.
+ * Function that computes Keccak-p[1600, nr], the last nr rounds of the
+ * Keccak-f[1600] permutation, on the given state.
  */
-static void KeccakF1600_StatePermute(uint64_t *s)
+static inline void KeccakP1600_StatePermute_nr(uint64_t *s, const int nr)
 {
-    int round, y;
-
-    for(round=0; round<24; round++) {
-        uint64_t C0, C1, C2, C3;
-
-        C0 = s[0] ^ s[5] ^ s[10] ^ s[15] ^ s[20] ;
-        C1 = s[1] ^ s[6] ^ s[11] ^ s[16] ^ s[21] ;
-        C3 = s[4] ^ s[9] ^ s[14] ^ s[19] ^ s[24] ;
-        
-        C2 = ROL64(C1, 1) ^ C3;
-
-        s[ 0] = s[ 0] ^ C2;
-        s[ 5] = s[ 5] ^ C2;
-        s[10] = s[10] ^ C2;
-        s[15] = s[15] ^ C2;
-        s[20] = s[20] ^ C2;
-        
-        C2 = s[2] ^ s[7] ^ s[12] ^ s[17] ^ s[22] ;
-
-        C3 = ROL64(C3, 1) ^ C2;
-        C2 = ROL64(C2, 1) ^ C0;
-             
-        s[ 1] = s[ 1] ^ C2;
-        s[ 6] = s[ 6] ^ C2;
-        s[11] = s[11] ^ C2;
-        s[16] = s[16] ^ C2;
-        s[21] = s[21] ^ C2;
-        
-        C2 = s[3] ^ s[8] ^ s[13] ^ s[18] ^ s[23] ;
-        
-        C0 = ROL64(C0, 1) ^ C2;
-        C2 = ROL64(C2, 1) ^ C1;
-             
-        s[ 4] = s[ 4] ^ C0;
-        s[ 9] = s[ 9] ^ C0;
-        s[14] = s[14] ^ C0;
-        s[19] = s[19] ^ C0;
-        s[24] = s[24] ^ C0;
-             
-        s[ 3] = s[ 3] ^ C3;
-        s[ 8] = s[ 8] ^ C3;
-        s[13] = s[13] ^ C3;
-        s[18] = s[18] ^ C3;
-        s[23] = s[23] ^ C3;
-        
-        s[ 2] = s[ 2] ^ C2;
-        s[ 7] = s[ 7] ^ C2;
-        s[12] = s[12] ^ C2;
-        s[17] = s[17] ^ C2;
-        s[22] = s[22] ^ C2;
-        
-        C1    = s[5];
-        s[ 5] = ROL64(s[ 3],28);
-        s[ 3] = ROL64(s[18],21);
-        s[18] = ROL64(s[17],15);
-        s[17] = ROL64(s[11],10);
-        s[11] = ROL64(s[ 7], 6);
-        s[ 7] = ROL64(s[10], 3);
-        s[10] = ROL64(s[ 1], 1);
-        s[ 1] = ROL64(s[ 6],44);
-        s[ 6] = ROL64(s[ 9],20);
-        s[ 9] = ROL64(s[22],61);
-        s[22] = ROL64(s[14],39);
-        s[14] = ROL64(s[20],18);
-        s[20] = ROL64(s[ 2],62);
-        s[ 2] = ROL64(s[12],43);
-        s[12] = ROL64(s[13],25);
-        s[13] = ROL64(s[19], 8);
-        s[19] = ROL64(s[23],56);
-        s[23] = ROL64(s[15],41);
-        s[15] = ROL64(s[ 4],27);
-        s[ 4] = ROL64(s[24],14);
-        s[24] = ROL64(s[21], 2);
-        s[21] = ROL64(s[ 8],55);
-        s[ 8] = ROL64(s[16],45);
-        s[16] = ROL64(C1,36);
-
-        C0    = (~s[ 3]) & s[ 4];
-        s[ 4] = s[ 4] ^ ANDN(s[ 0], s[ 1]);
-        s[ 1] = s[ 1] ^ ANDN(s[ 2], s[ 3]);
-        s[ 3] = s[ 3] ^ ANDN(s[ 4], s[ 0]);
-        s[ 0] = s[ 0] ^ ANDN(s[ 1], s[ 2]);
-        s[ 2] = s[ 2] ^ (C0              );
-
-        C0    = (~s[ 8]) & s[ 9];
-        s[ 9] = s[ 9] ^ ANDN(s[ 5], s[ 6]);
-        s[ 6] = s[ 6] ^ ANDN(s[ 7], s[ 8]);
-        s[ 8] = s[ 8] ^ ANDN(s[ 9], s[ 5]);
-        s[ 5] = s[ 5] ^ ANDN(s[ 6], s[ 7]);
-        s[ 7] = s[ 7] ^ (C0              );
-
-        C0    = (~s[13]) & s[14];
-        s[14] = s[14] ^ ANDN(s[10], s[11]);
-        s[11] = s[11] ^ ANDN(s[12], s[13]);
-        s[13] = s[13] ^ ANDN(s[14], s[10]);
-        s[10] = s[10] ^ ANDN(s[11], s[12]);
-        s[12] = s[12] ^ (C0                );
-                     
-        C0    = (~s[18]) & s[19];
-        s[19] = s[19] ^ ANDN(s[15], s[16]);
-        s[16] = s[16] ^ ANDN(s[17], s[18]);
-        s[18] = s[18] ^ ANDN(s[19], s[15]);
-        s[15] = s[15] ^ ANDN(s[16], s[17]);
-        s[17] = s[17] ^ (C0                );
-
-        C0    = (~s[23]) & s[24];
-        s[24] = s[24] ^ ANDN(s[20], s[21]);
-        s[21] = s[21] ^ ANDN(s[22], s[23]);
-        s[23] = s[23] ^ ANDN(s[24], s[20]);
-        s[20] = s[20] ^ ANDN(s[21], s[22]);
-        s[22] = s[22] ^ (C0                );
+    uint64_t T[4];
 
+    for(int round=24-nr; round<24; round++) {
+        KECCAK_THETA (s, T)
+        KECCAK_RHO_PI(s, T)
+        KECCAK_CHI   (s, T)
         s[0] ^= KeccakP1600RoundConstants[round];
     }
 }
 
-#define MIN(a, b) ((a) < (b) ? (a) : (b))
-
-void Keccak(unsigned int rate, unsigned int capacity, const unsigned char *input, unsigned long long int inputByteLen, unsigned char delimitedSuffix, unsigned char *output, unsigned long long int outputByteLen)
+static inline void KeccakP1600_StatePermute_x2_nr(uint64_t s[2][25], const int nr)
 {
-    // Extra 8 bytes for saving SP in KeccakPermute.S
-    uint8_t state[200 + 8];
-    unsigned int rateInBytes = rate/8;
-    unsigned int blockSize = 0;
-    unsigned int i;
-
-    if (((rate + capacity) != 1600) || ((rate % 8) != 0))
-        return;
-
-    /* === Initialize the state === */
-    memset(state, 0, sizeof(state));
-
-    /* === Absorb all the input blocks === */
-    while(inputByteLen > 0) {
-        blockSize = MIN(inputByteLen, rateInBytes);
-        for(i=0; i<blockSize; i++)
-            state[i] ^= input[i];
-        input += blockSize;
-        inputByteLen -= blockSize;
-
-        if (blockSize == rateInBytes) {
-            KeccakF1600_StatePermute((uint64_t*)state);
-            blockSize = 0;
-        }
+    uint64_t T0[4], T1[4];
+
+    for(int round=24-nr; round<24; round++) {
+        KECCAK_THETA (s[0], T0)
+        KECCAK_THETA (s[1], T1)
+        KECCAK_RHO_PI(s[0], T0)
+        KECCAK_RHO_PI(s[1], T1)
+        KECCAK_CHI   (s[0], T0)
+        KECCAK_CHI   (s[1], T1)
+        s[0][0] ^= KeccakP1600RoundConstants[round];
+        s[1][0] ^= KeccakP1600RoundConstants[round];
     }
+}
 
-    /* === Do the padding and switch to the squeezing phase === */
-    /* Absorb the last few bits and add the first bit of padding (which coincides with the delimiter in delimitedSuffix) */
-    state[blockSize] ^= delimitedSuffix;
-    /* If the first bit of padding is at position rate-1, we need a whole new block for the second bit of padding */
-    if (((delimitedSuffix & 0x80) != 0) && (blockSize == (rateInBytes-1)))
-        KeccakF1600_StatePermute((uint64_t*)state);
-    /* Add the second bit of padding */
-    state[rateInBytes-1] ^= 0x80;
-    /* Switch to the squeezing phase */
-    KeccakF1600_StatePermute((uint64_t*)state);
-
-    /* === Squeeze out all the output blocks === */
-    while(outputByteLen > 0) {
-        blockSize = MIN(outputByteLen, rateInBytes);
-        memcpy(output, state, blockSize);
-        output += blockSize;
-        outputByteLen -= blockSize;
-
-        if (outputByteLen > 0)
-            KeccakF1600_StatePermute((uint64_t*)state);
+static inline void KeccakP1600_StatePermute_x4_nr(uint64_t s[4][25], const int nr)
+{
+    uint64_t T0[4], T1[4], T2[4], T3[4];
+
+    for(int round=24-nr; round<24; round++) {
+        KECCAK_THETA (s[0], T0)
+        KECCAK_THETA (s[1], T1)
+        KECCAK_THETA (s[2], T2)
+        KECCAK_THETA (s[3], T3)
+        KECCAK_RHO_PI(s[0], T0)
+        KECCAK_RHO_PI(s[1], T1)
+        KECCAK_RHO_PI(s[2], T2)
+        KECCAK_RHO_PI(s[3], T3)
+        KECCAK_CHI   (s[0], T0)
+        KECCAK_CHI   (s[1], T1)
+        KECCAK_CHI   (s[2], T2)
+        KECCAK_CHI   (s[3], T3)
+        s[0][0] ^= KeccakP1600RoundConstants[round];
+        s[1][0] ^= KeccakP1600RoundConstants[round];
+        s[2][0] ^= KeccakP1600RoundConstants[round];
+        s[3][0] ^= KeccakP1600RoundConstants[round];
     }
 }
 
-/*! @} */
+void KeccakF1600_StatePermute(uint64_t *s)
+{
+    KeccakP1600_StatePermute_nr(s, 24);
+}
+
+void KeccakF1600_StatePermute_x2(uint64_t s[2][25])
+{
+    KeccakP1600_StatePermute_x2_nr(s, 24);
+}
+
+void KeccakF1600_StatePermute_x4(uint64_t s[4][25])
+{
+    KeccakP1600_StatePermute_x4_nr(s, 24);
+}
+
+void KeccakP1600_StatePermute_12rounds(uint64_t *s)
+{
+    KeccakP1600_StatePermute_nr(s, 12);
+}
 
+void KeccakP1600_StatePermute_12rounds_x2(uint64_t s[2][25])
+{
+    KeccakP1600_StatePermute_x2_nr(s, 12);
+}
+
+void KeccakP1600_StatePermute_12rounds_x4(uint64_t s[4][25])
+{
+    KeccakP1600_StatePermute_x4_nr(s, 12);
+}
+
+/*! @} */
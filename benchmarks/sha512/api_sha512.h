@@ -5,15 +5,135 @@
 */
 
 #include <stdint.h>
+#include <stddef.h>
 
 #include "riscvcrypto/share/util.h"
 
 #ifndef __API_SHA512__
 #define __API_SHA512__
 
-//! Hash a message using SHA512
+//! Size of one SHA-512 message block in bytes.
+#define SHA512_BLOCK_BYTES       128
+
+//! Size of a SHA-512 digest in bytes.
+#define SHA512_DIGEST_BYTES      64
+
+//! Size of a SHA-384 digest in bytes.
+#define SHA384_DIGEST_BYTES      48
+
+//! Size of a SHA-512/256 digest in bytes.
+#define SHA512_256_DIGEST_BYTES  32
+
+//! Size of a SHA-512/224 digest in bytes.
+#define SHA512_224_DIGEST_BYTES  28
+
+/*!
+@brief State of a streaming SHA-512, SHA-384, SHA-512/256 or SHA-512/224
+    computation.
+@details The variants differ only in their initial value and in how much
+    of the final chaining value is output, so they share a context.
+*/
+typedef struct {
+    uint64_t    H [8] ;       //!< Chaining value.
+    uint64_t    B [16];       //!< Partial block. Words, so it is aligned.
+    uint64_t    len_lo;       //!< Bytes absorbed so far, low 64 bits.
+    uint64_t    len_hi;       //!< Bytes absorbed so far, high 64 bits.
+    size_t      digest_bytes; //!< One of the SHA*_DIGEST_BYTES values.
+} sha512_ctx_t;
+
+//! Add a single message block to the chaining value H. M must be aligned.
+void sha512_hash_block (
+    uint64_t    H[ 8], //!< in,out - chaining value
+    uint64_t    M[16]  //!< in - The message block to add to the hash
+);
+
+/*!
+@brief Add a single message block, given as 16 host order words, to H.
+@details For callers which build blocks from chaining values (HMAC
+    iterations, Merkle nodes), as it avoids converting to bytes and back.
+*/
+void sha512_hash_block_words (
+    uint64_t    H[ 8], //!< in,out - chaining value
+    const uint64_t W[16] //!< in - The message block, word i is bytes 8*i.. BE
+);
+
+/*!
+@brief Add nblocks consecutive message blocks to the chaining value H.
+@details Words are read big-endian straight from M, with word loads when
+    M is 8-byte aligned and byte loads when it is not, so M never needs
+    to be copied.
+*/
+void sha512_hash_blocks (
+    uint64_t    H[ 8], //!< in,out - chaining value
+    uint8_t   * M    , //!< in - The message blocks. Any alignment.
+    size_t      nblocks //!< Number of SHA512_BLOCK_BYTES blocks in M.
+);
+
+//! Begin a SHA-512 computation.
+void sha512_init (
+    sha512_ctx_t * ctx //!< out - Context to initialise.
+);
+
+//! Begin a SHA-384 computation.
+void sha384_init (
+    sha512_ctx_t * ctx //!< out - Context to initialise.
+);
+
+//! Begin a SHA-512/256 computation.
+void sha512_256_init (
+    sha512_ctx_t * ctx //!< out - Context to initialise.
+);
+
+//! Begin a SHA-512/224 computation.
+void sha512_224_init (
+    sha512_ctx_t * ctx //!< out - Context to initialise.
+);
+
+/*!
+@brief Absorb len bytes of message into a SHA-512 family context.
+@details Whole blocks are compressed straight from M, whatever its
+    alignment. Only partial blocks are copied through the context. The
+    message length is counted in 128 bits, as FIPS 180-4 specifies.
+*/
+void sha512_update (
+    sha512_ctx_t * ctx, //!< in,out - Context.
+    uint8_t      * M  , //!< in - Message bytes.
+    size_t         len  //!< Length of M in bytes.
+);
+
+/*!
+@brief Pad the message and write the digest.
+@details Writes ctx->digest_bytes bytes, set by the init function used.
+*/
+void sha512_final (
+    sha512_ctx_t * ctx   , //!< in - Context. Must be re-initialised after.
+    uint8_t      * digest  //!< out - Message digest.
+);
+
+//! Hash a message using SHA512. H receives the digest bytes.
 void sha512_hash (
-    uint64_t    H[ 8], //!< in,out - message block hash
+    uint64_t    H[ 8], //!< out - message digest
+    uint8_t   * M    , //!< in - The message to be hashed
+    size_t      len    //!< Length of the message in *bytes*.
+);
+
+//! Hash a whole message with SHA-384.
+void sha384_hash (
+    uint8_t     digest[SHA384_DIGEST_BYTES], //!< out - message digest
+    uint8_t   * M    , //!< in - The message to be hashed
+    size_t      len    //!< Length of the message in *bytes*.
+);
+
+//! Hash a whole message with SHA-512/256.
+void sha512_256_hash (
+    uint8_t     digest[SHA512_256_DIGEST_BYTES], //!< out - message digest
+    uint8_t   * M    , //!< in - The message to be hashed
+    size_t      len    //!< Length of the message in *bytes*.
+);
+
+//! Hash a whole message with SHA-512/224.
+void sha512_224_hash (
+    uint8_t     digest[SHA512_224_DIGEST_BYTES], //!< out - message digest
     uint8_t   * M    , //!< in - The message to be hashed
     size_t      len    //!< Length of the message in *bytes*.
 );
@@ -0,0 +1,188 @@
+
+/*!
+@addtogroup crypto_hash_sha512
+@{
+*/
+
+#include <string.h>
+
+#include "riscvcrypto/sha512/api_sha512.h"
+
+//! Set the chaining value and digest length, and clear the length.
+static void sha512_ctx_init (
+    sha512_ctx_t   * ctx         ,
+    const uint64_t   iv[8]       ,
+    size_t           digest_bytes
+){
+    for(int i = 0; i < 8; i ++) {
+        ctx->H[i] = iv[i];
+    }
+    ctx->len_lo       = 0;
+    ctx->len_hi       = 0;
+    ctx->digest_bytes = digest_bytes;
+}
+
+static const uint64_t sha512_iv [8] = {
+    0x6A09E667F3BCC908L, 0xBB67AE8584CAA73BL, 0x3C6EF372FE94F82BL,
+    0xA54FF53A5F1D36F1L, 0x510E527FADE682D1L, 0x9B05688C2B3E6C1FL,
+    0x1F83D9ABFB41BD6BL, 0x5BE0CD19137E2179L
+};
+
+static const uint64_t sha384_iv [8] = {
+    0xCBBB9D5DC1059ED8L, 0x629A292A367CD507L, 0x9159015A3070DD17L,
+    0x152FECD8F70E5939L, 0x67332667FFC00B31L, 0x8EB44A8768581511L,
+    0xDB0C2E0D64F98FA7L, 0x47B5481DBEFA4FA4L
+};
+
+static const uint64_t sha512_256_iv [8] = {
+    0x22312194FC2BF72CL, 0x9F555FA3C84C64C2L, 0x2393B86B6F53B151L,
+    0x963877195940EABDL, 0x96283EE2A88EFFE3L, 0xBE5E1E2553863992L,
+    0x2B0199FC2C85B8AAL, 0x0EB72DDC81C52CA2L
+};
+
+static const uint64_t sha512_224_iv [8] = {
+    0x8C3D37C819544DA2L, 0x73E1996689DCD4D6L, 0x1DFAB7AE32FF9C82L,
+    0x679DD514582F9FCFL, 0x0F6D2B697BD44DA8L, 0x77E36F7304C48942L,
+    0x3F9D85A86A1D36C8L, 0x1112E6AD91D692A1L
+};
+
+void sha512_init (
+    sha512_ctx_t * ctx
+){
+    sha512_ctx_init(ctx, sha512_iv, SHA512_DIGEST_BYTES);
+}
+
+void sha384_init (
+    sha512_ctx_t * ctx
+){
+    sha512_ctx_init(ctx, sha384_iv, SHA384_DIGEST_BYTES);
+}
+
+void sha512_256_init (
+    sha512_ctx_t * ctx
+){
+    sha512_ctx_init(ctx, sha512_256_iv, SHA512_256_DIGEST_BYTES);
+}
+
+void sha512_224_init (
+    sha512_ctx_t * ctx
+){
+    sha512_ctx_init(ctx, sha512_224_iv, SHA512_224_DIGEST_BYTES);
+}
+
+void sha512_update (
+    sha512_ctx_t * ctx,
+    uint8_t      * M  ,
+    size_t         len
+){
+    uint8_t * bp   = (uint8_t*)ctx->B;
+    size_t    fill = ctx->len_lo % SHA512_BLOCK_BYTES;
+
+    ctx->len_lo += len;                 // 128-bit length, with carry.
+    if(ctx->len_lo < len) {
+        ctx->len_hi += 1;
+    }
+
+    if(fill) {                          // Top up a partial block first.
+        size_t take = SHA512_BLOCK_BYTES - fill;
+        take = take < len ? take : len;
+
+        memcpy(bp + fill, M, take);
+
+        M    += take;
+        len  -= take;
+        fill += take;
+
+        if(fill < SHA512_BLOCK_BYTES) {
+            return;
+        }
+
+        sha512_hash_block(ctx->H, ctx->B);
+    }
+
+    size_t nblocks = len / SHA512_BLOCK_BYTES;
+
+    sha512_hash_blocks(ctx->H, M, nblocks); // Compress whole blocks in place
+
+    M   += SHA512_BLOCK_BYTES * nblocks;
+    len -= SHA512_BLOCK_BYTES * nblocks;
+
+    memcpy(bp, M, len);                 // Keep the tail for next time.
+}
+
+void sha512_final (
+    sha512_ctx_t * ctx   ,
+    uint8_t      * digest
+){
+    uint8_t * bp       = (uint8_t*)ctx->B;
+    size_t    fill     = ctx->len_lo % SHA512_BLOCK_BYTES;
+    uint64_t  bits_lo  =  ctx->len_lo << 3;
+    uint64_t  bits_hi  = (ctx->len_hi << 3) | (ctx->len_lo >> 61);
+
+    bp[fill++] = 0x80;                  // Append `1` to end of message
+
+    if(fill > 112) {                    // Do we spill into another block?
+        memset(bp + fill, 0, SHA512_BLOCK_BYTES - fill);
+        sha512_hash_block(ctx->H, ctx->B);
+        fill = 0;
+    }
+
+    memset(bp + fill, 0, 112 - fill);
+
+    for(int i = 0; i < 8; i ++) {       // Add length to end of this block
+        bp[127 - i] = bits_lo >> (8*i);
+        bp[119 - i] = bits_hi >> (8*i);
+    }
+
+    sha512_hash_block(ctx->H, ctx->B);
+
+    for(size_t i = 0; i < ctx->digest_bytes; i ++) {
+        digest[i] = ctx->H[i / 8] >> (56 - 8 * (i % 8)); // Big endian
+    }
+}
+
+void sha512_hash (
+    uint64_t    H[ 8],
+    uint8_t   * M    ,
+    size_t      len
+){
+    sha512_ctx_t ctx;
+    sha512_init  (&ctx);
+    sha512_update(&ctx, M, len);
+    sha512_final (&ctx, (uint8_t*)H);
+}
+
+void sha384_hash (
+    uint8_t     digest[SHA384_DIGEST_BYTES],
+    uint8_t   * M    ,
+    size_t      len
+){
+    sha512_ctx_t ctx;
+    sha384_init  (&ctx);
+    sha512_update(&ctx, M, len);
+    sha512_final (&ctx, digest);
+}
+
+void sha512_256_hash (
+    uint8_t     digest[SHA512_256_DIGEST_BYTES],
+    uint8_t   * M    ,
+    size_t      len
+){
+    sha512_ctx_t ctx;
+    sha512_256_init(&ctx);
+    sha512_update  (&ctx, M, len);
+    sha512_final   (&ctx, digest);
+}
+
+void sha512_224_hash (
+    uint8_t     digest[SHA512_224_DIGEST_BYTES],
+    uint8_t   * M    ,
+    size_t      len
+){
+    sha512_ctx_t ctx;
+    sha512_224_init(&ctx);
+    sha512_update  (&ctx, M, len);
+    sha512_final   (&ctx, digest);
+}
+
+//! @}
@@ -35,27 +35,15 @@ static uint64_t K [80] = {
     0x5fcb6fab3ad6faecL, 0x6c44198c4a475817L
 };
 
-static inline void sha512_hash_init (
-    uint64_t    H [8]  //!< out - message block hash
-){
-	H[0] = 0x6A09E667F3BCC908L;
-	H[1] = 0xBB67AE8584CAA73BL;
-	H[2] = 0x3C6EF372FE94F82BL;
-	H[3] = 0xA54FF53A5F1D36F1L;
-	H[4] = 0x510E527FADE682D1L;
-	H[5] = 0x9B05688C2B3E6C1FL;
-	H[6] = 0x1F83D9ABFB41BD6BL;
-	H[7] = 0x5BE0CD19137E2179L;
-}
-
-
 #define SHA512_LOAD64_BE(X, A, I) {    \
     X = ((uint64_t*)A)[I];             \
     X = __builtin_bswap64(X);          \
 }
 
-#define SHA512_STORE64_BE(X, A, I) {    \
-    A[I] = __builtin_bswap64(X);  \
+//! Load big-endian word I of A, which need not be aligned.
+#define SHA512_LOADU64_BE(X, A, I) {    \
+    memcpy(&X, A + 8*I, 8);            \
+    X = __builtin_bswap64(X);          \
 }
 
 #define ROR64(X,Y) ((X>>Y) | (X << (64-Y)))
@@ -79,9 +67,15 @@ static inline void sha512_hash_init (
     M0 = SIGMA_1(ME) + M9 + SIGMA_0(M1) + M0; \
 }
 
-static void sha512_hash_block (
-    uint64_t    H[ 8], //!< in,out - message block hash
-    uint64_t    M[16]  //!< in - The message block to add to the hash
+/*!
+@brief Add one block to H, loading its words straight from M, or taking
+    them from W when it is not NULL. Inlined, so each caller gets only
+    the path it uses.
+*/
+static inline void sha512_compress (
+    uint64_t    H[ 8], //!< in,out - chaining value
+    uint8_t   * M    , //!< in - The message block to add to the hash
+    const uint64_t * W     //!< in - Host order message words, or NULL.
 ){
     uint64_t    a,b,c,d,e,f,g,h ;   // Working variables.
 
@@ -96,22 +90,58 @@ static void sha512_hash_block (
 
     uint64_t m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, ma, mb, mc, md, me, mf;
 
-    SHA512_LOAD64_BE(m0, M,  0);
-    SHA512_LOAD64_BE(m1, M,  1);
-    SHA512_LOAD64_BE(m2, M,  2);
-    SHA512_LOAD64_BE(m3, M,  3);
-    SHA512_LOAD64_BE(m4, M,  4);
-    SHA512_LOAD64_BE(m5, M,  5);
-    SHA512_LOAD64_BE(m6, M,  6);
-    SHA512_LOAD64_BE(m7, M,  7);
-    SHA512_LOAD64_BE(m8, M,  8);
-    SHA512_LOAD64_BE(m9, M,  9);
-    SHA512_LOAD64_BE(ma, M, 10);
-    SHA512_LOAD64_BE(mb, M, 11);
-    SHA512_LOAD64_BE(mc, M, 12);
-    SHA512_LOAD64_BE(md, M, 13);
-    SHA512_LOAD64_BE(me, M, 14);
-    SHA512_LOAD64_BE(mf, M, 15);
+    if(W != NULL) {                     // Words given by the caller.
+        m0 = W[ 0];
+        m1 = W[ 1];
+        m2 = W[ 2];
+        m3 = W[ 3];
+        m4 = W[ 4];
+        m5 = W[ 5];
+        m6 = W[ 6];
+        m7 = W[ 7];
+        m8 = W[ 8];
+        m9 = W[ 9];
+        ma = W[10];
+        mb = W[11];
+        mc = W[12];
+        md = W[13];
+        me = W[14];
+        mf = W[15];
+    } else if(((uintptr_t)M & 7) == 0) { // Aligned: plain word loads.
+        SHA512_LOAD64_BE(m0, M,  0);
+        SHA512_LOAD64_BE(m1, M,  1);
+        SHA512_LOAD64_BE(m2, M,  2);
+        SHA512_LOAD64_BE(m3, M,  3);
+        SHA512_LOAD64_BE(m4, M,  4);
+        SHA512_LOAD64_BE(m5, M,  5);
+        SHA512_LOAD64_BE(m6, M,  6);
+        SHA512_LOAD64_BE(m7, M,  7);
+        SHA512_LOAD64_BE(m8, M,  8);
+        SHA512_LOAD64_BE(m9, M,  9);
+        SHA512_LOAD64_BE(ma, M, 10);
+        SHA512_LOAD64_BE(mb, M, 11);
+        SHA512_LOAD64_BE(mc, M, 12);
+        SHA512_LOAD64_BE(md, M, 13);
+        SHA512_LOAD64_BE(me, M, 14);
+        SHA512_LOAD64_BE(mf, M, 15);
+    } else {                            // Misaligned: byte loads.
+        SHA512_LOADU64_BE(m0, M,  0);
+        SHA512_LOADU64_BE(m1, M,  1);
+        SHA512_LOADU64_BE(m2, M,  2);
+        SHA512_LOADU64_BE(m3, M,  3);
+        SHA512_LOADU64_BE(m4, M,  4);
+        SHA512_LOADU64_BE(m5, M,  5);
+        SHA512_LOADU64_BE(m6, M,  6);
+        SHA512_LOADU64_BE(m7, M,  7);
+        SHA512_LOADU64_BE(m8, M,  8);
+        SHA512_LOADU64_BE(m9, M,  9);
+        SHA512_LOADU64_BE(ma, M, 10);
+        SHA512_LOADU64_BE(mb, M, 11);
+        SHA512_LOADU64_BE(mc, M, 12);
+        SHA512_LOADU64_BE(md, M, 13);
+        SHA512_LOADU64_BE(me, M, 14);
+        SHA512_LOADU64_BE(mf, M, 15);
+    }
 
     uint64_t *kp = K     ;
     uint64_t *ke = K + 64;
@@ -167,56 +197,27 @@ static void sha512_hash_block (
     H[7] += h;
 }
 
-
-void sha512_hash (
-    uint64_t    H[ 8], //!< in,out - message block hash
-    uint8_t   * M    , //!< in - The message to be hashed
-    size_t      len    //!< Length of the message in *bytes*.
+void sha512_hash_block (
+    uint64_t    H[ 8],
+    uint64_t    M[16]
 ){
-    uint64_t   p_H[ 8] ;
-    uint64_t   p_B[16] ;
-    uint8_t  * p_M     = M ;
-
-    size_t     len_bits= len << 3;
-
-    sha512_hash_init(p_H);
-
-    while(len >= 128) {
-        memcpy(p_B, p_M, 128);          // Copy 128 bytes / 1024 bits . 
-
-        sha512_hash_block (p_H, p_B);   // Digest another block
-
-        p_M += 128;                     // Adjust pointers and length.
-        len -= 128;
-    }
-
-    memcpy(p_B, p_M, len);              // Copy remaining bytes into block
-
-    uint8_t * bp = (uint8_t*)p_B;
-    bp[len++] = 0x80;                   // Append `1` to end of message
-
-    if(len > 112) {                     // Do we spill into another block?
-        memset(bp+len, 0, 128-len);     // If yes, clear rest of this block
-        sha512_hash_block(p_H, p_B);    // Length will be added in a new block
-        len = 0;                        //
-    }
-
-    size_t i = 128;
-    while(len_bits) {                   // Add length to end of this block
-        bp[--i] = len_bits  & 0xFF;
-        len_bits= len_bits >>    8;
-    }
-
-    memset(bp + len, 0, i-len);         // Clear fstart of block/EoM to len
+    sha512_hash_blocks(H, (uint8_t*)M, 1);
+}
 
-    sha512_hash_block(p_H,p_B);
+void sha512_hash_block_words (
+    uint64_t    H[ 8],
+    const uint64_t W[16]
+){
+    sha512_compress(H, NULL, W);
+}
 
-    for(size_t i = 0; i < 8; i ++) {    // Store result in big endian
-        uint64_t x = p_H[i];
-        SHA512_STORE64_BE(x,H,i);
+void sha512_hash_blocks (
+    uint64_t    H[ 8],
+    uint8_t   * M    ,
+    size_t      nblocks
+){
+    while(nblocks --) {
+        sha512_compress(H, M, NULL);
+        M += 128;
     }
 }
-
-
-
-
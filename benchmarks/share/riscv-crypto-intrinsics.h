@@ -104,6 +104,10 @@ static inline volatile uint_xlen_t _getnoise()    {uint_xlen_t rd; __asm__ volat
 static inline uint_xlen_t _pack  (uint_xlen_t rs1, uint_xlen_t rs2) {uint_xlen_t rd; __asm__("pack  %0, %1, %2" : "=r"(rd) : "r"(rs1), "r"(rs2)); return rd;}
 static inline uint_xlen_t _packu (uint_xlen_t rs1, uint_xlen_t rs2) {uint_xlen_t rd; __asm__("packu %0, %1, %2" : "=r"(rd) : "r"(rs1), "r"(rs2)); return rd;}
 static inline uint_xlen_t _packh (uint_xlen_t rs1, uint_xlen_t rs2) {uint_xlen_t rd; __asm__("packh %0, %1, %2" : "=r"(rd) : "r"(rs1), "r"(rs2)); return rd;}
+static inline uint_xlen_t _rev8  (uint_xlen_t rs1                 ) {uint_xlen_t rd; __asm__("rev8  %0, %1    " : "=r"(rd) : "r"(rs1)           ); return rd;}
+static inline uint_xlen_t _brev8 (uint_xlen_t rs1                 ) {uint_xlen_t rd; __asm__("brev8 %0, %1    " : "=r"(rd) : "r"(rs1)           ); return rd;}
+static inline uint_xlen_t _clmul (uint_xlen_t rs1, uint_xlen_t rs2) {uint_xlen_t rd; __asm__("clmul  %0, %1, %2" : "=r"(rd) : "r"(rs1), "r"(rs2)); return rd;}
+static inline uint_xlen_t _clmulh(uint_xlen_t rs1, uint_xlen_t rs2) {uint_xlen_t rd; __asm__("clmulh %0, %1, %2" : "=r"(rd) : "r"(rs1), "r"(rs2)); return rd;}
 #endif
 
 #endif // __RISCV_CRYPTO_INTRINSICS__
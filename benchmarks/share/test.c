@@ -53,6 +53,30 @@ size_t test_rdrandom(unsigned char * dest, size_t len) {
 }
 
 
+void test_split_update (
+    void         * ctx,
+    void        (* fn)(void * ctx, uint8_t * chunk, size_t len),
+    uint8_t      * buf,
+    size_t         len,
+    size_t         max_chunk
+){
+    // Seed once, then step a local LCG. test_rdrandom reseeds from
+    // time() on every call, so it repeats itself within a second.
+    uint8_t  r[4];
+    uint32_t state;
+    test_rdrandom(r, 4);
+    state = r[0] | (r[1] << 8) | (r[2] << 16) | ((uint32_t)r[3] << 24);
+    while(len > 0) {
+        state = state * 1664525 + 1013904223;
+        size_t chunk = 1 + (state >> 16) % max_chunk;
+        chunk = chunk < len ? chunk : len;
+        fn(ctx, buf, chunk);
+        buf += chunk;
+        len -= chunk;
+    }
+}
+
+
 
 //!@}
 
@@ -49,6 +49,29 @@ void puthex_py(unsigned char * in, size_t len);
 size_t test_rdrandom(unsigned char * dest, size_t len);
 
 
+/*!
+@brief Pass len bytes at buf to fn in randomly sized chunks.
+@details For streaming API tests. Chunk sizes are drawn uniformly from
+    1..max_chunk by a generator seeded once per call, so a run mixes
+    aligned and unaligned chunks and partial block fills. Coverage of
+    every split is not guaranteed by a single run. fn may read or write
+    each chunk, so this serves for squeezing output as well as for
+    absorbing input.
+@param [in]    ctx       - Context passed through to fn.
+@param [in]    fn        - Called as fn(ctx, chunk, chunk_len) for each chunk.
+@param [inout] buf       - Buffer to split up.
+@param [in]    len       - Length of buf in bytes.
+@param [in]    max_chunk - Largest chunk in bytes, at least 1, at most 65536.
+*/
+void test_split_update (
+    void         * ctx,
+    void        (* fn)(void * ctx, uint8_t * chunk, size_t len),
+    uint8_t      * buf,
+    size_t         len,
+    size_t         max_chunk
+);
+
+
 
 //
 // Low level register access.
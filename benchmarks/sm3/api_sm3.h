@@ -1,4 +1,3 @@
-
 /*!
 @defgroup crypto_hash_sm3 Crypto Hash SM3
 @{
@@ -12,6 +11,55 @@
 #ifndef __API_SM3__
 #define __API_SM3__
 
+//! Size of one SM3 message block in bytes.
+#define SM3_BLOCK_BYTES   64
+
+//! Size of an SM3 digest in bytes.
+#define SM3_DIGEST_BYTES  32
+
+//! State of a streaming SM3 computation.
+typedef struct {
+  uint32_t H[8];  //!< Chaining value.
+  uint32_t B[16]; //!< Partial block. Words, so it is aligned.
+  uint64_t len;   //!< Bytes absorbed so far.
+} sm3_ctx_t;
+
+/*!
+@brief Add nblocks consecutive message blocks to the chaining value H.
+@details Implemented by each backend. The 16 message words and the
+    expanded schedule are kept in local variables, so a block is read
+    from M once and the schedule never goes through memory. Words are
+    read big-endian straight from M, with word loads when it is 4-byte
+    aligned and byte loads when it is not.
+*/
+void sm3_hash_blocks(
+  uint32_t       H[8],   //!< in,out - chaining value
+  const uint8_t *M,      //!< in - The message blocks. Any alignment.
+  size_t         nblocks //!< Number of SM3_BLOCK_BYTES blocks in M.
+);
+
+//! Begin an SM3 computation.
+void sm3_init(
+  sm3_ctx_t *ctx //!< out - Context to initialise.
+);
+
+/*!
+@brief Absorb len bytes of message into an SM3 context.
+@details Whole blocks are compressed straight from M. Only partial
+    blocks are copied through the context.
+*/
+void sm3_update(
+  sm3_ctx_t     *ctx, //!< in,out - Context.
+  const uint8_t *M,   //!< in - Message bytes.
+  size_t         len  //!< Length of M in bytes.
+);
+
+//! Pad the message and write the SM3_DIGEST_BYTES byte digest.
+void sm3_final(
+  sm3_ctx_t *ctx,   //!< in - Context. Must be re-initialised after.
+  uint8_t   *digest //!< out - Message digest.
+);
+
 // Hashes `message` with `len` bytes with SM3 and stores it to `hash`
 void sm3_hash(uint8_t hash[32], const uint8_t *message, size_t len);
 
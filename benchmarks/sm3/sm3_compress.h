@@ -0,0 +1,193 @@
+#ifndef __SM3_COMPRESS__
+#define __SM3_COMPRESS__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "riscvcrypto/sm3/api_sm3.h"
+
+/*!
+@brief The SM3 compression function, shared by every backend.
+@details A backend defines SM3_P0(X) and SM3_P1(X), the two permutation
+    functions, then includes this file and builds sm3_hash_blocks on
+    sm3_compress. Nothing else differs between backends.
+*/
+#if !defined(SM3_P0) || !defined(SM3_P1)
+#error "Define SM3_P0 and SM3_P1 before including sm3_compress.h"
+#endif
+
+// The rotated round constants, T_j <<< (j mod 32)
+static const uint32_t SM3_T[64] = {
+    0x79CC4519, 0xF3988A32, 0xE7311465, 0xCE6228CB, 0x9CC45197, 0x3988A32F,
+    0x7311465E, 0xE6228CBC, 0xCC451979, 0x988A32F3, 0x311465E7, 0x6228CBCE,
+    0xC451979C, 0x88A32F39, 0x11465E73, 0x228CBCE6, 0x9D8A7A87, 0x3B14F50F,
+    0x7629EA1E, 0xEC53D43C, 0xD8A7A879, 0xB14F50F3, 0x629EA1E7, 0xC53D43CE,
+    0x8A7A879D, 0x14F50F3B, 0x29EA1E76, 0x53D43CEC, 0xA7A879D8, 0x4F50F3B1,
+    0x9EA1E762, 0x3D43CEC5, 0x7A879D8A, 0xF50F3B14, 0xEA1E7629, 0xD43CEC53,
+    0xA879D8A7, 0x50F3B14F, 0xA1E7629E, 0x43CEC53D, 0x879D8A7A, 0x0F3B14F5,
+    0x1E7629EA, 0x3CEC53D4, 0x79D8A7A8, 0xF3B14F50, 0xE7629EA1, 0xCEC53D43,
+    0x9D8A7A87, 0x3B14F50F, 0x7629EA1E, 0xEC53D43C, 0xD8A7A879, 0xB14F50F3,
+    0x629EA1E7, 0xC53D43CE, 0x8A7A879D, 0x14F50F3B, 0x29EA1E76, 0x53D43CEC,
+    0xA7A879D8, 0x4F50F3B1, 0x9EA1E762, 0x3D43CEC5};
+
+// Loads big-endian word I of A, which must be 4-byte aligned
+#define SM3_LOAD32_BE(X, A, I)                                                 \
+  {                                                                            \
+    X = ((const uint32_t *)(A))[I];                                            \
+    X = __builtin_bswap32(X);                                                  \
+  }
+
+// Loads big-endian word I of A, which need not be aligned
+#define SM3_LOADU32_BE(X, A, I)                                                \
+  {                                                                            \
+    memcpy(&X, (A) + 4 * (I), 4);                                              \
+    X = __builtin_bswap32(X);                                                  \
+  }
+
+// Rotates `V` by `N` bits to the left
+#define SM3_ROTATE_32(V, N) (((V) << (N)) | ((V) >> (32 - (N))))
+
+// The boolean functions of rounds 0-15 and 16-63
+#define SM3_FF0(X, Y, Z) ((X) ^ (Y) ^ (Z))
+#define SM3_GG0(X, Y, Z) ((X) ^ (Y) ^ (Z))
+#define SM3_FF1(X, Y, Z) (((X) & (Y)) | ((X) & (Z)) | ((Y) & (Z)))
+#define SM3_GG1(X, Y, Z) (((X) & (Y)) | (~(X) & (Z)))
+
+// Expands the next schedule word into W0, which holds W[j-16] on entry
+#define SM3_EXPAND(W0, W7, W13, W3, W10)                                       \
+  {                                                                            \
+    W0 = SM3_P1((W0) ^ (W7) ^ SM3_ROTATE_32((W13), 15)) ^                      \
+         SM3_ROTATE_32((W3), 7) ^ (W10);                                       \
+  }
+
+// Performs one compression step with rotated constant T and schedule words
+// W0 = W[j] and W4 = W[j+4]. Rather than shifting the state, the new A is
+// left in D and the new E in H, and the caller rotates the arguments.
+#define SM3_ROUND(FF, GG, A, B, C, D, E, F, G, H, T, W0, W4)                   \
+  {                                                                            \
+    uint32_t rot = SM3_ROTATE_32((A), 12);                                     \
+    uint32_t ss1 = SM3_ROTATE_32(rot + (E) + (T), 7);                          \
+    D = FF((A), (B), (C)) + (D) + (ss1 ^ rot) + ((W0) ^ (W4));                 \
+    H = GG((E), (F), (G)) + (H) + ss1 + (W0);                                  \
+    H = SM3_P0(H);                                                             \
+    B = SM3_ROTATE_32((B), 9);                                                 \
+    F = SM3_ROTATE_32((F), 19);                                                \
+  }
+
+#define SM3_ROUND_0(...) SM3_ROUND(SM3_FF0, SM3_GG0, __VA_ARGS__)
+#define SM3_ROUND_1(...) SM3_ROUND(SM3_FF1, SM3_GG1, __VA_ARGS__)
+
+// Compresses one block from `M` into `H`. The message words and the
+// expanded schedule live in m0..mf, a sliding window of the last 16 words.
+static inline void sm3_compress(uint32_t H[8], const uint8_t *M) {
+  uint32_t a = H[0], b = H[1], c = H[2], d = H[3];
+  uint32_t e = H[4], f = H[5], g = H[6], h = H[7];
+
+  uint32_t m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, ma, mb, mc, md, me, mf;
+
+  if (((uintptr_t)M & 3) == 0) {
+    SM3_LOAD32_BE(m0, M, 0);
+    SM3_LOAD32_BE(m1, M, 1);
+    SM3_LOAD32_BE(m2, M, 2);
+    SM3_LOAD32_BE(m3, M, 3);
+    SM3_LOAD32_BE(m4, M, 4);
+    SM3_LOAD32_BE(m5, M, 5);
+    SM3_LOAD32_BE(m6, M, 6);
+    SM3_LOAD32_BE(m7, M, 7);
+    SM3_LOAD32_BE(m8, M, 8);
+    SM3_LOAD32_BE(m9, M, 9);
+    SM3_LOAD32_BE(ma, M, 10);
+    SM3_LOAD32_BE(mb, M, 11);
+    SM3_LOAD32_BE(mc, M, 12);
+    SM3_LOAD32_BE(md, M, 13);
+    SM3_LOAD32_BE(me, M, 14);
+    SM3_LOAD32_BE(mf, M, 15);
+  } else {
+    SM3_LOADU32_BE(m0, M, 0);
+    SM3_LOADU32_BE(m1, M, 1);
+    SM3_LOADU32_BE(m2, M, 2);
+    SM3_LOADU32_BE(m3, M, 3);
+    SM3_LOADU32_BE(m4, M, 4);
+    SM3_LOADU32_BE(m5, M, 5);
+    SM3_LOADU32_BE(m6, M, 6);
+    SM3_LOADU32_BE(m7, M, 7);
+    SM3_LOADU32_BE(m8, M, 8);
+    SM3_LOADU32_BE(m9, M, 9);
+    SM3_LOADU32_BE(ma, M, 10);
+    SM3_LOADU32_BE(mb, M, 11);
+    SM3_LOADU32_BE(mc, M, 12);
+    SM3_LOADU32_BE(md, M, 13);
+    SM3_LOADU32_BE(me, M, 14);
+    SM3_LOADU32_BE(mf, M, 15);
+  }
+
+  // Rounds 0 to 15. W[16..19] are expanded as W[j+4] becomes due.
+  SM3_ROUND_0(a, b, c, d, e, f, g, h, SM3_T[0], m0, m4);
+  SM3_ROUND_0(d, a, b, c, h, e, f, g, SM3_T[1], m1, m5);
+  SM3_ROUND_0(c, d, a, b, g, h, e, f, SM3_T[2], m2, m6);
+  SM3_ROUND_0(b, c, d, a, f, g, h, e, SM3_T[3], m3, m7);
+  SM3_ROUND_0(a, b, c, d, e, f, g, h, SM3_T[4], m4, m8);
+  SM3_ROUND_0(d, a, b, c, h, e, f, g, SM3_T[5], m5, m9);
+  SM3_ROUND_0(c, d, a, b, g, h, e, f, SM3_T[6], m6, ma);
+  SM3_ROUND_0(b, c, d, a, f, g, h, e, SM3_T[7], m7, mb);
+  SM3_ROUND_0(a, b, c, d, e, f, g, h, SM3_T[8], m8, mc);
+  SM3_ROUND_0(d, a, b, c, h, e, f, g, SM3_T[9], m9, md);
+  SM3_ROUND_0(c, d, a, b, g, h, e, f, SM3_T[10], ma, me);
+  SM3_ROUND_0(b, c, d, a, f, g, h, e, SM3_T[11], mb, mf);
+  SM3_EXPAND(m0, m7, md, m3, ma);
+  SM3_ROUND_0(a, b, c, d, e, f, g, h, SM3_T[12], mc, m0);
+  SM3_EXPAND(m1, m8, me, m4, mb);
+  SM3_ROUND_0(d, a, b, c, h, e, f, g, SM3_T[13], md, m1);
+  SM3_EXPAND(m2, m9, mf, m5, mc);
+  SM3_ROUND_0(c, d, a, b, g, h, e, f, SM3_T[14], me, m2);
+  SM3_EXPAND(m3, ma, m0, m6, md);
+  SM3_ROUND_0(b, c, d, a, f, g, h, e, SM3_T[15], mf, m3);
+
+  // Rounds 16 to 63, each expanding the W[j+4] it needs.
+  for (const uint32_t *tp = SM3_T + 16; tp < SM3_T + 64; tp += 16) {
+    SM3_EXPAND(m4, mb, m1, m7, me);
+    SM3_ROUND_1(a, b, c, d, e, f, g, h, tp[0], m0, m4);
+    SM3_EXPAND(m5, mc, m2, m8, mf);
+    SM3_ROUND_1(d, a, b, c, h, e, f, g, tp[1], m1, m5);
+    SM3_EXPAND(m6, md, m3, m9, m0);
+    SM3_ROUND_1(c, d, a, b, g, h, e, f, tp[2], m2, m6);
+    SM3_EXPAND(m7, me, m4, ma, m1);
+    SM3_ROUND_1(b, c, d, a, f, g, h, e, tp[3], m3, m7);
+    SM3_EXPAND(m8, mf, m5, mb, m2);
+    SM3_ROUND_1(a, b, c, d, e, f, g, h, tp[4], m4, m8);
+    SM3_EXPAND(m9, m0, m6, mc, m3);
+    SM3_ROUND_1(d, a, b, c, h, e, f, g, tp[5], m5, m9);
+    SM3_EXPAND(ma, m1, m7, md, m4);
+    SM3_ROUND_1(c, d, a, b, g, h, e, f, tp[6], m6, ma);
+    SM3_EXPAND(mb, m2, m8, me, m5);
+    SM3_ROUND_1(b, c, d, a, f, g, h, e, tp[7], m7, mb);
+    SM3_EXPAND(mc, m3, m9, mf, m6);
+    SM3_ROUND_1(a, b, c, d, e, f, g, h, tp[8], m8, mc);
+    SM3_EXPAND(md, m4, ma, m0, m7);
+    SM3_ROUND_1(d, a, b, c, h, e, f, g, tp[9], m9, md);
+    SM3_EXPAND(me, m5, mb, m1, m8);
+    SM3_ROUND_1(c, d, a, b, g, h, e, f, tp[10], ma, me);
+    SM3_EXPAND(mf, m6, mc, m2, m9);
+    SM3_ROUND_1(b, c, d, a, f, g, h, e, tp[11], mb, mf);
+    SM3_EXPAND(m0, m7, md, m3, ma);
+    SM3_ROUND_1(a, b, c, d, e, f, g, h, tp[12], mc, m0);
+    SM3_EXPAND(m1, m8, me, m4, mb);
+    SM3_ROUND_1(d, a, b, c, h, e, f, g, tp[13], md, m1);
+    SM3_EXPAND(m2, m9, mf, m5, mc);
+    SM3_ROUND_1(c, d, a, b, g, h, e, f, tp[14], me, m2);
+    SM3_EXPAND(m3, ma, m0, m6, md);
+    SM3_ROUND_1(b, c, d, a, f, g, h, e, tp[15], mf, m3);
+  }
+
+  H[0] ^= a;
+  H[1] ^= b;
+  H[2] ^= c;
+  H[3] ^= d;
+  H[4] ^= e;
+  H[5] ^= f;
+  H[6] ^= g;
+  H[7] ^= h;
+}
+
+#endif // __SM3_COMPRESS__
@@ -0,0 +1,92 @@
+#include <string.h>
+
+#include "riscvcrypto/sm3/api_sm3.h"
+
+void sm3_init(sm3_ctx_t *ctx) {
+  ctx->H[0] = 0x7380166F;
+  ctx->H[1] = 0x4914B2B9;
+  ctx->H[2] = 0x172442D7;
+  ctx->H[3] = 0xDA8A0600;
+  ctx->H[4] = 0xA96F30BC;
+  ctx->H[5] = 0x163138AA;
+  ctx->H[6] = 0xE38DEE4D;
+  ctx->H[7] = 0xB0FB0E4E;
+  ctx->len = 0;
+}
+
+void sm3_update(sm3_ctx_t *ctx, const uint8_t *M, size_t len) {
+  uint8_t *bp = (uint8_t *)ctx->B;
+  size_t fill = ctx->len % SM3_BLOCK_BYTES;
+
+  ctx->len += len;
+
+  // Top up a partial block first
+  if (fill) {
+    size_t take = SM3_BLOCK_BYTES - fill;
+    take = take < len ? take : len;
+
+    memcpy(bp + fill, M, take);
+
+    M += take;
+    len -= take;
+    fill += take;
+
+    if (fill < SM3_BLOCK_BYTES) {
+      return;
+    }
+
+    sm3_hash_blocks(ctx->H, bp, 1);
+  }
+
+  // Compress whole blocks in place
+  size_t nblocks = len / SM3_BLOCK_BYTES;
+
+  sm3_hash_blocks(ctx->H, M, nblocks);
+
+  M += SM3_BLOCK_BYTES * nblocks;
+  len -= SM3_BLOCK_BYTES * nblocks;
+
+  // Keep the tail for next time
+  memcpy(bp, M, len);
+}
+
+void sm3_final(sm3_ctx_t *ctx, uint8_t *digest) {
+  uint8_t *bp = (uint8_t *)ctx->B;
+  size_t fill = ctx->len % SM3_BLOCK_BYTES;
+  uint64_t bitlen = ctx->len << 3;
+
+  // Append bit 1 after the message
+  bp[fill++] = 0x80;
+
+  if (fill > SM3_BLOCK_BYTES - sizeof(uint64_t)) {
+    memset(bp + fill, 0, SM3_BLOCK_BYTES - fill);
+    sm3_hash_blocks(ctx->H, bp, 1);
+    fill = 0;
+  }
+
+  // Pad everything between the message and the length with zeros
+  memset(bp + fill, 0, SM3_BLOCK_BYTES - sizeof(uint64_t) - fill);
+
+  // Append the length of the message in bits
+  for (int i = SM3_BLOCK_BYTES - 1; i >= SM3_BLOCK_BYTES - 8; --i) {
+    bp[i] = (uint8_t)bitlen;
+    bitlen >>= 8;
+  }
+
+  sm3_hash_blocks(ctx->H, bp, 1);
+
+  // Stores the chaining value in `digest` in big-endian
+  for (size_t i = 0; i < 8; ++i) {
+    digest[i * 4 + 0] = (uint8_t)(ctx->H[i] >> 24);
+    digest[i * 4 + 1] = (uint8_t)(ctx->H[i] >> 16);
+    digest[i * 4 + 2] = (uint8_t)(ctx->H[i] >> 8);
+    digest[i * 4 + 3] = (uint8_t)(ctx->H[i] >> 0);
+  }
+}
+
+void sm3_hash(uint8_t hash[32], const uint8_t *message, size_t len) {
+  sm3_ctx_t ctx;
+  sm3_init(&ctx);
+  sm3_update(&ctx, message, len);
+  sm3_final(&ctx, hash);
+}
@@ -1,7 +1,35 @@
 
+#include <stddef.h>
+#include <stdint.h>
+
 #ifndef __API_SM4_H__
 #define __API_SM4_H__
 
+/*!
+@defgroup crypto_block_sm4 Crypto Block SM4
+@{
+*/
+
+//! Number of bytes in a single SM4 block
+#define SM4_BLOCK_BYTES     16
+
+//! Bytes in an SM4 cipher key
+#define SM4_KEY_BYTES       16
+
+//! Words in an expanded SM4 key schedule
+#define SM4_RK_WORDS        32
+
+//! Number of blocks sm4_ecb_blocks works on side by side.
+#define SM4_ECB_BLOCKS_INTERLEAVE 4
+
+/*!
+@brief Most blocks the modes hand to sm4_ecb_blocks in one call.
+@details A multiple of SM4_ECB_BLOCKS_INTERLEAVE and of the bitsliced
+    batch size. The bitsliced backend slices the round keys once per
+    call, so larger groups spread that over more blocks.
+*/
+#define SM4_MODES_GROUP_BLOCKS    32
+
 void    sm4_key_schedule_enc (
     uint32_t rk [32], //!< Output expanded round key
     uint8_t  mk [16]  //!< Input cipher key
@@ -18,5 +46,140 @@ void    sm4_block_enc_dec (
     uint32_t rk  [32]  // Round key (encrypt or decrypt)
 );
 
-#endif
+/*!
+@brief Multi-block SM4 ECB encrypt / decrypt.
+@details Groups of SM4_ECB_BLOCKS_INTERLEAVE independent blocks are
+    interleaved within each round, so every round key is loaded once per
+    group and the latency of each block's serial round chain is hidden
+    behind the others. The bitsliced backend instead works on 8 or 16
+    blocks at once. As for sm4_block_enc_dec, in and out must be
+    4-byte aligned.
+@param [out] out     - Output text, nblocks*SM4_BLOCK_BYTES long.
+@param [in]  in      - Input text, nblocks*SM4_BLOCK_BYTES long.
+@param [in]  rk      - Round key (encrypt or decrypt)
+@param [in]  nblocks - Number of blocks.
+*/
+void    sm4_ecb_blocks (
+    uint8_t   * out,
+    uint8_t   * in,
+    uint32_t    rk [32],
+    size_t      nblocks
+);
+
+/*!
+@defgroup crypto_block_sm4_modes SM4 Modes
+@brief CBC, CTR and XTS on top of sm4_block_enc_dec and sm4_ecb_blocks.
+@details Provided by the sm4_modes library, which works with any SM4
+    backend. Buffers may have any alignment. Where a mode allows it,
+    blocks go through sm4_ecb_blocks SM4_MODES_GROUP_BLOCKS at a time.
+@{
+*/
+
+/*!
+@brief SM4 CBC encrypt.
+@details Each block depends on the last, so this runs one block at a
+    time. On return, iv holds the last cipher text block, so a long
+    message may be encrypted in several calls.
+@param [out]   ct  - Output cipher text, len bytes long.
+@param [in]    pt  - Input plaintext, len bytes long.
+@param [in]    erk - The expanded encryption key schedule
+@param [in]    len - Length of pt and ct. A multiple of SM4_BLOCK_BYTES.
+@param [inout] iv  - Initialisation vector. Updated in place.
+@returns 0 on success, non-zero if len is not a whole number of blocks.
+*/
+int     sm4_cbc_encrypt (
+    uint8_t   * ct,
+    uint8_t   * pt,
+    uint32_t  * erk,
+    size_t      len,
+    uint8_t     iv [SM4_BLOCK_BYTES]
+);
 
+/*!
+@brief SM4 CBC decrypt.
+@details Blocks are decrypted in groups, then each is xored with
+    the cipher text block before it. ct and pt may be the same buffer.
+@param [out]   pt  - Output plaintext, len bytes long.
+@param [in]    ct  - Input cipher text, len bytes long.
+@param [in]    drk - The expanded decryption key schedule
+@param [in]    len - Length of ct and pt. A multiple of SM4_BLOCK_BYTES.
+@param [inout] iv  - Initialisation vector. Updated in place.
+@returns 0 on success, non-zero if len is not a whole number of blocks.
+*/
+int     sm4_cbc_decrypt (
+    uint8_t   * pt,
+    uint8_t   * ct,
+    uint32_t  * drk,
+    size_t      len,
+    uint8_t     iv [SM4_BLOCK_BYTES]
+);
+
+/*!
+@brief SM4 counter mode encrypt / decrypt.
+@details The keystream for block i is the encryption of ctr+i, where ctr
+    is a 128-bit big-endian counter. A trailing partial block uses the
+    leading bytes of one more keystream block. On return, ctr holds the
+    next unused counter value, as for aes_128_ctr_xcrypt.
+@param [out]   out - Output text, len bytes long.
+@param [in]    in  - Input text, len bytes long.
+@param [in]    erk - The expanded encryption key schedule
+@param [in]    len - Length of in and out in bytes.
+@param [inout] ctr - Initial counter block. Updated in place.
+*/
+void    sm4_ctr_xcrypt (
+    uint8_t   * out,
+    uint8_t   * in,
+    uint32_t  * erk,
+    size_t      len,
+    uint8_t     ctr [SM4_BLOCK_BYTES]
+);
+
+/*!
+@brief SM4 XTS encrypt one data unit, as in IEEE 1619.
+@details The tweak for block j is the encryption of iv under the tweak
+    key, times x^j in GF(2^128), with the little-endian convention of
+    IEEE 1619. A trailing partial block is handled by cipher text
+    stealing. ct and pt may be the same buffer.
+@param [out] ct   - Output cipher text, len bytes long.
+@param [in]  pt   - Input plaintext, len bytes long.
+@param [in]  erk1 - Encryption key schedule of the data key.
+@param [in]  erk2 - Encryption key schedule of the tweak key.
+@param [in]  len  - Length of pt and ct. At least SM4_BLOCK_BYTES.
+@param [in]  iv   - The tweak of this data unit, e.g. its sector number.
+@returns 0 on success, non-zero if len is less than one block.
+*/
+int     sm4_xts_encrypt (
+    uint8_t   * ct,
+    uint8_t   * pt,
+    uint32_t  * erk1,
+    uint32_t  * erk2,
+    size_t      len,
+    uint8_t     iv [SM4_BLOCK_BYTES]
+);
+
+/*!
+@brief SM4 XTS decrypt one data unit.
+@details The tweak key is still used to encrypt, so it takes the
+    encryption schedule, while the data key takes the decryption one.
+@param [out] pt   - Output plaintext, len bytes long.
+@param [in]  ct   - Input cipher text, len bytes long.
+@param [in]  drk1 - Decryption key schedule of the data key.
+@param [in]  erk2 - Encryption key schedule of the tweak key.
+@param [in]  len  - Length of ct and pt. At least SM4_BLOCK_BYTES.
+@param [in]  iv   - The tweak of this data unit.
+@returns 0 on success, non-zero if len is less than one block.
+*/
+int     sm4_xts_decrypt (
+    uint8_t   * pt,
+    uint8_t   * ct,
+    uint32_t  * drk1,
+    uint32_t  * erk2,
+    size_t      len,
+    uint8_t     iv [SM4_BLOCK_BYTES]
+);
+
+//! @}
+
+//! @}
+
+#endif
@@ -0,0 +1,454 @@
+/*!
+@addtogroup crypto_block_sm4_bitsliced SM4 Bitsliced
+@brief Constant time bitsliced implementation of SM4 w.out Zksed.
+@details SM4_BS_BLOCKS blocks are processed at once: 16 on RV64 and 8 on
+    RV32, one per bit of a register-wide word for each byte position. Each
+    of the four state words is held as eight words, one per bit of its
+    bytes, so the S-box layer is a circuit of XOR, AND and NOT gates and
+    the byte rotations of the linear layer are word rotations. There are
+    no table lookups and no data dependent branches.
+
+    SM4's S-box is an affine map, an inversion in GF(2^8) under a
+    different polynomial to AES, then another affine map. Both fields are
+    isomorphic, so the S-box is the Boyar-Peralta inversion core used by
+    the AES bitsliced backend, with the affine maps and the change of
+    basis folded into its top and bottom linear layers.
+
+    The key schedule is the standard one, so rk has the same layout as
+    for the other backends. Round keys are bitsliced at the start of every
+    call to sm4_ecb_blocks, which spreads that cost over all of its blocks.
+    sm4_block_enc_dec costs as much as a full batch of blocks, so bulk
+    data should go through sm4_ecb_blocks or the sm4_modes functions.
+@ingroup crypto_block_sm4
+@{
+*/
+
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/sm4/api_sm4.h"
+
+#if __riscv_xlen == 32
+typedef uint32_t sm4_bs_word_t;
+#else
+typedef uint64_t sm4_bs_word_t;
+#endif
+
+//! Blocks in one bitsliced state: a quarter of the bits of a word.
+#define SM4_BS_BLOCKS   (2 * sizeof(sm4_bs_word_t))
+
+//! Bytes of a word which the packing transpose gives to one byte position.
+#define SM4_BS_SPAN     (SM4_BS_BLOCKS / 8)
+
+/*!
+@brief Bitsliced state of SM4_BS_BLOCKS blocks.
+@details x[i][j] holds bit j of every byte of state word i. Byte k of the
+    word of block b, counting from the least significant, is at bit
+    SM4_BS_BLOCKS*k + b, so rotating a word left by 8 bits is rotating
+    each of its eight words left by SM4_BS_BLOCKS bits.
+*/
+typedef sm4_bs_word_t sm4_bs_state_t [4][8];
+
+//! Rotate a bitsliced word left by n bits, 0 < n < its width.
+#define SM4_BS_ROL(x, n) \
+    (((x) << (n)) | ((x) >> (8 * sizeof(sm4_bs_word_t) - (n))))
+
+//! Swap the bits of a selected by mask << n with the bits of b in mask.
+#define SWAPMOVE(a, b, mask, n) {                                   \
+    sm4_bs_word_t t_ = (((a) >> (n)) ^ (b)) & (sm4_bs_word_t)(mask);\
+    (b) ^= t_;                                                      \
+    (a) ^= t_ << (n);                                               \
+}
+
+//! System parameter FK, xored into the cipher key.
+static const uint32_t FK [ 4] = {
+    0xA3B1BAC6, 0x56AA3350, 0x677D9197, 0xB27022DC
+};
+
+//! Key schedule constants CK.
+static const uint32_t CK [32] = {
+    0x00070E15, 0x1C232A31, 0x383F464D, 0x545B6269, 0x70777E85, 0x8C939AA1,
+    0xA8AFB6BD, 0xC4CBD2D9, 0xE0E7EEF5, 0xFC030A11, 0x181F262D, 0x343B4249,
+    0x50575E65, 0x6C737A81, 0x888F969D, 0xA4ABB2B9, 0xC0C7CED5, 0xDCE3EAF1,
+    0xF8FF060D, 0x141B2229, 0x30373E45, 0x4C535A61, 0x686F767D, 0x848B9299,
+    0xA0A7AEB5, 0xBCC3CAD1, 0xD8DFE6ED, 0xF4FB0209, 0x10171E25, 0x2C333A41,
+    0x484F565D, 0x646B7279
+};
+
+/*!
+@brief Transpose the 8x8 bit matrix found at each byte position of the
+    eight words in q. Used both to enter and to leave bitsliced form.
+*/
+static void sm4_bs_transpose(sm4_bs_word_t q[8]) {
+    SWAPMOVE(q[0], q[1], 0x5555555555555555ULL, 1);
+    SWAPMOVE(q[2], q[3], 0x5555555555555555ULL, 1);
+    SWAPMOVE(q[4], q[5], 0x5555555555555555ULL, 1);
+    SWAPMOVE(q[6], q[7], 0x5555555555555555ULL, 1);
+    SWAPMOVE(q[0], q[2], 0x3333333333333333ULL, 2);
+    SWAPMOVE(q[1], q[3], 0x3333333333333333ULL, 2);
+    SWAPMOVE(q[4], q[6], 0x3333333333333333ULL, 2);
+    SWAPMOVE(q[5], q[7], 0x3333333333333333ULL, 2);
+    SWAPMOVE(q[0], q[4], 0x0F0F0F0F0F0F0F0FULL, 4);
+    SWAPMOVE(q[1], q[5], 0x0F0F0F0F0F0F0F0FULL, 4);
+    SWAPMOVE(q[2], q[6], 0x0F0F0F0F0F0F0F0FULL, 4);
+    SWAPMOVE(q[3], q[7], 0x0F0F0F0F0F0F0F0FULL, 4);
+}
+
+/*
+Before the transpose, byte p of word w of x[i] is byte p/SM4_BS_SPAN,
+from the least significant, of word i of block 8*(p%SM4_BS_SPAN) + w.
+After it, bit 8*p + w of each word is then that byte's bit, which is the
+layout given for sm4_bs_state_t. Words are big-endian in memory.
+Blocks from nblocks on are zero going in and are not written coming out.
+*/
+
+//! Convert nblocks (at most SM4_BS_BLOCKS) blocks into bitsliced form.
+static void sm4_bs_pack(sm4_bs_state_t x, uint8_t * in, size_t nblocks) {
+    for(int i = 0; i < 4; i ++) {
+        for(int w = 0; w < 8; w ++) {
+            sm4_bs_word_t v = 0;
+            for(int p = sizeof(sm4_bs_word_t) - 1; p >= 0; p --) {
+                size_t b = 8 * (p % SM4_BS_SPAN) + w;
+                int    k = 3 - p / SM4_BS_SPAN;
+                v = (v << 8) | (b < nblocks ? in[SM4_BLOCK_BYTES*b + 4*i + k]
+                                            : 0);
+            }
+            x[i][w] = v;
+        }
+        sm4_bs_transpose(x[i]);
+    }
+}
+
+/*!
+@brief Convert the first nblocks blocks back out of bitsliced form.
+@details The cipher's output is its last four state words in reverse
+    order, which are x[3] down to x[0] after 32 rounds.
+*/
+static void sm4_bs_unpack(uint8_t * out, sm4_bs_state_t x, size_t nblocks) {
+    for(int i = 0; i < 4; i ++) {
+        sm4_bs_transpose(x[3 - i]);
+        for(int w = 0; w < 8; w ++) {
+            sm4_bs_word_t v = x[3 - i][w];
+            for(int p = 0; p < (int)sizeof(sm4_bs_word_t); p ++) {
+                size_t b = 8 * (p % SM4_BS_SPAN) + w;
+                int    k = 3 - p / SM4_BS_SPAN;
+                if(b < nblocks) {
+                    out[SM4_BLOCK_BYTES*b + 4*i + k] = v & 0xFF;
+                }
+                v >>= 8;
+            }
+        }
+    }
+}
+
+/*!
+@brief Bitslice each round key, copied into every block position.
+@details Bit j of each byte of rk[r] is picked out, moved to the bottom
+    of that byte's lane, and multiplied out to a run of SM4_BS_BLOCKS ones
+    or zeros in k[r][j]. There are no branches on the key.
+*/
+static void sm4_bs_slice_keys(sm4_bs_word_t k[32][8], uint32_t rk[32]) {
+    sm4_bs_word_t lane = ((sm4_bs_word_t)1 << SM4_BS_BLOCKS) - 1;
+    for(int r = 0; r < 32; r ++) {
+        for(int j = 0; j < 8; j ++) {
+            sm4_bs_word_t v = (rk[r] >> j) & 0x01010101;
+#if __riscv_xlen != 32
+            v = (v ^ (v << 16)) & 0x0000FFFF0000FFFFULL;
+            v = (v ^ (v <<  8)) & 0x00FF00FF00FF00FFULL;
+#endif
+            k[r][j] = v * lane;
+        }
+    }
+}
+
+/*!
+@brief The SM4 S-box on every byte of the eight words in q.
+@details q[j] holds bit j of each byte, q[0] being the least significant.
+*/
+static void sm4_bs_sbox(sm4_bs_word_t q[8]) {
+    sm4_bs_word_t X0 = q[0], X1 = q[1], X2 = q[2], X3 = q[3];
+    sm4_bs_word_t X4 = q[4], X5 = q[5], X6 = q[6], X7 = q[7];
+
+    // Top linear transform: the SM4 input affine map, then the change
+    // of basis into the AES field, folded into the core's inputs.
+    sm4_bs_word_t Y0  = X0  ^ X3 ;
+    sm4_bs_word_t Y1  = X2  ^ X4 ;
+    sm4_bs_word_t Y2  = X1  ^ X5 ;
+    sm4_bs_word_t T10 = X7  ^ Y1 ;
+    sm4_bs_word_t Y3  = X6  ^ Y2 ;
+    sm4_bs_word_t Y4  = X1  ^ X7 ;
+    sm4_bs_word_t Y5  = Y0  ^ Y1 ;
+    sm4_bs_word_t Y6  = Y0  ^ Y3 ;
+    sm4_bs_word_t T22 = X2  ^ X6 ;
+    sm4_bs_word_t Y7  = X3  ^ X5 ;
+    sm4_bs_word_t Y8  = X4  ^ Y4 ;
+    sm4_bs_word_t Y9  = X6  ^ T10;
+    sm4_bs_word_t Y10 = X0  ^ X6 ;
+    sm4_bs_word_t Y11 = X0  ^ T10;
+    sm4_bs_word_t Y12 = X1  ^ Y5 ;
+    sm4_bs_word_t T20 = X1  ^ T22;
+    sm4_bs_word_t Y14 = X2  ^ X7 ;
+    sm4_bs_word_t T2  = X2  ^ Y6 ;
+    sm4_bs_word_t Y16 = X3  ^ Y4 ;
+    sm4_bs_word_t Y17 = X4  ^ X7 ;
+    sm4_bs_word_t T16 = X5  ^ Y5 ;
+    sm4_bs_word_t T4  = X5  ^ Y9 ;
+    sm4_bs_word_t Y18 = X7  ^ Y7 ;
+    sm4_bs_word_t T23 = Y0  ^ Y2 ;
+    sm4_bs_word_t Y19 = Y0  ^ Y4 ;
+    sm4_bs_word_t T1  = Y0  ^ Y8 ;
+    sm4_bs_word_t T19 = Y0  ^ Y9 ;
+    sm4_bs_word_t Y21 = Y1  ^ Y7 ;
+    sm4_bs_word_t Y22 = Y2  ^ T10;
+    sm4_bs_word_t T26 = Y2  ^ Y5 ;
+    sm4_bs_word_t T13 = T10 ^ Y3 ;
+    sm4_bs_word_t T24 = Y6  ^ Y17;
+    sm4_bs_word_t Y24 = Y8  ^ Y10;
+    sm4_bs_word_t T3  = X1;
+    sm4_bs_word_t T6  = ~Y22;
+    sm4_bs_word_t T8  = ~Y21;
+    sm4_bs_word_t T9  = ~Y18;
+    sm4_bs_word_t T14 = ~Y14;
+    sm4_bs_word_t T15 = ~Y12;
+    sm4_bs_word_t T17 = ~Y11;
+    sm4_bs_word_t T25 = ~Y24;
+    sm4_bs_word_t T27 = ~Y19;
+    sm4_bs_word_t U7  = Y16;
+
+    // Shared non-linear middle: inversion in GF(2^4)^2, as for AES
+    sm4_bs_word_t M1  = T13 & T6 ;
+    sm4_bs_word_t M2  = T23 & T8 ;
+    sm4_bs_word_t M3  = T14 ^ M1 ;
+    sm4_bs_word_t M4  = T19 & U7 ;
+    sm4_bs_word_t M5  = M4  ^ M1 ;
+    sm4_bs_word_t M6  = T3  & T16;
+    sm4_bs_word_t M7  = T22 & T9 ;
+    sm4_bs_word_t M8  = T26 ^ M6 ;
+    sm4_bs_word_t M9  = T20 & T17;
+    sm4_bs_word_t M10 = M9  ^ M6 ;
+    sm4_bs_word_t M11 = T1  & T15;
+    sm4_bs_word_t M12 = T4  & T27;
+    sm4_bs_word_t M13 = M12 ^ M11;
+    sm4_bs_word_t M14 = T2  & T10;
+    sm4_bs_word_t M15 = M14 ^ M11;
+    sm4_bs_word_t M16 = M3  ^ M2 ;
+    sm4_bs_word_t M17 = M5  ^ T24;
+    sm4_bs_word_t M18 = M8  ^ M7 ;
+    sm4_bs_word_t M19 = M10 ^ M15;
+    sm4_bs_word_t M20 = M16 ^ M13;
+    sm4_bs_word_t M21 = M17 ^ M15;
+    sm4_bs_word_t M22 = M18 ^ M13;
+    sm4_bs_word_t M23 = M19 ^ T25;
+    sm4_bs_word_t M24 = M22 ^ M23;
+    sm4_bs_word_t M25 = M22 & M20;
+    sm4_bs_word_t M26 = M21 ^ M25;
+    sm4_bs_word_t M27 = M20 ^ M21;
+    sm4_bs_word_t M28 = M23 ^ M25;
+    sm4_bs_word_t M29 = M28 & M27;
+    sm4_bs_word_t M30 = M26 & M24;
+    sm4_bs_word_t M31 = M20 & M23;
+    sm4_bs_word_t M32 = M27 & M31;
+    sm4_bs_word_t M33 = M27 ^ M25;
+    sm4_bs_word_t M34 = M21 & M22;
+    sm4_bs_word_t M35 = M24 & M34;
+    sm4_bs_word_t M36 = M24 ^ M25;
+    sm4_bs_word_t M37 = M21 ^ M29;
+    sm4_bs_word_t M38 = M32 ^ M33;
+    sm4_bs_word_t M39 = M23 ^ M30;
+    sm4_bs_word_t M40 = M35 ^ M36;
+    sm4_bs_word_t M41 = M38 ^ M40;
+    sm4_bs_word_t M42 = M37 ^ M39;
+    sm4_bs_word_t M43 = M37 ^ M38;
+    sm4_bs_word_t M44 = M39 ^ M40;
+    sm4_bs_word_t M45 = M42 ^ M41;
+    sm4_bs_word_t M46 = M44 & T6 ;
+    sm4_bs_word_t M47 = M40 & T8 ;
+    sm4_bs_word_t M48 = M39 & U7 ;
+    sm4_bs_word_t M49 = M43 & T16;
+    sm4_bs_word_t M50 = M38 & T9 ;
+    sm4_bs_word_t M51 = M37 & T17;
+    sm4_bs_word_t M52 = M42 & T15;
+    sm4_bs_word_t M53 = M45 & T27;
+    sm4_bs_word_t M54 = M41 & T10;
+    sm4_bs_word_t M55 = M44 & T13;
+    sm4_bs_word_t M56 = M40 & T23;
+    sm4_bs_word_t M57 = M39 & T19;
+    sm4_bs_word_t M58 = M43 & T3 ;
+    sm4_bs_word_t M59 = M38 & T22;
+    sm4_bs_word_t M60 = M37 & T20;
+    sm4_bs_word_t M61 = M42 & T1 ;
+    sm4_bs_word_t M62 = M45 & T4 ;
+    sm4_bs_word_t M63 = M41 & T2 ;
+
+    // Bottom linear transform: back out of the AES field, then the SM4
+    // output affine map.
+    sm4_bs_word_t Z0  = M46 ^ M56;
+    sm4_bs_word_t Z1  = M55 ^ M61;
+    sm4_bs_word_t Z2  = M47 ^ Z0 ;
+    sm4_bs_word_t Z3  = M50 ^ M52;
+    sm4_bs_word_t Z4  = M59 ^ M60;
+    sm4_bs_word_t Z5  = M51 ^ M54;
+    sm4_bs_word_t Z6  = M53 ^ Z1 ;
+    sm4_bs_word_t Z7  = Z2  ^ Z5 ;
+    sm4_bs_word_t Z8  = Z3  ^ Z4 ;
+    sm4_bs_word_t Z9  = M49 ^ Z6 ;
+    sm4_bs_word_t Z10 = M57 ^ Z8 ;
+    sm4_bs_word_t Z11 = M62 ^ Z7 ;
+    sm4_bs_word_t Z12 = M48 ^ M51;
+    sm4_bs_word_t Z13 = M52 ^ M63;
+    sm4_bs_word_t Z14 = M53 ^ Z0 ;
+    sm4_bs_word_t Z15 = M56 ^ M63;
+    sm4_bs_word_t Z16 = M57 ^ M63;
+    sm4_bs_word_t Z17 = M58 ^ M59;
+    sm4_bs_word_t Z18 = M61 ^ M62;
+    sm4_bs_word_t Z19 = Z1  ^ Z3 ;
+    sm4_bs_word_t Z20 = Z1  ^ Z16;
+    sm4_bs_word_t Z21 = Z2  ^ Z4 ;
+    sm4_bs_word_t Z22 = Z6  ^ Z13;
+    sm4_bs_word_t Z23 = Z7  ^ Z10;
+    sm4_bs_word_t Z24 = Z8  ^ Z9 ;
+    sm4_bs_word_t Z25 = Z9  ^ Z11;
+    sm4_bs_word_t Z26 = Z10 ^ Z12;
+    sm4_bs_word_t Z27 = Z11 ^ Z19;
+    sm4_bs_word_t Z28 = Z14 ^ Z26;
+    sm4_bs_word_t Z29 = Z15 ^ Z24;
+    sm4_bs_word_t Z30 = Z17 ^ Z18;
+    sm4_bs_word_t Z31 = Z21 ^ Z22;
+
+    q[0] = ~Z25;
+    q[1] = ~Z23;
+    q[2] =  Z29;
+    q[3] =  Z20;
+    q[4] = ~Z27;
+    q[5] =  Z31;
+    q[6] = ~Z28;
+    q[7] = ~Z30;
+}
+
+/*!
+@brief x ^= L(t), the SM4 linear transform of the S-box output t.
+@details L(t) = t ^ (t <<< 2) ^ (t <<< 10) ^ (t <<< 18) ^ (t <<< 24),
+    computed as t ^ (t <<< 24) ^ (y <<< 2) with y = t ^ (t <<< 8) ^
+    (t <<< 16). Byte rotations are word rotations. Rotating by 2 moves
+    bit j of each byte to bit j+2, and the top two bits to the bottom of
+    the next byte up.
+*/
+static void sm4_bs_linear(sm4_bs_word_t x[8], sm4_bs_word_t t[8]) {
+    sm4_bs_word_t y[8];
+    for(int j = 0; j < 8; j ++) {
+        y[j] = t[j] ^ SM4_BS_ROL(t[j],     SM4_BS_BLOCKS)
+                    ^ SM4_BS_ROL(t[j], 2 * SM4_BS_BLOCKS);
+    }
+    for(int j = 0; j < 8; j ++) {
+        sm4_bs_word_t y2 = j >= 2 ? y[j - 2]
+                                  : SM4_BS_ROL(y[j + 6], SM4_BS_BLOCKS);
+        x[j] ^= t[j] ^ SM4_BS_ROL(t[j], 3 * SM4_BS_BLOCKS) ^ y2;
+    }
+}
+
+//! The 32 rounds of SM4 with bitsliced round keys k.
+static void sm4_bs_rounds(sm4_bs_state_t x, sm4_bs_word_t k[32][8]) {
+    sm4_bs_word_t t[8];
+    for(int r = 0; r < 32; r ++) {
+        sm4_bs_word_t * x0 = x[(r + 0) & 3];
+        sm4_bs_word_t * x1 = x[(r + 1) & 3];
+        sm4_bs_word_t * x2 = x[(r + 2) & 3];
+        sm4_bs_word_t * x3 = x[(r + 3) & 3];
+        for(int j = 0; j < 8; j ++) {
+            t[j] = x1[j] ^ x2[j] ^ x3[j] ^ k[r][j];
+        }
+        sm4_bs_sbox(t);
+        sm4_bs_linear(x0, t);
+    }
+}
+
+/*!
+@brief The S-box on each byte of a single word, for the key schedule.
+@details Byte k of a goes in bit k of each sliced word. Only four bit
+    positions are used, but the S-box costs the same as for a batch.
+*/
+static uint32_t sm4_bs_tau(uint32_t a) {
+    sm4_bs_word_t q[8];
+    uint32_t      r = 0;
+    for(int j = 0; j < 8; j ++) {
+        q[j] = 0;
+        for(int k = 0; k < 4; k ++) {
+            q[j] |= (sm4_bs_word_t)((a >> (8*k + j)) & 1) << k;
+        }
+    }
+    sm4_bs_sbox(q);
+    for(int j = 0; j < 8; j ++) {
+        for(int k = 0; k < 4; k ++) {
+            r |= (uint32_t)((q[j] >> k) & 1) << (8*k + j);
+        }
+    }
+    return r;
+}
+
+void    sm4_key_schedule_enc (
+    uint32_t rk [32], //!< Output expanded round key
+    uint8_t  mk [16]  //!< Input cipher key
+) {
+    uint32_t K [4];
+
+    for(int i = 0; i < 4; i ++) {
+        K[i] = ((uint32_t)mk[4*i + 0] << 24) | ((uint32_t)mk[4*i + 1] << 16) |
+               ((uint32_t)mk[4*i + 2] <<  8) | ((uint32_t)mk[4*i + 3] <<  0) ;
+        K[i] = K[i] ^ FK[i];
+    }
+
+    for(int i = 0; i < 32; i ++) {
+        uint32_t t = sm4_bs_tau(K[(i+1)&3] ^ K[(i+2)&3] ^ K[(i+3)&3] ^ CK[i]);
+        K[i & 3]  ^= t ^ ROTL32(t, 13) ^ ROTL32(t, 23);
+        rk[i]      = K[i & 3];
+    }
+}
+
+void    sm4_key_schedule_dec (
+    uint32_t rk [32], //!< Output expanded round key
+    uint8_t  mk [16]  //!< Input cipher key
+){
+    uint32_t tmp;
+
+    sm4_key_schedule_enc(rk, mk);
+
+    for(int i = 0; i < 16; i ++) {
+        tmp      = rk[   i];
+        rk[   i] = rk[31-i];
+        rk[31-i] = tmp     ;
+    }
+}
+
+void    sm4_ecb_blocks (
+    uint8_t   * out,
+    uint8_t   * in,
+    uint32_t    rk [32],
+    size_t      nblocks
+){
+    sm4_bs_word_t  k [32][8];
+    sm4_bs_state_t x;
+
+    sm4_bs_slice_keys(k, rk);
+
+    while(nblocks > 0) {
+
+        size_t nb = nblocks < SM4_BS_BLOCKS ? nblocks : SM4_BS_BLOCKS;
+
+        sm4_bs_pack  (x, in, nb);
+        sm4_bs_rounds(x, k);
+        sm4_bs_unpack(out, x, nb);
+
+        in      += nb * SM4_BLOCK_BYTES;
+        out     += nb * SM4_BLOCK_BYTES;
+        nblocks -= nb;
+    }
+}
+
+void    sm4_block_enc_dec (
+    uint8_t  out [16], // Output block
+    uint8_t  in  [16], // Input block
+    uint32_t rk  [32]  // Round key (encrypt or decrypt)
+){
+    sm4_ecb_blocks(out, in, rk, 1);
+}
+
+//!@}
@@ -0,0 +1,298 @@
+/*!
+@addtogroup crypto_block_sm4_modes SM4 Modes
+@details Caller buffers are only ever read and written bytewise or
+    through memcpy. Blocks are staged in word aligned local buffers
+    before they reach the block functions, which need aligned
+    arguments, so that in place operation and any alignment both work.
+@ingroup crypto_block_sm4
+@{
+*/
+
+#include <string.h>
+
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/sm4/api_sm4.h"
+
+//! Bytes in one group of blocks handed to sm4_ecb_blocks.
+#define SM4_GROUP_BYTES (SM4_MODES_GROUP_BLOCKS * SM4_BLOCK_BYTES)
+
+//! Load a 64-bit big-endian value.
+static inline uint64_t sm4_load64_be(uint8_t * p) {
+    uint64_t r = 0;
+    for(int i = 0; i < 8; i ++) {
+        r = (r << 8) | p[i];
+    }
+    return r;
+}
+
+//! Store a 64-bit big-endian value.
+static inline void sm4_store64_be(uint8_t * p, uint64_t x) {
+    for(int i = 7; i >= 0; i --) {
+        p[i] = x & 0xFF;
+        x  >>= 8;
+    }
+}
+
+//! Load a 64-bit little-endian value.
+static inline uint64_t sm4_load64_le(uint8_t * p) {
+    uint64_t r = 0;
+    for(int i = 7; i >= 0; i --) {
+        r = (r << 8) | p[i];
+    }
+    return r;
+}
+
+//! Store a 64-bit little-endian value.
+static inline void sm4_store64_le(uint8_t * p, uint64_t x) {
+    for(int i = 0; i < 8; i ++) {
+        p[i] = x & 0xFF;
+        x  >>= 8;
+    }
+}
+
+//! out = a ^ b over len bytes. Any of them may alias.
+static inline void sm4_xor(uint8_t * out, uint8_t * a, uint8_t * b,
+                           size_t len) {
+    for(size_t i = 0; i < len; i ++) {
+        out[i] = a[i] ^ b[i];
+    }
+}
+
+int     sm4_cbc_encrypt (
+    uint8_t   * ct,
+    uint8_t   * pt,
+    uint32_t  * erk,
+    size_t      len,
+    uint8_t     iv [SM4_BLOCK_BYTES]
+){
+    uint32_t c [SM4_BLOCK_BYTES / 4]; //!< Chaining value, word aligned.
+
+    if(len % SM4_BLOCK_BYTES) {
+        return 1;
+    }
+
+    memcpy(c, iv, SM4_BLOCK_BYTES);
+
+    for(; len > 0; len -= SM4_BLOCK_BYTES) {
+        sm4_xor((uint8_t*)c, (uint8_t*)c, pt, SM4_BLOCK_BYTES);
+        sm4_block_enc_dec((uint8_t*)c, (uint8_t*)c, erk);
+        memcpy(ct, c, SM4_BLOCK_BYTES);
+        ct += SM4_BLOCK_BYTES;
+        pt += SM4_BLOCK_BYTES;
+    }
+
+    memcpy(iv, c, SM4_BLOCK_BYTES);
+
+    return 0;
+}
+
+int     sm4_cbc_decrypt (
+    uint8_t   * pt,
+    uint8_t   * ct,
+    uint32_t  * drk,
+    size_t      len,
+    uint8_t     iv [SM4_BLOCK_BYTES]
+){
+    //! The cipher text of this group, then its decryption.
+    uint32_t c [SM4_GROUP_BYTES / 4];
+    uint32_t d [SM4_GROUP_BYTES / 4];
+    //! The cipher text block before the group.
+    uint8_t  prev [SM4_BLOCK_BYTES];
+
+    if(len % SM4_BLOCK_BYTES) {
+        return 1;
+    }
+
+    memcpy(prev, iv, SM4_BLOCK_BYTES);
+
+    while(len > 0) {
+
+        size_t nbytes = len < SM4_GROUP_BYTES ? len : SM4_GROUP_BYTES;
+        size_t nb     = nbytes / SM4_BLOCK_BYTES;
+
+        // Copy the cipher text out first, in case pt and ct are the same.
+        memcpy(c, ct, nbytes);
+
+        sm4_ecb_blocks((uint8_t*)d, (uint8_t*)c, drk, nb);
+
+        sm4_xor(pt, (uint8_t*)d, prev, SM4_BLOCK_BYTES);
+        sm4_xor(pt + SM4_BLOCK_BYTES, (uint8_t*)d + SM4_BLOCK_BYTES,
+                (uint8_t*)c, nbytes - SM4_BLOCK_BYTES);
+
+        memcpy(prev, (uint8_t*)c + nbytes - SM4_BLOCK_BYTES, SM4_BLOCK_BYTES);
+
+        pt  += nbytes;
+        ct  += nbytes;
+        len -= nbytes;
+    }
+
+    memcpy(iv, prev, SM4_BLOCK_BYTES);
+
+    return 0;
+}
+
+void    sm4_ctr_xcrypt (
+    uint8_t   * out,
+    uint8_t   * in,
+    uint32_t  * erk,
+    size_t      len,
+    uint8_t     ctr [SM4_BLOCK_BYTES]
+){
+    uint64_t ks [SM4_GROUP_BYTES / 8]; //!< Counter blocks, then keystream.
+    uint64_t ctr_hi = sm4_load64_be(ctr + 0);
+    uint64_t ctr_lo = sm4_load64_be(ctr + 8);
+
+    while(len > 0) {
+
+        size_t nb = (len + SM4_BLOCK_BYTES - 1) / SM4_BLOCK_BYTES;
+        nb        = nb < SM4_MODES_GROUP_BLOCKS ? nb : SM4_MODES_GROUP_BLOCKS;
+
+        for(size_t b = 0; b < nb; b ++) {
+            sm4_store64_be((uint8_t*)(ks + 2*b + 0), ctr_hi);
+            sm4_store64_be((uint8_t*)(ks + 2*b + 1), ctr_lo);
+            ctr_lo += 1;
+            ctr_hi += ctr_lo == 0;
+        }
+
+        sm4_ecb_blocks((uint8_t*)ks, (uint8_t*)ks, erk, nb);
+
+        size_t nbytes = nb * SM4_BLOCK_BYTES;
+        nbytes        = nbytes < len ? nbytes : len;
+
+        sm4_xor(out, in, (uint8_t*)ks, nbytes);
+
+        out += nbytes;
+        in  += nbytes;
+        len -= nbytes;
+    }
+
+    sm4_store64_be(ctr + 0, ctr_hi);
+    sm4_store64_be(ctr + 8, ctr_lo);
+}
+
+/*!
+@brief Multiply the XTS tweak, held as two little-endian halves, by x.
+*/
+static inline void sm4_xts_mul_x(uint64_t * lo, uint64_t * hi) {
+    uint64_t carry = *hi >> 63;
+    *hi = (*hi << 1) | (*lo >> 63);
+    *lo = (*lo << 1) ^ (0x87 & -carry);
+}
+
+//! Encrypt or decrypt one block with tweak t: out = E(in ^ t) ^ t.
+static void sm4_xts_block (
+    uint8_t   * out,
+    uint8_t   * in,
+    uint32_t  * rk,
+    uint8_t     t [SM4_BLOCK_BYTES]
+){
+    uint32_t b [SM4_BLOCK_BYTES / 4];
+    sm4_xor((uint8_t*)b, in, t, SM4_BLOCK_BYTES);
+    sm4_block_enc_dec((uint8_t*)b, (uint8_t*)b, rk);
+    sm4_xor(out, (uint8_t*)b, t, SM4_BLOCK_BYTES);
+}
+
+/*!
+@brief XTS in either direction, parameterised by the data key schedule.
+@details All whole blocks but the one cipher text stealing needs are
+    done in groups: the tweaks of a group are computed and xored in,
+    the group goes through sm4_ecb_blocks, and the tweaks are xored out.
+*/
+static int sm4_xts (
+    uint8_t   * out,
+    uint8_t   * in,
+    uint32_t  * rk1,
+    uint32_t  * erk2,
+    size_t      len,
+    uint8_t     iv [SM4_BLOCK_BYTES],
+    int         decrypt
+){
+    uint32_t  t  [SM4_BLOCK_BYTES / 4]; //!< Current tweak.
+    uint32_t  tw [SM4_GROUP_BYTES / 4]; //!< Tweaks of this group.
+    uint32_t  b  [SM4_GROUP_BYTES / 4]; //!< Blocks of this group.
+
+    if(len < SM4_BLOCK_BYTES) {
+        return 1;
+    }
+
+    size_t tail  = len % SM4_BLOCK_BYTES;
+    size_t bulk  = len - tail - (tail ? SM4_BLOCK_BYTES : 0);
+
+    memcpy(t, iv, SM4_BLOCK_BYTES);
+    sm4_block_enc_dec((uint8_t*)t, (uint8_t*)t, erk2);
+
+    uint64_t t_lo = sm4_load64_le((uint8_t*)t + 0);
+    uint64_t t_hi = sm4_load64_le((uint8_t*)t + 8);
+
+    while(bulk > 0) {
+
+        size_t nbytes = bulk < SM4_GROUP_BYTES ? bulk : SM4_GROUP_BYTES;
+
+        for(size_t i = 0; i < nbytes; i += SM4_BLOCK_BYTES) {
+            sm4_store64_le((uint8_t*)tw + i + 0, t_lo);
+            sm4_store64_le((uint8_t*)tw + i + 8, t_hi);
+            sm4_xts_mul_x(&t_lo, &t_hi);
+        }
+
+        sm4_xor((uint8_t*)b, in, (uint8_t*)tw, nbytes);
+        sm4_ecb_blocks((uint8_t*)b, (uint8_t*)b, rk1,
+                       nbytes / SM4_BLOCK_BYTES);
+        sm4_xor(out, (uint8_t*)b, (uint8_t*)tw, nbytes);
+
+        out  += nbytes;
+        in   += nbytes;
+        bulk -= nbytes;
+    }
+
+    if(tail) {
+        // Cipher text stealing. The last whole block and the partial
+        // block after it are done with tweaks j and j+1, except that
+        // decryption must undo the j+1 block first.
+        uint8_t * t0 = (uint8_t*)tw;
+        uint8_t * t1 = (uint8_t*)tw + SM4_BLOCK_BYTES;
+        uint8_t * cc = (uint8_t*)b;
+        uint8_t   last [SM4_BLOCK_BYTES];
+
+        sm4_store64_le(t0 + 0, t_lo);
+        sm4_store64_le(t0 + 8, t_hi);
+        sm4_xts_mul_x(&t_lo, &t_hi);
+        sm4_store64_le(t1 + 0, t_lo);
+        sm4_store64_le(t1 + 8, t_hi);
+
+        memcpy(last, in + SM4_BLOCK_BYTES, tail);
+
+        sm4_xts_block(cc, in, rk1, decrypt ? t1 : t0);
+
+        memcpy(last + tail, cc + tail, SM4_BLOCK_BYTES - tail);
+        memcpy(out + SM4_BLOCK_BYTES, cc, tail);
+
+        sm4_xts_block(out, last, rk1, decrypt ? t0 : t1);
+    }
+
+    return 0;
+}
+
+int     sm4_xts_encrypt (
+    uint8_t   * ct,
+    uint8_t   * pt,
+    uint32_t  * erk1,
+    uint32_t  * erk2,
+    size_t      len,
+    uint8_t     iv [SM4_BLOCK_BYTES]
+){
+    return sm4_xts(ct, pt, erk1, erk2, len, iv, 0);
+}
+
+int     sm4_xts_decrypt (
+    uint8_t   * pt,
+    uint8_t   * ct,
+    uint32_t  * drk1,
+    uint32_t  * erk2,
+    size_t      len,
+    uint8_t     iv [SM4_BLOCK_BYTES]
+){
+    return sm4_xts(pt, ct, drk1, erk2, len, iv, 1);
+}
+
+//!@}
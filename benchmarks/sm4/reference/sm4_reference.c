@@ -153,3 +153,95 @@ void    sm4_block_enc_dec (
 
 }
 
+
+//! One round on each of the four blocks a, b, c and d.
+#define SM4_ROUND_X4(W0, W1, W2, W3, K) {                         \
+    a##W0 = a##W0 ^ T(a##W1 ^ a##W2 ^ a##W3 ^ (K));               \
+    b##W0 = b##W0 ^ T(b##W1 ^ b##W2 ^ b##W3 ^ (K));               \
+    c##W0 = c##W0 ^ T(c##W1 ^ c##W2 ^ c##W3 ^ (K));               \
+    d##W0 = d##W0 ^ T(d##W1 ^ d##W2 ^ d##W3 ^ (K));               \
+}
+
+/*!
+@brief Encrypt or decrypt four consecutive blocks. The table lookups of
+    one block do not depend on those of the others, so they can overlap.
+*/
+static void sm4_block_enc_dec_x4 (
+    uint8_t  out [64],
+    uint8_t  in  [64],
+    uint32_t rk  [32]
+){
+
+    uint32_t * inp = (uint32_t*)in      ;
+    uint32_t * op  = (uint32_t*)out     ;
+    uint32_t * rkp = (uint32_t*)rk      ;
+    uint32_t * rke = (uint32_t*)rk + 32 ;
+
+    uint32_t   a0  = __builtin_bswap32(inp[ 0]);
+    uint32_t   a1  = __builtin_bswap32(inp[ 1]);
+    uint32_t   a2  = __builtin_bswap32(inp[ 2]);
+    uint32_t   a3  = __builtin_bswap32(inp[ 3]);
+    uint32_t   b0  = __builtin_bswap32(inp[ 4]);
+    uint32_t   b1  = __builtin_bswap32(inp[ 5]);
+    uint32_t   b2  = __builtin_bswap32(inp[ 6]);
+    uint32_t   b3  = __builtin_bswap32(inp[ 7]);
+    uint32_t   c0  = __builtin_bswap32(inp[ 8]);
+    uint32_t   c1  = __builtin_bswap32(inp[ 9]);
+    uint32_t   c2  = __builtin_bswap32(inp[10]);
+    uint32_t   c3  = __builtin_bswap32(inp[11]);
+    uint32_t   d0  = __builtin_bswap32(inp[12]);
+    uint32_t   d1  = __builtin_bswap32(inp[13]);
+    uint32_t   d2  = __builtin_bswap32(inp[14]);
+    uint32_t   d3  = __builtin_bswap32(inp[15]);
+
+    while(rkp < rke) {
+
+        SM4_ROUND_X4(0, 1, 2, 3, rkp[0])
+        SM4_ROUND_X4(1, 2, 3, 0, rkp[1])
+        SM4_ROUND_X4(2, 3, 0, 1, rkp[2])
+        SM4_ROUND_X4(3, 0, 1, 2, rkp[3])
+
+        rkp += 4;
+    }
+
+    op[ 0] = __builtin_bswap32(a3);
+    op[ 1] = __builtin_bswap32(a2);
+    op[ 2] = __builtin_bswap32(a1);
+    op[ 3] = __builtin_bswap32(a0);
+    op[ 4] = __builtin_bswap32(b3);
+    op[ 5] = __builtin_bswap32(b2);
+    op[ 6] = __builtin_bswap32(b1);
+    op[ 7] = __builtin_bswap32(b0);
+    op[ 8] = __builtin_bswap32(c3);
+    op[ 9] = __builtin_bswap32(c2);
+    op[10] = __builtin_bswap32(c1);
+    op[11] = __builtin_bswap32(c0);
+    op[12] = __builtin_bswap32(d3);
+    op[13] = __builtin_bswap32(d2);
+    op[14] = __builtin_bswap32(d1);
+    op[15] = __builtin_bswap32(d0);
+
+}
+
+
+void    sm4_ecb_blocks (
+    uint8_t   * out,
+    uint8_t   * in,
+    uint32_t    rk [32],
+    size_t      nblocks
+){
+
+    for(; nblocks >= SM4_ECB_BLOCKS_INTERLEAVE;
+          nblocks -= SM4_ECB_BLOCKS_INTERLEAVE) {
+        sm4_block_enc_dec_x4(out, in, rk);
+        out += SM4_ECB_BLOCKS_INTERLEAVE * SM4_BLOCK_BYTES;
+        in  += SM4_ECB_BLOCKS_INTERLEAVE * SM4_BLOCK_BYTES;
+    }
+
+    for(; nblocks > 0; nblocks --) {
+        sm4_block_enc_dec(out, in, rk);
+        out += SM4_BLOCK_BYTES;
+        in  += SM4_BLOCK_BYTES;
+    }
+
+}
@@ -0,0 +1,102 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/aes/api_aes.h"
+
+//! Largest buffer size in the sweep.
+#define BENCH_CTR_MAX_BYTES 4096
+
+//! Number of times each size is run. The fastest run is reported.
+#define BENCH_CTR_REPEATS   4
+
+typedef void (*aes_ks_t   )(uint32_t * const rk, uint8_t * const ck);
+typedef void (*aes_ctr_t  )(uint8_t * out, uint8_t * in, uint32_t * rk,
+                            size_t len, uint8_t ctr[AES_BLOCK_BYTES]);
+
+//! Buffer sizes to sweep, in bytes.
+static const size_t bench_ctr_lengths [] = {
+    16, 64, 256, 1024, BENCH_CTR_MAX_BYTES
+};
+
+#define BENCH_CTR_NUM_LENGTHS \
+    (sizeof(bench_ctr_lengths) / sizeof(bench_ctr_lengths[0]))
+
+static uint8_t bench_pt [BENCH_CTR_MAX_BYTES];
+static uint8_t bench_ct [BENCH_CTR_MAX_BYTES];
+
+/*!
+@brief Time one CTR parameterisation over each buffer size, and print
+    cycles and instructions per byte.
+*/
+void bench_aes_ctr(
+    int         key_bits,
+    size_t      key_bytes,
+    aes_ks_t    enc_ks,
+    aes_ctr_t   ctr_fn
+) {
+
+    uint8_t  key [AES_256_KEY_BYTES];
+    uint32_t erk [AES_256_RK_WORDS ];
+    uint8_t  ctr [AES_BLOCK_BYTES  ];
+
+    test_rdrandom(key, key_bytes);
+    test_rdrandom(ctr, AES_BLOCK_BYTES);
+    test_rdrandom(bench_pt, BENCH_CTR_MAX_BYTES);
+
+    enc_ks(erk, key);
+
+    for(size_t i = 0; i < BENCH_CTR_NUM_LENGTHS; i ++) {
+
+        size_t   len        = bench_ctr_lengths[i];
+        uint64_t min_cycles = (uint64_t)-1;
+        uint64_t min_instrs = (uint64_t)-1;
+
+        for(int r = 0; r < BENCH_CTR_REPEATS; r ++) {
+
+            uint64_t start_cycles = test_rdcycle();
+            uint64_t start_instrs = test_rdinstret();
+
+            ctr_fn(bench_ct, bench_pt, erk, len, ctr);
+
+            uint64_t end_instrs   = test_rdinstret();
+            uint64_t end_cycles   = test_rdcycle();
+
+            uint64_t cycles = end_cycles - start_cycles;
+            uint64_t instrs = end_instrs - start_instrs;
+
+            min_cycles = cycles < min_cycles ? cycles : min_cycles;
+            min_instrs = instrs < min_instrs ? instrs : min_instrs;
+        }
+
+        printf("print(\"%-28s AES %d CTR %5d bytes: "
+               "%%8.2f cycles/byte, %%8.2f instrs/byte\" %% "
+               "(%lu / %d, %lu / %d))\n",
+            STR(TEST_NAME), key_bits, (int)len,
+            (unsigned long)min_cycles, (int)len,
+            (unsigned long)min_instrs, (int)len);
+
+    }
+
+}
+
+
+int main(int argc, char ** argv) {
+
+    printf("import sys\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    bench_aes_ctr(128, AES_128_KEY_BYTES,
+        aes_128_enc_key_schedule, aes_128_ctr_xcrypt);
+
+    bench_aes_ctr(192, AES_192_KEY_BYTES,
+        aes_192_enc_key_schedule, aes_192_ctr_xcrypt);
+
+    bench_aes_ctr(256, AES_256_KEY_BYTES,
+        aes_256_enc_key_schedule, aes_256_ctr_xcrypt);
+
+    return 0;
+
+}
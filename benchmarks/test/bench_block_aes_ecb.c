@@ -0,0 +1,122 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/aes/api_aes.h"
+
+//! Largest number of blocks in the sweep.
+#define BENCH_ECB_MAX_BLOCKS 256
+
+//! Number of times each size is run. The fastest run is reported.
+#define BENCH_ECB_REPEATS    4
+
+typedef void (*aes_ks_t   )(uint32_t * const rk, uint8_t * const ck);
+typedef void (*aes_ecb_n_t)(uint8_t * out, uint8_t * in, uint32_t * rk,
+                            size_t nblocks);
+
+//! Numbers of blocks per call to sweep.
+static const size_t bench_ecb_blocks [] = {
+    1, 4, 16, 64, BENCH_ECB_MAX_BLOCKS
+};
+
+#define BENCH_ECB_NUM_SIZES \
+    (sizeof(bench_ecb_blocks) / sizeof(bench_ecb_blocks[0]))
+
+static uint8_t bench_pt [BENCH_ECB_MAX_BLOCKS * AES_BLOCK_BYTES];
+static uint8_t bench_ct [BENCH_ECB_MAX_BLOCKS * AES_BLOCK_BYTES];
+
+/*!
+@brief Time one multi-block ECB function over each number of blocks, and
+    print cycles and instructions per block.
+*/
+static void bench_aes_ecb_fn(
+    const char  * what,
+    int           key_bits,
+    uint32_t    * rk,
+    aes_ecb_n_t   ecb_fn
+) {
+
+    for(size_t i = 0; i < BENCH_ECB_NUM_SIZES; i ++) {
+
+        size_t   nblocks    = bench_ecb_blocks[i];
+        uint64_t min_cycles = (uint64_t)-1;
+        uint64_t min_instrs = (uint64_t)-1;
+
+        for(int r = 0; r < BENCH_ECB_REPEATS; r ++) {
+
+            uint64_t start_cycles = test_rdcycle();
+            uint64_t start_instrs = test_rdinstret();
+
+            ecb_fn(bench_ct, bench_pt, rk, nblocks);
+
+            uint64_t end_instrs   = test_rdinstret();
+            uint64_t end_cycles   = test_rdcycle();
+
+            uint64_t cycles = end_cycles - start_cycles;
+            uint64_t instrs = end_instrs - start_instrs;
+
+            min_cycles = cycles < min_cycles ? cycles : min_cycles;
+            min_instrs = instrs < min_instrs ? instrs : min_instrs;
+        }
+
+        printf("print(\"%-28s AES %d ECB %-7s %4d blocks: "
+               "%%9.2f cycles/block, %%9.2f instrs/block\" %% "
+               "(%lu / %d, %lu / %d))\n",
+            STR(TEST_NAME), key_bits, what, (int)nblocks,
+            (unsigned long)min_cycles, (int)nblocks,
+            (unsigned long)min_instrs, (int)nblocks);
+
+    }
+
+}
+
+/*!
+@brief Time multi-block encryption and decryption for one key size.
+*/
+void bench_aes_ecb(
+    int           key_bits,
+    size_t        key_bytes,
+    aes_ks_t      enc_ks,
+    aes_ks_t      dec_ks,
+    aes_ecb_n_t   enc_n,
+    aes_ecb_n_t   dec_n
+) {
+
+    uint8_t  key [AES_256_KEY_BYTES];
+    uint32_t erk [AES_256_RK_WORDS ];
+    uint32_t drk [AES_256_RK_WORDS ];
+
+    test_rdrandom(key, key_bytes);
+    test_rdrandom(bench_pt, sizeof(bench_pt));
+
+    enc_ks(erk, key);
+    dec_ks(drk, key);
+
+    bench_aes_ecb_fn("encrypt", key_bits, erk, enc_n);
+    bench_aes_ecb_fn("decrypt", key_bits, drk, dec_n);
+
+}
+
+
+int main(int argc, char ** argv) {
+
+    printf("import sys\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    bench_aes_ecb(128, AES_128_KEY_BYTES,
+        aes_128_enc_key_schedule  , aes_128_dec_key_schedule,
+        aes_128_ecb_encrypt_blocks, aes_128_ecb_decrypt_blocks);
+
+    bench_aes_ecb(192, AES_192_KEY_BYTES,
+        aes_192_enc_key_schedule  , aes_192_dec_key_schedule,
+        aes_192_ecb_encrypt_blocks, aes_192_ecb_decrypt_blocks);
+
+    bench_aes_ecb(256, AES_256_KEY_BYTES,
+        aes_256_enc_key_schedule  , aes_256_dec_key_schedule,
+        aes_256_ecb_encrypt_blocks, aes_256_ecb_decrypt_blocks);
+
+    return 0;
+
+}
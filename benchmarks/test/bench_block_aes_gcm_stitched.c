@@ -0,0 +1,162 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/aes/api_aes.h"
+#include "riscvcrypto/aes/api_aes_gcm.h"
+
+//! Largest buffer size in the sweep.
+#define BENCH_GCM_MAX_BYTES 4096
+
+//! Bytes of AAD hashed with each message, as for a TLS 1.3 record.
+#define BENCH_GCM_AAD_BYTES 13
+
+//! Number of times each size is run. The fastest run is reported.
+#define BENCH_GCM_REPEATS   4
+
+typedef void (*aes_gcm_init_t)(aes_gcm_ctx_t * ctx, uint8_t * ck,
+                               uint8_t * iv, size_t iv_len);
+
+//! Buffer sizes to sweep, in bytes.
+static const size_t bench_gcm_lengths [] = {
+    16, 64, 256, 1024, BENCH_GCM_MAX_BYTES
+};
+
+#define BENCH_GCM_NUM_LENGTHS \
+    (sizeof(bench_gcm_lengths) / sizeof(bench_gcm_lengths[0]))
+
+static uint8_t bench_pt [BENCH_GCM_MAX_BYTES];
+static uint8_t bench_ct [BENCH_GCM_MAX_BYTES];
+static uint8_t bench_tag[AES_GCM_TAG_BYTES  ];
+
+//! Print one result line as a python print statement.
+static void bench_gcm_report(
+    const char * what,
+    int          key_bits,
+    size_t       len,
+    uint64_t     cycles,
+    uint64_t     instrs
+) {
+    printf("print(\"%-28s AES %d GCM %-16s %5d bytes: "
+           "%%8.2f cycles/byte, %%8.2f instrs/byte\" %% "
+           "(%lu / %d, %lu / %d))\n",
+        STR(TEST_NAME), key_bits, what, (int)len,
+        (unsigned long)cycles, (int)len,
+        (unsigned long)instrs, (int)len);
+}
+
+//! An update function: aes_gcm_encrypt_update and friends.
+typedef void (*aes_gcm_update_t)(aes_gcm_ctx_t * ctx, uint8_t * out,
+                                 uint8_t * in, size_t len);
+
+/*!
+@brief Time a whole AEAD operation (aad, update, final) with one update
+    function, keeping the fastest of BENCH_GCM_REPEATS runs.
+*/
+static void bench_gcm_time(
+    aes_gcm_ctx_t     * ctx0,
+    aes_gcm_update_t    update,
+    int                 decrypt,
+    uint8_t           * aad,
+    size_t              len,
+    uint64_t          * best_cycles,
+    uint64_t          * best_instrs
+) {
+    aes_gcm_ctx_t ctx;
+    uint8_t       tag [AES_GCM_TAG_BYTES];
+
+    *best_cycles = (uint64_t)-1;
+    *best_instrs = (uint64_t)-1;
+
+    for(int r = 0; r < BENCH_GCM_REPEATS; r ++) {
+
+        memcpy(&ctx, ctx0, sizeof(ctx));
+
+        uint64_t start_cycles = test_rdcycle();
+        uint64_t start_instrs = test_rdinstret();
+
+        aes_gcm_aad(&ctx, aad, BENCH_GCM_AAD_BYTES);
+
+        if(decrypt) {
+            update(&ctx, bench_pt, bench_ct, len);
+            aes_gcm_final_verify(&ctx, bench_tag, AES_GCM_TAG_BYTES);
+        } else {
+            update(&ctx, bench_ct, bench_pt, len);
+            aes_gcm_final(&ctx, tag);
+        }
+
+        uint64_t end_instrs   = test_rdinstret();
+        uint64_t end_cycles   = test_rdcycle();
+
+        uint64_t cycles = end_cycles - start_cycles;
+        uint64_t instrs = end_instrs - start_instrs;
+        *best_cycles = cycles < *best_cycles ? cycles : *best_cycles;
+        *best_instrs = instrs < *best_instrs ? instrs : *best_instrs;
+    }
+}
+
+/*!
+@brief Compare the stitched encrypt and decrypt-and-verify paths with the
+    unstitched composition of counter mode and GHASH, over each buffer
+    size. Key setup is excluded.
+*/
+void bench_aes_gcm_stitched(
+    int             key_bits,
+    size_t          key_bytes,
+    aes_gcm_init_t  init
+) {
+
+    aes_gcm_ctx_t ctx0;
+
+    uint8_t  key [AES_256_KEY_BYTES  ];
+    uint8_t  iv  [12                 ];
+    uint8_t  aad [BENCH_GCM_AAD_BYTES];
+
+    test_rdrandom(key, key_bytes);
+    test_rdrandom(iv , sizeof(iv));
+    test_rdrandom(aad, sizeof(aad));
+    test_rdrandom(bench_pt , BENCH_GCM_MAX_BYTES);
+    test_rdrandom(bench_tag, AES_GCM_TAG_BYTES);
+
+    init(&ctx0, key, iv, sizeof(iv));
+
+    for(size_t i = 0; i < BENCH_GCM_NUM_LENGTHS; i ++) {
+
+        size_t   len = bench_gcm_lengths[i];
+        uint64_t cycles, instrs;
+
+        bench_gcm_time(&ctx0, aes_gcm_encrypt_update, 0, aad, len,
+                       &cycles, &instrs);
+        bench_gcm_report("encrypt"         , key_bits, len, cycles, instrs);
+
+        bench_gcm_time(&ctx0, aes_gcm_encrypt_update_stitched, 0, aad, len,
+                       &cycles, &instrs);
+        bench_gcm_report("encrypt stitched", key_bits, len, cycles, instrs);
+
+        bench_gcm_time(&ctx0, aes_gcm_decrypt_update, 1, aad, len,
+                       &cycles, &instrs);
+        bench_gcm_report("decrypt"         , key_bits, len, cycles, instrs);
+
+        bench_gcm_time(&ctx0, aes_gcm_decrypt_update_stitched, 1, aad, len,
+                       &cycles, &instrs);
+        bench_gcm_report("decrypt stitched", key_bits, len, cycles, instrs);
+
+    }
+
+}
+
+
+int main(int argc, char ** argv) {
+
+    printf("import sys\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    bench_aes_gcm_stitched(128, AES_128_KEY_BYTES, aes_128_gcm_init);
+    bench_aes_gcm_stitched(192, AES_192_KEY_BYTES, aes_192_gcm_init);
+    bench_aes_gcm_stitched(256, AES_256_KEY_BYTES, aes_256_gcm_init);
+
+    return 0;
+
+}
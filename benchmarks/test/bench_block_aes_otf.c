@@ -0,0 +1,134 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/aes/api_aes.h"
+
+//! Number of times each measurement is run. The fastest run is reported.
+#define BENCH_OTF_REPEATS 4
+
+typedef void (*aes_ks_t     )(uint32_t * const rk, uint8_t * const ck);
+typedef void (*aes_ecb_t    )(uint8_t * out, uint8_t * in, uint32_t * rk);
+typedef void (*aes_otf_t    )(uint8_t * out, uint8_t * in, uint8_t  * ck);
+typedef void (*aes_otf_dk_t )(uint8_t * dk , uint8_t * ck);
+
+//! One measurement: fastest of BENCH_OTF_REPEATS runs.
+typedef struct {
+    uint64_t cycles;
+    uint64_t instrs;
+} bench_otf_result_t;
+
+static uint8_t  bench_key [AES_256_KEY_BYTES];
+static uint8_t  bench_dk  [AES_256_KEY_BYTES];
+static uint32_t bench_rk  [AES_256_RK_WORDS ];
+static uint8_t  bench_pt  [AES_BLOCK_BYTES  ];
+static uint8_t  bench_ct  [AES_BLOCK_BYTES  ];
+
+static void bench_otf_print(
+    const char         * what,
+    int                  key_bits,
+    bench_otf_result_t   r
+) {
+    printf("print(\"%-28s AES %d %-26s: %6lu cycles, %6lu instrs\")\n",
+        STR(TEST_NAME), key_bits, what,
+        (unsigned long)r.cycles, (unsigned long)r.instrs);
+}
+
+#define BENCH_OTF_TIME(RESULT, CODE) {                                   \
+    RESULT.cycles = (uint64_t)-1;                                        \
+    RESULT.instrs = (uint64_t)-1;                                        \
+    for(int rep = 0; rep < BENCH_OTF_REPEATS; rep ++) {                  \
+        uint64_t start_cycles = test_rdcycle();                          \
+        uint64_t start_instrs = test_rdinstret();                        \
+        CODE;                                                            \
+        uint64_t end_instrs   = test_rdinstret();                        \
+        uint64_t end_cycles   = test_rdcycle();                          \
+        uint64_t cycles       = end_cycles - start_cycles;               \
+        uint64_t instrs       = end_instrs - start_instrs;               \
+        RESULT.cycles = cycles < RESULT.cycles ? cycles : RESULT.cycles; \
+        RESULT.instrs = instrs < RESULT.instrs ? instrs : RESULT.instrs; \
+    }                                                                    \
+}
+
+/*!
+@brief Compare the stored schedule and on-the-fly paths for one key size.
+@details "key + block" is the cost of one block under a fresh key, which
+    is where on-the-fly expansion pays off. "block" is the cost of one
+    more block once the key is set up.
+*/
+void bench_aes_otf(
+    int           key_bits,
+    size_t        key_bytes,
+    size_t        rk_bytes,
+    aes_ks_t      enc_ks,
+    aes_ks_t      dec_ks,
+    aes_ecb_t     enc,
+    aes_ecb_t     dec,
+    aes_otf_t     enc_otf,
+    aes_otf_dk_t  dec_key,
+    aes_otf_t     dec_otf
+) {
+    bench_otf_result_t r;
+
+    test_rdrandom(bench_key, key_bytes);
+    test_rdrandom(bench_pt , AES_BLOCK_BYTES);
+
+    printf("print(\"%-28s AES %d key state: stored %3d bytes, "
+           "on-the-fly %2d bytes\")\n", STR(TEST_NAME), key_bits,
+           (int)rk_bytes, (int)key_bytes);
+
+    BENCH_OTF_TIME(r, enc_ks(bench_rk, bench_key);
+                      enc(bench_ct, bench_pt, bench_rk));
+    bench_otf_print("encrypt key + block stored", key_bits, r);
+
+    BENCH_OTF_TIME(r, enc_otf(bench_ct, bench_pt, bench_key));
+    bench_otf_print("encrypt key + block otf"   , key_bits, r);
+
+    BENCH_OTF_TIME(r, enc(bench_ct, bench_pt, bench_rk));
+    bench_otf_print("encrypt block stored"      , key_bits, r);
+
+    BENCH_OTF_TIME(r, dec_ks(bench_rk, bench_key);
+                      dec(bench_pt, bench_ct, bench_rk));
+    bench_otf_print("decrypt key + block stored", key_bits, r);
+
+    BENCH_OTF_TIME(r, dec_key(bench_dk, bench_key);
+                      dec_otf(bench_pt, bench_ct, bench_dk));
+    bench_otf_print("decrypt key + block otf"   , key_bits, r);
+
+    BENCH_OTF_TIME(r, dec(bench_pt, bench_ct, bench_rk));
+    bench_otf_print("decrypt block stored"      , key_bits, r);
+
+    BENCH_OTF_TIME(r, dec_otf(bench_pt, bench_ct, bench_dk));
+    bench_otf_print("decrypt block otf"         , key_bits, r);
+
+}
+
+
+int main(int argc, char ** argv) {
+
+    printf("import sys\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    bench_aes_otf(128, AES_128_KEY_BYTES, AES_128_RK_BYTES,
+        aes_128_enc_key_schedule, aes_128_dec_key_schedule,
+        aes_128_ecb_encrypt     , aes_128_ecb_decrypt,
+        aes_128_ecb_encrypt_otf , aes_128_otf_dec_key,
+        aes_128_ecb_decrypt_otf );
+
+    bench_aes_otf(192, AES_192_KEY_BYTES, AES_192_RK_BYTES,
+        aes_192_enc_key_schedule, aes_192_dec_key_schedule,
+        aes_192_ecb_encrypt     , aes_192_ecb_decrypt,
+        aes_192_ecb_encrypt_otf , aes_192_otf_dec_key,
+        aes_192_ecb_decrypt_otf );
+
+    bench_aes_otf(256, AES_256_KEY_BYTES, AES_256_RK_BYTES,
+        aes_256_enc_key_schedule, aes_256_dec_key_schedule,
+        aes_256_ecb_encrypt     , aes_256_ecb_decrypt,
+        aes_256_ecb_encrypt_otf , aes_256_otf_dec_key,
+        aes_256_ecb_decrypt_otf );
+
+    return 0;
+
+}
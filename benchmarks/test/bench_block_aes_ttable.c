@@ -0,0 +1,143 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/aes/api_aes.h"
+#include "riscvcrypto/aes/ttable/common.h"
+
+//! Number of blocks for the multi-block measurement.
+#define BENCH_TTABLE_BLOCKS      64
+
+//! Number of times each measurement is run. The fastest run is reported.
+#define BENCH_TTABLE_REPEATS     4
+
+/*!
+@brief Size of the buffer walked before each "evicted" measurement.
+@details This stands in for an application working set which is larger
+    than a small L1 data cache, so the tables start out mostly cold.
+*/
+#define BENCH_TTABLE_EVICT_BYTES (32 * 1024)
+
+//! Stride of the eviction walk. One access per (small) cache line.
+#define BENCH_TTABLE_EVICT_STEP  32
+
+typedef void (*aes_ks_t   )(uint32_t * const rk, uint8_t * const ck);
+typedef void (*aes_ecb_n_t)(uint8_t * out, uint8_t * in, uint32_t * rk,
+                            size_t nblocks);
+
+static uint8_t bench_pt   [BENCH_TTABLE_BLOCKS * AES_BLOCK_BYTES];
+static uint8_t bench_ct   [BENCH_TTABLE_BLOCKS * AES_BLOCK_BYTES];
+static uint8_t bench_evict[BENCH_TTABLE_EVICT_BYTES];
+
+//! Touch every line of bench_evict, pushing the tables out of the L1.
+static uint32_t bench_evict_l1() {
+    volatile uint8_t * p   = bench_evict;
+    uint32_t           acc = 0;
+    for(size_t i = 0; i < sizeof(bench_evict); i += BENCH_TTABLE_EVICT_STEP){
+        acc += p[i];
+        p[i] = acc;
+    }
+    return acc;
+}
+
+/*!
+@brief Time nblocks of one ECB function, optionally evicting the tables
+    first, and print cycles per block.
+*/
+static void bench_aes_ttable_fn(
+    const char  * what,
+    int           key_bits,
+    uint32_t    * rk,
+    aes_ecb_n_t   ecb_fn,
+    size_t        nblocks,
+    int           evict
+) {
+    uint64_t min_cycles = (uint64_t)-1;
+
+    for(int r = 0; r < BENCH_TTABLE_REPEATS; r ++) {
+
+        if(evict) {
+            bench_evict_l1();
+        }
+
+        uint64_t start_cycles = test_rdcycle();
+
+        ecb_fn(bench_ct, bench_pt, rk, nblocks);
+
+        uint64_t end_cycles   = test_rdcycle();
+        uint64_t cycles       = end_cycles - start_cycles;
+
+        min_cycles = cycles < min_cycles ? cycles : min_cycles;
+    }
+
+    printf("print(\"%-28s %-8s AES %d ECB %-7s %3d blocks %-7s: "
+           "%%9.2f cycles/block\" %% (%lu / %d))\n",
+        STR(TEST_NAME), aes_ttable_layout, key_bits, what, (int)nblocks,
+        evict ? "evicted" : "warm",
+        (unsigned long)min_cycles, (int)nblocks);
+}
+
+/*!
+@brief Time encryption and decryption for one key size, warm and with
+    the tables evicted.
+*/
+void bench_aes_ttable(
+    int           key_bits,
+    size_t        key_bytes,
+    aes_ks_t      enc_ks,
+    aes_ks_t      dec_ks,
+    aes_ecb_n_t   enc_n,
+    aes_ecb_n_t   dec_n
+) {
+
+    uint8_t  key [AES_256_KEY_BYTES];
+    uint32_t erk [AES_256_RK_WORDS ];
+    uint32_t drk [AES_256_RK_WORDS ];
+
+    test_rdrandom(key, key_bytes);
+    test_rdrandom(bench_pt, sizeof(bench_pt));
+
+    enc_ks(erk, key);
+    dec_ks(drk, key);
+
+    bench_aes_ttable_fn("encrypt", key_bits, erk, enc_n, 1, 0);
+    bench_aes_ttable_fn("encrypt", key_bits, erk, enc_n, 1, 1);
+    bench_aes_ttable_fn("encrypt", key_bits, erk, enc_n,
+                        BENCH_TTABLE_BLOCKS, 0);
+    bench_aes_ttable_fn("decrypt", key_bits, drk, dec_n, 1, 0);
+    bench_aes_ttable_fn("decrypt", key_bits, drk, dec_n, 1, 1);
+    bench_aes_ttable_fn("decrypt", key_bits, drk, dec_n,
+                        BENCH_TTABLE_BLOCKS, 0);
+
+}
+
+
+int main(int argc, char ** argv) {
+
+    printf("import sys\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    printf("print(\"%-28s %-8s encrypt tables: %5lu bytes\")\n",
+        STR(TEST_NAME), aes_ttable_layout,
+        (unsigned long)aes_ttable_enc_table_bytes);
+    printf("print(\"%-28s %-8s decrypt tables: %5lu bytes\")\n",
+        STR(TEST_NAME), aes_ttable_layout,
+        (unsigned long)aes_ttable_dec_table_bytes);
+
+    bench_aes_ttable(128, AES_128_KEY_BYTES,
+        aes_128_enc_key_schedule  , aes_128_dec_key_schedule,
+        aes_128_ecb_encrypt_blocks, aes_128_ecb_decrypt_blocks);
+
+    bench_aes_ttable(192, AES_192_KEY_BYTES,
+        aes_192_enc_key_schedule  , aes_192_dec_key_schedule,
+        aes_192_ecb_encrypt_blocks, aes_192_ecb_decrypt_blocks);
+
+    bench_aes_ttable(256, AES_256_KEY_BYTES,
+        aes_256_enc_key_schedule  , aes_256_dec_key_schedule,
+        aes_256_ecb_encrypt_blocks, aes_256_ecb_decrypt_blocks);
+
+    return 0;
+
+}
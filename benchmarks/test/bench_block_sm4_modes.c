@@ -0,0 +1,132 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/sm4/api_sm4.h"
+
+//! Largest buffer size in the sweep.
+#define BENCH_SM4_MAX_BYTES 4096
+
+//! Number of times each size is run. The fastest run is reported.
+#define BENCH_SM4_REPEATS   4
+
+//! Buffer sizes to sweep, in bytes.
+static const size_t bench_sm4_lengths [] = {
+    16, 64, 256, 1024, BENCH_SM4_MAX_BYTES
+};
+
+#define BENCH_SM4_NUM_LENGTHS \
+    (sizeof(bench_sm4_lengths) / sizeof(bench_sm4_lengths[0]))
+
+//! Modes measured.
+typedef enum {
+    BENCH_SM4_ECB_SINGLE,   //!< sm4_block_enc_dec on one block at a time.
+    BENCH_SM4_ECB_BLOCKS,   //!< sm4_ecb_blocks.
+    BENCH_SM4_CBC_ENC,
+    BENCH_SM4_CBC_DEC,
+    BENCH_SM4_CTR,
+    BENCH_SM4_XTS_ENC,
+    BENCH_SM4_XTS_DEC,
+    BENCH_SM4_NUM_MODES
+} bench_sm4_mode_t;
+
+static const char * bench_sm4_mode_names [] = {
+    "ECB 1-block", "ECB n-block", "CBC enc", "CBC dec", "CTR",
+    "XTS enc", "XTS dec"
+};
+
+static uint32_t bench_pt [BENCH_SM4_MAX_BYTES / 4];
+static uint32_t bench_ct [BENCH_SM4_MAX_BYTES / 4];
+
+static uint32_t erk  [SM4_RK_WORDS];
+static uint32_t drk  [SM4_RK_WORDS];
+static uint32_t erk2 [SM4_RK_WORDS];
+
+//! Run one mode over len bytes of bench_pt.
+static void bench_sm4_run(bench_sm4_mode_t mode, size_t len) {
+
+    uint8_t * pt = (uint8_t*)bench_pt;
+    uint8_t * ct = (uint8_t*)bench_ct;
+    uint8_t   iv [SM4_BLOCK_BYTES] = {0};
+
+    switch(mode) {
+        case BENCH_SM4_ECB_SINGLE:
+            for(size_t i = 0; i < len; i += SM4_BLOCK_BYTES) {
+                sm4_block_enc_dec(ct + i, pt + i, erk);
+            }
+            break;
+        case BENCH_SM4_ECB_BLOCKS:
+            sm4_ecb_blocks(ct, pt, erk, len / SM4_BLOCK_BYTES);
+            break;
+        case BENCH_SM4_CBC_ENC:
+            sm4_cbc_encrypt(ct, pt, erk, len, iv);
+            break;
+        case BENCH_SM4_CBC_DEC:
+            sm4_cbc_decrypt(ct, pt, drk, len, iv);
+            break;
+        case BENCH_SM4_CTR:
+            sm4_ctr_xcrypt(ct, pt, erk, len, iv);
+            break;
+        case BENCH_SM4_XTS_ENC:
+            sm4_xts_encrypt(ct, pt, erk, erk2, len, iv);
+            break;
+        default:
+            sm4_xts_decrypt(ct, pt, drk, erk2, len, iv);
+            break;
+    }
+}
+
+int main(int argc, char ** argv) {
+
+    printf("import sys\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    uint8_t key  [SM4_KEY_BYTES];
+    uint8_t key2 [SM4_KEY_BYTES];
+
+    test_rdrandom(key , SM4_KEY_BYTES);
+    test_rdrandom(key2, SM4_KEY_BYTES);
+    test_rdrandom((uint8_t*)bench_pt, BENCH_SM4_MAX_BYTES);
+
+    sm4_key_schedule_enc(erk , key );
+    sm4_key_schedule_dec(drk , key );
+    sm4_key_schedule_enc(erk2, key2);
+
+    for(int mode = 0; mode < BENCH_SM4_NUM_MODES; mode ++) {
+        for(size_t i = 0; i < BENCH_SM4_NUM_LENGTHS; i ++) {
+
+            size_t   len        = bench_sm4_lengths[i];
+            uint64_t min_cycles = (uint64_t)-1;
+            uint64_t min_instrs = (uint64_t)-1;
+
+            for(int r = 0; r < BENCH_SM4_REPEATS; r ++) {
+
+                uint64_t start_cycles = test_rdcycle();
+                uint64_t start_instrs = test_rdinstret();
+
+                bench_sm4_run(mode, len);
+
+                uint64_t end_instrs   = test_rdinstret();
+                uint64_t end_cycles   = test_rdcycle();
+
+                uint64_t cycles = end_cycles - start_cycles;
+                uint64_t instrs = end_instrs - start_instrs;
+
+                min_cycles = cycles < min_cycles ? cycles : min_cycles;
+                min_instrs = instrs < min_instrs ? instrs : min_instrs;
+            }
+
+            printf("print(\"%-24s SM4 %-11s %5d bytes: "
+                   "%%8.2f cycles/byte, %%8.2f instrs/byte\" %% "
+                   "(%lu / %d, %lu / %d))\n",
+                STR(TEST_NAME), bench_sm4_mode_names[mode], (int)len,
+                (unsigned long)min_cycles, (int)len,
+                (unsigned long)min_instrs, (int)len);
+        }
+    }
+
+    return 0;
+
+}
@@ -0,0 +1,111 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/sha3/fips202.h"
+#include "riscvcrypto/sha3/k12.h"
+
+//! Number of times each measurement is run. The fastest run is reported.
+#define BENCH_K12_REPEATS   3
+
+//! Bytes of output for each function.
+#define BENCH_K12_OUT_BYTES 32
+
+//! Largest message measured.
+#define BENCH_K12_MAX_BYTES (16 * K12_CHUNK_BYTES)
+
+//! Message lengths measured.
+static size_t bench_lengths [] = {
+    1024, K12_CHUNK_BYTES, 4 * K12_CHUNK_BYTES, BENCH_K12_MAX_BYTES
+};
+
+static uint8_t bench_msg [BENCH_K12_MAX_BYTES];
+static uint8_t bench_out [BENCH_K12_OUT_BYTES];
+
+//! Functions measured.
+typedef enum {
+    BENCH_SHA3_256,
+    BENCH_TURBOSHAKE128,
+    BENCH_K12,
+    BENCH_K12_SERIAL,
+    BENCH_NUM_FNS
+} bench_fn_t;
+
+static const char * bench_fn_names [] = {
+    "SHA3-256", "TurboSHAKE128", "K12", "K12 serial"
+};
+
+/*!
+@brief Hash len bytes of bench_msg with one function.
+@details "K12 serial" absorbs in pieces of one byte under a leaf, so no
+    whole leaf is ever seen in one call and every leaf takes the
+    single-state path. The difference from "K12" is what the
+    multi-state leaf hashing gives.
+*/
+static void bench_k12_run(bench_fn_t fn, size_t len) {
+
+    k12_ctx_t ctx;
+
+    switch(fn) {
+        case BENCH_SHA3_256:
+            FIPS202_SHA3_256(bench_msg, len, bench_out);
+            break;
+        case BENCH_TURBOSHAKE128:
+            TurboSHAKE128(bench_msg, len, TURBOSHAKE_DEFAULT_D,
+                          bench_out, BENCH_K12_OUT_BYTES);
+            break;
+        case BENCH_K12:
+            KangarooTwelve(bench_msg, len, NULL, 0,
+                           bench_out, BENCH_K12_OUT_BYTES);
+            break;
+        default:
+            k12_init(&ctx);
+            for(size_t done = 0; done < len; ) {
+                size_t take = len - done;
+                take = take < K12_CHUNK_BYTES - 1 ? take : K12_CHUNK_BYTES - 1;
+                k12_absorb(&ctx, bench_msg + done, take);
+                done += take;
+            }
+            k12_finalize(&ctx, NULL, 0);
+            k12_squeeze (&ctx, bench_out, BENCH_K12_OUT_BYTES);
+            break;
+    }
+}
+
+int main(int argc, char ** argv) {
+
+    printf("import sys\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    test_rdrandom(bench_msg, sizeof(bench_msg));
+
+    for(size_t l = 0; l < sizeof(bench_lengths)/sizeof(size_t); l ++) {
+        for(int fn = 0; fn < BENCH_NUM_FNS; fn ++) {
+
+            size_t   len        = bench_lengths[l];
+            uint64_t min_cycles = (uint64_t)-1;
+
+            for(int r = 0; r < BENCH_K12_REPEATS; r ++) {
+
+                uint64_t start_cycles = test_rdcycle();
+
+                bench_k12_run(fn, len);
+
+                uint64_t end_cycles   = test_rdcycle();
+                uint64_t cycles       = end_cycles - start_cycles;
+
+                min_cycles = cycles < min_cycles ? cycles : min_cycles;
+            }
+
+            printf("print(\"%-24s %-14s %6d bytes: "
+                   "%%8.2f cycles/byte\" %% (%lu / %d))\n",
+                STR(TEST_NAME), bench_fn_names[fn], (int)len,
+                (unsigned long)min_cycles, (int)len);
+        }
+    }
+
+    return 0;
+
+}
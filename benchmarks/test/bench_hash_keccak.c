@@ -0,0 +1,86 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/sha3/fips202.h"
+
+//! Number of times each measurement is run. The fewest instructions win.
+#define BENCH_KECCAK_REPEATS 4
+
+//! Message length for the whole-hash measurement.
+#define BENCH_KECCAK_MSG     1024
+
+static uint64_t bench_state [25];
+static uint8_t  bench_block [KECCAK_RATE_SHAKE128];
+static uint8_t  bench_msg   [BENCH_KECCAK_MSG];
+static uint8_t  bench_out   [CRYPTO_HASH_SHA3_256_BYTES];
+
+typedef enum {
+    BENCH_PERMUTE,      //!< One KeccakF1600_StatePermute.
+    BENCH_XOR_BLOCK,    //!< XOR a SHAKE128 block into the state.
+    BENCH_EXTRACT_BLOCK,//!< Extract a SHAKE128 block from the state.
+    BENCH_SHA3_256      //!< SHA3-256 of BENCH_KECCAK_MSG bytes.
+} bench_what_t;
+
+static const char * bench_names [] = {
+    "permutation", "xor 168 bytes", "extract 168 bytes", "SHA3-256 1024 B"
+};
+
+static void bench_keccak_run(bench_what_t what) {
+    switch(what) {
+        case BENCH_PERMUTE:
+            KeccakF1600_StatePermute(bench_state);
+            break;
+        case BENCH_XOR_BLOCK:
+            KeccakF1600_StateXORBytes(bench_state, 0, bench_block,
+                                      sizeof(bench_block));
+            break;
+        case BENCH_EXTRACT_BLOCK:
+            KeccakF1600_StateExtractBytes(bench_state, 0, bench_block,
+                                          sizeof(bench_block));
+            break;
+        case BENCH_SHA3_256:
+            FIPS202_SHA3_256(bench_msg, sizeof(bench_msg), bench_out);
+            break;
+    }
+}
+
+/*!
+@brief Count the instructions retired by the permutation, the lane
+    conversions at either end of it, and a whole hash. Run against the
+    reference and zscrypto targets of the same XLEN to compare them.
+*/
+int main(int argc, char ** argv) {
+
+    printf("import sys\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    test_rdrandom((uint8_t*)bench_state, sizeof(bench_state));
+    test_rdrandom(bench_block, sizeof(bench_block));
+    test_rdrandom(bench_msg  , sizeof(bench_msg  ));
+
+    for(int what = BENCH_PERMUTE; what <= BENCH_SHA3_256; what ++) {
+
+        uint64_t min_instrs = (uint64_t)-1;
+
+        for(int r = 0; r < BENCH_KECCAK_REPEATS; r ++) {
+
+            uint64_t start_instrs = test_rdinstret();
+
+            bench_keccak_run(what);
+
+            uint64_t end_instrs   = test_rdinstret();
+            uint64_t instrs       = end_instrs - start_instrs;
+
+            min_instrs = instrs < min_instrs ? instrs : min_instrs;
+        }
+
+        printf("print(\"%-24s %-18s: %%8d instrs\" %% %lu)\n",
+            STR(TEST_NAME), bench_names[what], (unsigned long)min_instrs);
+    }
+
+    return 0;
+
+}
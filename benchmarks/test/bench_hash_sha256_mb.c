@@ -0,0 +1,116 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+
+#include "riscvcrypto/sha256/api_sha256.h"
+
+//! Number of independent messages hashed by each measurement.
+#define BENCH_MB_MESSAGES 64
+
+//! Number of times each measurement is run. The fastest run is reported.
+#define BENCH_MB_REPEATS  3
+
+//! Message lengths measured.
+static size_t bench_lengths [] = {32, 64, 256, 1024, 4096};
+
+//! Which way of hashing BENCH_MB_MESSAGES messages to run.
+typedef enum {
+    BENCH_SINGLE,       //!< sha256_hash on each message in turn.
+    BENCH_X2,           //!< sha256_hash_x2 on pairs.
+    BENCH_X4,           //!< sha256_hash_x4 on groups of four.
+    BENCH_JOBS          //!< sha256_hash_jobs on all of them.
+} bench_mode_t;
+
+static const char * bench_mode_names [] = {
+    "single", "x2", "x4", "jobs"
+};
+
+static sha256_job_t bench_jobs [BENCH_MB_MESSAGES];
+
+//! Hash every job's message in the given mode.
+static void bench_mb_run(bench_mode_t mode) {
+
+    uint8_t * dp [SHA256_MB_LANES];
+    uint8_t * mp [SHA256_MB_LANES];
+    size_t    len = bench_jobs[0].len;
+    int       n   = mode == BENCH_X2 ? 2 : SHA256_MB_LANES;
+
+    switch(mode) {
+        case BENCH_SINGLE:
+            for(int i = 0; i < BENCH_MB_MESSAGES; i ++) {
+                sha256_hash((uint32_t*)bench_jobs[i].digest,
+                            bench_jobs[i].M, len);
+            }
+            break;
+
+        case BENCH_X2:
+        case BENCH_X4:
+            for(int i = 0; i < BENCH_MB_MESSAGES; i += n) {
+                for(int l = 0; l < n; l ++) {
+                    dp[l] = bench_jobs[i + l].digest;
+                    mp[l] = bench_jobs[i + l].M;
+                }
+                if(mode == BENCH_X2) {
+                    sha256_hash_x2(dp, mp, len);
+                } else {
+                    sha256_hash_x4(dp, mp, len);
+                }
+            }
+            break;
+
+        case BENCH_JOBS:
+            sha256_hash_jobs(bench_jobs, BENCH_MB_MESSAGES);
+            break;
+    }
+}
+
+int main(int argc, char ** argv) {
+
+    printf("import sys\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    size_t    max_len = bench_lengths[
+        sizeof(bench_lengths) / sizeof(bench_lengths[0]) - 1];
+    uint8_t * data    = malloc(BENCH_MB_MESSAGES * max_len);
+
+    test_rdrandom(data, BENCH_MB_MESSAGES * max_len);
+
+    for(size_t l = 0; l < sizeof(bench_lengths)/sizeof(size_t); l ++) {
+
+        size_t len = bench_lengths[l];
+
+        for(int i = 0; i < BENCH_MB_MESSAGES; i ++) {
+            bench_jobs[i].M   = data + i * len;
+            bench_jobs[i].len = len;
+        }
+
+        for(int mode = BENCH_SINGLE; mode <= BENCH_JOBS; mode ++) {
+
+            uint64_t min_cycles = (uint64_t)-1;
+
+            for(int r = 0; r < BENCH_MB_REPEATS; r ++) {
+
+                uint64_t start_cycles = test_rdcycle();
+
+                bench_mb_run(mode);
+
+                uint64_t end_cycles   = test_rdcycle();
+                uint64_t cycles       = end_cycles - start_cycles;
+
+                min_cycles = cycles < min_cycles ? cycles : min_cycles;
+            }
+
+            printf("print(\"%-24s %d x %5d bytes %-6s: "
+                   "%%7.2f cycles/byte\" %% (%lu / %lu))\n",
+                STR(TEST_NAME), BENCH_MB_MESSAGES, (int)len,
+                bench_mode_names[mode], (unsigned long)min_cycles,
+                (unsigned long)(BENCH_MB_MESSAGES * len));
+        }
+    }
+
+    free(data);
+
+    return 0;
+
+}
@@ -0,0 +1,101 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+
+#include "riscvcrypto/sha256/api_sha256.h"
+
+//! Number of times each measurement is run. The fastest run is reported.
+#define BENCH_SHA256_REPEATS 3
+
+//! Size of the chunks a streaming caller hands to sha256_update.
+#define BENCH_SHA256_CHUNK   1500
+
+//! Message lengths measured: small, medium and multi-MB.
+static size_t bench_lengths [] = {
+    16, 64, 256, 1024, 4096, 16384, 2 * 1024 * 1024
+};
+
+typedef enum {
+    BENCH_ONESHOT,      //!< One sha256_hash call.
+    BENCH_CHUNKED,      //!< sha256_update in BENCH_SHA256_CHUNK pieces.
+    BENCH_MISALIGNED    //!< One sha256_update from a misaligned pointer.
+} bench_mode_t;
+
+static const char * bench_mode_names [] = {
+    "one-shot", "chunked", "misaligned"
+};
+
+//! Hash len bytes of M in the given mode.
+static void bench_sha256_run (
+    uint8_t      * digest,
+    uint8_t      * M     ,
+    size_t         len   ,
+    bench_mode_t   mode
+){
+    sha256_ctx_t ctx;
+
+    if(mode == BENCH_ONESHOT) {
+        sha256_hash((uint32_t*)digest, M, len);
+        return;
+    }
+
+    sha256_init(&ctx);
+
+    if(mode == BENCH_CHUNKED) {
+        while(len > BENCH_SHA256_CHUNK) {
+            sha256_update(&ctx, M, BENCH_SHA256_CHUNK);
+            M   += BENCH_SHA256_CHUNK;
+            len -= BENCH_SHA256_CHUNK;
+        }
+    }
+
+    sha256_update(&ctx, M, len);
+    sha256_final (&ctx, digest);
+}
+
+int main(int argc, char ** argv) {
+
+    printf("import sys\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    size_t    max_len = bench_lengths[
+        sizeof(bench_lengths) / sizeof(bench_lengths[0]) - 1];
+
+    // One spare byte, so the misaligned runs stay in bounds.
+    uint8_t * buf     = malloc(max_len + 1);
+    uint32_t  digest [8];
+
+    test_rdrandom(buf, max_len + 1);
+
+    for(size_t l = 0; l < sizeof(bench_lengths)/sizeof(size_t); l ++) {
+        for(int mode = BENCH_ONESHOT; mode <= BENCH_MISALIGNED; mode ++) {
+
+            size_t    len        = bench_lengths[l];
+            uint8_t * M          = mode == BENCH_MISALIGNED ? buf + 1 : buf;
+            uint64_t  min_cycles = (uint64_t)-1;
+
+            for(int r = 0; r < BENCH_SHA256_REPEATS; r ++) {
+
+                uint64_t start_cycles = test_rdcycle();
+
+                bench_sha256_run((uint8_t*)digest, M, len, mode);
+
+                uint64_t end_cycles   = test_rdcycle();
+                uint64_t cycles       = end_cycles - start_cycles;
+
+                min_cycles = cycles < min_cycles ? cycles : min_cycles;
+            }
+
+            printf("print(\"%-24s %-10s %8lu bytes: %%8.2f cycles/byte\" "
+                   "%% (%lu / %lu))\n",
+                STR(TEST_NAME), bench_mode_names[mode], (unsigned long)len,
+                (unsigned long)min_cycles, (unsigned long)len);
+        }
+    }
+
+    free(buf);
+
+    return 0;
+
+}
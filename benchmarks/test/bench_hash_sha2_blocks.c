@@ -0,0 +1,107 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+
+#include "riscvcrypto/sha256/api_sha256.h"
+#include "riscvcrypto/sha512/api_sha512.h"
+
+//! Number of times each measurement is run. The fastest run is reported.
+#define BENCH_BLOCKS_REPEATS 3
+
+//! Bytes hashed by each measurement.
+#define BENCH_BLOCKS_BYTES   (64 * 1024)
+
+//! Input, with a spare byte so it can be read from a misaligned address.
+static uint64_t bench_buf [BENCH_BLOCKS_BYTES / 8 + 1];
+
+/*!
+@brief The old sha256_hash inner loop: copy each block to an aligned
+    buffer, then compress it.
+*/
+static void bench_sha256_copy(uint32_t H[8], uint8_t * M, size_t nblocks) {
+    uint32_t B [16];
+    while(nblocks --) {
+        memcpy(B, M, SHA256_BLOCK_BYTES);
+        sha256_hash_block(H, B);
+        M += SHA256_BLOCK_BYTES;
+    }
+}
+
+//! The old sha512_hash inner loop.
+static void bench_sha512_copy(uint64_t H[8], uint8_t * M, size_t nblocks) {
+    uint64_t B [16];
+    while(nblocks --) {
+        memcpy(B, M, SHA512_BLOCK_BYTES);
+        sha512_hash_block(H, B);
+        M += SHA512_BLOCK_BYTES;
+    }
+}
+
+//! Which of the three ways of feeding blocks to run.
+typedef enum {
+    BENCH_COPY,
+    BENCH_DIRECT,
+    BENCH_DIRECT_MISALIGNED
+} bench_mode_t;
+
+static const char * bench_mode_names [] = {
+    "copy (before)", "direct aligned", "direct misaligned"
+};
+
+//! Time BENCH_BLOCKS_BYTES of SHA-256 or SHA-512 in one mode.
+static void bench_sha2_blocks(int bits, bench_mode_t mode) {
+
+    uint8_t  * M          = (uint8_t*)bench_buf;
+    uint64_t   min_cycles = (uint64_t)-1;
+    uint32_t   H32 [8]    = {0};
+    uint64_t   H64 [8]    = {0};
+
+    if(mode == BENCH_DIRECT_MISALIGNED) {
+        M += 1;
+    }
+
+    for(int r = 0; r < BENCH_BLOCKS_REPEATS; r ++) {
+
+        uint64_t start_cycles = test_rdcycle();
+
+        if(bits == 256 && mode == BENCH_COPY) {
+            bench_sha256_copy(H32, M, BENCH_BLOCKS_BYTES/SHA256_BLOCK_BYTES);
+        } else if(bits == 256) {
+            sha256_hash_blocks(H32, M, BENCH_BLOCKS_BYTES/SHA256_BLOCK_BYTES);
+        } else if(mode == BENCH_COPY) {
+            bench_sha512_copy(H64, M, BENCH_BLOCKS_BYTES/SHA512_BLOCK_BYTES);
+        } else {
+            sha512_hash_blocks(H64, M, BENCH_BLOCKS_BYTES/SHA512_BLOCK_BYTES);
+        }
+
+        uint64_t end_cycles   = test_rdcycle();
+        uint64_t cycles       = end_cycles - start_cycles;
+
+        min_cycles = cycles < min_cycles ? cycles : min_cycles;
+    }
+
+    printf("print(\"%-28s SHA-%d %-17s: %%6.2f cycles/byte\" "
+           "%% (%lu / %d))\n",
+        STR(TEST_NAME), bits, bench_mode_names[mode],
+        (unsigned long)min_cycles, BENCH_BLOCKS_BYTES);
+}
+
+int main(int argc, char ** argv) {
+
+    printf("import sys\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    test_rdrandom((uint8_t*)bench_buf, sizeof(bench_buf));
+
+    for(int mode = BENCH_COPY; mode <= BENCH_DIRECT_MISALIGNED; mode ++) {
+        bench_sha2_blocks(256, mode);
+    }
+
+    for(int mode = BENCH_COPY; mode <= BENCH_DIRECT_MISALIGNED; mode ++) {
+        bench_sha2_blocks(512, mode);
+    }
+
+    return 0;
+
+}
@@ -0,0 +1,92 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/sha3/fips202.h"
+
+//! Number of times each measurement is run. The fastest run is reported.
+#define BENCH_SHAKE_REPEATS 3
+
+/*!
+@brief Size of each squeeze call. One SHAKE128 block, as read by
+    lattice schemes expanding a seed into a matrix.
+*/
+#define BENCH_SHAKE_CHUNK   KECCAK_RATE_SHAKE128
+
+//! Output lengths measured, in chunks.
+static size_t bench_chunks [] = {1, 4, 16, 64};
+
+static uint8_t bench_seed [34];
+static uint8_t bench_out  [64 * BENCH_SHAKE_CHUNK];
+
+/*!
+@brief Squeeze nchunks chunks from SHAKE128 or SHAKE256, either in
+    BENCH_SHAKE_CHUNK pieces from one context, or all at once with the
+    one-shot wrapper.
+*/
+static void bench_shake_run(int bits, size_t nchunks, int streamed) {
+
+    keccak_ctx_t ctx;
+    size_t       len = nchunks * BENCH_SHAKE_CHUNK;
+
+    if(!streamed) {
+        if(bits == 128) {
+            FIPS202_SHAKE128(bench_seed, sizeof(bench_seed), bench_out, len);
+        } else {
+            FIPS202_SHAKE256(bench_seed, sizeof(bench_seed), bench_out, len);
+        }
+        return;
+    }
+
+    keccak_init(&ctx, bits == 128 ? KECCAK_RATE_SHAKE128
+                                  : KECCAK_RATE_SHAKE256, KECCAK_SUFFIX_SHAKE);
+    keccak_absorb  (&ctx, bench_seed, sizeof(bench_seed));
+    keccak_finalize(&ctx);
+
+    for(size_t i = 0; i < nchunks; i ++) {
+        keccak_squeeze(&ctx, bench_out + i * BENCH_SHAKE_CHUNK,
+                       BENCH_SHAKE_CHUNK);
+    }
+}
+
+int main(int argc, char ** argv) {
+
+    printf("import sys\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    test_rdrandom(bench_seed, sizeof(bench_seed));
+
+    for(int bits = 128; bits <= 256; bits += 128) {
+        for(size_t c = 0; c < sizeof(bench_chunks)/sizeof(size_t); c ++) {
+            for(int streamed = 0; streamed <= 1; streamed ++) {
+
+                size_t   nchunks    = bench_chunks[c];
+                uint64_t min_cycles = (uint64_t)-1;
+
+                for(int r = 0; r < BENCH_SHAKE_REPEATS; r ++) {
+
+                    uint64_t start_cycles = test_rdcycle();
+
+                    bench_shake_run(bits, nchunks, streamed);
+
+                    uint64_t end_cycles   = test_rdcycle();
+                    uint64_t cycles       = end_cycles - start_cycles;
+
+                    min_cycles = cycles < min_cycles ? cycles : min_cycles;
+                }
+
+                printf("print(\"%-24s SHAKE%d %5d bytes %-8s: "
+                       "%%8.2f cycles/byte\" %% (%lu / %d))\n",
+                    STR(TEST_NAME), bits, (int)(nchunks * BENCH_SHAKE_CHUNK),
+                    streamed ? "squeeze" : "one-shot",
+                    (unsigned long)min_cycles,
+                    (int)(nchunks * BENCH_SHAKE_CHUNK));
+            }
+        }
+    }
+
+    return 0;
+
+}
@@ -0,0 +1,83 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/sha3/fips202.h"
+
+//! Number of times each measurement is run. The fastest run is reported.
+#define BENCH_X4_REPEATS 3
+
+//! Bytes of seed absorbed by each stream: a 32-byte seed and two indices.
+#define BENCH_X4_SEED    34
+
+//! Output lengths measured per stream, in SHAKE128 blocks.
+static size_t bench_blocks [] = {1, 3, 5, 16};
+
+static uint8_t bench_seed [4][BENCH_X4_SEED];
+static uint8_t bench_out  [4][16 * KECCAK_RATE_SHAKE128];
+
+//! Expand four streams of len bytes, either with shake128_x4 or one by one.
+static void bench_x4_run(size_t len, int batched) {
+
+    if(batched) {
+        shake128_x4_ctx_t ctx;
+        const uint8_t   * in [4] = {bench_seed[0], bench_seed[1],
+                                    bench_seed[2], bench_seed[3]};
+        uint8_t         * out[4] = {bench_out [0], bench_out [1],
+                                    bench_out [2], bench_out [3]};
+
+        shake128_x4_init    (&ctx);
+        shake128_x4_absorb  (&ctx, in, BENCH_X4_SEED);
+        shake128_x4_finalize(&ctx);
+        shake128_x4_squeeze (&ctx, out, len);
+
+    } else {
+        keccak_ctx_t ctx;
+
+        for(int l = 0; l < 4; l ++) {
+            keccak_init    (&ctx, KECCAK_RATE_SHAKE128, KECCAK_SUFFIX_SHAKE);
+            keccak_absorb  (&ctx, bench_seed[l], BENCH_X4_SEED);
+            keccak_finalize(&ctx);
+            keccak_squeeze (&ctx, bench_out[l], len);
+        }
+    }
+}
+
+int main(int argc, char ** argv) {
+
+    printf("import sys\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    test_rdrandom((uint8_t*)bench_seed, sizeof(bench_seed));
+
+    for(size_t b = 0; b < sizeof(bench_blocks)/sizeof(size_t); b ++) {
+        for(int batched = 0; batched <= 1; batched ++) {
+
+            size_t   len        = bench_blocks[b] * KECCAK_RATE_SHAKE128;
+            uint64_t min_cycles = (uint64_t)-1;
+
+            for(int r = 0; r < BENCH_X4_REPEATS; r ++) {
+
+                uint64_t start_cycles = test_rdcycle();
+
+                bench_x4_run(len, batched);
+
+                uint64_t end_cycles   = test_rdcycle();
+                uint64_t cycles       = end_cycles - start_cycles;
+
+                min_cycles = cycles < min_cycles ? cycles : min_cycles;
+            }
+
+            printf("print(\"%-24s 4 x SHAKE128 %5d bytes %-10s: "
+                   "%%7.4f bytes/cycle\" %% (%d / %lu))\n",
+                STR(TEST_NAME), (int)len,
+                batched ? "x4" : "sequential",
+                (int)(4 * len), (unsigned long)min_cycles);
+        }
+    }
+
+    return 0;
+
+}
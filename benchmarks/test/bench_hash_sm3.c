@@ -0,0 +1,74 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+
+#include "riscvcrypto/sha256/api_sha256.h"
+#include "riscvcrypto/sm3/api_sm3.h"
+
+//! Number of times each measurement is run. The fastest run is reported.
+#define BENCH_SM3_REPEATS 3
+
+//! Message lengths measured: small, medium and large.
+static size_t bench_lengths [] = {
+    16, 64, 256, 1024, 4096, 16384, 262144
+};
+
+//! Functions measured. SHA-256 has the same block and digest size.
+typedef enum {
+    BENCH_SM3,
+    BENCH_SHA256,
+    BENCH_NUM_FNS
+} bench_fn_t;
+
+static const char * bench_fn_names [] = {
+    "SM3", "SHA-256"
+};
+
+int main(int argc, char ** argv) {
+
+    printf("import sys\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    size_t    max_len = bench_lengths[
+        sizeof(bench_lengths) / sizeof(bench_lengths[0]) - 1];
+
+    uint8_t * buf     = malloc(max_len);
+    uint32_t  digest [8];
+
+    test_rdrandom(buf, max_len);
+
+    for(size_t l = 0; l < sizeof(bench_lengths)/sizeof(size_t); l ++) {
+        for(int fn = 0; fn < BENCH_NUM_FNS; fn ++) {
+
+            size_t    len        = bench_lengths[l];
+            uint64_t  min_cycles = (uint64_t)-1;
+
+            for(int r = 0; r < BENCH_SM3_REPEATS; r ++) {
+
+                uint64_t start_cycles = test_rdcycle();
+
+                if(fn == BENCH_SM3) {
+                    sm3_hash((uint8_t*)digest, buf, len);
+                } else {
+                    sha256_hash(digest, buf, len);
+                }
+
+                uint64_t end_cycles   = test_rdcycle();
+                uint64_t cycles       = end_cycles - start_cycles;
+
+                min_cycles = cycles < min_cycles ? cycles : min_cycles;
+            }
+
+            printf("print(\"%-24s %-8s %8lu bytes: %%8.2f cycles/byte\" "
+                   "%% (%lu / %lu))\n",
+                STR(TEST_NAME), bench_fn_names[fn], (unsigned long)len,
+                (unsigned long)min_cycles, (unsigned long)len);
+        }
+    }
+
+    free(buf);
+
+    return 0;
+
+}
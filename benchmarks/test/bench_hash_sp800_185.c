@@ -0,0 +1,122 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/sha3/fips202.h"
+#include "riscvcrypto/sha3/sp800_185.h"
+
+//! Number of times each measurement is run. The fastest run is reported.
+#define BENCH_SP800_185_REPEATS   3
+
+//! Bytes of output for each function.
+#define BENCH_SP800_185_OUT_BYTES 32
+
+//! ParallelHash block size, as used for large artifacts.
+#define BENCH_SP800_185_B         8192
+
+//! Largest message measured.
+#define BENCH_SP800_185_MAX_BYTES (8 * BENCH_SP800_185_B)
+
+//! Message lengths measured.
+static size_t bench_lengths [] = {64, 1024, BENCH_SP800_185_MAX_BYTES};
+
+static uint8_t bench_msg [BENCH_SP800_185_MAX_BYTES];
+static uint8_t bench_key [32];
+static uint8_t bench_out [BENCH_SP800_185_OUT_BYTES];
+
+//! Functions measured.
+typedef enum {
+    BENCH_SHAKE128,
+    BENCH_KMAC128,
+    BENCH_PH128,
+    BENCH_PH128_SERIAL,
+    BENCH_PH256,
+    BENCH_NUM_FNS
+} bench_fn_t;
+
+static const char * bench_fn_names [] = {
+    "SHAKE128", "KMAC128", "ParallelHash128", "PH128 serial",
+    "ParallelHash256"
+};
+
+/*!
+@brief Hash len bytes of bench_msg with one function.
+@details "PH128 serial" absorbs in pieces of one byte under a block, so
+    every block takes the single-state path. The difference from
+    "ParallelHash128" is what the multi-state block hashing gives.
+*/
+static void bench_sp800_185_run(bench_fn_t fn, size_t len) {
+
+    parallelhash_ctx_t ctx;
+
+    switch(fn) {
+        case BENCH_SHAKE128:
+            FIPS202_SHAKE128(bench_msg, len, bench_out,
+                             BENCH_SP800_185_OUT_BYTES);
+            break;
+        case BENCH_KMAC128:
+            KMAC128(bench_key, sizeof(bench_key), bench_msg, len, NULL, 0,
+                    bench_out, BENCH_SP800_185_OUT_BYTES);
+            break;
+        case BENCH_PH128:
+            ParallelHash128(bench_msg, len, BENCH_SP800_185_B, NULL, 0,
+                            bench_out, BENCH_SP800_185_OUT_BYTES);
+            break;
+        case BENCH_PH256:
+            ParallelHash256(bench_msg, len, BENCH_SP800_185_B, NULL, 0,
+                            bench_out, BENCH_SP800_185_OUT_BYTES);
+            break;
+        default:
+            parallelhash_init(&ctx, KECCAK_RATE_SHAKE128, BENCH_SP800_185_B,
+                              NULL, 0);
+            for(size_t done = 0; done < len; ) {
+                size_t take = len - done;
+                take = take < BENCH_SP800_185_B - 1 ? take
+                                                    : BENCH_SP800_185_B - 1;
+                parallelhash_absorb(&ctx, bench_msg + done, take);
+                done += take;
+            }
+            parallelhash_finalize(&ctx, BENCH_SP800_185_OUT_BYTES);
+            parallelhash_squeeze (&ctx, bench_out, BENCH_SP800_185_OUT_BYTES);
+            break;
+    }
+}
+
+int main(int argc, char ** argv) {
+
+    printf("import sys\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    test_rdrandom(bench_msg, sizeof(bench_msg));
+    test_rdrandom(bench_key, sizeof(bench_key));
+
+    for(size_t l = 0; l < sizeof(bench_lengths)/sizeof(size_t); l ++) {
+        for(int fn = 0; fn < BENCH_NUM_FNS; fn ++) {
+
+            size_t   len        = bench_lengths[l];
+            uint64_t min_cycles = (uint64_t)-1;
+
+            for(int r = 0; r < BENCH_SP800_185_REPEATS; r ++) {
+
+                uint64_t start_cycles = test_rdcycle();
+
+                bench_sp800_185_run(fn, len);
+
+                uint64_t end_cycles   = test_rdcycle();
+                uint64_t cycles       = end_cycles - start_cycles;
+
+                min_cycles = cycles < min_cycles ? cycles : min_cycles;
+            }
+
+            printf("print(\"%-24s %-16s %6d bytes: "
+                   "%%8.2f cycles/byte\" %% (%lu / %d))\n",
+                STR(TEST_NAME), bench_fn_names[fn], (int)len,
+                (unsigned long)min_cycles, (int)len);
+        }
+    }
+
+    return 0;
+
+}
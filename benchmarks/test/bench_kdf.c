@@ -0,0 +1,113 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+
+#include "riscvcrypto/kdf/api_kdf.h"
+
+//! Iteration count of each PBKDF2 measurement.
+#define BENCH_KDF_ITERATIONS 1000
+
+//! Number of times each measurement is run. The fastest run is reported.
+#define BENCH_KDF_REPEATS    3
+
+/*!
+@brief Nominal core clock used to turn cycles into iterations per
+    second. The cycles per iteration figure does not depend on it.
+*/
+#define BENCH_KDF_CLOCK_HZ   100000000
+
+static uint8_t bench_pwd  [16];
+static uint8_t bench_salt [16];
+static uint8_t bench_dk   [SHA512_DIGEST_BYTES];
+
+/*!
+@brief One PBKDF2 output block written the obvious way: a full HMAC call
+    on the previous output for every iteration. This is the baseline the
+    word-level loop in pbkdf2_hmac_sha* is measured against.
+*/
+static void bench_kdf_naive(int bits, uint32_t iterations) {
+
+    hmac_sha256_key_t k256;
+    hmac_sha512_key_t k512;
+    uint8_t           u [SHA512_DIGEST_BYTES];
+    uint8_t           s [sizeof(bench_salt) + 4];
+    size_t            n = bits / 8;
+
+    memcpy(s, bench_salt, sizeof(bench_salt));
+    s[sizeof(bench_salt)+0] = 0;
+    s[sizeof(bench_salt)+1] = 0;
+    s[sizeof(bench_salt)+2] = 0;
+    s[sizeof(bench_salt)+3] = 1;
+
+    if(bits == 256) {
+        hmac_sha256_key_init(&k256, bench_pwd, sizeof(bench_pwd));
+        hmac_sha256(u, &k256, s, sizeof(s));
+    } else {
+        hmac_sha512_key_init(&k512, bench_pwd, sizeof(bench_pwd));
+        hmac_sha512(u, &k512, s, sizeof(s));
+    }
+
+    memcpy(bench_dk, u, n);
+
+    for(uint32_t j = 1; j < iterations; j ++) {
+        if(bits == 256) {
+            hmac_sha256(u, &k256, u, n);
+        } else {
+            hmac_sha512(u, &k512, u, n);
+        }
+        for(size_t i = 0; i < n; i ++) {
+            bench_dk[i] ^= u[i];
+        }
+    }
+}
+
+int main(int argc, char ** argv) {
+
+    printf("import sys\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    test_rdrandom(bench_pwd , sizeof(bench_pwd ));
+    test_rdrandom(bench_salt, sizeof(bench_salt));
+
+    for(int bits = 256; bits <= 512; bits += 256) {
+        for(int naive = 1; naive >= 0; naive --) {
+
+            uint64_t min_cycles = (uint64_t)-1;
+
+            for(int r = 0; r < BENCH_KDF_REPEATS; r ++) {
+
+                uint64_t start_cycles = test_rdcycle();
+
+                if(naive) {
+                    bench_kdf_naive(bits, BENCH_KDF_ITERATIONS);
+                } else if(bits == 256) {
+                    pbkdf2_hmac_sha256(bench_dk, SHA256_DIGEST_BYTES,
+                        bench_pwd , sizeof(bench_pwd ),
+                        bench_salt, sizeof(bench_salt), BENCH_KDF_ITERATIONS);
+                } else {
+                    pbkdf2_hmac_sha512(bench_dk, SHA512_DIGEST_BYTES,
+                        bench_pwd , sizeof(bench_pwd ),
+                        bench_salt, sizeof(bench_salt), BENCH_KDF_ITERATIONS);
+                }
+
+                uint64_t end_cycles   = test_rdcycle();
+                uint64_t cycles       = end_cycles - start_cycles;
+
+                min_cycles = cycles < min_cycles ? cycles : min_cycles;
+            }
+
+            printf("print(\"%-24s PBKDF2-HMAC-SHA%d %-6s: "
+                   "%%8.1f cycles/iteration, %%10.0f iterations/s at %d MHz\""
+                   " %% (%lu / %d, %d * %d / %lu))\n",
+                STR(TEST_NAME), bits, naive ? "hmac" : "words",
+                BENCH_KDF_CLOCK_HZ / 1000000,
+                (unsigned long)min_cycles, BENCH_KDF_ITERATIONS,
+                BENCH_KDF_ITERATIONS, BENCH_KDF_CLOCK_HZ,
+                (unsigned long)min_cycles);
+        }
+    }
+
+    return 0;
+
+}
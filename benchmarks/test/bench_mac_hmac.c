@@ -0,0 +1,89 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+
+#include "riscvcrypto/hmac/api_hmac.h"
+
+//! Number of messages MACed by each measurement.
+#define BENCH_HMAC_MESSAGES 16
+
+//! Number of times each measurement is run. The fastest run is reported.
+#define BENCH_HMAC_REPEATS  3
+
+//! Message lengths measured. Small packets are where the pads dominate.
+static size_t bench_lengths [] = {16, 64, 256, 1024};
+
+static uint8_t bench_key [32];
+static uint8_t bench_msg [1024];
+static uint8_t bench_mac [HMAC_SHA512_BYTES];
+
+/*!
+@brief MAC every message, either re-deriving the key context each time
+    (the cost of HMAC without cached midstates) or reusing one.
+*/
+static void bench_hmac_run(int bits, size_t len, int cached) {
+
+    hmac_sha256_key_t k256;
+    hmac_sha512_key_t k512;
+
+    if(bits == 256) {
+        hmac_sha256_key_init(&k256, bench_key, sizeof(bench_key));
+    } else {
+        hmac_sha512_key_init(&k512, bench_key, sizeof(bench_key));
+    }
+
+    for(int i = 0; i < BENCH_HMAC_MESSAGES; i ++) {
+        if(bits == 256) {
+            if(!cached) {
+                hmac_sha256_key_init(&k256, bench_key, sizeof(bench_key));
+            }
+            hmac_sha256(bench_mac, &k256, bench_msg, len);
+        } else {
+            if(!cached) {
+                hmac_sha512_key_init(&k512, bench_key, sizeof(bench_key));
+            }
+            hmac_sha512(bench_mac, &k512, bench_msg, len);
+        }
+    }
+}
+
+int main(int argc, char ** argv) {
+
+    printf("import sys\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    test_rdrandom(bench_key, sizeof(bench_key));
+    test_rdrandom(bench_msg, sizeof(bench_msg));
+
+    for(int bits = 256; bits <= 512; bits += 256) {
+        for(size_t l = 0; l < sizeof(bench_lengths)/sizeof(size_t); l ++) {
+            for(int cached = 0; cached <= 1; cached ++) {
+
+                size_t   len        = bench_lengths[l];
+                uint64_t min_cycles = (uint64_t)-1;
+
+                for(int r = 0; r < BENCH_HMAC_REPEATS; r ++) {
+
+                    uint64_t start_cycles = test_rdcycle();
+
+                    bench_hmac_run(bits, len, cached);
+
+                    uint64_t end_cycles   = test_rdcycle();
+                    uint64_t cycles       = end_cycles - start_cycles;
+
+                    min_cycles = cycles < min_cycles ? cycles : min_cycles;
+                }
+
+                printf("print(\"%-24s HMAC-SHA%d %4d bytes %-9s: "
+                       "%%8.1f cycles/message\" %% (%lu / %d))\n",
+                    STR(TEST_NAME), bits, (int)len,
+                    cached ? "midstate" : "per-key",
+                    (unsigned long)min_cycles, BENCH_HMAC_MESSAGES);
+            }
+        }
+    }
+
+    return 0;
+
+}
@@ -0,0 +1,87 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+
+#include "riscvcrypto/merkle/api_merkle.h"
+
+//! Leaves in the benchmarked tree.
+#define BENCH_MERKLE_LEAVES  256
+
+//! Size of each storage chunk.
+#define BENCH_MERKLE_CHUNK   64
+
+//! Number of times each measurement is run. The fastest run is reported.
+#define BENCH_MERKLE_REPEATS 3
+
+static uint8_t bench_data  [BENCH_MERKLE_LEAVES * BENCH_MERKLE_CHUNK];
+static uint8_t bench_nodes [2 * BENCH_MERKLE_LEAVES * MERKLE_NODE_BYTES];
+
+/*!
+@brief Hash every level with sha256_hash, as a tree builder would
+    without the 64-byte entry point.
+*/
+static void bench_merkle_generic_build(merkle_tree_t * tree) {
+    for(size_t l = 0; l + 1 < tree->levels; l ++) {
+        uint8_t * in  = tree->nodes + tree->start[l  ] * MERKLE_NODE_BYTES;
+        uint8_t * out = tree->nodes + tree->start[l+1] * MERKLE_NODE_BYTES;
+        for(size_t p = 0; p < tree->count[l] / 2; p ++) {
+            sha256_hash((uint32_t*)(out + p * MERKLE_NODE_BYTES),
+                        in + p * MERKLE_NODE_BYTES * 2,
+                        MERKLE_NODE_BYTES * 2);
+        }
+    }
+}
+
+int main(int argc, char ** argv) {
+
+    printf("import sys\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    merkle_tree_t tree;
+
+    test_rdrandom(bench_data, sizeof(bench_data));
+
+    merkle_tree_init(&tree, bench_nodes, BENCH_MERKLE_LEAVES, NULL);
+
+    for(size_t i = 0; i < BENCH_MERKLE_LEAVES; i ++) {
+        merkle_tree_set_leaf(&tree, i, bench_data + i * BENCH_MERKLE_CHUNK,
+                             BENCH_MERKLE_CHUNK);
+    }
+
+    for(int what = 0; what < 3; what ++) {
+
+        uint64_t min_cycles = (uint64_t)-1;
+        int      nodes      = what == 2 ? (int)tree.levels - 1
+                                        : BENCH_MERKLE_LEAVES - 1;
+
+        for(int r = 0; r < BENCH_MERKLE_REPEATS; r ++) {
+
+            uint64_t start_cycles = test_rdcycle();
+
+            if(what == 0) {
+                bench_merkle_generic_build(&tree);
+            } else if(what == 1) {
+                merkle_tree_build(&tree);
+            } else {
+                merkle_tree_update(&tree, r * 37, bench_data,
+                                   BENCH_MERKLE_CHUNK);
+            }
+
+            uint64_t end_cycles   = test_rdcycle();
+            uint64_t cycles       = end_cycles - start_cycles;
+
+            min_cycles = cycles < min_cycles ? cycles : min_cycles;
+        }
+
+        printf("print(\"%-24s %d leaves %-17s: %%9lu cycles, "
+               "%%7.1f cycles/node\" %% (%lu, %lu / %d))\n",
+            STR(TEST_NAME), BENCH_MERKLE_LEAVES,
+            what == 0 ? "build sha256_hash" :
+            what == 1 ? "build hash_64"     : "update one leaf",
+            (unsigned long)min_cycles, (unsigned long)min_cycles, nodes);
+    }
+
+    return 0;
+
+}
@@ -14,6 +14,7 @@ void test_aes_128(int num_tests) {
     uint8_t  pt  [AES_BLOCK_BYTES   ] = {0x32 ,0x43 ,0xf6 ,0xa8 ,0x88 ,0x5a ,0x30 ,0x8d ,0x31 ,0x31 ,0x98 ,0xa2 ,0xe0 ,0x37 ,0x07 ,0x34};
     uint32_t erk [AES_128_RK_WORDS  ]; //!< Roundkeys (encrypt)
     uint32_t drk [AES_128_RK_WORDS  ]; //!< Roundkeys (decrypt)
+    uint32_t frk [AES_128_RK_WORDS  ]; //!< Roundkeys (decrypt, from erk)
     uint8_t  ct  [AES_BLOCK_BYTES   ];
     uint8_t  pt2 [AES_BLOCK_BYTES   ];
     uint64_t start_instrs;
@@ -32,6 +33,8 @@ void test_aes_128(int num_tests) {
         aes_128_dec_key_schedule(drk, key    );
         //uint64_t ksd_icount   = test_rdinstret() - start_instrs;
 
+        aes_128_dec_key_schedule_from_enc(frk, erk);
+
         //start_instrs        = test_rdinstret();
         aes_128_ecb_decrypt     (pt2, ct, drk);
         //uint64_t dec_icount = test_rdinstret() - start_instrs;
@@ -41,6 +44,7 @@ void test_aes_128(int num_tests) {
         printf("key=");puthex_py(key, AES_128_KEY_BYTES); printf("\n");
         printf("erk=");puthex_py((uint8_t*)erk,AES_128_RK_BYTES);printf("\n");
         printf("drk=");puthex_py((uint8_t*)drk,AES_128_RK_BYTES);printf("\n");
+        printf("frk=");puthex_py((uint8_t*)frk,AES_128_RK_BYTES);printf("\n");
         printf("pt =");puthex_py(pt , AES_BLOCK_BYTES  ); printf("\n");
         printf("pt2=");puthex_py(pt2, AES_BLOCK_BYTES  ); printf("\n");
         printf("ct =");puthex_py(ct , AES_BLOCK_BYTES  ); printf("\n");
@@ -70,6 +74,12 @@ void test_aes_128(int num_tests) {
         printf("    print( 'pt  == %%s' %% ( binascii.b2a_hex( pt2    )))\n");
         printf("    print( '    != %%s' %% ( binascii.b2a_hex( ref_pt )))\n");
         printf("    sys.exit(1)\n");
+        printf("elif( frk        != drk       ):\n");
+        printf("    print(\"AES 128 Test %d dec_key_schedule_from_enc failed.\")\n", i);
+        printf("    print( 'erk == %%s' %% ( binascii.b2a_hex(erk     )))\n");
+        printf("    print( 'frk == %%s' %% ( binascii.b2a_hex(frk     )))\n");
+        printf("    print( '    != %%s' %% ( binascii.b2a_hex(drk     )))\n");
+        printf("    sys.exit(1)\n");
         printf("else:\n");
         printf("    sys.stdout.write(\""STR(TEST_NAME)" AES 128 Test passed. \")\n");
         //printf("    sys.stdout.write(\"enc: %%d, \" %% (enc_icount))\n");
@@ -27,6 +27,7 @@ void test_aes_192(int num_tests) {
     };
     uint32_t erk [AES_192_RK_WORDS  ]; //!< Roundkeys (encrypt)
     uint32_t drk [AES_192_RK_WORDS  ]; //!< Roundkeys (decrypt)
+    uint32_t frk [AES_192_RK_WORDS  ]; //!< Roundkeys (decrypt, from erk)
     uint8_t  ct  [AES_BLOCK_BYTES   ];
     uint8_t  pt2 [AES_BLOCK_BYTES   ];
     uint64_t start_instrs;
@@ -50,6 +51,10 @@ void test_aes_192(int num_tests) {
         aes_192_dec_key_schedule(drk, key    );
         uint64_t ksd_icount   = test_rdinstret() - start_instrs;
 
+        start_instrs        = test_rdinstret();
+        aes_192_dec_key_schedule_from_enc(frk, erk);
+        uint64_t ksf_icount   = test_rdinstret() - start_instrs;
+
         start_instrs        = test_rdinstret();
         aes_192_ecb_decrypt     (pt2, ct, drk);
         uint64_t dec_icount = test_rdinstret() - start_instrs;
@@ -59,12 +64,14 @@ void test_aes_192(int num_tests) {
         printf("key=");puthex_py(key, AES_192_KEY_BYTES); printf("\n");
         printf("erk=");puthex_py((uint8_t*)erk,AES_192_RK_BYTES);printf("\n");
         printf("drk=");puthex_py((uint8_t*)drk,AES_192_RK_BYTES);printf("\n");
+        printf("frk=");puthex_py((uint8_t*)frk,AES_192_RK_BYTES);printf("\n");
         printf("pt =");puthex_py(pt , AES_BLOCK_BYTES  ); printf("\n");
         printf("pt2=");puthex_py(pt2, AES_BLOCK_BYTES  ); printf("\n");
         printf("ct =");puthex_py(ct , AES_BLOCK_BYTES  ); printf("\n");
 
         printf("kse_icount = 0x"); puthex64(kse_icount); printf("\n");
         printf("ksd_icount = 0x"); puthex64(ksd_icount); printf("\n");
+        printf("ksf_icount = 0x"); puthex64(ksf_icount); printf("\n");
         printf("enc_icount = 0x"); puthex64(enc_icount); printf("\n");
         printf("dec_icount = 0x"); puthex64(dec_icount); printf("\n");
 
@@ -88,12 +95,19 @@ void test_aes_192(int num_tests) {
         printf("    print( 'pt  == %%s' %% ( binascii.b2a_hex( pt2    )))\n");
         printf("    print( '    != %%s' %% ( binascii.b2a_hex( ref_pt )))\n");
         printf("    sys.exit(1)\n");
+        printf("elif( frk        != drk       ):\n");
+        printf("    print(\"AES 192 Test %d dec_key_schedule_from_enc failed.\")\n", i);
+        printf("    print( 'erk == %%s' %% ( binascii.b2a_hex(erk     )))\n");
+        printf("    print( 'frk == %%s' %% ( binascii.b2a_hex(frk     )))\n");
+        printf("    print( '    != %%s' %% ( binascii.b2a_hex(drk     )))\n");
+        printf("    sys.exit(1)\n");
         printf("else:\n");
         printf("    sys.stdout.write(\""STR(TEST_NAME)" AES 192 Test passed. \")\n");
         printf("    sys.stdout.write(\"enc: %%d, \" %% (enc_icount))\n");
         printf("    sys.stdout.write(\"dec: %%d, \" %% (dec_icount))\n");
         printf("    sys.stdout.write(\"kse: %%d, \" %% (kse_icount))\n");
         printf("    sys.stdout.write(\"ksd: %%d, \" %% (ksd_icount))\n");
+        printf("    sys.stdout.write(\"ksf: %%d, \" %% (ksf_icount))\n");
         printf("    print(\"\")\n");
         
         // New random inputs
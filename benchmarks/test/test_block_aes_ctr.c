@@ -0,0 +1,132 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/aes/api_aes.h"
+
+//! Longest message passed to a single CTR call.
+#define TEST_CTR_MAX_BYTES  (8 * AES_BLOCK_BYTES)
+
+typedef void (*aes_ks_t   )(uint32_t * const rk, uint8_t * const ck);
+typedef void (*aes_ctr_t  )(uint8_t * out, uint8_t * in, uint32_t * rk,
+                            size_t len, uint8_t ctr[AES_BLOCK_BYTES]);
+
+//! Message lengths to test. Covers partial, whole and odd block counts.
+static const size_t test_ctr_lengths [] = {
+    0, 1, 15, 16, 17, 31, 32, 33, 48, 63, 64, 100, TEST_CTR_MAX_BYTES
+};
+
+#define TEST_CTR_NUM_LENGTHS \
+    (sizeof(test_ctr_lengths) / sizeof(test_ctr_lengths[0]))
+
+void test_aes_ctr(
+    int         key_bits,
+    size_t      key_bytes,
+    aes_ks_t    enc_ks,
+    aes_ctr_t   ctr_fn
+) {
+
+    uint8_t  key [AES_256_KEY_BYTES];
+    uint32_t erk [AES_256_RK_WORDS ]; //!< Roundkeys (encrypt)
+    uint8_t  ctr [AES_BLOCK_BYTES  ]; //!< Initial counter
+    uint8_t  nxt [AES_BLOCK_BYTES  ]; //!< Counter after the call
+    uint8_t  pt  [TEST_CTR_MAX_BYTES];
+    uint8_t  ct  [TEST_CTR_MAX_BYTES];
+    uint8_t  pt2 [TEST_CTR_MAX_BYTES];
+    uint64_t start_instrs;
+
+    for(size_t i = 0; i < TEST_CTR_NUM_LENGTHS; i ++) {
+
+        size_t len = test_ctr_lengths[i];
+
+        test_rdrandom(key, key_bytes      );
+        test_rdrandom(pt , len            );
+        test_rdrandom(ctr, AES_BLOCK_BYTES);
+
+        if(i & 1) {
+            // Force a carry out of the low 32 and 64 bits of the counter.
+            memset(ctr + 8 , 0xFF, 8);
+            ctr[8 + (i & 0x7)] = 0xFF - (i & 0x3);
+        }
+
+        enc_ks(erk, key);
+
+        memcpy(nxt, ctr, AES_BLOCK_BYTES);
+        start_instrs        = test_rdinstret();
+        ctr_fn(ct, pt, erk, len, nxt);
+        uint64_t enc_icount = test_rdinstret() - start_instrs;
+
+        // Decrypt in two calls, to check the counter is carried over.
+        uint8_t ctr2 [AES_BLOCK_BYTES];
+        size_t  split = (len / 2) & ~(AES_BLOCK_BYTES - 1);
+        memcpy(ctr2, ctr, AES_BLOCK_BYTES);
+        ctr_fn(pt2        , ct        , erk, split      , ctr2);
+        ctr_fn(pt2 + split, ct + split, erk, len - split, ctr2);
+
+        printf("#\n# AES %d CTR %d-byte test %d\n",
+            key_bits, (int)len, (int)i);
+
+        printf("key =");puthex_py(key , key_bytes      ); printf("\n");
+        printf("ctr =");puthex_py(ctr , AES_BLOCK_BYTES); printf("\n");
+        printf("nxt =");puthex_py(nxt , AES_BLOCK_BYTES); printf("\n");
+        printf("ctr2=");puthex_py(ctr2, AES_BLOCK_BYTES); printf("\n");
+        printf("pt  =");puthex_py(pt  , len            ); printf("\n");
+        printf("ct  =");puthex_py(ct  , len            ); printf("\n");
+        printf("pt2 =");puthex_py(pt2 , len            ); printf("\n");
+
+        printf("ref_ct, ref_nxt = ref_ctr(key, ctr, pt)\n");
+        printf("if( ref_ct != ct or ref_nxt != nxt ):\n");
+        printf("    print(\"AES %d CTR %d-byte Test %d encrypt failed.\")\n",
+            key_bits, (int)len, (int)i);
+        printf("    print( 'key == %%s' %% ( binascii.b2a_hex( key     )))\n");
+        printf("    print( 'ctr == %%s' %% ( binascii.b2a_hex( ctr     )))\n");
+        printf("    print( 'ct  == %%s' %% ( binascii.b2a_hex( ct      )))\n");
+        printf("    print( '    != %%s' %% ( binascii.b2a_hex( ref_ct  )))\n");
+        printf("    print( 'nxt == %%s' %% ( binascii.b2a_hex( nxt     )))\n");
+        printf("    print( '    != %%s' %% ( binascii.b2a_hex( ref_nxt )))\n");
+        printf("    sys.exit(1)\n");
+        printf("elif( pt != pt2 or ctr2 != nxt ):\n");
+        printf("    print(\"AES %d CTR %d-byte Test %d chained decrypt failed.\")\n",
+            key_bits, (int)len, (int)i);
+        printf("    print( 'pt  == %%s' %% ( binascii.b2a_hex( pt2     )))\n");
+        printf("    print( '    != %%s' %% ( binascii.b2a_hex( pt      )))\n");
+        printf("    sys.exit(1)\n");
+        printf("else:\n");
+        printf("    sys.stdout.write(\""STR(TEST_NAME)" AES %d CTR %d-byte Test passed. \")\n",
+            key_bits, (int)len);
+        printf("    sys.stdout.write(\"icount: %%d\" %% (%lu))\n",
+            (unsigned long)enc_icount);
+        printf("    print(\"\")\n");
+
+    }
+
+}
+
+
+int main(int argc, char ** argv) {
+
+    printf("import sys, binascii, Crypto.Cipher.AES as AES\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+    printf("def ref_ctr(key, ctr, pt):\n");
+    printf("    c   = int.from_bytes(ctr, 'big')\n");
+    printf("    ecb = AES.new(key, AES.MODE_ECB)\n");
+    printf("    ks  = b''\n");
+    printf("    for i in range(0, len(pt), 16):\n");
+    printf("        ks += ecb.encrypt(c.to_bytes(16, 'big'))\n");
+    printf("        c   = (c + 1) %% (1 << 128)\n");
+    printf("    return bytes(a ^ b for a, b in zip(pt, ks)), c.to_bytes(16, 'big')\n");
+
+    test_aes_ctr(128, AES_128_KEY_BYTES,
+        aes_128_enc_key_schedule, aes_128_ctr_xcrypt);
+
+    test_aes_ctr(192, AES_192_KEY_BYTES,
+        aes_192_enc_key_schedule, aes_192_ctr_xcrypt);
+
+    test_aes_ctr(256, AES_256_KEY_BYTES,
+        aes_256_enc_key_schedule, aes_256_ctr_xcrypt);
+
+    return 0;
+
+}
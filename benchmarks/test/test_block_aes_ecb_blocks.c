@@ -0,0 +1,126 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/aes/api_aes.h"
+
+//! Largest number of blocks passed to a single multi-block call.
+#define TEST_ECB_MAX_BLOCKS 9
+
+typedef void (*aes_ks_t   )(uint32_t * const rk, uint8_t * const ck);
+typedef void (*aes_ecb_t  )(uint8_t * out, uint8_t * in, uint32_t * rk);
+typedef void (*aes_ecb_n_t)(uint8_t * out, uint8_t * in, uint32_t * rk,
+                            size_t nblocks);
+
+void test_aes_ecb_blocks(
+    int         num_tests,
+    int         key_bits,
+    size_t      key_bytes,
+    aes_ks_t    enc_ks,
+    aes_ks_t    dec_ks,
+    aes_ecb_t   enc_1,
+    aes_ecb_n_t enc_n,
+    aes_ecb_n_t dec_n
+) {
+
+    uint8_t  key [AES_256_KEY_BYTES];
+    uint32_t erk [AES_256_RK_WORDS ]; //!< Roundkeys (encrypt)
+    uint32_t drk [AES_256_RK_WORDS ]; //!< Roundkeys (decrypt)
+    uint8_t  pt  [TEST_ECB_MAX_BLOCKS * AES_BLOCK_BYTES];
+    uint8_t  ct  [TEST_ECB_MAX_BLOCKS * AES_BLOCK_BYTES];
+    uint8_t  ct1 [TEST_ECB_MAX_BLOCKS * AES_BLOCK_BYTES];
+    uint8_t  pt2 [TEST_ECB_MAX_BLOCKS * AES_BLOCK_BYTES];
+    uint64_t start_instrs;
+
+    for(int i = 0; i < num_tests; i ++) {
+
+        size_t nblocks = 1 + (i % TEST_ECB_MAX_BLOCKS);
+        size_t nbytes  = nblocks * AES_BLOCK_BYTES;
+
+        test_rdrandom(key, key_bytes);
+        test_rdrandom(pt , nbytes   );
+
+        enc_ks(erk, key);
+        dec_ks(drk, key);
+
+        start_instrs        = test_rdinstret();
+        for(size_t b = 0; b < nblocks; b ++) {
+            enc_1(ct1 + AES_BLOCK_BYTES*b, pt + AES_BLOCK_BYTES*b, erk);
+        }
+        uint64_t one_icount = test_rdinstret() - start_instrs;
+
+        start_instrs        = test_rdinstret();
+        enc_n(ct , pt, erk, nblocks);
+        uint64_t enc_icount = test_rdinstret() - start_instrs;
+
+        start_instrs        = test_rdinstret();
+        dec_n(pt2, ct, drk, nblocks);
+        uint64_t dec_icount = test_rdinstret() - start_instrs;
+
+        printf("#\n# AES %d ECB %d-block test %d/%d\n",
+            key_bits, (int)nblocks, i, num_tests);
+
+        printf("key=");puthex_py(key, key_bytes); printf("\n");
+        printf("pt =");puthex_py(pt , nbytes   ); printf("\n");
+        printf("ct =");puthex_py(ct , nbytes   ); printf("\n");
+        printf("ct1=");puthex_py(ct1, nbytes   ); printf("\n");
+        printf("pt2=");puthex_py(pt2, nbytes   ); printf("\n");
+
+        printf("ref_ct          = AES.new(key,AES.MODE_ECB).encrypt(pt    )\n");
+        printf("if( ref_ct     != ct or ref_ct != ct1 ):\n");
+        printf("    print(\"AES %d ECB %d-block Test %d encrypt failed.\")\n",
+            key_bits, (int)nblocks, i);
+        printf("    print( 'key == %%s' %% ( binascii.b2a_hex( key    )))\n");
+        printf("    print( 'pt  == %%s' %% ( binascii.b2a_hex( pt     )))\n");
+        printf("    print( 'ct  == %%s' %% ( binascii.b2a_hex( ct     )))\n");
+        printf("    print( '    != %%s' %% ( binascii.b2a_hex( ref_ct )))\n");
+        printf("    sys.exit(1)\n");
+        printf("elif( pt       != pt2       ):\n");
+        printf("    print(\"AES %d ECB %d-block Test %d decrypt failed.\")\n",
+            key_bits, (int)nblocks, i);
+        printf("    print( 'key == %%s' %% ( binascii.b2a_hex( key    )))\n");
+        printf("    print( 'ct  == %%s' %% ( binascii.b2a_hex( ct     )))\n");
+        printf("    print( 'pt  == %%s' %% ( binascii.b2a_hex( pt2    )))\n");
+        printf("    print( '    != %%s' %% ( binascii.b2a_hex( pt     )))\n");
+        printf("    sys.exit(1)\n");
+        printf("else:\n");
+        printf("    sys.stdout.write(\""STR(TEST_NAME)" AES %d ECB %d-block Test passed. \")\n",
+            key_bits, (int)nblocks);
+        printf("    sys.stdout.write(\"1x%d: %%d, \" %% (%lu))\n",
+            (int)nblocks, (unsigned long)one_icount);
+        printf("    sys.stdout.write(\"enc: %%d, \" %% (%lu))\n",
+            (unsigned long)enc_icount);
+        printf("    sys.stdout.write(\"dec: %%d, \" %% (%lu))\n",
+            (unsigned long)dec_icount);
+        printf("    print(\"\")\n");
+
+    }
+
+}
+
+
+int main(int argc, char ** argv) {
+
+    printf("import sys, binascii, Crypto.Cipher.AES as AES\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    test_aes_ecb_blocks(TEST_ECB_MAX_BLOCKS, 128, AES_128_KEY_BYTES,
+        aes_128_enc_key_schedule, aes_128_dec_key_schedule,
+        aes_128_ecb_encrypt, aes_128_ecb_encrypt_blocks,
+        aes_128_ecb_decrypt_blocks);
+
+    test_aes_ecb_blocks(TEST_ECB_MAX_BLOCKS, 192, AES_192_KEY_BYTES,
+        aes_192_enc_key_schedule, aes_192_dec_key_schedule,
+        aes_192_ecb_encrypt, aes_192_ecb_encrypt_blocks,
+        aes_192_ecb_decrypt_blocks);
+
+    test_aes_ecb_blocks(TEST_ECB_MAX_BLOCKS, 256, AES_256_KEY_BYTES,
+        aes_256_enc_key_schedule, aes_256_dec_key_schedule,
+        aes_256_ecb_encrypt, aes_256_ecb_encrypt_blocks,
+        aes_256_ecb_decrypt_blocks);
+
+    return 0;
+
+}
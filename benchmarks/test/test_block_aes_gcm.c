@@ -0,0 +1,162 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/aes/api_aes.h"
+#include "riscvcrypto/aes/api_aes_gcm.h"
+
+//! Longest message / AAD used by the tests.
+#define TEST_GCM_MAX_BYTES  (9 * AES_BLOCK_BYTES + 5)
+
+typedef void (*aes_gcm_init_t)(aes_gcm_ctx_t * ctx, uint8_t * ck,
+                               uint8_t * iv, size_t iv_len);
+
+//! Test parameters: IV, AAD and text lengths.
+typedef struct {
+    size_t iv_len;
+    size_t aad_len;
+    size_t txt_len;
+} test_gcm_case_t;
+
+static const test_gcm_case_t test_gcm_cases [] = {
+    {12,  0,   0},
+    {12,  0,  16},
+    {12, 16,  64},
+    {12, 20,  60},
+    {12, 13, TEST_GCM_MAX_BYTES},
+    {12, TEST_GCM_MAX_BYTES, 1},
+    { 8, 17,  33},
+    {16,  0,  80},
+    {60, 28, 100},
+};
+
+#define TEST_GCM_NUM_CASES \
+    (sizeof(test_gcm_cases) / sizeof(test_gcm_cases[0]))
+
+void test_aes_gcm(
+    int             key_bits,
+    size_t          key_bytes,
+    aes_gcm_init_t  init
+) {
+
+    aes_gcm_ctx_t ctx;
+
+    uint8_t  key [AES_256_KEY_BYTES ];
+    uint8_t  iv  [64                ];
+    uint8_t  aad [TEST_GCM_MAX_BYTES];
+    uint8_t  pt  [TEST_GCM_MAX_BYTES];
+    uint8_t  ct  [TEST_GCM_MAX_BYTES];
+    uint8_t  pt2 [TEST_GCM_MAX_BYTES];
+    uint8_t  tag [AES_GCM_TAG_BYTES ];
+    uint8_t  tag2[AES_GCM_TAG_BYTES ];
+    uint64_t start_instrs;
+
+    for(size_t i = 0; i < TEST_GCM_NUM_CASES; i ++) {
+
+        size_t iv_len  = test_gcm_cases[i].iv_len;
+        size_t aad_len = test_gcm_cases[i].aad_len;
+        size_t txt_len = test_gcm_cases[i].txt_len;
+
+        test_rdrandom(key, key_bytes);
+        test_rdrandom(iv , iv_len   );
+        test_rdrandom(aad, aad_len  );
+        test_rdrandom(pt , txt_len  );
+
+        // Encrypt in one go.
+        start_instrs        = test_rdinstret();
+        init(&ctx, key, iv, iv_len);
+        aes_gcm_aad           (&ctx, aad, aad_len);
+        aes_gcm_encrypt_update(&ctx, ct , pt , txt_len);
+        aes_gcm_final         (&ctx, tag);
+        uint64_t enc_icount = test_rdinstret() - start_instrs;
+
+        // Decrypt in uneven pieces, to exercise the partial block paths.
+        size_t a_split = aad_len / 3;
+        size_t t_split = txt_len / 3;
+        init(&ctx, key, iv, iv_len);
+        aes_gcm_aad           (&ctx, aad          , a_split          );
+        aes_gcm_aad           (&ctx, aad + a_split, aad_len - a_split);
+        aes_gcm_decrypt_update(&ctx, pt2          , ct     , t_split );
+        aes_gcm_decrypt_update(&ctx, pt2 + t_split, ct + t_split,
+                               txt_len - t_split);
+        aes_gcm_final         (&ctx, tag2);
+
+        // Verify full and truncated tags. Tags shorter than
+        // AES_GCM_TAG_MIN_BYTES must be rejected, even when they match.
+        int verify_ok = 0;
+        int verify_short = 1;
+        size_t verify_lens [] = {0, 4, 8, 11, 12, 15, 16};
+        for(size_t j = 0; j < sizeof(verify_lens)/sizeof(size_t); j ++) {
+            size_t len = verify_lens[j];
+            init(&ctx, key, iv, iv_len);
+            aes_gcm_aad           (&ctx, aad, aad_len);
+            aes_gcm_decrypt_update(&ctx, pt2, ct , txt_len);
+            int r = aes_gcm_final_verify(&ctx, tag, len);
+            if(len < AES_GCM_TAG_MIN_BYTES) {
+                verify_short &= r != 0;
+            } else {
+                verify_ok    |= r;
+            }
+        }
+
+        printf("#\n# AES %d GCM test %d\n", key_bits, (int)i);
+
+        printf("key =");puthex_py(key , key_bytes        ); printf("\n");
+        printf("iv  =");puthex_py(iv  , iv_len           ); printf("\n");
+        printf("aad =");puthex_py(aad , aad_len          ); printf("\n");
+        printf("pt  =");puthex_py(pt  , txt_len          ); printf("\n");
+        printf("ct  =");puthex_py(ct  , txt_len          ); printf("\n");
+        printf("pt2 =");puthex_py(pt2 , txt_len          ); printf("\n");
+        printf("tag =");puthex_py(tag , AES_GCM_TAG_BYTES); printf("\n");
+        printf("tag2=");puthex_py(tag2, AES_GCM_TAG_BYTES); printf("\n");
+
+        printf("ref = AES.new(key, AES.MODE_GCM, nonce=iv)\n");
+        printf("ref.update(aad)\n");
+        printf("ref_ct, ref_tag = ref.encrypt_and_digest(pt)\n");
+        printf("if( ref_ct != ct or ref_tag != tag ):\n");
+        printf("    print(\"AES %d GCM Test %d encrypt failed.\")\n",
+            key_bits, (int)i);
+        printf("    print( 'ct  == %%s' %% ( binascii.b2a_hex( ct      )))\n");
+        printf("    print( '    != %%s' %% ( binascii.b2a_hex( ref_ct  )))\n");
+        printf("    print( 'tag == %%s' %% ( binascii.b2a_hex( tag     )))\n");
+        printf("    print( '    != %%s' %% ( binascii.b2a_hex( ref_tag )))\n");
+        printf("    sys.exit(1)\n");
+        printf("elif( pt != pt2 or tag != tag2 ):\n");
+        printf("    print(\"AES %d GCM Test %d decrypt failed.\")\n",
+            key_bits, (int)i);
+        printf("    print( 'pt  == %%s' %% ( binascii.b2a_hex( pt2     )))\n");
+        printf("    print( '    != %%s' %% ( binascii.b2a_hex( pt      )))\n");
+        printf("    print( 'tag == %%s' %% ( binascii.b2a_hex( tag2    )))\n");
+        printf("    print( '    != %%s' %% ( binascii.b2a_hex( tag     )))\n");
+        printf("    sys.exit(1)\n");
+        printf("elif( %d != 0 or %d == 0 ):\n", verify_ok, verify_short);
+        printf("    print(\"AES %d GCM Test %d tag verify failed.\")\n",
+            key_bits, (int)i);
+        printf("    sys.exit(1)\n");
+        printf("else:\n");
+        printf("    sys.stdout.write(\""STR(TEST_NAME)" AES %d GCM Test passed. "
+               "iv=%2d, aad=%3d, txt=%3d \")\n",
+            key_bits, (int)iv_len, (int)aad_len, (int)txt_len);
+        printf("    sys.stdout.write(\"icount: %%d\" %% (%lu))\n",
+            (unsigned long)enc_icount);
+        printf("    print(\"\")\n");
+
+    }
+
+}
+
+
+int main(int argc, char ** argv) {
+
+    printf("import sys, binascii, Crypto.Cipher.AES as AES\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    test_aes_gcm(128, AES_128_KEY_BYTES, aes_128_gcm_init);
+    test_aes_gcm(192, AES_192_KEY_BYTES, aes_192_gcm_init);
+    test_aes_gcm(256, AES_256_KEY_BYTES, aes_256_gcm_init);
+
+    return 0;
+
+}
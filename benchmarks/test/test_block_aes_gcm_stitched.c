@@ -0,0 +1,159 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/aes/api_aes.h"
+#include "riscvcrypto/aes/api_aes_gcm.h"
+
+//! Longest message / AAD used by the tests.
+#define TEST_GCM_MAX_BYTES  (9 * AES_BLOCK_BYTES + 5)
+
+typedef void (*aes_gcm_init_t)(aes_gcm_ctx_t * ctx, uint8_t * ck,
+                               uint8_t * iv, size_t iv_len);
+
+//! Test parameters: IV, AAD and text lengths.
+typedef struct {
+    size_t iv_len;
+    size_t aad_len;
+    size_t txt_len;
+} test_gcm_case_t;
+
+static const test_gcm_case_t test_gcm_cases [] = {
+    {12,  0,   0},
+    {12,  0,  32},
+    {12, 16,  48},
+    {12, 20,  60},
+    {12, 13, TEST_GCM_MAX_BYTES},
+    { 8, 17,  33},
+    {60, 28, 100},
+};
+
+#define TEST_GCM_NUM_CASES \
+    (sizeof(test_gcm_cases) / sizeof(test_gcm_cases[0]))
+
+/*!
+@brief Check the stitched update functions against pycryptodome, and
+    against the unstitched ones.
+@details Decryption is done in place and in uneven pieces, then checked
+    with aes_gcm_final_verify, which must also reject a corrupted tag.
+*/
+void test_aes_gcm_stitched(
+    int             key_bits,
+    size_t          key_bytes,
+    aes_gcm_init_t  init
+) {
+
+    aes_gcm_ctx_t ctx;
+
+    uint8_t  key [AES_256_KEY_BYTES ];
+    uint8_t  iv  [64                ];
+    uint8_t  aad [TEST_GCM_MAX_BYTES];
+    uint8_t  pt  [TEST_GCM_MAX_BYTES];
+    uint8_t  ct  [TEST_GCM_MAX_BYTES];
+    uint8_t  ct2 [TEST_GCM_MAX_BYTES];
+    uint8_t  pt2 [TEST_GCM_MAX_BYTES];
+    uint8_t  tag [AES_GCM_TAG_BYTES ];
+    uint8_t  tag2[AES_GCM_TAG_BYTES ];
+    uint64_t start_instrs;
+
+    for(size_t i = 0; i < TEST_GCM_NUM_CASES; i ++) {
+
+        size_t iv_len  = test_gcm_cases[i].iv_len;
+        size_t aad_len = test_gcm_cases[i].aad_len;
+        size_t txt_len = test_gcm_cases[i].txt_len;
+
+        test_rdrandom(key, key_bytes);
+        test_rdrandom(iv , iv_len   );
+        test_rdrandom(aad, aad_len  );
+        test_rdrandom(pt , txt_len  );
+
+        // Stitched encrypt in one go.
+        start_instrs        = test_rdinstret();
+        init(&ctx, key, iv, iv_len);
+        aes_gcm_aad                    (&ctx, aad, aad_len);
+        aes_gcm_encrypt_update_stitched(&ctx, ct , pt , txt_len);
+        aes_gcm_final                  (&ctx, tag);
+        uint64_t enc_icount = test_rdinstret() - start_instrs;
+
+        // Unstitched encrypt, which must give the same result.
+        init(&ctx, key, iv, iv_len);
+        aes_gcm_aad           (&ctx, aad, aad_len);
+        aes_gcm_encrypt_update(&ctx, ct2, pt , txt_len);
+        aes_gcm_final         (&ctx, tag2);
+
+        int same = memcmp(ct, ct2, txt_len) == 0 &&
+                   memcmp(tag, tag2, AES_GCM_TAG_BYTES) == 0;
+
+        // Stitched decrypt in place, in uneven pieces, and verify.
+        size_t t_split = txt_len / 3;
+        memcpy(pt2, ct, txt_len);
+        init(&ctx, key, iv, iv_len);
+        aes_gcm_aad                    (&ctx, aad, aad_len);
+        aes_gcm_decrypt_update_stitched(&ctx, pt2, pt2, t_split);
+        aes_gcm_decrypt_update_stitched(&ctx, pt2 + t_split, pt2 + t_split,
+                                        txt_len - t_split);
+        int verify_ok = aes_gcm_final_verify(&ctx, tag, AES_GCM_TAG_BYTES);
+
+        // Corrupt the tag: verification must fail.
+        memcpy(tag2, tag, AES_GCM_TAG_BYTES);
+        tag2[i % AES_GCM_TAG_BYTES] ^= 0x01;
+        init(&ctx, key, iv, iv_len);
+        aes_gcm_aad                    (&ctx, aad, aad_len);
+        aes_gcm_decrypt_update_stitched(&ctx, ct2, ct, txt_len);
+        int verify_bad = aes_gcm_final_verify(&ctx, tag2, AES_GCM_TAG_BYTES);
+
+        printf("#\n# AES %d GCM stitched test %d\n", key_bits, (int)i);
+
+        printf("key =");puthex_py(key , key_bytes        ); printf("\n");
+        printf("iv  =");puthex_py(iv  , iv_len           ); printf("\n");
+        printf("aad =");puthex_py(aad , aad_len          ); printf("\n");
+        printf("pt  =");puthex_py(pt  , txt_len          ); printf("\n");
+        printf("ct  =");puthex_py(ct  , txt_len          ); printf("\n");
+        printf("pt2 =");puthex_py(pt2 , txt_len          ); printf("\n");
+        printf("tag =");puthex_py(tag , AES_GCM_TAG_BYTES); printf("\n");
+
+        printf("ref = AES.new(key, AES.MODE_GCM, nonce=iv)\n");
+        printf("ref.update(aad)\n");
+        printf("ref_ct, ref_tag = ref.encrypt_and_digest(pt)\n");
+        printf("if( ref_ct != ct or ref_tag != tag or not %d ):\n", same);
+        printf("    print(\"AES %d GCM stitched Test %d encrypt failed.\")\n",
+            key_bits, (int)i);
+        printf("    print( 'ct  == %%s' %% ( binascii.b2a_hex( ct      )))\n");
+        printf("    print( '    != %%s' %% ( binascii.b2a_hex( ref_ct  )))\n");
+        printf("    print( 'tag == %%s' %% ( binascii.b2a_hex( tag     )))\n");
+        printf("    print( '    != %%s' %% ( binascii.b2a_hex( ref_tag )))\n");
+        printf("    sys.exit(1)\n");
+        printf("elif( pt != pt2 or %d != 0 or %d == 0 ):\n",
+            verify_ok, verify_bad);
+        printf("    print(\"AES %d GCM stitched Test %d decrypt failed.\")\n",
+            key_bits, (int)i);
+        printf("    print( 'pt  == %%s' %% ( binascii.b2a_hex( pt2     )))\n");
+        printf("    print( '    != %%s' %% ( binascii.b2a_hex( pt      )))\n");
+        printf("    sys.exit(1)\n");
+        printf("else:\n");
+        printf("    sys.stdout.write(\""STR(TEST_NAME)" AES %d GCM stitched "
+               "Test passed. iv=%2d, aad=%3d, txt=%3d \")\n",
+            key_bits, (int)iv_len, (int)aad_len, (int)txt_len);
+        printf("    sys.stdout.write(\"icount: %%d\" %% (%lu))\n",
+            (unsigned long)enc_icount);
+        printf("    print(\"\")\n");
+
+    }
+
+}
+
+
+int main(int argc, char ** argv) {
+
+    printf("import sys, binascii, Crypto.Cipher.AES as AES\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    test_aes_gcm_stitched(128, AES_128_KEY_BYTES, aes_128_gcm_init);
+    test_aes_gcm_stitched(192, AES_192_KEY_BYTES, aes_192_gcm_init);
+    test_aes_gcm_stitched(256, AES_256_KEY_BYTES, aes_256_gcm_init);
+
+    return 0;
+
+}
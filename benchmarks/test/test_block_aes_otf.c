@@ -0,0 +1,120 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/aes/api_aes.h"
+
+//! Number of random keys / blocks tried per key size.
+#define TEST_OTF_COUNT 10
+
+typedef void (*aes_ks_t     )(uint32_t * const rk, uint8_t * const ck);
+typedef void (*aes_ecb_t    )(uint8_t * out, uint8_t * in, uint32_t * rk);
+typedef void (*aes_otf_t    )(uint8_t * out, uint8_t * in, uint8_t  * ck);
+typedef void (*aes_otf_dk_t )(uint8_t * dk , uint8_t * ck);
+
+void test_aes_otf(
+    int           num_tests,
+    int           key_bits,
+    size_t        key_bytes,
+    aes_ks_t      enc_ks,
+    aes_ecb_t     enc,
+    aes_otf_t     enc_otf,
+    aes_otf_dk_t  dec_key,
+    aes_otf_t     dec_otf
+) {
+
+    uint8_t  key [AES_256_KEY_BYTES];
+    uint8_t  dk  [AES_256_KEY_BYTES];
+    uint32_t erk [AES_256_RK_WORDS ];
+    uint8_t  pt  [AES_BLOCK_BYTES  ];
+    uint8_t  ct  [AES_BLOCK_BYTES  ];
+    uint8_t  ct1 [AES_BLOCK_BYTES  ];
+    uint8_t  pt2 [AES_BLOCK_BYTES  ];
+    uint64_t start_instrs;
+
+    for(int i = 0; i < num_tests; i ++) {
+
+        test_rdrandom(key, key_bytes);
+        test_rdrandom(pt , AES_BLOCK_BYTES);
+
+        enc_ks(erk, key);
+        enc(ct1, pt, erk);
+
+        start_instrs        = test_rdinstret();
+        enc_otf(ct, pt, key);
+        uint64_t enc_icount = test_rdinstret() - start_instrs;
+
+        start_instrs        = test_rdinstret();
+        dec_key(dk, key);
+        uint64_t dk_icount  = test_rdinstret() - start_instrs;
+
+        start_instrs        = test_rdinstret();
+        dec_otf(pt2, ct, dk);
+        uint64_t dec_icount = test_rdinstret() - start_instrs;
+
+        printf("#\n# AES %d on-the-fly test %d/%d\n",key_bits,i,num_tests);
+
+        printf("key=");puthex_py(key, key_bytes      ); printf("\n");
+        printf("pt =");puthex_py(pt , AES_BLOCK_BYTES); printf("\n");
+        printf("ct =");puthex_py(ct , AES_BLOCK_BYTES); printf("\n");
+        printf("ct1=");puthex_py(ct1, AES_BLOCK_BYTES); printf("\n");
+        printf("pt2=");puthex_py(pt2, AES_BLOCK_BYTES); printf("\n");
+
+        printf("ref_ct          = AES.new(key,AES.MODE_ECB).encrypt(pt    )\n");
+        printf("if( ref_ct     != ct or ref_ct != ct1 ):\n");
+        printf("    print(\"AES %d on-the-fly Test %d encrypt failed.\")\n",
+            key_bits, i);
+        printf("    print( 'key == %%s' %% ( binascii.b2a_hex( key    )))\n");
+        printf("    print( 'pt  == %%s' %% ( binascii.b2a_hex( pt     )))\n");
+        printf("    print( 'ct  == %%s' %% ( binascii.b2a_hex( ct     )))\n");
+        printf("    print( '    != %%s' %% ( binascii.b2a_hex( ref_ct )))\n");
+        printf("    sys.exit(1)\n");
+        printf("elif( pt       != pt2       ):\n");
+        printf("    print(\"AES %d on-the-fly Test %d decrypt failed.\")\n",
+            key_bits, i);
+        printf("    print( 'key == %%s' %% ( binascii.b2a_hex( key    )))\n");
+        printf("    print( 'ct  == %%s' %% ( binascii.b2a_hex( ct     )))\n");
+        printf("    print( 'pt  == %%s' %% ( binascii.b2a_hex( pt2    )))\n");
+        printf("    print( '    != %%s' %% ( binascii.b2a_hex( pt     )))\n");
+        printf("    sys.exit(1)\n");
+        printf("else:\n");
+        printf("    sys.stdout.write(\""STR(TEST_NAME)" AES %d on-the-fly Test passed. \")\n",
+            key_bits);
+        printf("    sys.stdout.write(\"enc: %%d, \" %% (%lu))\n",
+            (unsigned long)enc_icount);
+        printf("    sys.stdout.write(\"dk: %%d, \" %% (%lu))\n",
+            (unsigned long)dk_icount);
+        printf("    sys.stdout.write(\"dec: %%d, \" %% (%lu))\n",
+            (unsigned long)dec_icount);
+        printf("    print(\"\")\n");
+
+    }
+
+}
+
+
+int main(int argc, char ** argv) {
+
+    printf("import sys, binascii, Crypto.Cipher.AES as AES\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    test_aes_otf(TEST_OTF_COUNT, 128, AES_128_KEY_BYTES,
+        aes_128_enc_key_schedule, aes_128_ecb_encrypt,
+        aes_128_ecb_encrypt_otf , aes_128_otf_dec_key,
+        aes_128_ecb_decrypt_otf );
+
+    test_aes_otf(TEST_OTF_COUNT, 192, AES_192_KEY_BYTES,
+        aes_192_enc_key_schedule, aes_192_ecb_encrypt,
+        aes_192_ecb_encrypt_otf , aes_192_otf_dec_key,
+        aes_192_ecb_decrypt_otf );
+
+    test_aes_otf(TEST_OTF_COUNT, 256, AES_256_KEY_BYTES,
+        aes_256_enc_key_schedule, aes_256_ecb_encrypt,
+        aes_256_ecb_encrypt_otf , aes_256_otf_dec_key,
+        aes_256_ecb_decrypt_otf );
+
+    return 0;
+
+}
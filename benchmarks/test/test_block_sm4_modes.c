@@ -0,0 +1,217 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/sm4/api_sm4.h"
+
+//! Longest message passed to a single mode call. Spans two groups.
+#define TEST_SM4_MAX_BYTES  (35 * SM4_BLOCK_BYTES + 7)
+
+//! Message lengths to test. Covers partial, whole and odd block counts.
+static const size_t test_sm4_lengths [] = {
+    0, 1, 15, 16, 17, 31, 32, 33, 48, 63, 64, 65, 100, 128,
+    255, 256, 257, 400, TEST_SM4_MAX_BYTES
+};
+
+#define TEST_SM4_NUM_LENGTHS \
+    (sizeof(test_sm4_lengths) / sizeof(test_sm4_lengths[0]))
+
+//! Print a Python check that VAL equals the model value REF.
+static void test_sm4_check(const char * what, const char * val,
+                           const char * ref, size_t len, int i) {
+    printf("if( %s != %s ):\n", val, ref);
+    printf("    print(\"SM4 %s %d-byte Test %d failed.\")\n",
+        what, (int)len, i);
+    printf("    print( 'key == %%s' %% ( binascii.b2a_hex( key  )))\n");
+    printf("    print( 'got == %%s' %% ( binascii.b2a_hex( %s )))\n", val);
+    printf("    print( '    != %%s' %% ( binascii.b2a_hex( %s )))\n", ref);
+    printf("    sys.exit(1)\n");
+}
+
+//! Print the SM4 and mode models which the results are checked against.
+static void test_sm4_print_model() {
+    printf("S = bytes.fromhex(\n");
+    printf(" 'd690e9fecce13db716b614c228fb2c052b679a762abe04c3aa44132649860699'\n");
+    printf(" '9c4250f491ef987a33540b43edcfac62e4b31ca9c908e89580df94fa758f3fa6'\n");
+    printf(" '4707a7fcf37317ba83593c19e6854fa8686b81b27164da8bf8eb0f4b70569d35'\n");
+    printf(" '1e240e5e6358d1a225227c3b01217887d40046579fd327524c3602e7a0c4c89e'\n");
+    printf(" 'eabf8ad240c738b5a3f7f2cef96115a1e0ae5da49b341a55ad933230f58cb1e3'\n");
+    printf(" '1df6e22e8266ca60c02923ab0d534e6fd5db3745defd8e2f03ff6a726d6c5b51'\n");
+    printf(" '8d1baf92bbddbc7f11d95c411f105ad80ac13188a5cd7bbd2d74d012b8e5b4b0'\n");
+    printf(" '8969974a0c96777e65b9f109c56ec68418f07dec3adc4d2079ee5f3ed7cb3948')\n");
+    printf("def rol(x, n): return ((x << n) | (x >> (32 - n))) & 0xFFFFFFFF\n");
+    printf("def tau(x): return int.from_bytes(bytes(S[b] for b in x.to_bytes(4, 'big')), 'big')\n");
+    printf("def sm4(k, b):\n");
+    printf("    K = [int.from_bytes(k[4*i:4*i+4], 'big') ^ f for i, f in enumerate([0xA3B1BAC6, 0x56AA3350, 0x677D9197, 0xB27022DC])]\n");
+    printf("    for i in range(32):\n");
+    printf("        ck = int.from_bytes(bytes(((4*i+j)*7) & 0xFF for j in range(4)), 'big')\n");
+    printf("        t = tau(K[-3] ^ K[-2] ^ K[-1] ^ ck)\n");
+    printf("        K.append(K[-4] ^ t ^ rol(t, 13) ^ rol(t, 23))\n");
+    printf("    X = [int.from_bytes(b[4*i:4*i+4], 'big') for i in range(4)]\n");
+    printf("    for r in K[4:]:\n");
+    printf("        t = tau(X[-3] ^ X[-2] ^ X[-1] ^ r)\n");
+    printf("        X.append(X[-4] ^ t ^ rol(t, 2) ^ rol(t, 10) ^ rol(t, 18) ^ rol(t, 24))\n");
+    printf("    return b''.join(x.to_bytes(4, 'big') for x in X[:-5:-1])\n");
+    printf("def xor(a, b): return bytes(x ^ y for x, y in zip(a, b))\n");
+    printf("if sm4(bytes.fromhex('0123456789abcdeffedcba9876543210'), bytes.fromhex('0123456789abcdeffedcba9876543210')) != bytes.fromhex('681edf34d206965e86b3e94f536e4246'):\n");
+    printf("    print('SM4 model failed its known answer test.')\n");
+    printf("    sys.exit(1)\n");
+    printf("def ref_ecb(key, pt):\n");
+    printf("    return b''.join(sm4(key, pt[i:i+16]) for i in range(0, len(pt), 16))\n");
+    printf("def ref_cbc(key, iv, pt):\n");
+    printf("    ct = b''\n");
+    printf("    for i in range(0, len(pt), 16):\n");
+    printf("        iv  = sm4(key, xor(pt[i:i+16], iv))\n");
+    printf("        ct += iv\n");
+    printf("    return ct, iv\n");
+    printf("def ref_ctr(key, ctr, pt):\n");
+    printf("    c  = int.from_bytes(ctr, 'big')\n");
+    printf("    ks = b''\n");
+    printf("    for i in range(0, len(pt), 16):\n");
+    printf("        ks += sm4(key, c.to_bytes(16, 'big'))\n");
+    printf("        c   = (c + 1) %% (1 << 128)\n");
+    printf("    return xor(pt, ks), c.to_bytes(16, 'big')\n");
+    printf("def ref_xts(key1, key2, iv, pt):\n");
+    printf("    t  = int.from_bytes(sm4(key2, iv), 'little')\n");
+    printf("    tw = []\n");
+    printf("    for i in range(0, len(pt) + 16, 16):\n");
+    printf("        tw.append(t.to_bytes(16, 'little'))\n");
+    printf("        t = ((t << 1) ^ (0x87 if t >> 127 else 0)) & ((1 << 128) - 1)\n");
+    printf("    e  = lambda j, b: xor(sm4(key1, xor(b, tw[j])), tw[j])\n");
+    printf("    m  = len(pt) // 16\n");
+    printf("    r  = len(pt) %% 16\n");
+    printf("    ct = b''.join(e(j, pt[16*j:16*j+16]) for j in range(m))\n");
+    printf("    if r:\n");
+    printf("        cc = ct[-16:]\n");
+    printf("        ct = ct[:-16] + e(m, pt[16*m:] + cc[r:]) + cc[:r]\n");
+    printf("    return ct\n");
+}
+
+int main(int argc, char ** argv) {
+
+    printf("import sys, binascii\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    test_sm4_print_model();
+
+    uint8_t  key  [SM4_KEY_BYTES  ];
+    uint8_t  key2 [SM4_KEY_BYTES  ];
+    uint32_t erk  [SM4_RK_WORDS   ];
+    uint32_t drk  [SM4_RK_WORDS   ];
+    uint32_t erk2 [SM4_RK_WORDS   ];
+    uint8_t  iv   [SM4_BLOCK_BYTES];
+    uint8_t  nxt  [SM4_BLOCK_BYTES];
+    uint8_t  nxt2 [SM4_BLOCK_BYTES];
+
+    // Word arrays, since sm4_ecb_blocks needs 4-byte aligned buffers.
+    // One spare byte, so the misaligned cipher text stays in bounds.
+    uint32_t ptw  [TEST_SM4_MAX_BYTES / 4 + 1];
+    uint32_t ctw  [TEST_SM4_MAX_BYTES / 4 + 1];
+    uint32_t pt2w [TEST_SM4_MAX_BYTES / 4 + 1];
+    uint8_t  * pt  = (uint8_t*)ptw ;
+    uint8_t  * ct  = (uint8_t*)ctw ;
+    uint8_t  * pt2 = (uint8_t*)pt2w;
+
+    for(size_t i = 0; i < TEST_SM4_NUM_LENGTHS; i ++) {
+
+        size_t    len    = test_sm4_lengths[i];
+        size_t    blen   = len & ~(SM4_BLOCK_BYTES - 1);
+        size_t    split  = (blen / 2) & ~(SM4_BLOCK_BYTES - 1);
+
+        // Misalign the cipher text on odd tests.
+        uint8_t * c      = ct + (i & 1);
+
+        test_rdrandom(key , SM4_KEY_BYTES  );
+        test_rdrandom(key2, SM4_KEY_BYTES  );
+        test_rdrandom(iv  , SM4_BLOCK_BYTES);
+        test_rdrandom(pt  , len            );
+
+        if(i & 1) {
+            // Force a carry out of the low 64 bits of the counter.
+            memset(iv + 8 , 0xFF, 8);
+        }
+
+        sm4_key_schedule_enc(erk , key );
+        sm4_key_schedule_dec(drk , key );
+        sm4_key_schedule_enc(erk2, key2);
+
+        printf("#\n# SM4 modes %d-byte test %d\n", (int)len, (int)i);
+        printf("key  =");puthex_py(key , SM4_KEY_BYTES  ); printf("\n");
+        printf("key2 =");puthex_py(key2, SM4_KEY_BYTES  ); printf("\n");
+        printf("iv   =");puthex_py(iv  , SM4_BLOCK_BYTES); printf("\n");
+        printf("pt   =");puthex_py(pt  , len            ); printf("\n");
+        printf("bpt  = pt[:%d]\n", (int)blen);
+
+        // ECB over the whole blocks, straight through sm4_ecb_blocks.
+        sm4_ecb_blocks(ct, pt, erk, blen / SM4_BLOCK_BYTES);
+        printf("ct   =");puthex_py(ct, blen); printf("\n");
+        sm4_ecb_blocks(ct, ct, drk, blen / SM4_BLOCK_BYTES);
+        printf("pt2  =");puthex_py(ct, blen); printf("\n");
+        printf("ref_ct = ref_ecb(key, bpt)\n");
+        test_sm4_check("ECB encrypt", "ct" , "ref_ct", len, i);
+        test_sm4_check("ECB decrypt", "pt2", "bpt"   , len, i);
+
+        // CBC over the whole blocks. Decrypt in place, in two calls.
+        memcpy(nxt, iv, SM4_BLOCK_BYTES);
+        if(sm4_cbc_encrypt(c, pt, erk, blen, nxt)) {
+            printf("print('sm4_cbc_encrypt failed')\nsys.exit(1)\n");
+        }
+        printf("ct   =");puthex_py(c  , blen           ); printf("\n");
+        printf("nxt  =");puthex_py(nxt, SM4_BLOCK_BYTES); printf("\n");
+        memcpy(nxt2, iv, SM4_BLOCK_BYTES);
+        sm4_cbc_decrypt(c        , c        , drk, split       , nxt2);
+        sm4_cbc_decrypt(c + split, c + split, drk, blen - split, nxt2);
+        printf("pt2  =");puthex_py(c   , blen           ); printf("\n");
+        printf("nxt2 =");puthex_py(nxt2, SM4_BLOCK_BYTES); printf("\n");
+        printf("ref_ct, ref_nxt = ref_cbc(key, iv, bpt)\n");
+        test_sm4_check("CBC encrypt", "ct"  , "ref_ct" , len, i);
+        test_sm4_check("CBC iv"     , "nxt" , "ref_nxt", len, i);
+        test_sm4_check("CBC decrypt", "pt2" , "bpt"    , len, i);
+        test_sm4_check("CBC dec iv" , "nxt2", "ref_nxt", len, i);
+
+        if(len % SM4_BLOCK_BYTES && sm4_cbc_encrypt(c, pt, erk, len, nxt) == 0) {
+            printf("print('sm4_cbc_encrypt accepted a partial block')\n");
+            printf("sys.exit(1)\n");
+        }
+
+        // CTR, decrypting in two calls to check the counter carries over.
+        memcpy(nxt, iv, SM4_BLOCK_BYTES);
+        sm4_ctr_xcrypt(c, pt, erk, len, nxt);
+        memcpy(nxt2, iv, SM4_BLOCK_BYTES);
+        sm4_ctr_xcrypt(pt2        , c        , erk, split      , nxt2);
+        sm4_ctr_xcrypt(pt2 + split, c + split, erk, len - split, nxt2);
+        printf("ct   =");puthex_py(c   , len            ); printf("\n");
+        printf("nxt  =");puthex_py(nxt , SM4_BLOCK_BYTES); printf("\n");
+        printf("pt2  =");puthex_py(pt2 , len            ); printf("\n");
+        printf("nxt2 =");puthex_py(nxt2, SM4_BLOCK_BYTES); printf("\n");
+        printf("ref_ct, ref_nxt = ref_ctr(key, iv, pt)\n");
+        test_sm4_check("CTR encrypt", "ct"  , "ref_ct" , len, i);
+        test_sm4_check("CTR counter", "nxt" , "ref_nxt", len, i);
+        test_sm4_check("CTR decrypt", "pt2" , "pt"     , len, i);
+        test_sm4_check("CTR dec ctr", "nxt2", "ref_nxt", len, i);
+
+        // XTS, which needs at least one block. Decrypt in place.
+        int xts_enc = sm4_xts_encrypt(c, pt, erk, erk2, len, iv);
+        if((xts_enc != 0) != (len < SM4_BLOCK_BYTES)) {
+            printf("print('sm4_xts_encrypt returned %d for %d bytes')\n",
+                xts_enc, (int)len);
+            printf("sys.exit(1)\n");
+        }
+        if(len >= SM4_BLOCK_BYTES) {
+            printf("ct   =");puthex_py(c, len); printf("\n");
+            sm4_xts_decrypt(c, c, drk, erk2, len, iv);
+            printf("pt2  =");puthex_py(c, len); printf("\n");
+            printf("ref_ct = ref_xts(key, key2, iv, pt)\n");
+            test_sm4_check("XTS encrypt", "ct" , "ref_ct", len, i);
+            test_sm4_check("XTS decrypt", "pt2", "pt"    , len, i);
+        }
+
+        printf("print(\""STR(TEST_NAME)" SM4 modes %d-byte Test passed.\")\n",
+            (int)len);
+    }
+
+    return 0;
+
+}
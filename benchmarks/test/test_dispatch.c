@@ -0,0 +1,231 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/aes/api_aes.h"
+#include "riscvcrypto/dispatch/api_dispatch.h"
+
+//! Length of the messages hashed for each binding.
+#define TEST_DISPATCH_MSG_BYTES 200
+
+//! Leaves given to k12_absorb_cvs, after the first chunk.
+#define TEST_DISPATCH_K12_LEAVES 2
+
+//! ParallelHash block size, and blocks given to parallelhash_absorb_cvs.
+#define TEST_DISPATCH_PH_B      48
+#define TEST_DISPATCH_PH_BLOCKS 3
+
+//! Long enough for one K12 chunk and TEST_DISPATCH_K12_LEAVES leaves.
+static uint8_t test_dispatch_long [
+    K12_CHUNK_BYTES * (TEST_DISPATCH_K12_LEAVES + 1)];
+
+//! SM4 known answer, from test_block_sm4.c
+static uint8_t sm4_mk [16] = {
+    0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF,
+    0xFE, 0xDC, 0xBA, 0x98, 0x76, 0x54, 0x32, 0x10
+};
+
+static uint8_t sm4_ct [16] = {
+    0x68, 0x1E, 0xDF, 0x34, 0xD2, 0x06, 0x96, 0x5E,
+    0x86, 0xB3, 0xE9, 0x4F, 0x53, 0x6E, 0x42, 0x46
+};
+
+/*!
+@brief Exercise every family through rvcrypto_dispatch, as bound for isa.
+*/
+void test_dispatch(const char * what, uint32_t isa) {
+
+    rvcrypto_dispatch_t * d = &rvcrypto_dispatch;
+
+    uint8_t  key [AES_256_KEY_BYTES];
+    uint32_t erk [AES_256_RK_WORDS ];
+    uint32_t drk [AES_256_RK_WORDS ];
+    uint32_t drk2[AES_256_RK_WORDS ];
+    uint8_t  pt  [AES_BLOCK_BYTES  ];
+    uint8_t  ct  [AES_BLOCK_BYTES  ];
+    uint8_t  pt2 [AES_BLOCK_BYTES  ];
+    uint8_t  msg [TEST_DISPATCH_MSG_BYTES];
+    uint32_t h256[8];
+    uint8_t  h224[SHA224_DIGEST_BYTES];
+    sha256_ctx_t ctx;
+    uint64_t h512[8];
+    uint8_t  h384[SHA384_DIGEST_BYTES];
+    sha512_ctx_t ctx512;
+    uint8_t  sha3[32];
+    uint8_t  xof [64];
+    uint8_t  sm3 [SM3_DIGEST_BYTES];
+    uint8_t  sm3s[SM3_DIGEST_BYTES];
+    sm3_ctx_t ctxsm3;
+    uint32_t srk [32];
+    uint8_t  sct [16];
+    uint8_t  spt [16];
+    uint8_t  k12 [32];
+    uint8_t  k12s[32];
+    uint8_t  k12c[TEST_DISPATCH_K12_LEAVES * K12_CV_BYTES];
+    k12_ctx_t ctxk12;
+    uint8_t  ph  [32];
+    uint8_t  phs [32];
+    uint8_t  phc [TEST_DISPATCH_PH_BLOCKS * 32];
+    parallelhash_ctx_t ctxph;
+    int      status = 0;
+
+    rvcrypto_dispatch_init(isa);
+
+    test_rdrandom(key, sizeof(key));
+    test_rdrandom(pt , sizeof(pt ));
+    test_rdrandom(msg, sizeof(msg));
+    test_rdrandom(test_dispatch_long, sizeof(test_dispatch_long));
+
+    d->aes_256_enc_key_schedule(erk, key);
+    d->aes_256_dec_key_schedule(drk, key);
+    d->aes_256_ecb_encrypt(ct , pt, erk);
+    d->aes_256_ecb_decrypt(pt2, ct, drk);
+    d->aes_256_dec_key_schedule_from_enc(drk2, erk);
+
+    d->sha256_hash(h256, msg, sizeof(msg));
+    d->sha224_init(&ctx);
+    d->sha256_update(&ctx, msg, 3);
+    d->sha256_update(&ctx, msg + 3, sizeof(msg) - 3);
+    d->sha256_final(&ctx, h224);
+    d->sha512_hash(h512, msg, sizeof(msg));
+    d->sha384_init(&ctx512);
+    d->sha512_update(&ctx512, msg, 5);
+    d->sha512_update(&ctx512, msg + 5, sizeof(msg) - 5);
+    d->sha512_final(&ctx512, h384);
+    d->FIPS202_SHA3_256(msg, sizeof(msg), sha3);
+    d->FIPS202_SHAKE128(msg, sizeof(msg), xof, sizeof(xof));
+    d->sm3_hash(sm3, msg, sizeof(msg));
+    d->sm3_init(&ctxsm3);
+    d->sm3_update(&ctxsm3, msg, 7);
+    d->sm3_update(&ctxsm3, msg + 7, sizeof(msg) - 7);
+    d->sm3_final(&ctxsm3, sm3s);
+
+    // The functions which return a status, each checked against the
+    // one-shot function of the same backend.
+    uint8_t * leaves = test_dispatch_long + K12_CHUNK_BYTES;
+    d->KangarooTwelve(test_dispatch_long, sizeof(test_dispatch_long),
+                      NULL, 0, k12, sizeof(k12));
+    d->k12_init(&ctxk12);
+    d->k12_absorb(&ctxk12, test_dispatch_long, K12_CHUNK_BYTES);
+    d->k12_leaf_cvs(leaves, TEST_DISPATCH_K12_LEAVES, k12c);
+    status |= d->k12_absorb_cvs(&ctxk12, k12c, TEST_DISPATCH_K12_LEAVES);
+    d->k12_finalize(&ctxk12, NULL, 0);
+    d->k12_squeeze(&ctxk12, k12s, sizeof(k12s));
+
+    size_t ph_whole = TEST_DISPATCH_PH_B * TEST_DISPATCH_PH_BLOCKS;
+    status |= d->ParallelHash128(msg, sizeof(msg), TEST_DISPATCH_PH_B,
+                                 NULL, 0, ph, sizeof(ph));
+    status |= d->parallelhash_init(&ctxph, KECCAK_RATE_SHAKE128,
+                                   TEST_DISPATCH_PH_B, NULL, 0);
+    d->parallelhash_block_cvs(KECCAK_RATE_SHAKE128, msg, TEST_DISPATCH_PH_B,
+                              TEST_DISPATCH_PH_BLOCKS, phc);
+    status |= d->parallelhash_absorb_cvs(&ctxph, phc, TEST_DISPATCH_PH_BLOCKS);
+    d->parallelhash_absorb(&ctxph, msg + ph_whole, sizeof(msg) - ph_whole);
+    d->parallelhash_finalize(&ctxph, sizeof(phs));
+    d->parallelhash_squeeze(&ctxph, phs, sizeof(phs));
+
+    // A block size of 0 must be refused.
+    int ph_bad = d->ParallelHash128(msg, sizeof(msg), 0, NULL, 0,
+                                    ph, sizeof(ph));
+
+    d->sm4_key_schedule_enc(srk, sm4_mk);
+    d->sm4_block_enc_dec(sct, sm4_mk, srk);
+    d->sm4_key_schedule_dec(srk, sm4_mk);
+    d->sm4_block_enc_dec(spt, sct, srk);
+
+    printf("#\n# Dispatch with %s extensions: isa = 0x%x\n", what, isa);
+    printf("print(\""STR(TEST_NAME)" %-9s isa=0x%02x: aes %s, sha256 %s, "
+           "sha512 %s, sha3 %s, sm3 %s, sm4 %s\")\n", what, isa,
+           d->aes_backend, d->sha256_backend, d->sha512_backend,
+           d->sha3_backend, d->sm3_backend, d->sm4_backend);
+
+    printf("key =");puthex_py(key , sizeof(key )); printf("\n");
+    printf("pt  =");puthex_py(pt  , sizeof(pt  )); printf("\n");
+    printf("ct  =");puthex_py(ct  , sizeof(ct  )); printf("\n");
+    printf("pt2 =");puthex_py(pt2 , sizeof(pt2 )); printf("\n");
+    printf("msg =");puthex_py(msg , sizeof(msg )); printf("\n");
+    printf("h256=");puthex_py((uint8_t*)h256, sizeof(h256)); printf("\n");
+    printf("h224=");puthex_py(h224, sizeof(h224)); printf("\n");
+    printf("h512=");puthex_py((uint8_t*)h512, sizeof(h512)); printf("\n");
+    printf("h384=");puthex_py(h384, sizeof(h384)); printf("\n");
+    printf("sha3=");puthex_py(sha3, sizeof(sha3)); printf("\n");
+    printf("xof =");puthex_py(xof , sizeof(xof )); printf("\n");
+    printf("sm3 =");puthex_py(sm3 , sizeof(sm3 )); printf("\n");
+    printf("sm3s=");puthex_py(sm3s, sizeof(sm3s)); printf("\n");
+    printf("k12 =");puthex_py(k12 , sizeof(k12 )); printf("\n");
+    printf("k12s=");puthex_py(k12s, sizeof(k12s)); printf("\n");
+    printf("ph  =");puthex_py(ph  , sizeof(ph  )); printf("\n");
+    printf("phs =");puthex_py(phs , sizeof(phs )); printf("\n");
+
+    printf("checks = [\n");
+    printf("  ('aes enc', AES.new(key,AES.MODE_ECB).encrypt(pt), ct),\n");
+    printf("  ('aes dec', pt, pt2),\n");
+    printf("  ('sha256' , hashlib.sha256(msg).digest(), h256),\n");
+    printf("  ('sha224' , hashlib.sha224(msg).digest(), h224),\n");
+    printf("  ('sha512' , hashlib.sha512(msg).digest(), h512),\n");
+    printf("  ('sha384' , hashlib.sha384(msg).digest(), h384),\n");
+    printf("  ('sha3'   , hashlib.sha3_256(msg).digest(), sha3),\n");
+    printf("  ('shake'  , hashlib.shake_128(msg).digest(%d), xof),\n",
+        (int)sizeof(xof));
+    printf("  ('sm3'    , hashlib.new('sm3', msg).digest(), sm3),\n");
+    printf("  ('sm3 ctx', sm3, sm3s),\n");
+    printf("  ('k12 cvs', k12, k12s),\n");
+    printf("  ('ph cvs' , ph, phs),\n");
+    printf("]\n");
+    printf("for name, ref, got in checks:\n");
+    printf("    if ref != got:\n");
+    printf("        print(\"Dispatch %s %%s failed.\" %% name)\n", what);
+    printf("        print('    %%s' %% binascii.b2a_hex(got))\n");
+    printf("        print(' != %%s' %% binascii.b2a_hex(ref))\n");
+    printf("        sys.exit(1)\n");
+
+    if(memcmp(drk, drk2, sizeof(drk))) {
+        printf("print(\"Dispatch %s aes dec key schedule from enc failed.\")\n",
+            what);
+        printf("sys.exit(1)\n");
+    }
+
+    if(status != 0 || ph_bad == 0) {
+        printf("print(\"Dispatch %s status returns failed.\")\n", what);
+        printf("sys.exit(1)\n");
+    }
+
+    if(memcmp(sct, sm4_ct, 16) || memcmp(spt, sm4_mk, 16)) {
+        printf("print(\"Dispatch %s sm4 failed.\")\n", what);
+        printf("sys.exit(1)\n");
+    }
+}
+
+int main(int argc, char ** argv) {
+
+    printf("import sys, binascii, hashlib, Crypto.Cipher.AES as AES\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    // The first call binds the table through its stub, which must pass
+    // the result back: ParallelHash refuses a block size of 0.
+    uint8_t  msg [3] = {'a', 'b', 'c'};
+    uint32_t h   [8];
+    uint8_t  out [32];
+    if(!rvcrypto_dispatch.ParallelHash128(msg, sizeof(msg), 0, NULL, 0,
+                                          out, sizeof(out))) {
+        printf("print(\"Dispatch first-use stub lost the result.\")\n");
+        printf("sys.exit(1)\n");
+    }
+    rvcrypto_dispatch.sha256_hash(h, msg, sizeof(msg));
+    printf("if hashlib.sha256(b'abc').digest() != ");
+    puthex_py((uint8_t*)h, sizeof(h)); printf(":\n");
+    printf("    print(\"Dispatch first-use stub failed.\")\n");
+    printf("    sys.exit(1)\n");
+
+    uint32_t isa = rvcrypto_isa();
+
+    test_dispatch("no"      , 0  );
+    test_dispatch("detected", isa);
+
+    printf("print(\""STR(TEST_NAME)" Test passed.\")\n");
+
+    return 0;
+
+}
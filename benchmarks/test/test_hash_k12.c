@@ -0,0 +1,137 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/sha3/k12.h"
+
+//! Largest chunk passed to a single k12_absorb call. Above one leaf.
+#define TEST_K12_MAX_CHUNK  (3 * K12_CHUNK_BYTES / 2)
+
+//! Bytes of output read from each function.
+#define TEST_K12_OUT_BYTES  200
+
+/*!
+@brief Message lengths tested. Around the first chunk and leaf edges,
+    and long enough for a run of four leaves plus a remainder.
+*/
+static const size_t test_k12_lengths [] = {
+    0, 1, 167, 168, 169, 1000,
+    K12_CHUNK_BYTES - 1, K12_CHUNK_BYTES, K12_CHUNK_BYTES + 1,
+    2 * K12_CHUNK_BYTES, 3 * K12_CHUNK_BYTES + 100,
+    6 * K12_CHUNK_BYTES, 8 * K12_CHUNK_BYTES + 4097
+};
+
+//! Customization string lengths tested.
+static const size_t test_k12_custom [] = {0, 1, 41, 300};
+
+//! Randomly sized chunk length, at most len.
+static uint64_t test_k12_chunk(uint64_t len) {
+    uint16_t r;
+    test_rdrandom((uint8_t*)&r, sizeof(r));
+    uint64_t chunk = r % (TEST_K12_MAX_CHUNK + 1);
+    return chunk < len ? chunk : len;
+}
+
+int main(int argc, char ** argv) {
+
+    printf("import sys, binascii\n");
+    printf("from Crypto.Hash import KangarooTwelve, TurboSHAKE128, TurboSHAKE256\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+    printf("checks = []\n");
+
+    uint8_t   out    [TEST_K12_OUT_BYTES];
+    uint8_t   custom [300];
+    k12_ctx_t ctx;
+
+    const size_t num_lengths = sizeof(test_k12_lengths) / sizeof(size_t);
+    const size_t num_custom  = sizeof(test_k12_custom ) / sizeof(size_t);
+
+    test_rdrandom(custom, sizeof(custom));
+    printf("custom = "); puthex_py(custom, sizeof(custom)); printf("\n");
+
+    for(size_t i = 0; i < num_lengths; i ++) {
+
+        size_t    message_len = test_k12_lengths[i];
+        size_t    clen        = test_k12_custom[i % num_custom];
+
+        // Start the message at offset i%8 so lanes are misaligned.
+        size_t    offset  = i % 8;
+        uint8_t * buf     = calloc(message_len + offset + 1, sizeof(uint8_t));
+        uint8_t * message = buf + offset;
+
+        test_rdrandom(message, message_len);
+
+        printf("msg = "); puthex_py(message, message_len); printf("\n");
+
+        // One-shot.
+        KangarooTwelve(message, message_len, custom, clen,
+                       out, TEST_K12_OUT_BYTES);
+        printf("checks.append((\"k12\", msg, custom[:%d], ", (int)clen);
+        puthex_py(out, TEST_K12_OUT_BYTES); printf("))\n");
+
+        // Streamed, in random chunks which straddle leaf boundaries.
+        k12_init(&ctx);
+        for(uint64_t len = message_len; len > 0; ) {
+            uint64_t chunk = test_k12_chunk(len);
+            k12_absorb(&ctx, message + (message_len - len), chunk);
+            len -= chunk;
+        }
+        k12_finalize(&ctx, custom, clen);
+        k12_squeeze (&ctx, out, TEST_K12_OUT_BYTES / 2);
+        k12_squeeze (&ctx, out + TEST_K12_OUT_BYTES / 2,
+                           TEST_K12_OUT_BYTES / 2);
+        printf("checks.append((\"k12\", msg, custom[:%d], ", (int)clen);
+        puthex_py(out, TEST_K12_OUT_BYTES); printf("))\n");
+
+        // Whole leaves given as CVs, as a multi-hart caller would.
+        if(message_len >= K12_CHUNK_BYTES) {
+            uint64_t  nleaves = message_len / K12_CHUNK_BYTES - 1;
+            uint8_t * cvs     = calloc(nleaves + 1, K12_CV_BYTES);
+            k12_init    (&ctx);
+            k12_absorb  (&ctx, message, K12_CHUNK_BYTES);
+            k12_leaf_cvs(message + K12_CHUNK_BYTES, nleaves, cvs);
+            if(k12_absorb_cvs(&ctx, cvs, nleaves)) {
+                printf("print(\"k12_absorb_cvs failed\")\nsys.exit(1)\n");
+            }
+            k12_absorb  (&ctx, message + (nleaves + 1) * K12_CHUNK_BYTES,
+                         message_len - (nleaves + 1) * K12_CHUNK_BYTES);
+            k12_finalize(&ctx, custom, clen);
+            k12_squeeze (&ctx, out, TEST_K12_OUT_BYTES);
+            printf("checks.append((\"k12\", msg, custom[:%d], ", (int)clen);
+            puthex_py(out, TEST_K12_OUT_BYTES); printf("))\n");
+            free(cvs);
+        }
+
+        // TurboSHAKE, with a domain byte which varies per message.
+        uint8_t D = 0x01 + (uint8_t)(i * 9 % 0x7F);
+
+        TurboSHAKE128(message, message_len, D, out, TEST_K12_OUT_BYTES);
+        printf("checks.append((\"ts128\", msg, %d, ", D);
+        puthex_py(out, TEST_K12_OUT_BYTES); printf("))\n");
+
+        TurboSHAKE256(message, message_len, D, out, TEST_K12_OUT_BYTES);
+        printf("checks.append((\"ts256\", msg, %d, ", D);
+        puthex_py(out, TEST_K12_OUT_BYTES); printf("))\n");
+
+        free(buf);
+    }
+
+    printf("for i, (h, msg, arg, out) in enumerate(checks):\n");
+    printf("    if h == 'k12':\n");
+    printf("        ref = KangarooTwelve.new(data=msg, custom=arg)\n");
+    printf("    elif h == 'ts128':\n");
+    printf("        ref = TurboSHAKE128.new(data=msg, domain=arg)\n");
+    printf("    else:\n");
+    printf("        ref = TurboSHAKE256.new(data=msg, domain=arg)\n");
+    printf("    reference = ref.read(len(out))\n");
+    printf("    if( reference  != out ):\n");
+    printf("        print(\"Test %%d failed. %%s %%d bytes\" %% (i, h, len(msg)))\n");
+    printf("        print( 'reference == %%s' %% ( binascii.b2a_hex( out ) ) )" "\n"   );
+    printf("        print( '          != %%s' %% ( binascii.b2a_hex( reference ) ) )" "\n"   );
+    printf("        sys.exit(1)\n");
+    printf("print(\""STR(TEST_NAME)" %%d digests passed.\" %% len(checks))\n");
+
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+
+#include "riscvcrypto/sha256/api_sha256.h"
+
+//! Number of jobs given to sha256_hash_jobs. Not a multiple of the lanes.
+#define TEST_MB_JOBS     37
+
+//! Longest message given to sha256_hash_jobs.
+#define TEST_MB_MAX_LEN  700
+
+//! Print a python check of one digest against hashlib.
+static void test_mb_check(uint8_t * digest, uint8_t * M, size_t len) {
+    printf("checks.append((");
+    puthex_py(M, len);
+    printf(", ");
+    puthex_py(digest, SHA256_DIGEST_BYTES);
+    printf("))\n");
+}
+
+int main(int argc, char ** argv) {
+
+    printf("import sys, binascii, hashlib\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+    printf("checks = []\n");
+
+    uint8_t      digests [SHA256_MB_LANES][SHA256_DIGEST_BYTES];
+    uint8_t    * dp      [SHA256_MB_LANES];
+    uint8_t    * mp      [SHA256_MB_LANES];
+    uint8_t    * bufs    [SHA256_MB_LANES];
+    size_t       lens [] = {0, 3, 55, 56, 64, 119, 120, 1000};
+
+    //
+    // Equal length messages through sha256_hash_x2 and _x4, with every
+    // lane at a different alignment.
+    for(size_t t = 0; t < sizeof(lens)/sizeof(size_t); t ++) {
+
+        size_t len = lens[t];
+
+        for(int l = 0; l < SHA256_MB_LANES; l ++) {
+            bufs[l] = malloc(len + l + 1);
+            mp  [l] = bufs[l] + l;
+            dp  [l] = digests[l];
+            test_rdrandom(mp[l], len);
+        }
+
+        sha256_hash_x2(dp, mp, len);
+        for(int l = 0; l < 2; l ++) {
+            test_mb_check(dp[l], mp[l], len);
+        }
+
+        sha256_hash_x4(dp, mp, len);
+        for(int l = 0; l < 4; l ++) {
+            test_mb_check(dp[l], mp[l], len);
+        }
+
+        for(int l = 0; l < SHA256_MB_LANES; l ++) {
+            free(bufs[l]);
+        }
+    }
+
+    //
+    // Mixed length messages through the job scheduler.
+    sha256_job_t   jobs [TEST_MB_JOBS];
+    uint8_t      * data = malloc(TEST_MB_JOBS * TEST_MB_MAX_LEN);
+
+    test_rdrandom(data, TEST_MB_JOBS * TEST_MB_MAX_LEN);
+
+    for(int i = 0; i < TEST_MB_JOBS; i ++) {
+        uint8_t r[2];
+        test_rdrandom(r, 2);
+        jobs[i].M   = data + i * TEST_MB_MAX_LEN + (r[0] & 3);
+        jobs[i].len = (r[0] | (r[1] << 8)) % (TEST_MB_MAX_LEN - 3);
+    }
+
+    sha256_hash_jobs(jobs, TEST_MB_JOBS);
+
+    for(int i = 0; i < TEST_MB_JOBS; i ++) {
+        test_mb_check(jobs[i].digest, jobs[i].M, jobs[i].len);
+    }
+
+    free(data);
+
+    printf("for i, (input_data, signature) in enumerate(checks):\n");
+    printf("    reference = hashlib.sha256(input_data).digest()\n");
+    printf("    if( reference  != signature ):\n");
+    printf("        print(\"Test %%d failed. %%d bytes.\" %% (i, len(input_data)))\n");
+    printf("        print( 'reference == %%s' %% ( binascii.b2a_hex( signature ) ) )" "\n"   );
+    printf("        print( '          != %%s' %% ( binascii.b2a_hex( reference ) ) )" "\n"   );
+    printf("        sys.exit(1)\n");
+    printf("print(\""STR(TEST_NAME)" %%d digests passed.\" %% len(checks))\n");
+
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+
+#include "riscvcrypto/sha256/api_sha256.h"
+
+//! Largest chunk passed to a single sha256_update call.
+#define TEST_STREAM_MAX_CHUNK 150
+
+//! sha256_update, in the form test_split_update calls.
+static void test_stream_update(void * ctx, uint8_t * M, size_t len) {
+    sha256_update((sha256_ctx_t*)ctx, M, len);
+}
+
+int main(int argc, char ** argv) {
+
+    printf("import sys, binascii, hashlib\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    const int num_tests = 10;
+
+    size_t       message_len  = 0;
+    uint8_t    * message      ;
+    uint8_t      d256   [SHA256_DIGEST_BYTES];
+    uint8_t      d224   [SHA224_DIGEST_BYTES];
+    uint8_t      d224_1 [SHA224_DIGEST_BYTES];
+    sha256_ctx_t ctx;
+
+    for(int i = 0; i < num_tests; i ++) {
+
+        // Start the message at offset i%4 so it is misaligned 3/4 times.
+        size_t offset = i % 4;
+        uint8_t * buf = calloc(message_len + offset + 1, sizeof(uint8_t));
+        message       = buf + offset;
+
+        test_rdrandom(message, message_len);
+
+        sha256_init(&ctx);
+        test_split_update(&ctx, test_stream_update, message, message_len,
+                          TEST_STREAM_MAX_CHUNK);
+        sha256_final(&ctx, d256);
+
+        sha224_init(&ctx);
+        test_split_update(&ctx, test_stream_update, message, message_len,
+                          TEST_STREAM_MAX_CHUNK);
+        sha256_final(&ctx, d224);
+
+        sha224_hash(d224_1, message, message_len);
+
+        printf("#\n# test %d/%d\n",i , num_tests);
+
+        printf("input_data      = ");
+        puthex_py(message,message_len);
+        printf("\n");
+
+        printf("sha256          = ");
+        puthex_py(d256, sizeof(d256));
+        printf("\n");
+
+        printf("sha224          = ");
+        puthex_py(d224, sizeof(d224));
+        printf("\n");
+
+        printf("sha224_oneshot  = ");
+        puthex_py(d224_1, sizeof(d224_1));
+        printf("\n");
+
+        printf("checks = [\n");
+        printf("  (hashlib.sha256(input_data).digest(), sha256),\n");
+        printf("  (hashlib.sha224(input_data).digest(), sha224),\n");
+        printf("  (hashlib.sha224(input_data).digest(), sha224_oneshot),\n");
+        printf("]\n");
+        printf("for reference, signature in checks:\n");
+        printf("    if( reference  != signature ):\n");
+        printf("        print(\"Test %d failed.\")\n", i);
+        printf("        print( 'input     == %%s' %% ( binascii.b2a_hex( input_data ) ) )" "\n"   );
+        printf("        print( 'reference == %%s' %% ( binascii.b2a_hex( signature ) ) )" "\n"   );
+        printf("        print( '          != %%s' %% ( binascii.b2a_hex( reference ) ) )" "\n"   );
+        printf("        sys.exit(1)\n");
+        printf("print(\""STR(TEST_NAME)" Test %d passed. %d bytes.\")\n",
+            i, (int)message_len);
+
+        message_len = message_len * 2 + 55;
+
+        free(buf);
+
+    }
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/sha3/fips202.h"
+
+//! Largest chunk passed to a single keccak_absorb or keccak_squeeze call.
+#define TEST_STREAM_MAX_CHUNK 200
+
+//! Bytes of XOF output read from each SHAKE context.
+#define TEST_STREAM_XOF_BYTES 1000
+
+//! One FIPS 202 function, as a sponge configuration.
+typedef struct {
+    const char   * name  ; //!< hashlib name.
+    unsigned int   rate  ; //!< Rate in bytes.
+    uint8_t        suffix; //!< Delimited suffix.
+    unsigned int   out   ; //!< Output bytes. Fixed for SHA3, any for SHAKE
+} test_sponge_t;
+
+static const test_sponge_t test_sponges [] = {
+    {"sha3_224" , KECCAK_RATE_SHA3_224, KECCAK_SUFFIX_SHA3 , 28},
+    {"sha3_256" , KECCAK_RATE_SHA3_256, KECCAK_SUFFIX_SHA3 , 32},
+    {"sha3_384" , KECCAK_RATE_SHA3_384, KECCAK_SUFFIX_SHA3 , 48},
+    {"sha3_512" , KECCAK_RATE_SHA3_512, KECCAK_SUFFIX_SHA3 , 64},
+    {"shake_128", KECCAK_RATE_SHAKE128, KECCAK_SUFFIX_SHAKE, TEST_STREAM_XOF_BYTES},
+    {"shake_256", KECCAK_RATE_SHAKE256, KECCAK_SUFFIX_SHAKE, TEST_STREAM_XOF_BYTES},
+};
+
+//! keccak_absorb, in the form test_split_update calls.
+static void test_stream_absorb(void * ctx, uint8_t * in, size_t len) {
+    keccak_absorb((keccak_ctx_t*)ctx, in, len);
+}
+
+//! keccak_squeeze, in the form test_split_update calls.
+static void test_stream_squeeze(void * ctx, uint8_t * out, size_t len) {
+    keccak_squeeze((keccak_ctx_t*)ctx, out, len);
+}
+
+int main(int argc, char ** argv) {
+
+    printf("import sys, binascii, hashlib\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+    printf("checks = []\n");
+
+    const int num_tests = 10;
+
+    size_t         message_len = 0;
+    uint8_t        out [TEST_STREAM_XOF_BYTES];
+    keccak_ctx_t   ctx;
+
+    for(int i = 0; i < num_tests; i ++) {
+
+        // Start the message at offset i%8 so lanes are misaligned.
+        size_t    offset  = i % 8;
+        uint8_t * buf     = calloc(message_len + offset + 1, sizeof(uint8_t));
+        uint8_t * message = buf + offset;
+
+        test_rdrandom(message, message_len);
+
+        printf("msg = "); puthex_py(message, message_len); printf("\n");
+
+        for(size_t s = 0; s < sizeof(test_sponges)/sizeof(test_sponge_t); s++){
+
+            const test_sponge_t * sp = &test_sponges[s];
+
+            keccak_init(&ctx, sp->rate, sp->suffix);
+
+            test_split_update(&ctx, test_stream_absorb, message,
+                              message_len, TEST_STREAM_MAX_CHUNK);
+
+            keccak_finalize(&ctx);
+
+            test_split_update(&ctx, test_stream_squeeze, out,
+                              sp->out, TEST_STREAM_MAX_CHUNK);
+
+            printf("checks.append((\"%s\", msg, ", sp->name);
+            puthex_py(out, sp->out); printf("))\n");
+        }
+
+        // Calls in the wrong phase: squeezing finalizes first, and a
+        // second finalize or any later input is ignored.
+        keccak_init    (&ctx, KECCAK_RATE_SHAKE128, KECCAK_SUFFIX_SHAKE);
+        keccak_absorb  (&ctx, message, message_len);
+        keccak_squeeze (&ctx, out, 1);
+        keccak_finalize(&ctx);
+        keccak_absorb  (&ctx, message, message_len);
+        keccak_squeeze (&ctx, out + 1, TEST_STREAM_XOF_BYTES - 1);
+        printf("checks.append((\"shake_128\", msg, ");
+        puthex_py(out, TEST_STREAM_XOF_BYTES); printf("))\n");
+
+        // The one-shot wrappers, which now go through the same sponge.
+        FIPS202_SHA3_256(message, message_len, out);
+        printf("checks.append((\"sha3_256\", msg, ");
+        puthex_py(out, 32); printf("))\n");
+
+        FIPS202_SHAKE128(message, message_len, out, TEST_STREAM_XOF_BYTES);
+        printf("checks.append((\"shake_128\", msg, ");
+        puthex_py(out, TEST_STREAM_XOF_BYTES); printf("))\n");
+
+        message_len += 97 * (i + 1);
+
+        free(buf);
+    }
+
+    printf("for i, (h, msg, out) in enumerate(checks):\n");
+    printf("    ref = hashlib.new(h, msg)\n");
+    printf("    reference = ref.digest(len(out)) if h.startswith('shake') else ref.digest()\n");
+    printf("    if( reference  != out ):\n");
+    printf("        print(\"Test %%d failed. %%s %%d bytes\" %% (i, h, len(msg)))\n");
+    printf("        print( 'reference == %%s' %% ( binascii.b2a_hex( out ) ) )" "\n"   );
+    printf("        print( '          != %%s' %% ( binascii.b2a_hex( reference ) ) )" "\n"   );
+    printf("        sys.exit(1)\n");
+    printf("print(\""STR(TEST_NAME)" %%d digests passed.\" %% len(checks))\n");
+
+    return 0;
+}
@@ -20,7 +20,10 @@ int main(int argc, char ** argv) {
 
     for(int i = 0; i < num_tests; i ++) {
 
-        message  = calloc(message_len, sizeof(unsigned char));
+        // Odd numbered tests hash from a misaligned address.
+        size_t    offset = (i & 1) ? i % 8 : 0;
+        uint8_t * buf    = calloc(message_len + offset, sizeof(unsigned char));
+        message          = buf + offset;
 
         test_rdrandom(message, message_len);
 
@@ -69,7 +72,7 @@ int main(int argc, char ** argv) {
 
         message_len += TEST_HASH_INPUT_LENGTH / 2;
 
-        free(message);
+        free(buf);
 
     }
 
@@ -0,0 +1,107 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+
+#include "riscvcrypto/sha512/api_sha512.h"
+
+//! Largest chunk passed to a single sha512_update call.
+#define TEST_STREAM_MAX_CHUNK 300
+
+typedef void (*sha512_init_t)(sha512_ctx_t * ctx);
+
+//! Each variant: its init function, and its name in pycryptodome.
+static struct {
+    sha512_init_t   init;
+    const char    * py;
+} test_variants [] = {
+    {sha512_init    , "SHA512.new(input_data)"                  },
+    {sha384_init    , "SHA384.new(input_data)"                  },
+    {sha512_256_init, "SHA512.new(input_data, truncate='256')"  },
+    {sha512_224_init, "SHA512.new(input_data, truncate='224')"  },
+};
+
+//! sha512_update, in the form test_split_update calls.
+static void test_stream_update(void * ctx, uint8_t * M, size_t len) {
+    sha512_update((sha512_ctx_t*)ctx, M, len);
+}
+
+int main(int argc, char ** argv) {
+
+    printf("import sys, binascii\n");
+    printf("from Crypto.Hash import SHA512, SHA384\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    const int num_tests = 10;
+
+    size_t       message_len  = 0;
+    uint8_t    * message      ;
+    uint8_t      digest [SHA512_DIGEST_BYTES];
+    uint8_t      oneshot[SHA512_DIGEST_BYTES];
+    sha512_ctx_t ctx;
+
+    for(int i = 0; i < num_tests; i ++) {
+
+        // Start the message at offset i%8 so it is usually misaligned.
+        size_t offset = i % 8;
+        uint8_t * buf = calloc(message_len + offset + 1, sizeof(uint8_t));
+        message       = buf + offset;
+
+        test_rdrandom(message, message_len);
+
+        printf("#\n# test %d/%d\n",i , num_tests);
+
+        printf("input_data      = ");
+        puthex_py(message,message_len);
+        printf("\n");
+
+        printf("checks = []\n");
+
+        for(size_t v = 0; v < sizeof(test_variants)/sizeof(test_variants[0]);
+            v ++) {
+
+            test_variants[v].init(&ctx);
+            test_split_update(&ctx, test_stream_update, message,
+                              message_len, TEST_STREAM_MAX_CHUNK);
+            sha512_final(&ctx, digest);
+
+            printf("checks.append((%s.digest(), ", test_variants[v].py);
+            puthex_py(digest, ctx.digest_bytes);
+            printf("))\n");
+        }
+
+        sha384_hash    (oneshot, message, message_len);
+        printf("checks.append((SHA384.new(input_data).digest(), ");
+        puthex_py(oneshot, SHA384_DIGEST_BYTES);
+        printf("))\n");
+
+        sha512_256_hash(oneshot, message, message_len);
+        printf("checks.append((SHA512.new(input_data, truncate='256')"
+               ".digest(), ");
+        puthex_py(oneshot, SHA512_256_DIGEST_BYTES);
+        printf("))\n");
+
+        sha512_224_hash(oneshot, message, message_len);
+        printf("checks.append((SHA512.new(input_data, truncate='224')"
+               ".digest(), ");
+        puthex_py(oneshot, SHA512_224_DIGEST_BYTES);
+        printf("))\n");
+
+        printf("for reference, signature in checks:\n");
+        printf("    if( reference  != signature ):\n");
+        printf("        print(\"Test %d failed.\")\n", i);
+        printf("        print( 'input     == %%s' %% ( binascii.b2a_hex( input_data ) ) )" "\n"   );
+        printf("        print( 'reference == %%s' %% ( binascii.b2a_hex( signature ) ) )" "\n"   );
+        printf("        print( '          != %%s' %% ( binascii.b2a_hex( reference ) ) )" "\n"   );
+        printf("        sys.exit(1)\n");
+        printf("print(\""STR(TEST_NAME)" Test %d passed. %d bytes.\")\n",
+            i, (int)message_len);
+
+        message_len = message_len * 2 + 111;
+
+        free(buf);
+
+    }
+
+    return 0;
+}
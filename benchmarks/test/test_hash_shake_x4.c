@@ -0,0 +1,107 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/sha3/fips202.h"
+
+//! Input lengths tested, either side of the 168-byte rate.
+static size_t test_in_lens  [] = {0, 1, 34, 167, 168, 169, 500};
+
+//! Output lengths tested.
+static size_t test_out_lens [] = {1, 32, 168, 504, 1000};
+
+//! Largest chunk passed to one shake128_x4_squeeze call.
+#define TEST_X4_MAX_CHUNK 200
+
+int main(int argc, char ** argv) {
+
+    printf("import sys, binascii, hashlib\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+    printf("checks = []\n");
+
+    uint64_t          s1 [4][25];
+    uint64_t          s2 [2][25];
+    uint64_t          s4 [4][25];
+    uint8_t           in  [4][500];
+    uint8_t           out [4][1000];
+    const uint8_t   * inp [4] = {in [0], in [1], in [2], in [3]};
+    uint8_t         * outp[4] = {out[0], out[1], out[2], out[3]};
+    shake128_x4_ctx_t ctx;
+    int               fails = 0;
+
+    // The multi-state permutations must match the single state one.
+    test_rdrandom((uint8_t*)s1, sizeof(s1));
+    memcpy(s2, s1, sizeof(s2));
+    memcpy(s4, s1, sizeof(s4));
+
+    for(int l = 0; l < 4; l ++) {
+        KeccakF1600_StatePermute(s1[l]);
+    }
+    KeccakF1600_StatePermute_x2(s2);
+    KeccakF1600_StatePermute_x4(s4);
+
+    if(memcmp(s1, s2, sizeof(s2)) || memcmp(s1, s4, sizeof(s4))) {
+        printf("print(\"Multi-state permutation mismatch\")\n");
+        fails ++;
+    }
+
+    for(size_t i = 0; i < sizeof(test_in_lens)/sizeof(size_t); i ++) {
+        for(size_t o = 0; o < sizeof(test_out_lens)/sizeof(size_t); o ++) {
+
+            size_t ilen = test_in_lens [i];
+            size_t olen = test_out_lens[o];
+
+            test_rdrandom((uint8_t*)in, sizeof(in));
+
+            // Absorb in two pieces, squeeze in random pieces.
+            shake128_x4_init    (&ctx);
+            shake128_x4_absorb  (&ctx, inp, ilen / 2);
+            for(int l = 0; l < 4; l ++) {
+                inp[l] += ilen / 2;
+            }
+            shake128_x4_absorb  (&ctx, inp, ilen - ilen / 2);
+            for(int l = 0; l < 4; l ++) {
+                inp[l] -= ilen / 2;
+            }
+            shake128_x4_finalize(&ctx);
+
+            for(size_t done = 0; done < olen; ) {
+                uint8_t r;
+                test_rdrandom(&r, 1);
+                size_t chunk = r % TEST_X4_MAX_CHUNK + 1;
+                chunk = chunk < olen - done ? chunk : olen - done;
+                shake128_x4_squeeze(&ctx, outp, chunk);
+                for(int l = 0; l < 4; l ++) {
+                    outp[l] += chunk;
+                }
+                done += chunk;
+            }
+            for(int l = 0; l < 4; l ++) {
+                outp[l] = out[l];
+            }
+
+            for(int l = 0; l < 4; l ++) {
+                printf("checks.append((");
+                puthex_py(in [l], ilen); printf(", ");
+                puthex_py(out[l], olen); printf("))\n");
+            }
+        }
+    }
+
+    if(fails) {
+        printf("sys.exit(1)\n");
+    }
+
+    printf("for i, (msg, out) in enumerate(checks):\n");
+    printf("    reference = hashlib.shake_128(msg).digest(len(out))\n");
+    printf("    if( reference  != out ):\n");
+    printf("        print(\"Test %%d failed. lane %%d, %%d in, %%d out\" %% (i, i %% 4, len(msg), len(out)))\n");
+    printf("        print( 'reference == %%s' %% ( binascii.b2a_hex( out ) ) )" "\n"   );
+    printf("        print( '          != %%s' %% ( binascii.b2a_hex( reference ) ) )" "\n"   );
+    printf("        sys.exit(1)\n");
+    printf("print(\""STR(TEST_NAME)" %%d SHAKE128 streams passed.\" %% len(checks))\n");
+
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+
+#include "riscvcrypto/sm3/api_sm3.h"
+
+//! Largest chunk passed to a single sm3_update call.
+#define TEST_STREAM_MAX_CHUNK 150
+
+//! sm3_update, in the form test_split_update calls.
+static void test_stream_update(void * ctx, uint8_t * M, size_t len) {
+    sm3_update((sm3_ctx_t*)ctx, M, len);
+}
+
+int main(int argc, char ** argv) {
+
+    printf("import sys, binascii, hashlib\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    const int num_tests = 10;
+
+    size_t       message_len  = 0;
+    uint8_t    * message      ;
+    uint8_t      d_stream  [SM3_DIGEST_BYTES];
+    uint8_t      d_oneshot [SM3_DIGEST_BYTES];
+    sm3_ctx_t    ctx;
+
+    for(int i = 0; i < num_tests; i ++) {
+
+        // Start the message at offset i%4 so it is misaligned 3/4 times.
+        size_t offset = i % 4;
+        uint8_t * buf = calloc(message_len + offset + 1, sizeof(uint8_t));
+        message       = buf + offset;
+
+        test_rdrandom(message, message_len);
+
+        sm3_init(&ctx);
+        test_split_update(&ctx, test_stream_update, message, message_len,
+                          TEST_STREAM_MAX_CHUNK);
+        sm3_final(&ctx, d_stream);
+
+        sm3_hash(d_oneshot, message, message_len);
+
+        printf("#\n# test %d/%d\n",i , num_tests);
+
+        printf("input_data      = ");
+        puthex_py(message,message_len);
+        printf("\n");
+
+        printf("sm3             = ");
+        puthex_py(d_stream, sizeof(d_stream));
+        printf("\n");
+
+        printf("sm3_oneshot     = ");
+        puthex_py(d_oneshot, sizeof(d_oneshot));
+        printf("\n");
+
+        printf("checks = [\n");
+        printf("  (hashlib.new('sm3', input_data).digest(), sm3),\n");
+        printf("  (hashlib.new('sm3', input_data).digest(), sm3_oneshot),\n");
+        printf("]\n");
+        printf("for reference, signature in checks:\n");
+        printf("    if( reference  != signature ):\n");
+        printf("        print(\"Test %d failed.\")\n", i);
+        printf("        print( 'input     == %%s' %% ( binascii.b2a_hex( input_data ) ) )" "\n"   );
+        printf("        print( 'reference == %%s' %% ( binascii.b2a_hex( signature ) ) )" "\n"   );
+        printf("        print( '          != %%s' %% ( binascii.b2a_hex( reference ) ) )" "\n"   );
+        printf("        sys.exit(1)\n");
+        printf("print(\""STR(TEST_NAME)" Test %d passed. %d bytes.\")\n",
+            i, (int)message_len);
+
+        message_len = message_len * 2 + 55;
+
+        free(buf);
+
+    }
+
+    return 0;
+}
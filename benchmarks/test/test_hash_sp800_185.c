@@ -0,0 +1,204 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+#include "riscvcrypto/share/util.h"
+
+#include "riscvcrypto/sha3/sp800_185.h"
+
+//! Bytes of output read from each function.
+#define TEST_SP800_185_OUT_BYTES  100
+
+//! Largest chunk passed to a single parallelhash_absorb call.
+#define TEST_SP800_185_MAX_CHUNK  700
+
+//! Message lengths tested.
+static const size_t test_sp800_185_lengths [] = {
+    0, 1, 135, 136, 168, 169, 500, 1024, 4099
+};
+
+//! ParallelHash block sizes tested. Some not a multiple of either rate.
+static const uint64_t test_sp800_185_B [] = {1, 8, 168, 200, 1024};
+
+//! Key and customization string lengths tested.
+static const size_t test_sp800_185_klen [] = {32, 33, 64, 167, 200};
+static const size_t test_sp800_185_slen [] = {0, 1, 20, 160, 300};
+
+//! Randomly sized chunk length, at most len.
+static uint64_t test_sp800_185_chunk(uint64_t len) {
+    uint16_t r;
+    test_rdrandom((uint8_t*)&r, sizeof(r));
+    uint64_t chunk = r % (TEST_SP800_185_MAX_CHUNK + 1);
+    return chunk < len ? chunk : len;
+}
+
+//! Print one check: function, bits, message, key or B, S, output.
+static void test_sp800_185_check(
+    const char * fn, int bits, const char * arg, uint8_t * out
+){
+    printf("checks.append((\"%s\", %d, msg, %s, S, ", fn, bits, arg);
+    puthex_py(out, TEST_SP800_185_OUT_BYTES); printf("))\n");
+}
+
+int main(int argc, char ** argv) {
+
+    printf("import sys, binascii\n");
+    printf("from Crypto.Hash import cSHAKE128, cSHAKE256, SHAKE128, SHAKE256, KMAC128, KMAC256\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+    printf("checks = []\n");
+
+    uint8_t            out   [TEST_SP800_185_OUT_BYTES];
+    uint8_t            N     [] = "Email Signature";
+    uint8_t            key   [200];
+    uint8_t            S     [300];
+    keccak_ctx_t       kctx;
+    parallelhash_ctx_t pctx;
+
+    const size_t num_lengths = sizeof(test_sp800_185_lengths) / sizeof(size_t);
+
+    for(size_t i = 0; i < num_lengths; i ++) {
+
+        size_t    message_len = test_sp800_185_lengths[i];
+        size_t    klen        = test_sp800_185_klen[i % 5];
+        size_t    slen        = test_sp800_185_slen[i % 5];
+        uint64_t  B           = test_sp800_185_B   [i % 5];
+
+        // Start the message at offset i%8 so lanes are misaligned.
+        size_t    offset  = i % 8;
+        uint8_t * buf     = calloc(message_len + offset + 1, sizeof(uint8_t));
+        uint8_t * message = buf + offset;
+
+        test_rdrandom(message, message_len);
+        test_rdrandom(key, klen);
+        test_rdrandom(S  , slen);
+
+        printf("msg = "); puthex_py(message, message_len); printf("\n");
+        printf("key = "); puthex_py(key    , klen       ); printf("\n");
+        printf("S   = "); puthex_py(S      , slen       ); printf("\n");
+
+        for(int bits = 128; bits <= 256; bits += 128) {
+
+            unsigned int rate  = bits == 128 ? KECCAK_RATE_SHAKE128
+                                             : KECCAK_RATE_SHAKE256;
+            char         arg [32];
+
+            if(bits == 128) {
+                cSHAKE128(message, message_len, N, sizeof(N) - 1, S, slen,
+                          out, TEST_SP800_185_OUT_BYTES);
+                test_sp800_185_check("cshake", bits, "b'Email Signature'", out);
+                cSHAKE128(message, message_len, N, 0, S, 0,
+                          out, TEST_SP800_185_OUT_BYTES);
+                test_sp800_185_check("shake", bits, "b''", out);
+                KMAC128(key, klen, message, message_len, S, slen,
+                        out, TEST_SP800_185_OUT_BYTES);
+                test_sp800_185_check("kmac", bits, "key", out);
+                KMACXOF128(key, klen, message, message_len, S, slen,
+                           out, TEST_SP800_185_OUT_BYTES);
+                test_sp800_185_check("kmacxof", bits, "key", out);
+            } else {
+                cSHAKE256(message, message_len, N, sizeof(N) - 1, S, slen,
+                          out, TEST_SP800_185_OUT_BYTES);
+                test_sp800_185_check("cshake", bits, "b'Email Signature'", out);
+                cSHAKE256(message, message_len, N, 0, S, 0,
+                          out, TEST_SP800_185_OUT_BYTES);
+                test_sp800_185_check("shake", bits, "b''", out);
+                KMAC256(key, klen, message, message_len, S, slen,
+                        out, TEST_SP800_185_OUT_BYTES);
+                test_sp800_185_check("kmac", bits, "key", out);
+                KMACXOF256(key, klen, message, message_len, S, slen,
+                           out, TEST_SP800_185_OUT_BYTES);
+                test_sp800_185_check("kmacxof", bits, "key", out);
+            }
+
+            snprintf(arg, sizeof(arg), "%lu", (unsigned long)B);
+
+            // One-shot ParallelHash, which takes whole blocks 4 at a time.
+            if(bits == 128) {
+                ParallelHash128(message, message_len, B, S, slen,
+                                out, TEST_SP800_185_OUT_BYTES);
+            } else {
+                ParallelHash256(message, message_len, B, S, slen,
+                                out, TEST_SP800_185_OUT_BYTES);
+            }
+            test_sp800_185_check("ph", bits, arg, out);
+
+            // Streamed in random chunks, with the XOF output length.
+            parallelhash_init(&pctx, rate, B, S, slen);
+            for(uint64_t len = message_len; len > 0; ) {
+                uint64_t chunk = test_sp800_185_chunk(len);
+                parallelhash_absorb(&pctx, message + (message_len - len), chunk);
+                len -= chunk;
+            }
+            parallelhash_finalize(&pctx, 0);
+            parallelhash_squeeze (&pctx, out, 7);
+            parallelhash_squeeze (&pctx, out + 7, TEST_SP800_185_OUT_BYTES - 7);
+            test_sp800_185_check("phxof", bits, arg, out);
+
+            // Whole blocks given as CVs, as a multi-hart caller would.
+            uint64_t  nblocks = message_len / B;
+            uint8_t * cvs     = calloc(nblocks + 1, KECCAK_STATE_BYTES - rate);
+            parallelhash_block_cvs(rate, message, B, nblocks, cvs);
+            parallelhash_init(&pctx, rate, B, S, slen);
+            if(parallelhash_absorb_cvs(&pctx, cvs, nblocks)) {
+                printf("print(\"parallelhash_absorb_cvs failed\")\nsys.exit(1)\n");
+            }
+            parallelhash_absorb  (&pctx, message + nblocks * B,
+                                  message_len - nblocks * B);
+            parallelhash_finalize(&pctx, TEST_SP800_185_OUT_BYTES);
+            parallelhash_squeeze (&pctx, out, TEST_SP800_185_OUT_BYTES);
+            test_sp800_185_check("ph", bits, arg, out);
+            free(cvs);
+
+            // KMAC through the incremental interface.
+            kmac_init(&kctx, rate, key, klen, S, slen);
+            keccak_absorb (&kctx, message, message_len / 2);
+            keccak_absorb (&kctx, message + message_len / 2,
+                           message_len - message_len / 2);
+            kmac_finalize (&kctx, TEST_SP800_185_OUT_BYTES);
+            keccak_squeeze(&kctx, out, TEST_SP800_185_OUT_BYTES);
+            test_sp800_185_check("kmac", bits, "key", out);
+        }
+
+        free(buf);
+    }
+
+    printf("def lenc(x):\n");
+    printf("    n = max(1, (x.bit_length() + 7) // 8)\n");
+    printf("    return bytes([n]) + x.to_bytes(n, 'big')\n");
+    printf("def renc(x):\n");
+    printf("    n = max(1, (x.bit_length() + 7) // 8)\n");
+    printf("    return x.to_bytes(n, 'big') + bytes([n])\n");
+    printf("def bytepad(x, w):\n");
+    printf("    z = lenc(w) + x\n");
+    printf("    return z + bytes((-len(z)) %% w)\n");
+    printf("def cshake(bits, x, n, s, L):\n");
+    printf("    c = cSHAKE128 if bits == 128 else cSHAKE256\n");
+    printf("    return c._new(x, s, n).read(L)\n");
+    printf("def kmac(bits, x, k, s, L, xof):\n");
+    printf("    r = 168 if bits == 128 else 136\n");
+    printf("    x = bytepad(lenc(len(k) * 8) + k, r) + x + renc(0 if xof else L * 8)\n");
+    printf("    return cshake(bits, x, b'KMAC', s, L)\n");
+    printf("def ph(bits, x, B, s, L, xof):\n");
+    printf("    h = SHAKE128 if bits == 128 else SHAKE256\n");
+    printf("    n = (len(x) + B - 1) // B\n");
+    printf("    z = lenc(B) + b''.join(h.new(x[i*B:(i+1)*B]).read(bits // 4) for i in range(n))\n");
+    printf("    z = z + renc(n) + renc(0 if xof else L * 8)\n");
+    printf("    return cshake(bits, z, b'ParallelHash', s, L)\n");
+
+    printf("for i, (h, bits, msg, arg, S, out) in enumerate(checks):\n");
+    printf("    L = len(out)\n");
+    printf("    if   h == 'cshake' : reference = cshake(bits, msg, arg, S, L)\n");
+    printf("    elif h == 'shake'  : reference = (SHAKE128 if bits == 128 else SHAKE256).new(msg).read(L)\n");
+    printf("    elif h == 'kmac'   : reference = (KMAC128 if bits == 128 else KMAC256).new(key=arg, data=msg, mac_len=L, custom=S).digest()\n");
+    printf("    elif h == 'kmacxof': reference = kmac(bits, msg, arg, S, L, True)\n");
+    printf("    elif h == 'ph'     : reference = ph(bits, msg, arg, S, L, False)\n");
+    printf("    else               : reference = ph(bits, msg, arg, S, L, True)\n");
+    printf("    if( reference  != out ):\n");
+    printf("        print(\"Test %%d failed. %%s%%d %%d bytes\" %% (i, h, bits, len(msg)))\n");
+    printf("        print( 'reference == %%s' %% ( binascii.b2a_hex( out ) ) )" "\n"   );
+    printf("        print( '          != %%s' %% ( binascii.b2a_hex( reference ) ) )" "\n"   );
+    printf("        sys.exit(1)\n");
+    printf("print(\""STR(TEST_NAME)" %%d digests passed.\" %% len(checks))\n");
+
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+
+#include "riscvcrypto/kdf/api_kdf.h"
+
+//! PBKDF2 iteration counts tested. 1 skips the iteration loop entirely.
+static uint32_t test_iterations [] = {1, 2, 3, 100, 1000};
+
+//! Derived key lengths: part of a block, exactly one, several.
+static size_t   test_dk_lens    [] = {16, 32, 64, 100, 130};
+
+//! HKDF output lengths, including the 255 * HashLen maximum for SHA-256.
+static size_t   test_okm_lens   [] = {1, 32, 42, 64, 200, 255 * 32};
+
+int main(int argc, char ** argv) {
+
+    printf("import sys, binascii, hmac, hashlib\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+    printf("def hkdf(h, salt, ikm, info, n):\n");
+    printf("    prk = hmac.new(salt or bytes(hashlib.new(h).digest_size), ikm, h).digest()\n");
+    printf("    t, okm, i = b'', b'', 1\n");
+    printf("    while len(okm) < n:\n");
+    printf("        t = hmac.new(prk, t + info + bytes([i]), h).digest()\n");
+    printf("        okm, i = okm + t, i + 1\n");
+    printf("    return okm[:n]\n");
+    printf("pbkdf2 = []\n");
+    printf("hkdfs  = []\n");
+
+    uint8_t  pwd  [100];
+    uint8_t  salt [80];
+    uint8_t  info [40];
+    uint8_t  dk   [255 * 32];
+    uint8_t  prk  [SHA512_DIGEST_BYTES];
+
+    for(size_t i = 0; i < sizeof(test_iterations)/sizeof(uint32_t); i ++) {
+        for(size_t d = 0; d < sizeof(test_dk_lens)/sizeof(size_t); d ++) {
+
+            uint32_t c    = test_iterations[i];
+            size_t   dlen = test_dk_lens[d];
+            size_t   plen = (i * 37 + d * 11) % sizeof(pwd);
+            size_t   slen = (d * 13 + 1) % sizeof(salt);
+
+            test_rdrandom(pwd , plen);
+            test_rdrandom(salt, slen);
+
+            printf("pwd  = "); puthex_py(pwd , plen); printf("\n");
+            printf("salt = "); puthex_py(salt, slen); printf("\n");
+
+            if(pbkdf2_hmac_sha256(dk, dlen, pwd, plen, salt, slen, c)) {
+                printf("print('PBKDF2-SHA256 with c=%lu failed')\n",
+                    (unsigned long)c);
+                printf("sys.exit(1)\n");
+            }
+            printf("pbkdf2.append(('sha256', pwd, salt, %lu, ", (unsigned long)c);
+            puthex_py(dk, dlen); printf("))\n");
+
+            if(pbkdf2_hmac_sha512(dk, dlen, pwd, plen, salt, slen, c)) {
+                printf("print('PBKDF2-SHA512 with c=%lu failed')\n",
+                    (unsigned long)c);
+                printf("sys.exit(1)\n");
+            }
+            printf("pbkdf2.append(('sha512', pwd, salt, %lu, ", (unsigned long)c);
+            puthex_py(dk, dlen); printf("))\n");
+        }
+    }
+
+    for(size_t o = 0; o < sizeof(test_okm_lens)/sizeof(size_t); o ++) {
+
+        size_t olen = test_okm_lens[o];
+        size_t slen = (o * 23) % sizeof(salt);  // The first salt is empty.
+        size_t ilen = (o *  7) % sizeof(info);
+
+        test_rdrandom(pwd , sizeof(pwd));
+        test_rdrandom(salt, slen);
+        test_rdrandom(info, ilen);
+
+        printf("ikm  = "); puthex_py(pwd , sizeof(pwd)); printf("\n");
+        printf("salt = "); puthex_py(salt, slen); printf("\n");
+        printf("info = "); puthex_py(info, ilen); printf("\n");
+
+        hkdf_sha256_extract(prk, salt, slen, pwd, sizeof(pwd));
+        if(hkdf_sha256_expand(dk, olen, prk, SHA256_DIGEST_BYTES, info, ilen)) {
+            printf("print('HKDF-SHA256 expand of %lu bytes failed')\n",
+                (unsigned long)olen);
+            printf("sys.exit(1)\n");
+        }
+        printf("hkdfs.append(('sha256', salt, ikm, info, ");
+        puthex_py(dk, olen); printf("))\n");
+
+        hkdf_sha512_extract(prk, salt, slen, pwd, sizeof(pwd));
+        if(hkdf_sha512_expand(dk, olen, prk, SHA512_DIGEST_BYTES, info, ilen)) {
+            printf("print('HKDF-SHA512 expand of %lu bytes failed')\n",
+                (unsigned long)olen);
+            printf("sys.exit(1)\n");
+        }
+        printf("hkdfs.append(('sha512', salt, ikm, info, ");
+        puthex_py(dk, olen); printf("))\n");
+    }
+
+    // Requests over 255 * HashLen must be refused.
+    if(!hkdf_sha256_expand(dk, 255 * 32 + 1, prk, 32, info, 0)) {
+        printf("print('HKDF-SHA256 accepted an over-long output')\n");
+        printf("sys.exit(1)\n");
+    }
+
+    // An iteration count of 0 must be refused.
+    if(!pbkdf2_hmac_sha256(dk, 32, pwd, 8, salt, 8, 0) ||
+       !pbkdf2_hmac_sha512(dk, 64, pwd, 8, salt, 8, 0)) {
+        printf("print('PBKDF2 accepted an iteration count of 0')\n");
+        printf("sys.exit(1)\n");
+    }
+
+    printf("for i, (h, pwd, salt, c, dk) in enumerate(pbkdf2):\n");
+    printf("    reference = hashlib.pbkdf2_hmac(h, pwd, salt, c, len(dk))\n");
+    printf("    if( reference  != dk ):\n");
+    printf("        print(\"PBKDF2 test %%d failed. HMAC-%%s c=%%d dklen %%d\" %% (i, h, c, len(dk)))\n");
+    printf("        print( 'reference == %%s' %% ( binascii.b2a_hex( dk ) ) )" "\n"   );
+    printf("        print( '          != %%s' %% ( binascii.b2a_hex( reference ) ) )" "\n"   );
+    printf("        sys.exit(1)\n");
+    printf("for i, (h, salt, ikm, info, okm) in enumerate(hkdfs):\n");
+    printf("    reference = hkdf(h, salt, ikm, info, len(okm))\n");
+    printf("    if( reference  != okm ):\n");
+    printf("        print(\"HKDF test %%d failed. HMAC-%%s okm %%d bytes\" %% (i, h, len(okm)))\n");
+    printf("        sys.exit(1)\n");
+    printf("print(\""STR(TEST_NAME)" %%d PBKDF2 and %%d HKDF checks passed.\" %% (len(pbkdf2), len(hkdfs)))\n");
+
+    return 0;
+}
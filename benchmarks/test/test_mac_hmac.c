@@ -0,0 +1,82 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+
+#include "riscvcrypto/hmac/api_hmac.h"
+
+//! Key lengths tested: empty, short, one block, over one block of each.
+static size_t test_key_lens [] = {0, 16, 32, 64, 65, 128, 129, 200};
+
+//! Message lengths tested.
+static size_t test_msg_lens [] = {0, 1, 55, 64, 111, 128, 1000};
+
+int main(int argc, char ** argv) {
+
+    printf("import sys, binascii, hmac, hashlib\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+    printf("checks = []\n");
+
+    uint8_t           key   [200];
+    uint8_t           msg   [1000];
+    uint8_t           mac   [HMAC_SHA512_BYTES];
+    hmac_sha256_key_t k256;
+    hmac_sha512_key_t k512;
+    sha256_ctx_t      c256;
+    sha512_ctx_t      c512;
+
+    for(size_t k = 0; k < sizeof(test_key_lens)/sizeof(size_t); k ++) {
+        for(size_t m = 0; m < sizeof(test_msg_lens)/sizeof(size_t); m ++) {
+
+            size_t klen = test_key_lens[k];
+            size_t mlen = test_msg_lens[m];
+
+            test_rdrandom(key, klen);
+            test_rdrandom(msg, mlen);
+
+            printf("key = "); puthex_py(key, klen); printf("\n");
+            printf("msg = "); puthex_py(msg, mlen); printf("\n");
+
+            hmac_sha256_key_init(&k256, key, klen);
+            hmac_sha256(mac, &k256, msg, mlen);
+            printf("checks.append(('sha256', key, msg, ");
+            puthex_py(mac, HMAC_SHA256_BYTES); printf("))\n");
+
+            // The same MAC again, streamed in two pieces.
+            hmac_sha256_init (&c256, &k256);
+            sha256_update    (&c256, msg, mlen / 3);
+            sha256_update    (&c256, msg + mlen / 3, mlen - mlen / 3);
+            hmac_sha256_final(&c256, &k256, mac);
+            printf("checks.append(('sha256', key, msg, ");
+            puthex_py(mac, HMAC_SHA256_BYTES); printf("))\n");
+
+            hmac_sha384_key_init(&k512, key, klen);
+            hmac_sha512(mac, &k512, msg, mlen);
+            printf("checks.append(('sha384', key, msg, ");
+            puthex_py(mac, HMAC_SHA384_BYTES); printf("))\n");
+
+            hmac_sha512_key_init(&k512, key, klen);
+            hmac_sha512(mac, &k512, msg, mlen);
+            printf("checks.append(('sha512', key, msg, ");
+            puthex_py(mac, HMAC_SHA512_BYTES); printf("))\n");
+
+            hmac_sha512_init (&c512, &k512);
+            sha512_update    (&c512, msg, mlen / 3);
+            sha512_update    (&c512, msg + mlen / 3, mlen - mlen / 3);
+            hmac_sha512_final(&c512, &k512, mac);
+            printf("checks.append(('sha512', key, msg, ");
+            puthex_py(mac, HMAC_SHA512_BYTES); printf("))\n");
+        }
+    }
+
+    printf("for i, (h, key, msg, tag) in enumerate(checks):\n");
+    printf("    reference = hmac.new(key, msg, h).digest()\n");
+    printf("    if( reference  != tag ):\n");
+    printf("        print(\"Test %%d failed. HMAC-%%s key %%d msg %%d bytes\" %% (i, h, len(key), len(msg)))\n");
+    printf("        print( 'reference == %%s' %% ( binascii.b2a_hex( tag ) ) )" "\n"   );
+    printf("        print( '          != %%s' %% ( binascii.b2a_hex( reference ) ) )" "\n"   );
+    printf("        sys.exit(1)\n");
+    printf("print(\""STR(TEST_NAME)" %%d MACs passed.\" %% len(checks))\n");
+
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+
+#include "riscvcrypto/merkle/api_merkle.h"
+
+//! Leaf counts tested, covering odd levels at every height.
+static size_t test_leaf_counts [] = {1, 2, 3, 4, 5, 7, 16, 33, 100};
+
+//! Size of each storage chunk.
+#define TEST_MERKLE_CHUNK   48
+
+//! Leaves replaced with merkle_tree_update in each tree.
+#define TEST_MERKLE_UPDATES 3
+
+int main(int argc, char ** argv) {
+
+    printf("import sys, binascii, hashlib\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+    printf("def merkle(chunks):\n");
+    printf("    level = [hashlib.sha256(c).digest() for c in chunks]\n");
+    printf("    while len(level) > 1:\n");
+    printf("        nxt = [hashlib.sha256(level[i] + level[i+1]).digest()"
+                         " for i in range(0, len(level) - 1, 2)]\n");
+    printf("        level = nxt + level[len(nxt)*2:]\n");
+    printf("    return level[0]\n");
+    printf("checks = []\n");
+
+    size_t          max_leaves = 100;
+    uint8_t       * data       = malloc(max_leaves * TEST_MERKLE_CHUNK);
+    uint8_t       * nodes      = malloc(merkle_tree_nodes(max_leaves) *
+                                        MERKLE_NODE_BYTES);
+    merkle_tree_t   tree;
+
+    // The 64-byte entry point on its own.
+    test_rdrandom(data, 2 * MERKLE_NODE_BYTES);
+    merkle_sha256_hash_64(nodes, data);
+    printf("if hashlib.sha256("); puthex_py(data, 64); printf(").digest() != ");
+    puthex_py(nodes, MERKLE_NODE_BYTES); printf(":\n");
+    printf("    print(\"merkle_sha256_hash_64 failed\")\n");
+    printf("    sys.exit(1)\n");
+
+    for(size_t t = 0; t < sizeof(test_leaf_counts)/sizeof(size_t); t ++) {
+
+        size_t nleaves = test_leaf_counts[t];
+
+        if(merkle_tree_init(&tree, nodes, nleaves, NULL)) {
+            printf("print(\"merkle_tree_init failed for %d leaves\")\n",
+                (int)nleaves);
+            printf("sys.exit(1)\n");
+            return 1;
+        }
+
+        test_rdrandom(data, nleaves * TEST_MERKLE_CHUNK);
+
+        for(size_t i = 0; i < nleaves; i ++) {
+            merkle_tree_set_leaf(&tree, i, data + i * TEST_MERKLE_CHUNK,
+                                 TEST_MERKLE_CHUNK);
+        }
+
+        merkle_tree_build(&tree);
+
+        printf("data = "); puthex_py(data, nleaves * TEST_MERKLE_CHUNK);
+        printf("\n");
+        printf("checks.append(([data[i:i+%d] for i in range(0, len(data), %d)], ",
+            TEST_MERKLE_CHUNK, TEST_MERKLE_CHUNK);
+        puthex_py(merkle_tree_root(&tree), MERKLE_NODE_BYTES);
+        printf("))\n");
+
+        // Replace a few leaves, including the last, one path at a time.
+        for(int u = 0; u < TEST_MERKLE_UPDATES; u ++) {
+
+            size_t i = u == 0 ? nleaves - 1 : (u * 37) % nleaves;
+
+            test_rdrandom(data + i * TEST_MERKLE_CHUNK, TEST_MERKLE_CHUNK);
+            merkle_tree_update(&tree, i, data + i * TEST_MERKLE_CHUNK,
+                               TEST_MERKLE_CHUNK);
+
+            printf("data = "); puthex_py(data, nleaves * TEST_MERKLE_CHUNK);
+            printf("\n");
+            printf("checks.append(([data[i:i+%d] for i in range(0, len(data), %d)], ",
+                TEST_MERKLE_CHUNK, TEST_MERKLE_CHUNK);
+            puthex_py(merkle_tree_root(&tree), MERKLE_NODE_BYTES);
+            printf("))\n");
+        }
+    }
+
+    free(data);
+    free(nodes);
+
+    printf("for i, (chunks, root) in enumerate(checks):\n");
+    printf("    reference = merkle(chunks)\n");
+    printf("    if( reference  != root ):\n");
+    printf("        print(\"Test %%d failed. %%d leaves\" %% (i, len(chunks)))\n");
+    printf("        print( 'reference == %%s' %% ( binascii.b2a_hex( root ) ) )" "\n"   );
+    printf("        print( '          != %%s' %% ( binascii.b2a_hex( reference ) ) )" "\n"   );
+    printf("        sys.exit(1)\n");
+    printf("print(\""STR(TEST_NAME)" %%d roots passed.\" %% len(checks))\n");
+
+    return 0;
+}
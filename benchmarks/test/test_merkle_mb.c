@@ -0,0 +1,67 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "riscvcrypto/share/test.h"
+
+#include "riscvcrypto/merkle/api_merkle.h"
+
+//! Leaf counts tested. Levels leave 0 to 3 pairs for the scalar tail.
+static size_t test_leaf_counts [] = {2, 7, 8, 9, 31, 64, 129};
+
+/*!
+@brief Build each tree with merkle_sha256_pairs_x4 and with the default
+    kernel, and check every node matches. test_merkle checks the default
+    kernel itself against hashlib.
+*/
+int main(int argc, char ** argv) {
+
+    printf("import sys\n");
+    printf("benchmark_name = \"" STR(TEST_NAME)"\"\n");
+
+    size_t          max_leaves = 129;
+    size_t          max_nodes  = merkle_tree_nodes(max_leaves);
+    uint8_t       * data       = malloc(max_leaves * SHA256_BLOCK_BYTES);
+    uint8_t       * nodes_x1   = malloc(max_nodes  * MERKLE_NODE_BYTES);
+    uint8_t       * nodes_x4   = malloc(max_nodes  * MERKLE_NODE_BYTES);
+    merkle_tree_t   tree_x1, tree_x4;
+    int             fails      = 0;
+
+    for(size_t t = 0; t < sizeof(test_leaf_counts)/sizeof(size_t); t ++) {
+
+        size_t nleaves = test_leaf_counts[t];
+        size_t nnodes  = merkle_tree_nodes(nleaves);
+
+        merkle_tree_init(&tree_x1, nodes_x1, nleaves, NULL);
+        merkle_tree_init(&tree_x4, nodes_x4, nleaves, merkle_sha256_pairs_x4);
+
+        test_rdrandom(data, nleaves * SHA256_BLOCK_BYTES);
+
+        for(size_t i = 0; i < nleaves; i ++) {
+            uint8_t * c = data + i * SHA256_BLOCK_BYTES;
+            merkle_tree_set_leaf(&tree_x1, i, c, SHA256_BLOCK_BYTES);
+            merkle_tree_set_leaf(&tree_x4, i, c, SHA256_BLOCK_BYTES);
+        }
+
+        merkle_tree_build(&tree_x1);
+        merkle_tree_build(&tree_x4);
+
+        if(memcmp(nodes_x1, nodes_x4, nnodes * MERKLE_NODE_BYTES)) {
+            printf("print(\"%d leaves: x4 kernel tree differs\")\n",
+                (int)nleaves);
+            fails ++;
+        }
+    }
+
+    free(data);
+    free(nodes_x1);
+    free(nodes_x4);
+
+    if(fails) {
+        printf("sys.exit(1)\n");
+    }
+
+    printf("print(\""STR(TEST_NAME)" %d trees passed.\")\n",
+        (int)(sizeof(test_leaf_counts)/sizeof(size_t)));
+
+    return 0;
+}